@@ -19,6 +19,7 @@
 #define BYTEIR_C_PASSES_H
 
 #include "mlir-c/IR.h"
+#include "mlir-c/Pass.h"
 #include "mlir-c/Support.h"
 
 #ifdef __cplusplus
@@ -27,6 +28,46 @@ extern "C" {
 
 MLIR_CAPI_EXPORTED void byteirRegisterAllPasses();
 
+//===----------------------------------------------------------------------===//
+// Pass profiling
+//===----------------------------------------------------------------------===//
+
+struct MlirPassProfile {
+  void *ptr;
+};
+typedef struct MlirPassProfile MlirPassProfile;
+
+/// A single run of a pass, strings are only valid during the callback
+struct MlirPassProfileRecord {
+  MlirStringRef passName;
+  MlirStringRef passArgument;
+  MlirStringRef anchorName;
+  int64_t opsBefore;
+  int64_t opsAfter;
+  double wallSeconds;
+  int64_t rssDeltaKB;
+};
+typedef struct MlirPassProfileRecord MlirPassProfileRecord;
+
+typedef void (*MlirPassProfileRecordCallback)(MlirPassProfileRecord record,
+                                              void *userData);
+
+MLIR_CAPI_EXPORTED MlirPassProfile byteirPassProfileCreate();
+
+MLIR_CAPI_EXPORTED void byteirPassProfileDestroy(MlirPassProfile profile);
+
+/// Record every pass run by `passManager` into `profile`, which could be
+/// destroyed before `passManager`
+MLIR_CAPI_EXPORTED void
+byteirPassManagerAttachProfile(MlirPassManager passManager,
+                               MlirPassProfile profile);
+
+/// Call `callback` on each record collected so far and clear them
+MLIR_CAPI_EXPORTED void
+byteirPassProfileTakeRecords(MlirPassProfile profile,
+                             MlirPassProfileRecordCallback callback,
+                             void *userData);
+
 #ifdef __cplusplus
 }
 #endif
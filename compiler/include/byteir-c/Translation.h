@@ -37,6 +37,17 @@ MLIR_CAPI_EXPORTED bool byteirTranslateToLLVMBC(MlirModule module,
 MLIR_CAPI_EXPORTED bool byteirTranslateToLLVMIR(MlirModule module,
                                                 MlirStringRef outputFile);
 
+/// Emit a static archive of host objects, see byteir::translateToLLVMArchive
+MLIR_CAPI_EXPORTED bool
+byteirTranslateToLLVMArchive(MlirModule module, MlirStringRef outputFile,
+                             unsigned numPartitions, unsigned numThreads,
+                             MlirStringRef cpu);
+
+MLIR_CAPI_EXPORTED bool
+byteirTranslateToStandaloneCpp(MlirModule module, MlirStringRef sourceFile,
+                               MlirStringRef headerFile,
+                               MlirStringRef entryName);
+
 MLIR_CAPI_EXPORTED bool byteirSerializeByre(MlirModule module,
                                             MlirStringRef targetVersion,
                                             MlirStringRef outputFile);
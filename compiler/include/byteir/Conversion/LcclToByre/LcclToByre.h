@@ -32,8 +32,10 @@ const StringRef ByreSendName = "nccl.Send";
 const StringRef ByreBroadcastName = "nccl.Broadcast";
 const StringRef ByreAllReduceName = "nccl.AllReduce";
 const StringRef ByreAllGatherName = "nccl.AllGather";
+const StringRef ByreWaitName = "nccl.Wait";
 const StringRef ByreRankStr = "rank";
 const StringRef ReplicaGroupStr = "replica_group";
+const StringRef ByreAsyncIdStr = "async_id";
 } // namespace byre
 
 void populateLcclToByrePattern(RewritePatternSet &patterns);
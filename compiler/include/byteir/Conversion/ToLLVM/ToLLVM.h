@@ -36,6 +36,9 @@ constexpr StringRef getByteIRLLVMModuleAttrName() {
 std::unique_ptr<OperationPass<func::FuncOp>>
 createGenLLVMConfigPass(const std::string &fileName = "host_kernels.ll");
 
+std::unique_ptr<OperationPass<ModuleOp>>
+createMergeHostKernelsPass(bool fuseLoops = true);
+
 std::unique_ptr<OperationPass<ModuleOp>> createCollectFuncToLLVMPass();
 
 } // namespace mlir
@@ -18,7 +18,11 @@
 #ifndef BYTEIR_DIALECT_BYRE_PASSES_H
 #define BYTEIR_DIALECT_BYRE_PASSES_H
 
+#include "byteir/Dialect/Byre/Transforms/AsyncCollectives.h"
+#include "byteir/Dialect/Byre/Transforms/NumaStage.h"
+#include "byteir/Dialect/Byre/Transforms/OpDependency.h"
 #include "byteir/Dialect/Byre/Transforms/Serial.h"
+#include "byteir/Dialect/Byre/Transforms/SessionInitHoisting.h"
 
 namespace mlir {
 
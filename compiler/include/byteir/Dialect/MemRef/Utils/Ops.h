@@ -18,6 +18,9 @@
 #ifndef BYTEIR_DIALECT_MEMREF_UTILS_OPS_H
 #define BYTEIR_DIALECT_MEMREF_UTILS_OPS_H
 
+#include "mlir/IR/Value.h"
+#include "llvm/ADT/SmallVector.h"
+
 namespace mlir {
 
 namespace memref {
@@ -32,6 +35,12 @@ class SubViewOp;
 bool doSubViewsConservativelyNotOverlap(memref::SubViewOp lhs,
                                         memref::SubViewOp rhs);
 
+// return the buffer which `value` views into through view-like ops
+Value getRootBuffer(Value value);
+
+// collect `root` and all values viewing into it through view-like ops
+SmallVector<Value> getAllViews(Value root);
+
 } // namespace mlir
 
 #endif // BYTEIR_DIALECT_MEMREF_UTILS_OPS_H
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "byteir/Dialect/SCF/Transforms/ForallCollapsing.h"
 #include "byteir/Dialect/SCF/Transforms/FuseNestedForall.h"
 #include "byteir/Dialect/SCF/Transforms/InsertTrivialSCFLoop.h"
+#include "byteir/Dialect/SCF/Transforms/SoftwarePrefetch.h"
 
 namespace mlir {
 
@@ -18,6 +18,7 @@
 #ifndef BYTEIR_DIALECT_MHLO_PASSES_H
 #define BYTEIR_DIALECT_MHLO_PASSES_H
 
+#include "byteir/Dialect/mhlo/Transforms/BF16MixedPrecision.h"
 #include "byteir/Dialect/mhlo/Transforms/BoundedShapeInference.h"
 #include "byteir/Dialect/mhlo/Transforms/ClusterConstraint.h"
 #include "byteir/Dialect/mhlo/Transforms/ConvertFuncToCustomCall.h"
@@ -36,6 +37,7 @@
 #include "byteir/Dialect/mhlo/Transforms/InsertShapeConstraint.h"
 #include "byteir/Dialect/mhlo/Transforms/LayoutTransformation.h"
 #include "byteir/Dialect/mhlo/Transforms/MatmulLayoutTransform.h"
+#include "byteir/Dialect/mhlo/Transforms/QuantizeInt8.h"
 #include "byteir/Dialect/mhlo/Transforms/RewriteWithConstraint.h"
 #include "byteir/Dialect/mhlo/Transforms/ShapeReification.h"
 #include "byteir/Dialect/mhlo/Transforms/StaticShapeInference.h"
@@ -109,6 +109,10 @@ constexpr llvm::StringRef getRepeatName() {
   return CUSTOM_CALL_NAME_PREFIX "repeat";
 }
 
+constexpr llvm::StringRef getConv2dNCHWcName() {
+  return CUSTOM_CALL_NAME_PREFIX "conv2d_nchwc";
+}
+
 constexpr llvm::StringRef getDynamicPartitionName() {
   return TF_NAME_PREFIX "DynamicPartition";
 }
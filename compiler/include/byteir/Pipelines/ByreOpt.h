@@ -38,6 +38,30 @@ struct ByreOptPipelineOptions
       *this, "disable-memory-planning",
       llvm::cl::desc("whether to disable memory planning"),
       llvm::cl::init(false)};
+  Option<bool> enableInPlaceConcatSlice{
+      *this, "enable-inplace-concat-slice",
+      llvm::cl::desc("whether to write concat operands and read slices in "
+                     "place"),
+      llvm::cl::init(false)};
+  Option<bool> enableSessionInitHoisting{
+      *this, "enable-session-init-hoisting",
+      llvm::cl::desc("whether to hoist weight-only computes to session "
+                     "initialization"),
+      llvm::cl::init(false)};
+  Option<bool> enableAsyncCollectives{
+      *this, "enable-async-collectives",
+      llvm::cl::desc("whether to overlap collectives with computation"),
+      llvm::cl::init(false)};
+  Option<bool> enableOpDependency{
+      *this, "enable-op-dependency",
+      llvm::cl::desc("whether to annotate byre ops with dependencies for "
+                     "concurrent execution"),
+      llvm::cl::init(false)};
+  Option<int64_t> numaStages{
+      *this, "numa-stages",
+      llvm::cl::desc("number of stages split for NUMA nodes, 0 or 1 to "
+                     "disable"),
+      llvm::cl::init(0)};
 };
 
 void createByreOptPipeline(OpPassManager &pm,
@@ -34,6 +34,11 @@ struct HloGraphOptPipelineOptions
       *this, "target",
       llvm::cl::desc("An optional attribute to speicify target."),
       llvm::cl::init("")};
+  Option<std::string> convLayout{
+      *this, "conv-layout",
+      llvm::cl::desc("An optional layout which convolutions are transformed "
+                     "to on the cpu target, e.g. NCHW8c"),
+      llvm::cl::init("")};
 };
 
 void createHloGraphOptPipeline(OpPassManager &pm,
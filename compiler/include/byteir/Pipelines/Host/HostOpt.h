@@ -30,6 +30,20 @@ struct HostOptPipelineOptions
       llvm::cl::desc(
           "To specify where the generated llvm kernel will be writed to"),
       llvm::cl::init("host_kernels.ll")};
+  Option<bool> enableKernelMerge{
+      *this, "enable-kernel-merge",
+      llvm::cl::desc("Merge consecutive producer/consumer host kernels and "
+                     "fuse their loops"),
+      llvm::cl::init(false)};
+  Option<bool> enablePrefetch{
+      *this, "enable-prefetch",
+      llvm::cl::desc("Insert software prefetches into host kernel loops"),
+      llvm::cl::init(false)};
+  Option<int64_t> prefetchDistance{
+      *this, "prefetch-distance",
+      llvm::cl::desc("Prefetch distance in loop iterations, 0 to derive it "
+                     "from the cpu cost model"),
+      llvm::cl::init(0)};
 };
 
 void createHostOptPipeline(OpPassManager &pm,
@@ -19,15 +19,25 @@
 #define BYTEIR_PIPELINES_HOST_TOLLVM_H
 
 #include "mlir/Pass/PassManager.h"
+#include "mlir/Pass/PassOptions.h"
 #include "mlir/Pass/PassRegistry.h"
 
 namespace mlir {
+struct ToLLVMPipelineOptions
+    : public PassPipelineOptions<ToLLVMPipelineOptions> {
+  Option<bool> emulateBF16{
+      *this, "emulate-bf16",
+      llvm::cl::desc("Expand bf16 extf/truncf into integer ops instead of "
+                     "relying on native bf16 support of the target"),
+      llvm::cl::init(true)};
+};
 
-void createToLLVMPipeline(OpPassManager &pm);
+void createToLLVMPipeline(OpPassManager &pm,
+                          const ToLLVMPipelineOptions &options);
 
 inline void registerToLLVMPipeline() {
-  PassPipelineRegistration<>("to-llvm", "To LLVM dialect Pipeline",
-                             createToLLVMPipeline);
+  PassPipelineRegistration<ToLLVMPipelineOptions>(
+      "to-llvm", "To LLVM dialect Pipeline", createToLLVMPipeline);
 }
 
 } // namespace mlir
@@ -20,11 +20,13 @@
 
 #include "byteir/Stat/AllocCnt/AllocCnt.h"
 #include "byteir/Stat/OpCnt/OpCnt.h"
+#include "byteir/Stat/Roofline/Roofline.h"
 
 namespace byteir {
 inline void registerAllStatistics() {
   registerAllocCntStatistics();
   registerOpCntStatistics();
+  registerRooflineStatistics();
 }
 } // namespace byteir
 
@@ -0,0 +1,53 @@
+//===- Roofline.h ---------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef BYTEIR_STAT_ROOFLINE_ROOFLINE_H
+#define BYTEIR_STAT_ROOFLINE_ROOFLINE_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+namespace byteir {
+
+void registerRooflineStatistics();
+
+struct MachineProfile {
+  // peak compute throughput in GFLOP/s
+  double peakGFlops = 1000.0;
+  // peak memory bandwidth in GB/s
+  double peakBandwidth = 100.0;
+};
+
+// Estimate FLOPs, bytes read and bytes written of mhlo, linalg and byre ops
+// within funcOps in a ModuleOp, aggregated by op type and function, together
+// with the arithmetic intensity and roofline time against `machine`.
+// Fusions, calls and byre.compute are reported as kernels, whose bytes only
+// count their operands and results.
+// Counts of dynamic shapes are kept symbolic, unless `dynamicDimSize` is
+// positive, which is then used as the size of every dynamic dimension.
+// funcName and topOnly behave the same as in opCntStatistics.
+mlir::LogicalResult rooflineStatistics(mlir::ModuleOp op, llvm::raw_ostream &os,
+                                       const MachineProfile &machine,
+                                       const std::string &funcName = "",
+                                       bool topOnly = false,
+                                       int64_t dynamicDimSize = 0);
+
+} // namespace byteir
+
+#endif // BYTEIR_STAT_ROOFLINE_ROOFLINE_H
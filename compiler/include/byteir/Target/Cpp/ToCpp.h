@@ -30,6 +30,17 @@ void registerToCppTranslation();
 /// arguments are declared at the beginning of the function.
 mlir::LogicalResult translateToCpp(mlir::Operation *op, llvm::raw_ostream &os,
                                    bool declareVariablesAtTop = false);
+
+/// Translates a byre module with host kernels, i.e. the output of byre-opt for
+/// cpu, to self-contained C++ code. The source holds the kernels, constants,
+/// a static arena for the memory plan and an entry function named
+/// 'entryName' taking type-erased pointers of inputs and outputs. The header
+/// declares the entry function and describes its arguments if 'emitHeader' is
+/// set.
+mlir::LogicalResult translateToStandaloneCpp(mlir::Operation *op,
+                                             llvm::raw_ostream &os,
+                                             bool emitHeader = false,
+                                             llvm::StringRef entryName = "run");
 } // namespace byteir
 
 #endif // BYTEIR_TARGET_CPP_TOCPP_H
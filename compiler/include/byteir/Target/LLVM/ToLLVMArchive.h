@@ -0,0 +1,54 @@
+//===- ToLLVMArchive.h ------------------------------------------*- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef BYTEIR_TARGET_LLVMIR_TOLLVMARCHIVE_H
+#define BYTEIR_TARGET_LLVMIR_TOLLVMARCHIVE_H
+
+#include "mlir/Support/LogicalResult.h"
+#include "llvm/Support/raw_ostream.h"
+#include <string>
+
+namespace mlir {
+class Operation;
+} // namespace mlir
+
+namespace byteir {
+
+struct LLVMArchiveOptions {
+  // number of partitions the module is split into by function, which alone
+  // decides the content of the archive
+  unsigned numPartitions = 1;
+  // number of threads optimizing and emitting partitions, 0 for all cores
+  unsigned numThreads = 0;
+  unsigned optLevel = 3;
+  // host cpu if empty
+  std::string cpu;
+};
+
+/// Translate `op` into LLVM IR, split it by function into partitions balanced
+/// by instruction count, then optimize and emit an object of each partition
+/// concurrently. The objects are written into `os` as a static archive, which
+/// could be loaded by LLVMJITOp of brt in place of LLVM IR.
+mlir::LogicalResult translateToLLVMArchive(mlir::Operation *op,
+                                           llvm::raw_ostream &os,
+                                           const LLVMArchiveOptions &options);
+
+void registerToLLVMArchiveTranslation();
+
+} // namespace byteir
+
+#endif // BYTEIR_TARGET_LLVMIR_TOLLVMARCHIVE_H
@@ -29,6 +29,7 @@
 #include "byteir/Transforms/GenericDeviceConfig.h"
 #include "byteir/Transforms/GraphClusteringByDevice.h"
 #include "byteir/Transforms/InsertUniqueId.h"
+#include "byteir/Transforms/LargeConstantToResource.h"
 #include "byteir/Transforms/LoopTag.h"
 #include "byteir/Transforms/LoopUnroll.h"
 #include "byteir/Transforms/MemoryPlanning.h"
@@ -18,8 +18,10 @@
 #ifndef BYTEIR_UTILS_HASHUTILS_H
 #define BYTEIR_UTILS_HASHUTILS_H
 
+#include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/Types.h"
 #include "mlir/IR/Value.h"
+#include "llvm/ADT/Hashing.h"
 
 namespace byteir {
 
@@ -31,6 +33,15 @@ struct MlirTypeHash {
   size_t operator()(const mlir::Type &t) const { return hash_value(t); }
 };
 
+// hash the payload of a DenseElementsAttr regardless of its shape, so that
+// byte-identical constants with different shapes collide
+inline llvm::hash_code hashDenseElementsContent(mlir::DenseElementsAttr attr) {
+  return llvm::hash_combine(attr.getElementType(), attr.getNumElements(),
+                            attr.isSplat(),
+                            llvm::hash_combine_range(attr.getRawData().begin(),
+                                                     attr.getRawData().end()));
+}
+
 } // namespace byteir
 
 #endif // BYTEIR_UTILS_HASHUTILS_H
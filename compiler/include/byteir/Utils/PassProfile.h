@@ -0,0 +1,66 @@
+//===- PassProfile.h --------------------------------------------*- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef BYTEIR_UTILS_PASSPROFILE_H
+#define BYTEIR_UTILS_PASSPROFILE_H
+
+#include "mlir/Pass/PassManager.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mlir {
+
+/// A single run of a pass on an anchor op
+struct PassProfileRecord {
+  std::string passName;
+  std::string passArgument;
+  std::string anchorName;
+  // number of ops nested in the anchor op, including itself
+  int64_t opsBefore = 0;
+  int64_t opsAfter = 0;
+  double wallSeconds = 0.0;
+  // change of the resident set size of the process over the pass in KB, which
+  // also counts passes running concurrently on other anchors
+  int64_t rssDeltaKB = 0;
+};
+
+/// Collects PassProfileRecord from pass managers it is attached to, which may
+/// run passes of nested pass managers concurrently
+class PassProfile {
+public:
+  void addRecord(PassProfileRecord record);
+
+  /// Move out all records collected so far
+  std::vector<PassProfileRecord> takeRecords();
+
+private:
+  std::mutex mutex;
+  std::vector<PassProfileRecord> records;
+};
+
+/// Attach an instrumentation to `pm` which records every pass run into
+/// `profile`. Pass adaptors are not recorded since their nested passes are.
+void attachPassProfile(PassManager &pm, std::shared_ptr<PassProfile> profile);
+
+/// Return the current resident set size of the process in KB, or 0 if unknown
+int64_t getCurrentRSSKB();
+
+} // namespace mlir
+
+#endif // BYTEIR_UTILS_PASSPROFILE_H
@@ -35,6 +35,9 @@
 #include "byteir/Target/Cpp/ToCpp.h"
 #include "byteir/Target/PTX/ToPTX.h"
 #include "byteir/Transforms/Passes.h"
+#include "byteir/Utils/PassProfile.h"
+#include "mlir/CAPI/Pass.h"
+#include "mlir/CAPI/Support.h"
 #include "mlir/InitAllTranslations.h"
 
 using namespace mlir;
@@ -63,3 +66,38 @@ void byteirRegisterAllPasses() {
   registerAllByteIRGPUPipelines();
   registerAllByteIRHostPipelines();
 }
+
+//===----------------------------------------------------------------------===//
+// Pass profiling
+//===----------------------------------------------------------------------===//
+
+static std::shared_ptr<PassProfile> &unwrap(MlirPassProfile profile) {
+  return *static_cast<std::shared_ptr<PassProfile> *>(profile.ptr);
+}
+
+MlirPassProfile byteirPassProfileCreate() {
+  return MlirPassProfile{
+      new std::shared_ptr<PassProfile>(std::make_shared<PassProfile>())};
+}
+
+void byteirPassProfileDestroy(MlirPassProfile profile) {
+  delete static_cast<std::shared_ptr<PassProfile> *>(profile.ptr);
+}
+
+void byteirPassManagerAttachProfile(MlirPassManager passManager,
+                                    MlirPassProfile profile) {
+  attachPassProfile(*unwrap(passManager), unwrap(profile));
+}
+
+void byteirPassProfileTakeRecords(MlirPassProfile profile,
+                                  MlirPassProfileRecordCallback callback,
+                                  void *userData) {
+  for (auto &record : unwrap(profile)->takeRecords()) {
+    callback(MlirPassProfileRecord{wrap(llvm::StringRef(record.passName)),
+                                   wrap(llvm::StringRef(record.passArgument)),
+                                   wrap(llvm::StringRef(record.anchorName)),
+                                   record.opsBefore, record.opsAfter,
+                                   record.wallSeconds, record.rssDeltaKB},
+             userData);
+  }
+}
@@ -19,6 +19,8 @@
 #include "byteir/Dialect/Byre/ByreDialect.h"
 #include "byteir/Dialect/Byre/Serialization.h"
 #include "byteir/Dialect/Byre/Serialization/Versioning.h"
+#include "byteir/Target/Cpp/ToCpp.h"
+#include "byteir/Target/LLVM/ToLLVMArchive.h"
 #include "byteir/Target/PTX/ToPTX.h"
 #include "byteir/Utils/ModuleUtils.h"
 #include "mlir/CAPI/IR.h"
@@ -97,6 +99,40 @@ bool byteirTranslateToLLVMIR(MlirModule module, MlirStringRef outputFile) {
   return true;
 }
 
+bool byteirTranslateToLLVMArchive(MlirModule module, MlirStringRef outputFile,
+                                  unsigned numPartitions, unsigned numThreads,
+                                  MlirStringRef cpu) {
+  std::error_code ec;
+  llvm::raw_fd_ostream fout(std::string(unwrap(outputFile)), ec);
+  if (ec) {
+    llvm::errs() << "failed to create output file: " << unwrap(outputFile);
+    return false;
+  }
+  byteir::LLVMArchiveOptions options;
+  options.numPartitions = numPartitions;
+  options.numThreads = numThreads;
+  options.cpu = unwrap(cpu).str();
+  return mlir::succeeded(byteir::translateToLLVMArchive(
+      unwrap(module).getOperation(), fout, options));
+}
+
+bool byteirTranslateToStandaloneCpp(MlirModule module, MlirStringRef sourceFile,
+                                    MlirStringRef headerFile,
+                                    MlirStringRef entryName) {
+  auto emit = [&](MlirStringRef outputFile, bool emitHeader) {
+    std::error_code ec;
+    llvm::raw_fd_ostream fout(std::string(unwrap(outputFile)), ec);
+    if (ec) {
+      llvm::errs() << "failed to create output file: " << unwrap(outputFile);
+      return false;
+    }
+    return mlir::succeeded(byteir::translateToStandaloneCpp(
+        unwrap(module), fout, emitHeader, unwrap(entryName)));
+  };
+  return emit(sourceFile, /*emitHeader=*/false) &&
+         emit(headerFile, /*emitHeader=*/true);
+}
+
 bool byteirSerializeByre(MlirModule module, MlirStringRef targetVersion,
                          MlirStringRef outputFile) {
   mlir::ModuleOp m = unwrap(module);
@@ -420,8 +420,11 @@ static inline void markFuncOpInOutTypeForLmhlo(func::FuncOp func,
 }
 
 static void replaceGetGlobalConstantWithFuncArgument(func::FuncOp funcOp) {
-  SmallVector<std::pair<Type, DenseElementsAttr>> typeAndValue;
-  SmallVector<Operation *> globalConstants;
+  SmallVector<std::pair<Type, ElementsAttr>> typeAndValue;
+  // get_global ops and the index of their weight argument, all get_global ops
+  // of the same global share a single weight
+  SmallVector<std::pair<Operation *, unsigned>> globalConstants;
+  llvm::DenseMap<Operation *, unsigned> globalToWeightIdx;
   funcOp.walk([&](memref::GetGlobalOp getGlobalOp) {
     auto globalOp = SymbolTable::lookupNearestSymbolFrom<memref::GlobalOp>(
         getGlobalOp, getGlobalOp.getNameAttr());
@@ -433,14 +436,26 @@ static void replaceGetGlobalConstantWithFuncArgument(func::FuncOp funcOp) {
       return;
     }
 
-    DenseElementsAttr value =
-        llvm::dyn_cast_or_null<DenseElementsAttr>(*valueOrNot);
-    if (!value || value.isSplat()) {
+    // resource blobs are attached as they are to avoid copying large weights
+    ElementsAttr value;
+    if (auto denseAttr =
+            llvm::dyn_cast_or_null<DenseElementsAttr>(*valueOrNot)) {
+      if (denseAttr.isSplat()) {
+        return;
+      }
+      value = denseAttr;
+    } else {
+      value = llvm::dyn_cast_or_null<DenseResourceElementsAttr>(*valueOrNot);
+    }
+    if (!value) {
       return;
     }
 
-    typeAndValue.emplace_back(getGlobalOp.getResult().getType(), value);
-    globalConstants.emplace_back(getGlobalOp);
+    auto found = globalToWeightIdx.try_emplace(globalOp, typeAndValue.size());
+    if (found.second) {
+      typeAndValue.emplace_back(getGlobalOp.getResult().getType(), value);
+    }
+    globalConstants.emplace_back(getGlobalOp, found.first->second);
   });
 
   auto argTypeAttrName = byre::ByreDialect::getEntryPointFuncArgTypeAttrName();
@@ -495,11 +510,9 @@ static void replaceGetGlobalConstantWithFuncArgument(func::FuncOp funcOp) {
   }
 
   mlir::function_interface_impl::setAllArgAttrDicts(funcOp, newArgAttrs);
-  int idx = 0;
-  for (auto op : globalConstants) {
+  for (auto [op, idx] : globalConstants) {
     auto value = op->getResult(0);
     value.replaceAllUsesWith(entry.getArgument(idx));
-    idx += 1;
     op->erase();
   }
 }
@@ -0,0 +1,343 @@
+//===- MergeHostKernels.cpp -----------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Conversion/ToLLVM/ToLLVM.h"
+#include "byteir/Dialect/MemRef/Utils/Ops.h"
+#include "byteir/Dialect/mhlo/Transforms/HloFuser.h"
+#include "byteir/Utils/FuncUtils.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Debug.h"
+
+#include "../PassDetail.h"
+
+#define DEBUG_TYPE "merge-host-kernels"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+constexpr unsigned kMaxExprDepth = 8;
+
+bool isHostKernel(func::FuncOp func) {
+  return func && func.isPrivate() && !func.isExternal() &&
+         func.getBody().hasOneBlock() &&
+         (func->hasAttr(getByteIRHloAggressiveFusionAttrName()) ||
+          func->hasAttr(getByteIRElementwiseFusionAttrName()));
+}
+
+//===----------------------------------------------------------------------===//
+// kernel merging
+//===----------------------------------------------------------------------===//
+
+// Merge `second`, which consumes some results of `first` right before it,
+// into a single call of a new function inlining both callees.
+func::CallOp mergeCalls(func::CallOp first, func::CallOp second,
+                        func::FuncOp firstCallee, func::FuncOp secondCallee,
+                        SymbolTable &symbolTable) {
+  SetVector<Value> operands;
+  operands.insert(first.getOperands().begin(), first.getOperands().end());
+  for (Value operand : second.getOperands()) {
+    if (operand.getDefiningOp() != first)
+      operands.insert(operand);
+  }
+  // results of `first` only consumed by `second` become internal buffers
+  SmallVector<Value> results;
+  for (Value result : first.getResults()) {
+    if (llvm::any_of(result.getUsers(),
+                     [&](Operation *user) { return user != second; }))
+      results.push_back(result);
+  }
+  results.append(second.getResults().begin(), second.getResults().end());
+
+  OpBuilder b(first->getContext());
+  auto funcType = b.getFunctionType(TypeRange(operands.getArrayRef()),
+                                    TypeRange(results));
+  auto merged = func::FuncOp::create(firstCallee.getLoc(),
+                                     firstCallee.getSymName(), funcType);
+  merged.setPrivate();
+  cloneAllExtraFuncAttrs(firstCallee, merged);
+  cloneAllExtraFuncAttrs(secondCallee, merged);
+
+  // inline callees in call order
+  Block *entry = merged.addEntryBlock();
+  b.setInsertionPointToEnd(entry);
+  IRMapping valueMap;
+  for (auto [operand, arg] : llvm::zip(operands, entry->getArguments()))
+    valueMap.map(operand, arg);
+  for (auto [call, callee] :
+       {std::make_pair(first, firstCallee),
+        std::make_pair(second, secondCallee)}) {
+    IRMapping mapping;
+    for (auto [arg, operand] :
+         llvm::zip(callee.getArguments(), call.getOperands()))
+      mapping.map(arg, valueMap.lookup(operand));
+    Block &body = callee.getBody().front();
+    for (Operation &op : body.without_terminator())
+      b.clone(op, mapping);
+    for (auto [result, returned] :
+         llvm::zip(call.getResults(), body.getTerminator()->getOperands()))
+      valueMap.map(result, mapping.lookupOrDefault(returned));
+  }
+  b.create<func::ReturnOp>(
+      second.getLoc(), llvm::to_vector(llvm::map_range(results, [&](Value v) {
+        return valueMap.lookup(v);
+      })));
+
+  symbolTable.erase(firstCallee);
+  symbolTable.erase(secondCallee);
+  symbolTable.insert(merged, first->getParentOfType<func::FuncOp>()
+                                 ->getIterator());
+
+  b.setInsertionPoint(second);
+  auto mergedCall = b.create<func::CallOp>(second.getLoc(), merged,
+                                           operands.getArrayRef());
+  for (auto [result, newResult] : llvm::zip(results, mergedCall.getResults()))
+    result.replaceAllUsesWith(newResult);
+  second->erase();
+  first->erase();
+  return mergedCall;
+}
+
+//===----------------------------------------------------------------------===//
+// loop fusion
+//===----------------------------------------------------------------------===//
+
+// whether `lhs` in `lhsLoop` computes the same value as `rhs` in `rhsLoop` for
+// the same induction variable
+bool isEquivalentValue(Value lhs, Value rhs, scf::ForOp lhsLoop,
+                       scf::ForOp rhsLoop, unsigned depth = 0) {
+  if (lhs == lhsLoop.getInductionVar() || rhs == rhsLoop.getInductionVar())
+    return lhs == lhsLoop.getInductionVar() &&
+           rhs == rhsLoop.getInductionVar();
+  if (lhs == rhs)
+    return true;
+  auto lhsConst = getConstantIntValue(lhs);
+  auto rhsConst = getConstantIntValue(rhs);
+  if (lhsConst || rhsConst)
+    return lhsConst == rhsConst && lhs.getType() == rhs.getType();
+
+  Operation *lhsDef = lhs.getDefiningOp();
+  Operation *rhsDef = rhs.getDefiningOp();
+  if (!lhsDef || !rhsDef || depth >= kMaxExprDepth ||
+      lhs.getType() != rhs.getType())
+    return false;
+  if (lhsDef->getName() != rhsDef->getName() ||
+      lhsDef->getAttrDictionary() != rhsDef->getAttrDictionary() ||
+      lhsDef->getNumOperands() != rhsDef->getNumOperands() ||
+      lhsDef->getNumRegions() > 0 ||
+      cast<OpResult>(lhs).getResultNumber() !=
+          cast<OpResult>(rhs).getResultNumber())
+    return false;
+  if (!isPure(lhsDef) && !isa<ViewLikeOpInterface>(lhsDef))
+    return false;
+  return llvm::all_of(
+      llvm::zip(lhsDef->getOperands(), rhsDef->getOperands()), [&](auto it) {
+        return isEquivalentValue(std::get<0>(it), std::get<1>(it), lhsLoop,
+                                 rhsLoop, depth + 1);
+      });
+}
+
+struct Access {
+  Value memref;
+  SmallVector<Value> indices;
+  bool isWrite;
+};
+
+// Collect memory accesses of a loop whose body only has loads, stores and
+// pure ops, return false otherwise
+bool collectAccesses(scf::ForOp loop, SmallVectorImpl<Access> &accesses) {
+  if (loop.getNumResults() > 0)
+    return false;
+  for (Operation &op : loop.getBody()->without_terminator()) {
+    if (auto loadOp = dyn_cast<memref::LoadOp>(op)) {
+      accesses.push_back({loadOp.getMemRef(),
+                          llvm::to_vector(loadOp.getIndices()), false});
+    } else if (auto storeOp = dyn_cast<memref::StoreOp>(op)) {
+      accesses.push_back({storeOp.getMemRef(),
+                          llvm::to_vector(storeOp.getIndices()), true});
+    } else if (!isPure(&op) || op.getNumRegions() > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool haveSameBounds(scf::ForOp lhs, scf::ForOp rhs) {
+  auto isSame = [](Value a, Value b) {
+    if (a == b)
+      return true;
+    auto aConst = getConstantIntValue(a), bConst = getConstantIntValue(b);
+    return aConst && aConst == bConst;
+  };
+  return isSame(lhs.getLowerBound(), rhs.getLowerBound()) &&
+         isSame(lhs.getUpperBound(), rhs.getUpperBound()) &&
+         isSame(lhs.getStep(), rhs.getStep()) &&
+         lhs.getInductionVar().getType() == rhs.getInductionVar().getType();
+}
+
+// Fusing `consumer` into `producer` keeps the order of accesses to a buffer
+// if every pair of accesses involving a write touches the same element
+bool canFuseLoops(scf::ForOp producer, scf::ForOp consumer) {
+  SmallVector<Access> producerAccesses, consumerAccesses;
+  if (!haveSameBounds(producer, consumer) ||
+      !collectAccesses(producer, producerAccesses) ||
+      !collectAccesses(consumer, consumerAccesses))
+    return false;
+
+  for (auto &lhs : producerAccesses) {
+    for (auto &rhs : consumerAccesses) {
+      if ((!lhs.isWrite && !rhs.isWrite) ||
+          getRootBuffer(lhs.memref) != getRootBuffer(rhs.memref))
+        continue;
+      if (!isEquivalentValue(lhs.memref, rhs.memref, producer, consumer) ||
+          lhs.indices.size() != rhs.indices.size())
+        return false;
+      for (auto [lhsIndex, rhsIndex] : llvm::zip(lhs.indices, rhs.indices)) {
+        if (!isEquivalentValue(lhsIndex, rhsIndex, producer, consumer))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+// ops between two loops which could be moved before the first one
+bool isMovableBetweenLoops(Operation *op) {
+  return op->getNumRegions() == 0 &&
+         (isPure(op) || isa<memref::AllocOp, memref::AllocaOp>(op));
+}
+
+// Fuse adjacent loops in `block` with the same bounds, return the number of
+// fused loops
+int64_t fuseAdjacentLoops(Block &block) {
+  int64_t numFused = 0;
+  for (auto it = block.begin(); it != block.end(); ++it) {
+    auto producer = dyn_cast<scf::ForOp>(*it);
+    if (!producer)
+      continue;
+    while (true) {
+      SmallVector<Operation *> between;
+      Operation *next = producer->getNextNode();
+      while (next && !isa<scf::ForOp>(next) && isMovableBetweenLoops(next)) {
+        between.push_back(next);
+        next = next->getNextNode();
+      }
+      auto consumer = dyn_cast_or_null<scf::ForOp>(next);
+      if (!consumer || !canFuseLoops(producer, consumer))
+        break;
+
+      LLVM_DEBUG(llvm::dbgs() << "fuse loop " << consumer << "\n");
+      for (Operation *op : between)
+        op->moveBefore(producer);
+      consumer.getInductionVar().replaceAllUsesWith(
+          producer.getInductionVar());
+      Block *producerBody = producer.getBody();
+      Block *consumerBody = consumer.getBody();
+      producerBody->getOperations().splice(
+          Block::iterator(producerBody->getTerminator()),
+          consumerBody->getOperations(), consumerBody->begin(),
+          Block::iterator(consumerBody->getTerminator()));
+      consumer->erase();
+      ++numFused;
+    }
+  }
+  return numFused;
+}
+
+struct MergeHostKernelsPass
+    : public MergeHostKernelsBase<MergeHostKernelsPass> {
+  MergeHostKernelsPass(bool fuse) : MergeHostKernelsBase() {
+    fuseLoops = fuse;
+  }
+
+  void runOnOperation() override {
+    ModuleOp m = getOperation();
+    SymbolTable symbolTable(m);
+
+    DenseMap<Operation *, int64_t> numCalls;
+    m.walk([&](func::CallOp call) {
+      if (auto callee = symbolTable.lookup<func::FuncOp>(call.getCallee()))
+        ++numCalls[callee];
+    });
+    auto getMergeableCallee = [&](Operation *op) -> func::FuncOp {
+      auto call = dyn_cast_or_null<func::CallOp>(op);
+      if (!call)
+        return nullptr;
+      auto callee = symbolTable.lookup<func::FuncOp>(call.getCallee());
+      if (!isHostKernel(callee) || numCalls[callee] != 1 ||
+          call->getParentOfType<func::FuncOp>()->getParentOp() != m)
+        return nullptr;
+      return callee;
+    };
+
+    SmallVector<func::CallOp> calls;
+    m.walk([&](func::CallOp call) {
+      if (getMergeableCallee(call))
+        calls.push_back(call);
+    });
+
+    SmallVector<func::FuncOp> mergedFuncs;
+    DenseSet<Operation *> erased;
+    for (func::CallOp call : calls) {
+      if (erased.contains(call))
+        continue;
+      func::CallOp first = call;
+      while (true) {
+        auto second = dyn_cast_or_null<func::CallOp>(first->getNextNode());
+        func::FuncOp firstCallee = getMergeableCallee(first);
+        func::FuncOp secondCallee = getMergeableCallee(second);
+        if (!firstCallee || !secondCallee || firstCallee == secondCallee ||
+            llvm::none_of(second.getOperands(), [&](Value operand) {
+              return operand.getDefiningOp() == first;
+            }))
+          break;
+
+        erased.insert(first);
+        erased.insert(second);
+        llvm::erase_value(mergedFuncs, firstCallee);
+        first = mergeCalls(first, second, firstCallee, secondCallee,
+                           symbolTable);
+        auto merged = symbolTable.lookup<func::FuncOp>(first.getCallee());
+        numCalls[merged] = 1;
+        mergedFuncs.push_back(merged);
+        ++numMergedKernels;
+      }
+    }
+
+    if (!fuseLoops)
+      return;
+    for (func::FuncOp func : mergedFuncs)
+      numFusedLoops += fuseAdjacentLoops(func.getBody().front());
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+mlir::createMergeHostKernelsPass(bool fuseLoops) {
+  return std::make_unique<MergeHostKernelsPass>(fuseLoops);
+}
@@ -1326,6 +1326,80 @@ inline Value mapFPToSIConvertOpToStdScalarOp(Location loc,
   return nullptr;
 }
 
+// Lower byteir.conv2d_nchwc, whose operands are the padded [N, C/b, H, W, b]
+// input and the [O/b, I/b, KH, KW, b(I), b(O)] weight, into a linalg.generic
+// with the output channel block as the innermost parallel dim.
+class Conv2dNCHWcCustomCallConverter
+    : public OpConversionPattern<mhlo::CustomCallOp> {
+public:
+  using OpConversionPattern<mhlo::CustomCallOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(mhlo::CustomCallOp op, mhlo::CustomCallOp::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const final {
+    if (op.getCallTargetName() != getConv2dNCHWcName())
+      return failure();
+
+    auto attr = op->getAttrOfType<DictionaryAttr>(getCustomCallAttrName());
+    if (!attr)
+      return failure();
+    auto stridesAttr = attr.getAs<ArrayAttr>("window_strides");
+    auto dilationAttr = attr.getAs<ArrayAttr>("rhs_dilation");
+    if (!stridesAttr || !dilationAttr || stridesAttr.size() != 2 ||
+        dilationAttr.size() != 2)
+      return failure();
+    SmallVector<int64_t> strides, dilation;
+    for (auto s : stridesAttr.getAsRange<IntegerAttr>())
+      strides.push_back(s.getInt());
+    for (auto d : dilationAttr.getAsRange<IntegerAttr>())
+      dilation.push_back(d.getInt());
+
+    auto loc = op.getLoc();
+    auto resultType = dyn_cast<RankedTensorType>(op->getResult(0).getType());
+    if (!resultType || !resultType.hasStaticShape() ||
+        resultType.getRank() != 5)
+      return failure();
+    Type elementType = resultType.getElementType();
+    if (!isa<FloatType, IntegerType>(elementType))
+      return failure();
+
+    // (n, ob, oh, ow, oc, ib, kh, kw, ic)
+    MLIRContext *ctx = rewriter.getContext();
+    AffineExpr n, ob, oh, ow, oc, ib, kh, kw, ic;
+    bindDims(ctx, n, ob, oh, ow, oc, ib, kh, kw, ic);
+    SmallVector<AffineMap> indexingMaps = {
+        AffineMap::get(9, 0,
+                       {n, ib, oh * strides[0] + kh * dilation[0],
+                        ow * strides[1] + kw * dilation[1], ic},
+                       ctx),
+        AffineMap::get(9, 0, {ob, ib, kh, kw, ic, oc}, ctx),
+        AffineMap::get(9, 0, {n, ob, oh, ow, oc}, ctx)};
+    SmallVector<utils::IteratorType> iteratorTypes(
+        5, utils::IteratorType::parallel);
+    iteratorTypes.append(4, utils::IteratorType::reduction);
+
+    Value emptyTensor = rewriter.create<tensor::EmptyOp>(
+        loc, resultType.getShape(), elementType);
+    Value init = fillTensorWithZeros(rewriter, loc, emptyTensor);
+    rewriter.replaceOpWithNewOp<linalg::GenericOp>(
+        op, TypeRange{resultType}, adaptor.getOperands(), ValueRange{init},
+        indexingMaps, iteratorTypes,
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value result;
+          if (isa<FloatType>(elementType)) {
+            Value mul = b.create<arith::MulFOp>(loc, args[0], args[1]);
+            result = b.create<arith::AddFOp>(loc, args[2], mul);
+          } else {
+            Value mul = b.create<arith::MulIOp>(loc, args[0], args[1]);
+            result = b.create<arith::AddIOp>(loc, args[2], mul);
+          }
+          b.create<linalg::YieldOp>(loc, result);
+        },
+        linalg::getPrunedAttributeList(op));
+    return success();
+  }
+};
+
 class FPToSIConvertOpConverter : public OpConversionPattern<mhlo::ConvertOp> {
 public:
   using OpConversionPattern<mhlo::ConvertOp>::OpConversionPattern;
@@ -1448,6 +1522,7 @@ void mlir::populateHloToLinalgExtConversionPattern(TypeConverter &typeConverter,
   patterns.add<RngUniformCustomCallConverter>(ctx);
   patterns.add<RngNormalCustomCallConverter>(ctx);
   patterns.add<ByteirRepeatCustomCallConverter>(ctx);
+  patterns.add<Conv2dNCHWcCustomCallConverter>(ctx);
 }
 
 std::unique_ptr<OperationPass<func::FuncOp>> mlir::createHloFusionToLinalgPass(
@@ -24,6 +24,7 @@
 #include "mlir/IR/AttrTypeSubElements.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
 #include "mlir/IR/IRMapping.h"
 #include "llvm/ADT/TypeSwitch.h"
 
@@ -89,6 +90,14 @@ Attribute mappingAttrTo(Attribute attr) {
     return DenseIntOrFPElementsV1Attr::get(
         ctx, mappingTypeTo(tensorAttr.getType()), tensorAttr.getRawData());
   }
+  if (auto resourceAttr = llvm::dyn_cast<DenseResourceElementsAttr>(attr)) {
+    // the blob is referenced by its handle and written to the resource section
+    if (!resourceAttr.getRawHandle().getBlob())
+      return Attribute();
+    return DenseResourceElementsV1Attr::get(
+        ctx, mappingTypeTo(resourceAttr.getType()),
+        resourceAttr.getRawHandle());
+  }
   if (auto denseStringAttr = llvm::dyn_cast<DenseStringElementsAttr>(attr)) {
     llvm::SmallVector<llvm::StringRef> values =
         llvm::SmallVector<llvm::StringRef>(
@@ -185,6 +194,11 @@ Attribute mappingAttrFrom(Attribute attr) {
     return DenseIntOrFPElementsAttr::getFromRawBuffer(rankedTensorType,
                                                       tensorAttr.getData());
   }
+  if (auto resourceAttr = llvm::dyn_cast<DenseResourceElementsV1Attr>(attr)) {
+    return DenseResourceElementsAttr::get(
+        cast<ShapedType>(mappingTypeFrom(resourceAttr.getType())),
+        resourceAttr.getRawHandle());
+  }
   if (auto denseStringAttr = llvm::dyn_cast<DenseStringElementsV1Attr>(attr)) {
     return DenseStringElementsAttr::get(
         cast<ShapedType>(mappingTypeFrom(denseStringAttr.getType())),
@@ -72,7 +72,8 @@ enum class AttrKind : uint32_t {
   DenseStringElementsV1 = 9,
   DenseArrayV1 = 10,
   ArgTypeV1 = 11,
-  MemoryEffectV1 = 12
+  MemoryEffectV1 = 12,
+  DenseResourceElementsV1 = 13
 };
 
 const llvm::fltSemantics &getFloatSemantics(Type type) {
@@ -318,6 +319,14 @@ static LogicalResult write(DenseIntOrFPElementsV1Attr attr,
   return success();
 }
 
+static LogicalResult write(DenseResourceElementsV1Attr attr,
+                           DialectBytecodeWriter &writer) {
+  writer.writeVarInt(static_cast<uint32_t>(AttrKind::DenseResourceElementsV1));
+  writer.writeType(attr.getType());
+  writer.writeResourceHandle(attr.getRawHandle());
+  return success();
+}
+
 static LogicalResult write(DenseStringElementsV1Attr attr,
                            DialectBytecodeWriter &writer) {
   writer.writeVarInt(static_cast<uint32_t>(AttrKind::DenseStringElementsV1));
@@ -434,6 +443,19 @@ static Attribute readDenseIntOrFPElementsV1Attr(MLIRContext *ctx,
   return Attribute();
 }
 
+static Attribute
+readDenseResourceElementsV1Attr(MLIRContext *ctx,
+                                DialectBytecodeReader &reader) {
+  Type type;
+  if (failed(reader.readType(type)))
+    return Attribute();
+  FailureOr<DenseResourceElementsHandle> handle =
+      reader.readResourceHandle<DenseResourceElementsHandle>();
+  if (failed(handle))
+    return Attribute();
+  return DenseResourceElementsV1Attr::get(ctx, type, *handle);
+}
+
 static Attribute readDenseStringElementsV1Attr(MLIRContext *ctx,
                                                DialectBytecodeReader &reader) {
   Type type;
@@ -528,8 +550,9 @@ struct ByreDialectBytecodeInterface : public BytecodeDialectInterface {
     return TypeSwitch<Attribute, LogicalResult>(attr)
         .Case<IntegerV1Attr, FloatV1Attr, UnitV1Attr, ArrayV1Attr,
               DictionaryV1Attr, StringV1Attr, TypeV1Attr, SymbolRefV1Attr,
-              DenseIntOrFPElementsV1Attr, DenseStringElementsV1Attr,
-              DenseArrayV1Attr, ArgTypeV1Attr, MemoryEffectV1Attr>(
+              DenseIntOrFPElementsV1Attr, DenseResourceElementsV1Attr,
+              DenseStringElementsV1Attr, DenseArrayV1Attr, ArgTypeV1Attr,
+              MemoryEffectV1Attr>(
             [&](auto attr) { return write(attr, writer); })
         .Default([](Attribute) { return failure(); });
   }
@@ -558,6 +581,7 @@ struct ByreDialectBytecodeInterface : public BytecodeDialectInterface {
       Case(DenseArrayV1);
       Case(ArgTypeV1);
       Case(MemoryEffectV1);
+      Case(DenseResourceElementsV1);
 
 #undef Case
 
@@ -22,6 +22,7 @@
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/AttrTypeSubElements.h"
 #include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/DialectResourceBlobManager.h"
 #include "llvm/ADT/StringExtras.h"
@@ -42,7 +43,7 @@ uint32_t Version::getBytecodeVersion() const {
 
 ArrayRef<Version> Version::getSupportedVersions() {
   // all supported versions should be listed in increasing order
-  static SmallVector<Version> gVersions = {{1, 0, 0}};
+  static SmallVector<Version> gVersions = {{1, 0, 0}, {1, 1, 0}};
   return gVersions;
 }
 
@@ -143,7 +144,24 @@ mlir::byre::serialization::convertToVersion(Operation *topLevelOp,
     return topLevelOp->emitError()
            << "Version " << version.toString() << " was not supported";
 
-  // TODO: do upgrade or downgrade here
+  // TODO: do upgrade here
+
+  // resource blobs by reference are supported since 1.1.0, copy them into
+  // dense elements for earlier versions
+  if (version < Version(1, 1, 0)) {
+    AttrTypeReplacer replacer;
+    replacer.addReplacement(
+        [](DenseResourceElementsV1Attr attr) -> std::optional<Attribute> {
+          AsmResourceBlob *blob = attr.getRawHandle().getBlob();
+          if (!blob)
+            return std::nullopt;
+          return DenseIntOrFPElementsV1Attr::get(
+              attr.getContext(), attr.getType(), blob->getData());
+        });
+    replacer.recursivelyReplaceElementsIn(topLevelOp, /*replaceAttrs=*/true,
+                                          /*replaceLocs=*/false,
+                                          /*replaceTypes=*/false);
+  }
 
   return verifySerializableIRVersion(topLevelOp, version);
 }
@@ -0,0 +1,226 @@
+//===- AsyncCollectives.cpp -----------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/Byre/Transforms/AsyncCollectives.h"
+#include "byteir/Conversion/LcclToByre/LcclToByre.h"
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Dialect/MemRef/Utils/Ops.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "PassDetail.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace mlir::byre;
+
+namespace {
+
+constexpr StringRef kSynchronousAttrName = "synchronous";
+
+bool isCollective(Operation *op) {
+  auto computeOp = dyn_cast<ComputeOp>(op);
+  return computeOp && computeOp.getCallee().starts_with("nccl.");
+}
+
+bool isSynchronousCollective(Operation *op) {
+  auto computeOp = dyn_cast<ComputeOp>(op);
+  if (!isCollective(op) || computeOp.getCallee() == ByreWaitName)
+    return false;
+  auto synchronous = computeOp->getAttrOfType<BoolAttr>(kSynchronousAttrName);
+  return !synchronous || synchronous.getValue();
+}
+
+// Memrefs read and written by an op
+struct MemoryAccesses {
+  SmallVector<Value> reads;
+  SmallVector<Value> writes;
+};
+
+// Collect memrefs accessed by `op` into `accesses`, return false if the
+// effects of `op` are unknown
+bool collectMemoryAccesses(Operation *op, MemoryAccesses &accesses) {
+  if (isMemoryEffectFree(op))
+    return true;
+
+  auto iface = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!iface)
+    return false;
+
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  iface.getEffects(effects);
+  for (auto &effect : effects) {
+    if (isa<MemoryEffects::Allocate>(effect.getEffect()))
+      continue;
+    Value value = effect.getValue();
+    if (!value)
+      return false;
+    if (isa<MemoryEffects::Read>(effect.getEffect()))
+      accesses.reads.push_back(value);
+    else
+      accesses.writes.push_back(value);
+  }
+  return true;
+}
+
+// Distinct allocs and arguments of entry functions never overlap before
+// memory planning. Anything else conservatively may alias.
+bool mayAlias(Value lhs, Value rhs) {
+  Value lhsRoot = getRootBuffer(lhs);
+  Value rhsRoot = getRootBuffer(rhs);
+  if (lhsRoot == rhsRoot)
+    return true;
+  auto isDistinctBuffer = [](Value root) {
+    return isa<BlockArgument>(root) || root.getDefiningOp<memref::AllocOp>();
+  };
+  return !isDistinctBuffer(lhsRoot) || !isDistinctBuffer(rhsRoot);
+}
+
+bool mayAliasAny(ArrayRef<Value> lhs, ArrayRef<Value> rhs) {
+  return llvm::any_of(lhs, [&](Value l) {
+    return llvm::any_of(rhs, [&](Value r) { return mayAlias(l, r); });
+  });
+}
+
+// Return true if `op` can't be reordered with the collective accessing
+// `accesses`
+bool hasConflict(Operation *op, const MemoryAccesses &accesses) {
+  MemoryAccesses opAccesses;
+  if (!collectMemoryAccesses(op, opAccesses))
+    return true;
+  return mayAliasAny(accesses.writes, opAccesses.reads) ||
+         mayAliasAny(accesses.writes, opAccesses.writes) ||
+         mayAliasAny(accesses.reads, opAccesses.writes);
+}
+
+// Return the earliest op the collective `start` could be moved before. Static
+// allocs of its operands in between are collected into `allocs` and moved
+// along with it.
+Operation *getHoistPoint(ComputeOp start, const MemoryAccesses &accesses,
+                         SmallVectorImpl<Operation *> &allocs) {
+  Operation *point = start;
+  for (Operation *op = start->getPrevNode(); op; op = op->getPrevNode()) {
+    bool definesOperand = llvm::any_of(start->getOperands(), [&](Value v) {
+      return v.getDefiningOp() == op;
+    });
+    if (definesOperand) {
+      if (!isa<memref::AllocOp>(op) || op->getNumOperands() != 0)
+        break;
+      allocs.push_back(op);
+      continue;
+    }
+    if (isCollective(op) || hasConflict(op, accesses))
+      break;
+    point = op;
+  }
+  return point;
+}
+
+// Return the op the wait of the collective `start` should be placed before.
+// A synchronous collective runs on the compute stream, which isn't ordered
+// after `start` on the communication stream, so the wait never sinks past it.
+Operation *getSinkPoint(ComputeOp start, const MemoryAccesses &accesses) {
+  Operation *op = start->getNextNode();
+  while (!op->hasTrait<OpTrait::IsTerminator>() &&
+         !isSynchronousCollective(op) && !hasConflict(op, accesses))
+    op = op->getNextNode();
+  return op;
+}
+
+struct AsyncCollectivesPass
+    : public AsyncCollectivesBase<AsyncCollectivesPass> {
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    if (!funcOp->hasAttr(ByreDialect::getEntryPointFunctionAttrName()))
+      return;
+
+    SmallVector<ComputeOp> collectives;
+    funcOp.walk([&](ComputeOp computeOp) {
+      if (isSynchronousCollective(computeOp))
+        collectives.push_back(computeOp);
+    });
+
+    // later collectives are made async first, so the wait of an earlier one
+    // knows which collectives after it stay synchronous
+    OpBuilder builder(funcOp.getContext());
+    DenseMap<Operation *, ComputeOp> waits;
+    for (ComputeOp start : llvm::reverse(collectives)) {
+      // the wait keeps the memrefs of the start with the same effects, which
+      // orders both against other ops and extends their liveness
+      SmallVector<Value> buffers;
+      SmallVector<Attribute> effects;
+      MemoryAccesses accesses;
+      auto memoryEffects = start.getMemoryEffects();
+      for (OpOperand &operand : start->getOpOperands()) {
+        if (!isa<MemRefType>(operand.get().getType()))
+          continue;
+        MemoryEffect effect = MemoryEffect::Read | MemoryEffect::Write;
+        if (memoryEffects)
+          effect = cast<MemoryEffectAttr>(
+                       (*memoryEffects)[operand.getOperandNumber()])
+                       .getValue();
+        if (bitEnumContainsAll(effect, MemoryEffect::Read))
+          accesses.reads.push_back(operand.get());
+        if (bitEnumContainsAll(effect, MemoryEffect::Write))
+          accesses.writes.push_back(operand.get());
+        buffers.push_back(operand.get());
+        effects.push_back(builder.getAttr<MemoryEffectAttr>(effect));
+      }
+
+      SmallVector<Operation *> allocs;
+      Operation *hoistPoint = getHoistPoint(start, accesses, allocs);
+      Operation *sinkPoint = getSinkPoint(start, accesses);
+      // nothing to overlap with
+      if (hoistPoint == start.getOperation() &&
+          sinkPoint == start->getNextNode())
+        continue;
+
+      builder.setInsertionPoint(sinkPoint);
+      auto wait = builder.create<ComputeOp>(start.getLoc(), TypeRange(),
+                                            ByreWaitName, buffers,
+                                            builder.getArrayAttr(effects));
+      waits[start] = wait;
+      start->setAttr(kSynchronousAttrName, builder.getBoolAttr(false));
+      if (hoistPoint != start.getOperation()) {
+        // allocs are collected bottom-up
+        for (Operation *alloc : llvm::reverse(allocs))
+          alloc->moveBefore(hoistPoint);
+        start->moveBefore(hoistPoint);
+      }
+    }
+
+    // number async collectives in program order
+    int64_t asyncId = 0;
+    funcOp.walk([&](ComputeOp start) {
+      auto it = waits.find(start);
+      if (it == waits.end())
+        return;
+      auto asyncIdAttr = builder.getI64IntegerAttr(asyncId++);
+      start->setAttr(ByreAsyncIdStr, asyncIdAttr);
+      it->second->setAttr(ByreAsyncIdStr, asyncIdAttr);
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::createAsyncCollectivesPass() {
+  return std::make_unique<AsyncCollectivesPass>();
+}
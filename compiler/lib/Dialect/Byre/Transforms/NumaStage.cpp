@@ -0,0 +1,119 @@
+//===- NumaStage.cpp ------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/Byre/Transforms/NumaStage.h"
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Utils/TypeUtils.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+
+#include "PassDetail.h"
+
+#include <algorithm>
+
+using namespace llvm;
+using namespace mlir;
+using namespace mlir::byre;
+
+namespace {
+
+// flops worth a byte of memory traffic, roughly the machine balance of
+// server cpus
+constexpr int64_t kFlopsPerByte = 8;
+
+int64_t getStaticByteSize(Type type) {
+  auto memrefType = dyn_cast<MemRefType>(type);
+  if (!memrefType || !memrefType.hasStaticShape() ||
+      !memrefType.getElementType().isIntOrFloat())
+    return 0;
+  int64_t elementBytes =
+      canonicalizeTypeBitWidth(memrefType.getElementType()) >> 3;
+  return memrefType.getNumElements() * elementBytes;
+}
+
+// Return flops of matmuls, whose output is the last operand, and 0 for other
+// ops
+int64_t getFlops(Operation *op) {
+  auto lhsContractingDim =
+      op->getAttrOfType<IntegerAttr>("lhs_contracting_dimension");
+  if (!lhsContractingDim || op->getNumOperands() < 3)
+    return 0;
+  auto lhsType = dyn_cast<MemRefType>(op->getOperand(0).getType());
+  auto outType = dyn_cast<MemRefType>(op->getOperands().back().getType());
+  if (!lhsType || !outType || !lhsType.hasStaticShape() ||
+      !outType.hasStaticShape() ||
+      lhsContractingDim.getInt() >= lhsType.getRank())
+    return 0;
+  return 2 * outType.getNumElements() *
+         lhsType.getDimSize(lhsContractingDim.getInt());
+}
+
+int64_t estimateCost(Operation *op) {
+  int64_t bytes = 0;
+  for (Value operand : op->getOperands())
+    bytes += getStaticByteSize(operand.getType());
+  return std::max({getFlops(op) / kFlopsPerByte, bytes, int64_t(1)});
+}
+
+struct NumaStagePass : public NumaStageBase<NumaStagePass> {
+  NumaStagePass(int64_t numStages) : NumaStageBase() {
+    this->numStages = numStages;
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    if (!funcOp->hasAttr(ByreDialect::getEntryPointFunctionAttrName()) ||
+        funcOp.isExternal())
+      return;
+    if (numStages < 1) {
+      funcOp.emitError() << "num-stages must be positive";
+      return signalPassFailure();
+    }
+
+    SmallVector<Operation *> ops;
+    SmallVector<int64_t> costs;
+    int64_t totalCost = 0;
+    for (Operation &op : funcOp.getBody().front()) {
+      if (!isa<ByreOp>(op) || isa<AliasOp>(op))
+        continue;
+      ops.push_back(&op);
+      costs.push_back(estimateCost(&op));
+      totalCost += costs.back();
+    }
+
+    // an op belongs to the stage containing the midpoint of its cost, which
+    // keeps stages contiguous and balanced within the cost of one op
+    OpBuilder builder(funcOp.getContext());
+    int64_t prefixCost = 0;
+    for (auto [op, cost] : llvm::zip(ops, costs)) {
+      double midpoint = prefixCost + cost / 2.0;
+      int64_t stage = std::min<int64_t>(
+          numStages - 1, static_cast<int64_t>(midpoint * numStages /
+                                              static_cast<double>(totalCost)));
+      op->setAttr(ByreDialect::getNumaNodeAttrName(),
+                  builder.getI64IntegerAttr(stage));
+      prefixCost += cost;
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::createNumaStagePass(int64_t numStages) {
+  return std::make_unique<NumaStagePass>(numStages);
+}
@@ -0,0 +1,211 @@
+//===- OpDependency.cpp ---------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/Byre/Transforms/OpDependency.h"
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Utils/TypeUtils.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/ADT/BitVector.h"
+
+#include "PassDetail.h"
+
+#include <limits>
+
+using namespace llvm;
+using namespace mlir;
+using namespace mlir::byre;
+
+namespace {
+
+constexpr int64_t kWholeBuffer = std::numeric_limits<int64_t>::max();
+
+// A byte range [begin, end) of a root buffer accessed by an op. A null root
+// is an unknown buffer, which may alias anything.
+struct Access {
+  Value root;
+  int64_t begin = 0;
+  int64_t end = kWholeBuffer;
+  bool write = true;
+};
+
+bool isCollective(Operation *op) {
+  auto computeOp = dyn_cast<ComputeOp>(op);
+  return computeOp && computeOp.getCallee().starts_with("nccl.");
+}
+
+std::optional<int64_t> getStaticByteSize(Type type) {
+  auto memrefType = dyn_cast<MemRefType>(type);
+  if (!memrefType || !memrefType.hasStaticShape() ||
+      !memrefType.getLayout().isIdentity() ||
+      !memrefType.getElementType().isIntOrFloat())
+    return std::nullopt;
+  int64_t elementBytes =
+      canonicalizeTypeBitWidth(memrefType.getElementType()) >> 3;
+  return memrefType.getNumElements() * elementBytes;
+}
+
+// Resolve `value` through byre.alias to a byte range of its root buffer.
+// Entry function arguments aliased by byre.arg_alias_index share the root of
+// the argument they alias.
+Access resolveAccess(func::FuncOp funcOp, Value value, bool write) {
+  Access access;
+  access.write = write;
+  std::optional<int64_t> size = getStaticByteSize(value.getType());
+  bool exact = size.has_value();
+  int64_t offset = 0;
+  while (true) {
+    if (auto aliasOp = value.getDefiningOp<AliasOp>()) {
+      auto elementType =
+          cast<MemRefType>(aliasOp.getSource().getType()).getElementType();
+      if (elementType.isIntOrFloat()) {
+        int64_t elementBytes = canonicalizeTypeBitWidth(elementType) >> 3;
+        offset += aliasOp.getOffset() * elementBytes;
+      } else {
+        exact = false;
+      }
+      value = aliasOp.getSource();
+    } else if (auto viewOp = value.getDefiningOp<ViewLikeOpInterface>()) {
+      exact = false;
+      value = viewOp.getViewSource();
+    } else {
+      break;
+    }
+  }
+
+  if (auto arg = dyn_cast<BlockArgument>(value)) {
+    for (unsigned i = 0; i < funcOp.getNumArguments(); ++i) {
+      auto aliasIndex = funcOp.getArgAttrOfType<IntegerAttr>(
+          arg.getArgNumber(),
+          ByreDialect::getEntryPointFuncArgAliasIndexAttrName());
+      if (!aliasIndex)
+        break;
+      arg = funcOp.getArgument(aliasIndex.getInt());
+    }
+    access.root = arg;
+  } else if (value.getDefiningOp<memref::AllocOp>() ||
+             value.getDefiningOp<memref::AllocaOp>()) {
+    access.root = value;
+  } else {
+    return access;
+  }
+
+  if (exact) {
+    access.begin = offset;
+    access.end = offset + *size;
+  }
+  return access;
+}
+
+// Collect byte ranges accessed by `op`. An op of unknown effects gets a
+// single write to an unknown buffer, which conflicts with any op.
+SmallVector<Access> collectAccesses(func::FuncOp funcOp, Operation *op) {
+  SmallVector<Access> accesses;
+  if (isMemoryEffectFree(op))
+    return accesses;
+
+  auto iface = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!iface)
+    return {Access()};
+
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  iface.getEffects(effects);
+  for (auto &effect : effects) {
+    if (isa<MemoryEffects::Allocate>(effect.getEffect()))
+      continue;
+    Value value = effect.getValue();
+    if (!value)
+      return {Access()};
+    accesses.push_back(resolveAccess(
+        funcOp, value, !isa<MemoryEffects::Read>(effect.getEffect())));
+  }
+  return accesses;
+}
+
+bool mayConflict(const Access &lhs, const Access &rhs) {
+  if (!lhs.write && !rhs.write)
+    return false;
+  if (!lhs.root || !rhs.root)
+    return true;
+  return lhs.root == rhs.root && lhs.begin < rhs.end && rhs.begin < lhs.end;
+}
+
+bool mayConflict(ArrayRef<Access> lhs, ArrayRef<Access> rhs) {
+  return llvm::any_of(lhs, [&](const Access &l) {
+    return llvm::any_of(rhs,
+                        [&](const Access &r) { return mayConflict(l, r); });
+  });
+}
+
+struct OpDependencyPass : public OpDependencyBase<OpDependencyPass> {
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    if (!funcOp->hasAttr(ByreDialect::getEntryPointFunctionAttrName()) ||
+        funcOp.isExternal())
+      return;
+
+    // the same ops the runtime creates op kernels for, in the same order
+    SmallVector<Operation *> ops;
+    SmallVector<SmallVector<Access>> accesses;
+    for (Operation &op : funcOp.getBody().front()) {
+      if (!isa<ByreOp>(op) || isa<AliasOp>(op))
+        continue;
+      ops.push_back(&op);
+      accesses.push_back(collectAccesses(funcOp, &op));
+    }
+
+    OpBuilder builder(funcOp.getContext());
+    // transitive dependencies of each op
+    SmallVector<BitVector> ancestors;
+    ancestors.reserve(ops.size());
+    int64_t lastCollective = -1;
+    for (int64_t i = 0, e = ops.size(); i < e; ++i) {
+      BitVector covered(i);
+      SmallVector<int64_t> dependencies;
+      // visit later ops first, so ops implied by a dependency are already
+      // covered when reached
+      for (int64_t j = i - 1; j >= 0; --j) {
+        if (covered.test(j))
+          continue;
+        bool isOrdered = j == lastCollective && isCollective(ops[i]);
+        if (!isOrdered && !mayConflict(accesses[i], accesses[j]))
+          continue;
+        dependencies.push_back(j);
+        covered |= ancestors[j];
+        covered.set(j);
+      }
+      ancestors.push_back(std::move(covered));
+      if (isCollective(ops[i]))
+        lastCollective = i;
+
+      SmallVector<Attribute> attrs;
+      for (int64_t j : llvm::reverse(dependencies))
+        attrs.push_back(builder.getI64IntegerAttr(j));
+      ops[i]->setAttr(ByreDialect::getOpDependencyAttrName(),
+                      builder.getArrayAttr(attrs));
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> mlir::createOpDependencyPass() {
+  return std::make_unique<OpDependencyPass>();
+}
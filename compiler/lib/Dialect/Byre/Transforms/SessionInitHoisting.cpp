@@ -0,0 +1,168 @@
+//===- SessionInitHoisting.cpp --------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/Byre/Transforms/SessionInitHoisting.h"
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Dialect/Byre/Common.h"
+#include "byteir/Dialect/Byre/Passes.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SetVector.h"
+
+#include "PassDetail.h"
+
+using namespace llvm;
+using namespace mlir;
+using namespace mlir::byre;
+
+namespace {
+
+bool isWeightArg(func::FuncOp funcOp, unsigned idx) {
+  auto argTypeAttr = funcOp.getArgAttrOfType<EntryFuncArgTypeAttr>(
+      idx, ByreDialect::getEntryPointFuncArgTypeAttrName());
+  return argTypeAttr &&
+         bitEnumContainsAll(argTypeAttr.getValue(), EntryFuncArgType::Weight);
+}
+
+// Return true if all uses of `value` except those of `writer` only read it
+bool isOnlyReadByOthers(Value value, Operation *writer) {
+  for (OpOperand &use : value.getUses()) {
+    Operation *user = use.getOwner();
+    if (user == writer)
+      continue;
+
+    auto computeOp = dyn_cast<ComputeOp>(user);
+    if (!computeOp || !computeOp.getMemoryEffects())
+      return false;
+
+    auto effect = cast<MemoryEffectAttr>(
+                      (*computeOp.getMemoryEffects())[use.getOperandNumber()])
+                      .getValue();
+    if (effect != MemoryEffect::Read)
+      return false;
+  }
+  return true;
+}
+
+// Return allocs written by `computeOp` if it only reads values in `constants`
+// and only writes static allocs which are read-only for the rest of the
+// function. Otherwise return failure.
+FailureOr<SmallVector<memref::AllocOp>>
+getHoistableOutputs(ComputeOp computeOp, const DenseSet<Value> &constants) {
+  if (computeOp->hasAttr(getByreDynamicLaunchConfigAttrName()))
+    return failure();
+
+  auto memoryEffects = computeOp.getMemoryEffects();
+  if (!memoryEffects)
+    return failure();
+
+  bool hasInput = false;
+  llvm::SetVector<Operation *> outputs;
+  for (auto it : llvm::zip(computeOp->getOpOperands(),
+                           memoryEffects->getAsValueRange<MemoryEffectAttr>())) {
+    Value value = std::get<0>(it).get();
+    MemoryEffect effect = std::get<1>(it);
+    if (effect == MemoryEffect::Read) {
+      if (!constants.contains(value))
+        return failure();
+      hasInput = true;
+    } else if (effect == MemoryEffect::Write) {
+      auto allocOp = value.getDefiningOp<memref::AllocOp>();
+      if (!allocOp || !allocOp.getType().hasStaticShape() ||
+          allocOp->getBlock() != computeOp->getBlock() ||
+          !isOnlyReadByOthers(value, computeOp))
+        return failure();
+      outputs.insert(allocOp);
+    } else {
+      // ReadWrite operand
+      return failure();
+    }
+  }
+
+  // ops without any input, like rng, must be evaluated per request
+  if (!hasInput || outputs.empty())
+    return failure();
+
+  return llvm::to_vector(llvm::map_range(outputs, [](Operation *op) {
+    return cast<memref::AllocOp>(op);
+  }));
+}
+
+void hoistSessionInit(func::FuncOp funcOp) {
+  MLIRContext *ctx = funcOp.getContext();
+  Block &entryBlock = funcOp.getBody().front();
+
+  // weights are always the leading arguments of an entry function
+  DenseSet<Value> constants;
+  unsigned numWeights = 0;
+  while (numWeights < funcOp.getNumArguments() &&
+         isWeightArg(funcOp, numWeights)) {
+    constants.insert(funcOp.getArgument(numWeights++));
+  }
+  if (numWeights == 0)
+    return;
+
+  for (Operation &op : entryBlock.without_terminator()) {
+    if (isa<ViewLikeOpInterface>(op) && op.getNumResults() == 1) {
+      if (llvm::all_of(op.getOperands(), [&](Value v) {
+            return constants.contains(v) || matchPattern(v, m_Constant());
+          })) {
+        constants.insert(op.getResult(0));
+      }
+    } else if (auto computeOp = dyn_cast<ComputeOp>(op)) {
+      auto maybeOutputs = getHoistableOutputs(computeOp, constants);
+      if (failed(maybeOutputs))
+        continue;
+
+      // outputs stay session-internal buffers, which are allocated once per
+      // session by the runtime, so the signature of the entry function is
+      // unchanged
+      computeOp->setAttr(ByreDialect::getSessionInitAttrName(),
+                         UnitAttr::get(ctx));
+      for (auto allocOp : *maybeOutputs) {
+        allocOp->setAttr(ByreDialect::getSessionInitAttrName(),
+                         UnitAttr::get(ctx));
+        constants.insert(allocOp.getResult());
+      }
+    }
+  }
+}
+
+struct SessionInitHoistingPass
+    : public SessionInitHoistingBase<SessionInitHoistingPass> {
+  SessionInitHoistingPass() : SessionInitHoistingBase() {}
+
+  void runOnOperation() override {
+    ModuleOp m = getOperation();
+    for (auto funcOp : m.getOps<func::FuncOp>()) {
+      if (!funcOp->hasAttr(ByreDialect::getEntryPointFunctionAttrName()) ||
+          !funcOp.getBody().hasOneBlock()) {
+        continue;
+      }
+      hoistSessionInit(funcOp);
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> mlir::createSessionInitHoistingPass() {
+  return std::make_unique<SessionInitHoistingPass>();
+}
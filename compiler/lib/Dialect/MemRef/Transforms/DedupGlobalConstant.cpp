@@ -0,0 +1,173 @@
+//===- DedupGlobalConstant.cpp --------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/MemRef/Transforms/DedupGlobalConstant.h"
+#include "byteir/Utils/HashUtils.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/SymbolTable.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/Debug.h"
+
+#include "PassDetail.h"
+
+#define DEBUG_TYPE "dedup-global-constant"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+// return the payload of a global which could be merged, or null otherwise
+DenseElementsAttr getMergeablePayload(memref::GlobalOp globalOp,
+                                      int64_t minBytes) {
+  if (!globalOp.getConstant() || globalOp.isExternal())
+    return nullptr;
+
+  // splat constants are cheap and would be lowered to fills later
+  auto value =
+      dyn_cast_or_null<DenseElementsAttr>(globalOp.getInitialValueAttr());
+  if (!value || value.isSplat())
+    return nullptr;
+
+  MemRefType type = globalOp.getType();
+  if (!type.hasStaticShape() || !type.getLayout().isIdentity() ||
+      type.getRank() == 0)
+    return nullptr;
+
+  if (static_cast<int64_t>(value.getRawData().size()) < minBytes)
+    return nullptr;
+
+  return value;
+}
+
+bool isSamePayload(DenseElementsAttr lhs, DenseElementsAttr rhs) {
+  return lhs.getElementType() == rhs.getElementType() &&
+         lhs.getNumElements() == rhs.getNumElements() &&
+         lhs.getRawData() == rhs.getRawData();
+}
+
+// reshape `value` of kept global to `type` through a rank-1 memref
+Value reshapeTo(OpBuilder &builder, Location loc, Value value,
+                MemRefType type) {
+  auto srcType = cast<MemRefType>(value.getType());
+  if (srcType == type)
+    return value;
+
+  if (srcType.getRank() != 1) {
+    ReassociationIndices allDims =
+        llvm::to_vector(llvm::seq<int64_t>(0, srcType.getRank()));
+    auto flatType = MemRefType::get({srcType.getNumElements()},
+                                    srcType.getElementType(), AffineMap(),
+                                    srcType.getMemorySpace());
+    value = builder.create<memref::CollapseShapeOp>(
+        loc, flatType, value, SmallVector<ReassociationIndices>{allDims});
+  }
+
+  if (type.getRank() != 1) {
+    ReassociationIndices allDims =
+        llvm::to_vector(llvm::seq<int64_t>(0, type.getRank()));
+    value = builder.create<memref::ExpandShapeOp>(
+        loc, type, value, SmallVector<ReassociationIndices>{allDims});
+  }
+  return value;
+}
+
+struct DedupGlobalConstantPass
+    : public DedupGlobalConstantBase<DedupGlobalConstantPass> {
+  DedupGlobalConstantPass(int64_t minBytes) : DedupGlobalConstantBase() {
+    this->minBytes = minBytes;
+  }
+
+  void runOnOperation() override {
+    ModuleOp m = getOperation();
+    SymbolTable symbolTable(m);
+
+    // bucket globals by content hash, the first global of each payload is kept
+    llvm::DenseMap<llvm::hash_code, SmallVector<memref::GlobalOp>> buckets;
+    llvm::MapVector<memref::GlobalOp, memref::GlobalOp> replacements;
+    for (auto globalOp : m.getOps<memref::GlobalOp>()) {
+      auto payload = getMergeablePayload(globalOp, minBytes);
+      if (!payload)
+        continue;
+
+      auto &candidates = buckets[byteir::hashDenseElementsContent(payload)];
+      auto it = llvm::find_if(candidates, [&](memref::GlobalOp kept) {
+        return kept.getType().getMemorySpace() ==
+                   globalOp.getType().getMemorySpace() &&
+               isSamePayload(
+                   cast<DenseElementsAttr>(kept.getInitialValueAttr()),
+                   payload);
+      });
+      if (it == candidates.end()) {
+        candidates.push_back(globalOp);
+        continue;
+      }
+      replacements[globalOp] = *it;
+    }
+
+    if (replacements.empty())
+      return;
+
+    // retarget all get_global ops to the kept globals
+    m.walk([&](memref::GetGlobalOp getGlobalOp) {
+      auto globalOp =
+          symbolTable.lookup<memref::GlobalOp>(getGlobalOp.getName());
+      auto found = replacements.find(globalOp);
+      if (found == replacements.end())
+        return;
+
+      memref::GlobalOp kept = found->second;
+      OpBuilder builder(getGlobalOp);
+      auto newGetGlobalOp = builder.create<memref::GetGlobalOp>(
+          getGlobalOp.getLoc(), kept.getType(), kept.getSymName());
+      Value newValue = reshapeTo(builder, getGlobalOp.getLoc(),
+                                 newGetGlobalOp.getResult(),
+                                 getGlobalOp.getType());
+      getGlobalOp.getResult().replaceAllUsesWith(newValue);
+      getGlobalOp->erase();
+    });
+
+    for (auto [globalOp, kept] : replacements) {
+      // keep the strictest alignment among merged globals
+      if (auto alignment = globalOp.getAlignment()) {
+        if (!kept.getAlignment() || *kept.getAlignment() < *alignment)
+          kept.setAlignment(*alignment);
+      }
+
+      int64_t bytes = static_cast<int64_t>(
+          cast<DenseElementsAttr>(globalOp.getInitialValueAttr())
+              .getRawData()
+              .size());
+      LLVM_DEBUG(llvm::dbgs() << "merge " << globalOp.getSymName() << " into "
+                              << kept.getSymName() << ", saving " << bytes
+                              << " bytes\n");
+      numMergedGlobals++;
+      numBytesSaved += bytes;
+      symbolTable.erase(globalOp);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+mlir::createDedupGlobalConstantPass(int64_t minBytes) {
+  return std::make_unique<DedupGlobalConstantPass>(minBytes);
+}
@@ -0,0 +1,278 @@
+//===- InPlaceConcatSlice.cpp ---------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/MemRef/Transforms/InPlaceConcatSlice.h"
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Dialect/MemRef/Utils/MemEffect.h"
+#include "byteir/Dialect/MemRef/Utils/Ops.h"
+#include "byteir/Utils/Hoist.h"
+#include "byteir/Utils/MemUtils.h"
+#include "byteir/Utils/Utils.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/Support/Debug.h"
+
+#include <optional>
+
+#include "PassDetail.h"
+
+#define DEBUG_TYPE "inplace-concat-slice"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+// Return true if any op strictly between `begin` and `end` may access the
+// region of `base` covered by `view`. All views of the root buffer of `base`
+// are visited, accesses through subviews of `base` which don't overlap with
+// `view` are ignored, so are reads when `writesOnly` is set.
+bool mayAccessBetween(Value base, memref::SubViewOp view, Operation *begin,
+                      Operation *end, bool writesOnly) {
+  Block *block = end->getBlock();
+  for (Value alias : getAllViews(getRootBuffer(base))) {
+    auto aliasView = alias.getDefiningOp<memref::SubViewOp>();
+    if (aliasView == view)
+      continue;
+    if (aliasView && doSubViewsConservativelyNotOverlap(aliasView, view))
+      continue;
+    for (OpOperand &use : alias.getUses()) {
+      Operation *user = block->findAncestorOpInBlock(*use.getOwner());
+      if (!user || isa<ViewLikeOpInterface>(use.getOwner()))
+        continue;
+      if (!begin->isBeforeInBlock(user) || !user->isBeforeInBlock(end))
+        continue;
+      if (writesOnly && !maybeOpOperandWrite(use))
+        continue;
+      LLVM_DEBUG(llvm::dbgs() << "conflicting access " << *use.getOwner()
+                              << "\n");
+      return true;
+    }
+  }
+  return false;
+}
+
+// whether all uses of `value` could take a strided memref in place of it,
+// byre ops and calls require identity layout
+bool allUsesAcceptStrided(Value value) {
+  return llvm::all_of(value.getUses(), [](OpOperand &use) {
+    Operation *op = use.getOwner();
+    Dialect *dialect = op->getDialect();
+    return !isa<ViewLikeOpInterface, func::CallOp, func::ReturnOp>(op) &&
+           !(dialect && dialect->getNamespace() == "byre");
+  });
+}
+
+// Return the offset of a byre.alias which could replace `oldValue` by the
+// region of `view`, or std::nullopt if it is not supported. byre.alias
+// decouples the offset from the memref type, which only works for a
+// contiguous region of an identity buffer
+std::optional<int64_t> getInPlaceAliasOffset(memref::SubViewOp view,
+                                             bool enableByreAlias) {
+  auto sourceType = cast<MemRefType>(view.getSource().getType());
+  if (!enableByreAlias || !sourceType.getLayout().isIdentity() ||
+      !isStaticShapeAndContiguousRowMajorEx(view.getType()))
+    return std::nullopt;
+  int64_t offset;
+  SmallVector<int64_t> strides;
+  if (failed(getStridesAndOffset(view.getType(), strides, offset)) ||
+      ShapedType::isDynamic(offset))
+    return std::nullopt;
+  return offset;
+}
+
+// whether a view of the source of `view` could replace `oldValue`
+bool canCreateInPlaceView(memref::SubViewOp view, Value oldValue,
+                          bool enableByreAlias) {
+  return allUsesAcceptStrided(oldValue) ||
+         getInPlaceAliasOffset(view, enableByreAlias).has_value();
+}
+
+// Create a view of the source of `view` covering the same region to replace
+// `oldValue`, which is a strided subview if all uses of `oldValue` accept it,
+// or a byre.alias of the same identity type otherwise. Must be guarded by
+// canCreateInPlaceView
+Value createInPlaceView(OpBuilder &b, memref::SubViewOp view, Value oldValue,
+                        bool enableByreAlias) {
+  Location loc = view.getLoc();
+  if (allUsesAcceptStrided(oldValue)) {
+    return b.create<memref::SubViewOp>(
+        loc, view.getType(), view.getSource(), view.getMixedOffsets(),
+        view.getMixedSizes(), view.getMixedStrides());
+  }
+  return b.create<byre::AliasOp>(loc, oldValue.getType(), view.getSource(),
+                                 *getInPlaceAliasOffset(view, enableByreAlias));
+}
+
+bool isCandidateView(memref::SubViewOp view, Type elementType) {
+  return view && view.getType().hasStaticShape() &&
+         llvm::none_of(view.getStaticOffsets(), ShapedType::isDynamic) &&
+         llvm::none_of(view.getStaticStrides(), ShapedType::isDynamic) &&
+         view.getType().getElementType() == elementType &&
+         view.getSourceType().getRank() == view.getType().getRank();
+}
+
+bool isCandidateAlloc(memref::AllocOp alloc) {
+  return alloc && alloc.getType().hasStaticShape() &&
+         alloc.getType().getLayout().isIdentity() &&
+         llvm::none_of(alloc->getUsers(), [](Operation *user) {
+           return isa<memref::DeallocOp>(user);
+         });
+}
+
+// copy(%src, subview(%base)), where %src is an alloc whose producers could
+// write into the subview of %base directly, e.g. operands of a concatenate
+LogicalResult inPlaceConcatOperand(memref::CopyOp copyOp,
+                                   DominanceInfo &domInfo,
+                                   bool enableByreAlias) {
+  auto srcAlloc = copyOp.getSource().getDefiningOp<memref::AllocOp>();
+  auto view = copyOp.getTarget().getDefiningOp<memref::SubViewOp>();
+  if (!isCandidateAlloc(srcAlloc) ||
+      srcAlloc->getBlock() != copyOp->getBlock() ||
+      !isCandidateView(view, srcAlloc.getType().getElementType()))
+    return failure();
+  if (srcAlloc.getType().getMemorySpace() != view.getType().getMemorySpace())
+    return failure();
+
+  // the buffer is dead after the copy
+  Value src = srcAlloc.getResult();
+  Block *block = copyOp->getBlock();
+  for (Operation *user : src.getUsers()) {
+    Operation *ancestor = block->findAncestorOpInBlock(*user);
+    if (!ancestor || (user != copyOp && copyOp->isBeforeInBlock(ancestor)))
+      return failure();
+  }
+
+  // %base must dominate %src, possibly after hoisting up its alloc, which is
+  // only done once all checks passed
+  Value base = view.getSource();
+  memref::AllocOp baseAllocToHoist;
+  if (!domInfo.properlyDominates(base, srcAlloc)) {
+    auto baseAlloc = base.getDefiningOp<memref::AllocOp>();
+    if (!baseAlloc || baseAlloc->getBlock() != block ||
+        !findHoistUpInBlock(baseAlloc, domInfo)->isBeforeInBlock(srcAlloc))
+      return failure();
+    baseAllocToHoist = baseAlloc;
+  }
+
+  // no one else may touch the region before the copy would have written it
+  if (mayAccessBetween(base, view, srcAlloc, copyOp, /*writesOnly=*/false))
+    return failure();
+
+  if (!canCreateInPlaceView(view, src, enableByreAlias))
+    return failure();
+
+  if (baseAllocToHoist)
+    hoistUpOpInBlock(baseAllocToHoist, domInfo);
+  OpBuilder b(srcAlloc);
+  Value newView = createInPlaceView(b, view, src, enableByreAlias);
+
+  LLVM_DEBUG(llvm::dbgs() << "inplace concat operand " << copyOp << "\n");
+  copyOp->erase();
+  src.replaceAllUsesWith(newView);
+  srcAlloc->erase();
+  return success();
+}
+
+// copy(subview(%base), %dst), where %dst is an alloc only read after the copy,
+// so that its readers could read through the subview of %base directly, e.g.
+// results of a static slice
+LogicalResult inPlaceSlice(memref::CopyOp copyOp, bool enableByreAlias) {
+  auto view = copyOp.getSource().getDefiningOp<memref::SubViewOp>();
+  auto dstAlloc = copyOp.getTarget().getDefiningOp<memref::AllocOp>();
+  if (!isCandidateAlloc(dstAlloc) ||
+      dstAlloc->getBlock() != copyOp->getBlock() ||
+      !isCandidateView(view, dstAlloc.getType().getElementType()))
+    return failure();
+  if (dstAlloc.getType().getMemorySpace() != view.getType().getMemorySpace())
+    return failure();
+
+  // the buffer is read-only after the copy
+  Value dst = dstAlloc.getResult();
+  Block *block = copyOp->getBlock();
+  Operation *lastUse = copyOp;
+  for (Value alias : getAllViews(dst)) {
+    for (OpOperand &use : alias.getUses()) {
+      Operation *user = block->findAncestorOpInBlock(*use.getOwner());
+      if (!user || use.getOwner() == copyOp)
+        continue;
+      if (isa<ViewLikeOpInterface>(use.getOwner()))
+        continue;
+      if (!copyOp->isBeforeInBlock(user) || maybeOpOperandWrite(use) ||
+          isa<func::ReturnOp>(user))
+        return failure();
+      if (lastUse->isBeforeInBlock(user))
+        lastUse = user;
+    }
+  }
+
+  // the region must stay unchanged while it is read through the view,
+  // including by the last reader itself
+  Operation *end = lastUse->getNextNode();
+  if (!end || mayAccessBetween(view.getSource(), view, copyOp, end,
+                               /*writesOnly=*/true))
+    return failure();
+
+  if (!canCreateInPlaceView(view, dst, enableByreAlias))
+    return failure();
+
+  OpBuilder b(copyOp);
+  Value newView = createInPlaceView(b, view, dst, enableByreAlias);
+
+  LLVM_DEBUG(llvm::dbgs() << "inplace slice " << copyOp << "\n");
+  copyOp->erase();
+  dst.replaceAllUsesWith(newView);
+  dstAlloc->erase();
+  return success();
+}
+
+struct InPlaceConcatSlicePass
+    : public InPlaceConcatSliceBase<InPlaceConcatSlicePass> {
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    bool isByreEntryFunc =
+        funcOp->hasAttrOfType<UnitAttr>(
+            byre::ByreDialect::getEntryPointFunctionAttrName()) ||
+        funcOp->hasAttrOfType<UnitAttr>(getAttrPlaceholderName(
+            byre::ByreDialect::getEntryPointFunctionAttrName()));
+    auto &domInfo = getAnalysis<DominanceInfo>();
+
+    // byre.alias must live in the function body
+    SmallVector<memref::CopyOp> copyOps;
+    for (Block &block : funcOp.getBody()) {
+      for (auto copyOp : block.getOps<memref::CopyOp>())
+        copyOps.push_back(copyOp);
+    }
+
+    for (auto copyOp : copyOps) {
+      if (succeeded(inPlaceConcatOperand(copyOp, domInfo, isByreEntryFunc))) {
+        ++numInPlaceConcatOperands;
+      } else if (succeeded(inPlaceSlice(copyOp, isByreEntryFunc))) {
+        ++numInPlaceSlices;
+      }
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::createInPlaceConcatSlicePass() {
+  return std::make_unique<InPlaceConcatSlicePass>();
+}
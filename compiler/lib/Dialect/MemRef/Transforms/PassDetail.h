@@ -32,6 +32,10 @@ namespace arith {
 class ArithDialect;
 } // namespace arith
 
+namespace byre {
+class ByreDialect;
+} // namespace byre
+
 namespace func {
 class FuncOp;
 } // namespace func
@@ -18,6 +18,7 @@
 #include "byteir/Dialect/MemRef/Transforms/RemoveCopy.h"
 #include "byteir/Dialect/Byre/ByreDialect.h"
 #include "byteir/Dialect/MemRef/Utils/MemEffect.h"
+#include "byteir/Dialect/MemRef/Utils/Ops.h"
 #include "byteir/Utils/Hoist.h"
 #include "byteir/Utils/MemUtils.h"
 #include "byteir/Utils/Utils.h"
@@ -26,6 +27,8 @@
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/MemRef/Transforms/ComposeSubView.h"
 #include "mlir/IR/Dominance.h"
+#include "mlir/Interfaces/CopyOpInterface.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "llvm/Support/Debug.h"
 
@@ -406,6 +409,121 @@ private:
   bool enableByreAlias;
 };
 
+// Forward the target of a copy, e.g. an output buffer provided by the caller,
+// to the producers of its source across byre ops, so that the source alloc
+// and the copy are removed.
+//
+// Byre entry functions are straight-line code after ToByre, so the use ranges
+// of both buffers are computed in block order from the memory effects of each
+// use, e.g. the `memory_effects` of byre.compute. It is legal when the target
+// isn't accessed from the first use of the source to the copy, and when the
+// source is only read after the copy while the target isn't written.
+class ForwardCopyAcrossByreOpsPattern
+    : public OpInterfaceRewritePattern<CopyOpInterface> {
+public:
+  ForwardCopyAcrossByreOpsPattern(MLIRContext *context, DominanceInfo &dom)
+      : OpInterfaceRewritePattern(context), domInfo(dom) {}
+
+  LogicalResult matchAndRewrite(CopyOpInterface copyOp,
+                                PatternRewriter &rewriter) const override {
+    Operation *op = copyOp.getOperation();
+    if (!isa<func::FuncOp>(op->getParentOp()))
+      return failure();
+
+    Value src = copyOp.getSource();
+    Value target = copyOp.getTarget();
+    auto srcAlloc = src.getDefiningOp<memref::AllocOp>();
+    auto targetType = dyn_cast<MemRefType>(target.getType());
+    if (!srcAlloc || srcAlloc->getBlock() != op->getBlock() || !targetType ||
+        getRootBuffer(target) == src)
+      return failure();
+
+    // a different shape is reinterpreted by byre.alias
+    MemRefType srcType = srcAlloc.getType();
+    if (!srcType.hasStaticShape() || !srcType.getLayout().isIdentity() ||
+        !targetType.hasStaticShape() || !targetType.getLayout().isIdentity() ||
+        srcType.getElementType() != targetType.getElementType() ||
+        srcType.getNumElements() != targetType.getNumElements() ||
+        srcType.getMemorySpace() != targetType.getMemorySpace())
+      return failure();
+
+    Block *block = op->getBlock();
+    Operation *firstUse = nullptr;
+    for (Operation *user : src.getUsers()) {
+      if (user == op)
+        continue;
+      if (isa<memref::DeallocOp>(user))
+        return failure();
+      Operation *ancestor = block->findAncestorOpInBlock(*user);
+      if (!firstUse || ancestor->isBeforeInBlock(firstUse))
+        firstUse = ancestor;
+    }
+    if (!firstUse || op->isBeforeInBlock(firstUse))
+      return failure();
+
+    // the source must be read-only after the copy
+    Operation *lastUse = op;
+    llvm::SmallPtrSet<Operation *, 8> srcUsers;
+    for (Value view : getAllViews(src)) {
+      for (OpOperand &use : view.getUses()) {
+        Operation *user = block->findAncestorOpInBlock(*use.getOwner());
+        if (user == op || isa<ViewLikeOpInterface>(use.getOwner()))
+          continue;
+        srcUsers.insert(user);
+        if (op->isBeforeInBlock(user)) {
+          if (maybeOpOperandWrite(use) || isa<func::ReturnOp>(user))
+            return failure();
+          if (lastUse->isBeforeInBlock(user))
+            lastUse = user;
+        }
+      }
+    }
+
+    for (Value view : getAllViews(getRootBuffer(target))) {
+      for (OpOperand &use : view.getUses()) {
+        Operation *user = block->findAncestorOpInBlock(*use.getOwner());
+        if (!user || user == op || isa<ViewLikeOpInterface>(use.getOwner()) ||
+            user->isBeforeInBlock(firstUse))
+          continue;
+        if (user->isBeforeInBlock(op)) {
+          LLVM_DEBUG(llvm::dbgs() << "target accessed before copy by "
+                                  << *user << "\n");
+          return failure();
+        }
+        if (!lastUse->isBeforeInBlock(user) &&
+            (maybeOpOperandWrite(use) || srcUsers.contains(user))) {
+          LLVM_DEBUG(llvm::dbgs() << "target written while source is read by "
+                                  << *user << "\n");
+          return failure();
+        }
+      }
+    }
+
+    // the target must be available at the first use of the source
+    if (Operation *targetDef = target.getDefiningOp()) {
+      if (targetDef->getBlock() == block && targetDef->getNumOperands() == 0)
+        hoistUpOpInBlock(targetDef, domInfo);
+    }
+    if (!domInfo.properlyDominates(target, firstUse))
+      return failure();
+
+    LLVM_DEBUG(llvm::dbgs() << "forward copy " << *op << "\n");
+    rewriter.setInsertionPoint(firstUse);
+    Value replacement = target;
+    if (srcType != targetType) {
+      replacement =
+          rewriter.create<byre::AliasOp>(op->getLoc(), srcType, target, 0);
+    }
+    rewriter.eraseOp(op);
+    rewriter.replaceAllUsesWith(src, replacement);
+    rewriter.eraseOp(srcAlloc);
+    return success();
+  }
+
+private:
+  DominanceInfo &domInfo;
+};
+
 struct RemoveCopyPass : public RemoveCopyBase<RemoveCopyPass> {
 public:
   RemoveCopyPass() = default;
@@ -451,6 +569,10 @@ void mlir::populateRemoveCopyAfterBufferizationPattern(
     RewritePatternSet &patterns, DominanceInfo &domInfo, bool enableByreAlias) {
   patterns.add<RemoveCopyPattern>(patterns.getContext(), domInfo,
                                   enableByreAlias);
+  if (enableByreAlias) {
+    patterns.add<ForwardCopyAcrossByreOpsPattern>(patterns.getContext(),
+                                                  domInfo);
+  }
 }
 
 std::unique_ptr<OperationPass<func::FuncOp>> mlir::createRemoveCopyPass() {
@@ -17,6 +17,7 @@
 
 #include "byteir/Dialect/MemRef/Utils/Ops.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
 #include "llvm/Support/Debug.h"
 
 #define DEBUG_TYPE "memref-utils-ops"
@@ -81,3 +82,22 @@ bool mlir::doSubViewsConservativelyNotOverlap(memref::SubViewOp lhs,
 
   return false;
 }
+
+Value mlir::getRootBuffer(Value value) {
+  while (auto viewLike = value.getDefiningOp<ViewLikeOpInterface>())
+    value = viewLike.getViewSource();
+  return value;
+}
+
+SmallVector<Value> mlir::getAllViews(Value root) {
+  SmallVector<Value> views{root};
+  for (size_t i = 0; i < views.size(); ++i) {
+    for (Operation *user : views[i].getUsers()) {
+      if (auto viewLike = dyn_cast<ViewLikeOpInterface>(user)) {
+        if (viewLike.getViewSource() == views[i])
+          views.push_back(user->getResult(0));
+      }
+    }
+  }
+  return views;
+}
@@ -23,6 +23,14 @@
 
 // forward dialects for conversions
 namespace mlir {
+namespace arith {
+class ArithDialect;
+} // namespace arith
+
+namespace memref {
+class MemRefDialect;
+} // namespace memref
+
 namespace scf {
 class SCFDialect;
 } // namespace scf
@@ -0,0 +1,410 @@
+//===- SoftwarePrefetch.cpp -----------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/SCF/Transforms/SoftwarePrefetch.h"
+#include "byteir/Dialect/MemRef/Utils/Ops.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Debug.h"
+
+#include "PassDetail.h"
+
+#include <algorithm>
+
+#define DEBUG_TYPE "scf-software-prefetch"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+constexpr unsigned kMaxSliceDepth = 8;
+constexpr int64_t kMaxLinesPerRow = 8;
+
+struct PrefetchCandidate {
+  Operation *op;
+  Value memref;
+  SmallVector<Value> indices;
+  bool isWrite = false;
+  // whether any index is computed through another load
+  bool isIndirect = false;
+  // ops of the loop body computing indices, in def-before-use order
+  SetVector<Operation *> slice;
+  // nested loops whose induction variables are used by indices, which are
+  // replaced by their lower bounds when prefetching
+  SetVector<Operation *> innerLoops;
+};
+
+// whether any op in `loop` may write to the buffer `memref` views into
+bool mayWriteInLoop(Value memref, scf::ForOp loop) {
+  Value root = getRootBuffer(memref);
+  return loop.getBody()
+      ->walk([&](Operation *op) {
+        auto effectOp = dyn_cast<MemoryEffectOpInterface>(op);
+        if (!effectOp) {
+          return op->hasTrait<OpTrait::HasRecursiveMemoryEffects>()
+                     ? WalkResult::advance()
+                     : WalkResult::interrupt();
+        }
+        SmallVector<MemoryEffects::EffectInstance> effects;
+        effectOp.getEffects(effects);
+        for (auto &effect : effects) {
+          if (isa<MemoryEffects::Write>(effect.getEffect()) &&
+              (!effect.getValue() ||
+               getRootBuffer(effect.getValue()) == root))
+            return WalkResult::interrupt();
+        }
+        return WalkResult::advance();
+      })
+      .wasInterrupted();
+}
+
+// Collect ops of `loop` computing `value` into the slice of `candidate`,
+// return false if `value` couldn't be recomputed for another iteration. Only
+// ops in the loop body are collected, which are executed in every iteration,
+// so loads among them stay in bounds for any valid iteration.
+bool collectIndexSlice(Value value, scf::ForOp loop,
+                       PrefetchCandidate &candidate, unsigned depth = 0) {
+  if (value == loop.getInductionVar() || loop.isDefinedOutsideOfLoop(value))
+    return true;
+  if (auto inner = scf::getForInductionVarOwner(value)) {
+    if (!loop->isProperAncestor(inner) ||
+        !loop.isDefinedOutsideOfLoop(inner.getLowerBound()))
+      return false;
+    candidate.innerLoops.insert(inner);
+    return true;
+  }
+  Operation *def = value.getDefiningOp();
+  if (!def || def->getBlock() != loop.getBody())
+    return false;
+  if (candidate.slice.contains(def))
+    return true;
+  if (depth >= kMaxSliceDepth)
+    return false;
+
+  if (auto loadOp = dyn_cast<memref::LoadOp>(def)) {
+    if (!loop.isDefinedOutsideOfLoop(loadOp.getMemRef()) ||
+        mayWriteInLoop(loadOp.getMemRef(), loop))
+      return false;
+    candidate.isIndirect = true;
+  } else if (!isPure(def) || def->getNumRegions() > 0) {
+    return false;
+  }
+
+  for (Value operand : def->getOperands()) {
+    if (!collectIndexSlice(operand, loop, candidate, depth + 1))
+      return false;
+  }
+  candidate.slice.insert(def);
+  return true;
+}
+
+// constant coefficient of the induction variable of `loop` in `value`, or
+// std::nullopt if `value` isn't affine in it
+std::optional<int64_t> getIVCoefficient(Value value, scf::ForOp loop,
+                                        unsigned depth = 0) {
+  if (value == loop.getInductionVar())
+    return 1;
+  if (loop.isDefinedOutsideOfLoop(value) || matchPattern(value, m_Constant()))
+    return 0;
+  Operation *def = value.getDefiningOp();
+  if (!def || depth >= kMaxSliceDepth)
+    return std::nullopt;
+
+  auto getCoeff = [&](unsigned idx) {
+    return getIVCoefficient(def->getOperand(idx), loop, depth + 1);
+  };
+  if (isa<arith::IndexCastOp, arith::IndexCastUIOp, arith::ExtSIOp,
+          arith::ExtUIOp>(def))
+    return getCoeff(0);
+  if (isa<arith::AddIOp, arith::SubIOp>(def)) {
+    auto lhs = getCoeff(0), rhs = getCoeff(1);
+    if (!lhs || !rhs)
+      return std::nullopt;
+    return isa<arith::AddIOp>(def) ? *lhs + *rhs : *lhs - *rhs;
+  }
+  if (isa<arith::MulIOp>(def)) {
+    auto lhs = getCoeff(0), rhs = getCoeff(1);
+    if (!lhs || !rhs)
+      return std::nullopt;
+    if (*lhs == 0 && *rhs == 0)
+      return 0;
+    auto lhsConst = getConstantIntValue(def->getOperand(0));
+    auto rhsConst = getConstantIntValue(def->getOperand(1));
+    if (rhsConst)
+      return *lhs * *rhsConst;
+    if (lhsConst)
+      return *rhs * *lhsConst;
+  }
+  return std::nullopt;
+}
+
+int64_t getElementBytes(Value memref) {
+  Type elementType = cast<MemRefType>(memref.getType()).getElementType();
+  return elementType.isIntOrFloat()
+             ? llvm::divideCeil(elementType.getIntOrFloatBitWidth(), 8)
+             : 0;
+}
+
+// bytes moved by each iteration of `loop` for a strided access, or
+// std::nullopt if unknown
+std::optional<int64_t> getBytesPerIteration(const PrefetchCandidate &candidate,
+                                            scf::ForOp loop) {
+  auto memrefType = cast<MemRefType>(candidate.memref.getType());
+  int64_t elementBytes = getElementBytes(candidate.memref);
+  auto step = getConstantIntValue(loop.getStep());
+  SmallVector<int64_t> strides;
+  int64_t offset;
+  if (!step || elementBytes == 0 ||
+      failed(getStridesAndOffset(memrefType, strides, offset)))
+    return std::nullopt;
+
+  int64_t elementStride = 0;
+  for (auto [index, stride] : llvm::zip(candidate.indices, strides)) {
+    auto coeff = getIVCoefficient(index, loop);
+    if (!coeff || (*coeff != 0 && ShapedType::isDynamic(stride)))
+      return std::nullopt;
+    if (*coeff != 0)
+      elementStride += *coeff * stride;
+  }
+  return std::abs(elementStride * *step) * elementBytes;
+}
+
+// Number of cache lines of the row read by a gather in a nested loop, e.g.
+// `table[idx[i], j]` in a loop of `j` over a contiguous row, which are all
+// prefetched. Return 1 if unknown.
+int64_t getNumLinesPerRow(const PrefetchCandidate &candidate,
+                          int64_t cacheLineBytes) {
+  if (candidate.innerLoops.size() != 1)
+    return 1;
+  auto inner = cast<scf::ForOp>(candidate.innerLoops.front());
+  auto memrefType = cast<MemRefType>(candidate.memref.getType());
+  auto lb = getConstantIntValue(inner.getLowerBound());
+  auto ub = getConstantIntValue(inner.getUpperBound());
+  auto step = getConstantIntValue(inner.getStep());
+  int64_t elementBytes = getElementBytes(candidate.memref);
+  if (candidate.indices.back() != inner.getInductionVar() || !lb || !ub ||
+      step != 1 || *ub <= *lb || elementBytes == 0 ||
+      !isLastMemrefDimUnitStride(memrefType))
+    return 1;
+  return std::min(llvm::divideCeil((*ub - *lb) * elementBytes, cacheLineBytes),
+                  kMaxLinesPerRow);
+}
+
+std::optional<PrefetchCandidate> getPrefetchCandidate(Operation *op,
+                                                      scf::ForOp loop) {
+  PrefetchCandidate candidate;
+  candidate.op = op;
+  if (auto loadOp = dyn_cast<memref::LoadOp>(op)) {
+    candidate.memref = loadOp.getMemRef();
+    candidate.indices = llvm::to_vector(loadOp.getIndices());
+  } else if (auto storeOp = dyn_cast<memref::StoreOp>(op)) {
+    candidate.memref = storeOp.getMemRef();
+    candidate.indices = llvm::to_vector(storeOp.getIndices());
+    candidate.isWrite = true;
+  } else {
+    return std::nullopt;
+  }
+  // elements of unknown size, e.g. index, can't be mapped to cache lines
+  if (candidate.indices.empty() || getElementBytes(candidate.memref) == 0 ||
+      !loop.isDefinedOutsideOfLoop(candidate.memref))
+    return std::nullopt;
+
+  for (Value index : candidate.indices) {
+    if (!collectIndexSlice(index, loop, candidate))
+      return std::nullopt;
+  }
+
+  // accesses of nested loops are left to those loops unless they are gathers
+  // driven by this loop
+  if (op->getBlock() != loop.getBody() && !candidate.isIndirect)
+    return std::nullopt;
+
+  // skip accesses invariant to the loop
+  Value iv = loop.getInductionVar();
+  auto usesIV = [&](Operation *sliceOp) {
+    return llvm::is_contained(sliceOp->getOperands(), iv);
+  };
+  if (!llvm::is_contained(candidate.indices, iv) &&
+      llvm::none_of(candidate.slice, usesIV))
+    return std::nullopt;
+  return candidate;
+}
+
+// rough number of ops executed by one iteration of `block`
+int64_t getBlockCost(Block *block) {
+  int64_t cost = 0;
+  for (Operation &op : block->without_terminator()) {
+    ++cost;
+    int64_t tripCount = 1;
+    if (auto forOp = dyn_cast<scf::ForOp>(op)) {
+      auto lb = getConstantIntValue(forOp.getLowerBound());
+      auto ub = getConstantIntValue(forOp.getUpperBound());
+      auto step = getConstantIntValue(forOp.getStep());
+      if (lb && ub && step && *step > 0)
+        tripCount = std::max<int64_t>(llvm::divideCeil(*ub - *lb, *step), 1);
+    }
+    for (Region &region : op.getRegions()) {
+      for (Block &nested : region)
+        cost += tripCount * getBlockCost(&nested);
+    }
+  }
+  return cost;
+}
+
+struct SoftwarePrefetchPass
+    : public SoftwarePrefetchBase<SoftwarePrefetchPass> {
+  SoftwarePrefetchPass(llvm::StringRef anchor, int64_t dist)
+      : SoftwarePrefetchBase() {
+    anchorTag = anchor.str();
+    distance = dist;
+  }
+
+  // cover the memory latency by iterations of the loop, assuming roughly one
+  // cycle per op
+  int64_t getCostModelDistance(scf::ForOp loop) {
+    int64_t dist = llvm::divideCeil(
+        memoryLatency, std::max<int64_t>(getBlockCost(loop.getBody()), 1));
+    return std::clamp<int64_t>(dist, 1, std::max<int64_t>(maxDistance, 1));
+  }
+
+  void prefetchLoop(scf::ForOp loop) {
+    int64_t dist = distance;
+    if (auto distAttr =
+            loop->getAttrOfType<IntegerAttr>(getPrefetchDistanceAttrName()))
+      dist = distAttr.getInt();
+    else if (dist == 0)
+      dist = -1;
+    if (dist == 0)
+      return;
+
+    SmallVector<PrefetchCandidate> candidates;
+    loop.getBody()->walk([&](Operation *op) {
+      auto candidate = getPrefetchCandidate(op, loop);
+      if (!candidate)
+        return;
+      // short strides are left to hardware prefetchers
+      if (!candidate->isIndirect) {
+        auto bytes = getBytesPerIteration(*candidate, loop);
+        if (bytes && *bytes < cacheLineBytes)
+          return;
+      }
+      // one prefetch for accesses to the same element
+      bool isDuplicated = llvm::any_of(candidates, [&](auto &other) {
+        return other.memref == candidate->memref &&
+               other.indices == candidate->indices;
+      });
+      if (!isDuplicated)
+        candidates.push_back(std::move(*candidate));
+    });
+    // index loads of gathers are loaded ahead anyway
+    llvm::SmallPtrSet<Operation *, 8> indexLoads;
+    for (auto &candidate : candidates)
+      indexLoads.insert(candidate.slice.begin(), candidate.slice.end());
+    llvm::erase_if(candidates, [&](auto &candidate) {
+      return indexLoads.contains(candidate.op);
+    });
+    if (candidates.empty())
+      return;
+    if (dist < 0)
+      dist = getCostModelDistance(loop);
+
+    // ivAhead = iv + step * dist < ub ? iv + step * dist : iv
+    OpBuilder b(loop);
+    Location loc = loop.getLoc();
+    Value iv = loop.getInductionVar();
+    Value offset = b.create<arith::MulIOp>(
+        loc, loop.getStep(),
+        b.create<arith::ConstantOp>(loc,
+                                    b.getIntegerAttr(iv.getType(), dist)));
+    b.setInsertionPointToStart(loop.getBody());
+    Value ivNext = b.create<arith::AddIOp>(loc, iv, offset);
+    Value inBounds = b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                             ivNext, loop.getUpperBound());
+    Value ivAhead = b.create<arith::SelectOp>(loc, inBounds, ivNext, iv);
+
+    for (auto &candidate : candidates) {
+      IRMapping mapping;
+      mapping.map(iv, ivAhead);
+      for (Operation *inner : candidate.innerLoops) {
+        auto innerLoop = cast<scf::ForOp>(inner);
+        mapping.map(innerLoop.getInductionVar(), innerLoop.getLowerBound());
+      }
+      for (Operation *sliceOp : candidate.slice)
+        b.clone(*sliceOp, mapping);
+      SmallVector<Value> indices = llvm::to_vector(
+          llvm::map_range(candidate.indices, [&](Value index) {
+            return mapping.lookupOrDefault(index);
+          }));
+
+      Location prefetchLoc = candidate.op->getLoc();
+      int64_t numLines = getNumLinesPerRow(candidate, cacheLineBytes);
+      int64_t lineElements = std::max<int64_t>(
+          cacheLineBytes / getElementBytes(candidate.memref), 1);
+      Value rowStart = indices.back();
+      for (int64_t line = 0; line < numLines; ++line) {
+        if (line > 0) {
+          indices.back() = b.create<arith::AddIOp>(
+              prefetchLoc, rowStart,
+              b.create<arith::ConstantIndexOp>(prefetchLoc,
+                                               line * lineElements));
+        }
+        b.create<memref::PrefetchOp>(prefetchLoc, candidate.memref, indices,
+                                     candidate.isWrite,
+                                     /*localityHint=*/3, /*isDataCache=*/true);
+      }
+      LLVM_DEBUG(llvm::dbgs() << "prefetch " << dist << " iterations ahead for "
+                              << *candidate.op << "\n");
+      if (candidate.isIndirect)
+        ++numIndirectPrefetches;
+      else
+        ++numStreamingPrefetches;
+    }
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+
+    // skip non-anchored
+    if (!anchorTag.empty() && !funcOp->hasAttr(anchorTag)) {
+      return;
+    }
+
+    // outer loops first, so that ops inserted by them are never revisited
+    SmallVector<scf::ForOp> loops;
+    funcOp.walk<WalkOrder::PreOrder>(
+        [&](scf::ForOp loop) { loops.push_back(loop); });
+    for (auto loop : loops)
+      prefetchLoop(loop);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::createSoftwarePrefetchPass(llvm::StringRef anchorTag, int64_t distance) {
+  return std::make_unique<SoftwarePrefetchPass>(anchorTag, distance);
+}
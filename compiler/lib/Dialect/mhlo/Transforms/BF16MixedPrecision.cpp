@@ -0,0 +1,83 @@
+//===- BF16MixedPrecision.cpp ---------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/mhlo/Transforms/BF16MixedPrecision.h"
+
+#include "mhlo/IR/hlo_ops.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "PassDetail.h"
+
+using namespace mlir;
+
+namespace {
+
+template <typename OpTy>
+struct BF16OperandsPattern : public OpRewritePattern<OpTy> {
+  using OpRewritePattern<OpTy>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(OpTy op,
+                                PatternRewriter &rewriter) const override {
+    auto resultType = dyn_cast<TensorType>(op->getResult(0).getType());
+    if (!resultType || !resultType.getElementType().isF32())
+      return failure();
+    for (Value operand : op->getOperands()) {
+      if (!cast<TensorType>(operand.getType()).getElementType().isF32())
+        return failure();
+    }
+
+    Type bf16 = rewriter.getBF16Type();
+    rewriter.setInsertionPoint(op);
+    SmallVector<Value> newOperands;
+    for (Value operand : op->getOperands()) {
+      auto newType = cast<TensorType>(operand.getType()).clone(bf16);
+      newOperands.push_back(
+          rewriter.create<mhlo::ConvertOp>(op.getLoc(), newType, operand));
+    }
+    rewriter.startOpModification(op);
+    op->setOperands(newOperands);
+    rewriter.finalizeOpModification(op);
+    return success();
+  }
+};
+
+struct BF16MixedPrecisionPass
+    : public BF16MixedPrecisionBase<BF16MixedPrecisionPass> {
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *ctx = funcOp.getContext();
+    RewritePatternSet patterns(ctx);
+    patterns.add<BF16OperandsPattern<mhlo::DotOp>,
+                 BF16OperandsPattern<mhlo::DotGeneralOp>,
+                 BF16OperandsPattern<mhlo::ConvolutionOp>>(ctx);
+    // fold converts of constant weights
+    mhlo::ConvertOp::getCanonicalizationPatterns(patterns, ctx);
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns)))) {
+      return signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+mlir::createBF16MixedPrecisionPass() {
+  return std::make_unique<BF16MixedPrecisionPass>();
+}
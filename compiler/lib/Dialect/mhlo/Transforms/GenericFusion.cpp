@@ -52,6 +52,13 @@ bool isCustomMhloByteirRepeatOp(Operation *op) {
   return false;
 }
 
+bool isCustomMhloConvNCHWcOp(Operation *op) {
+  if (auto customOp = llvm::dyn_cast_or_null<mhlo::CustomCallOp>(op)) {
+    return customOp.getCallTargetName() == getConv2dNCHWcName();
+  }
+  return false;
+}
+
 bool isMhloElementwiseOp(Operation *op) {
   return isMhlo(op) && (op->hasTrait<::mlir::OpTrait::Elementwise>() ||
                         op->hasTrait<hlo::OpTrait::BroadcastingElementwise>());
@@ -341,7 +348,8 @@ static GenericFuserConfig config{
 namespace aggressive_fusion {
 
 bool isFusibleCandidate(Operation *op) {
-  if (isCustomMhloRngOp(op) || isCustomMhloByteirRepeatOp(op))
+  if (isCustomMhloRngOp(op) || isCustomMhloByteirRepeatOp(op) ||
+      isCustomMhloConvNCHWcOp(op))
     return true;
   if (llvm::isa<mhlo::CustomCallOp>(op))
     return false;
@@ -18,6 +18,7 @@
 #include "byteir/Dialect/mhlo/Transforms/LayoutTransformation.h"
 
 #include "byteir/Dialect/Byre/Common.h"
+#include "byteir/Dialect/mhlo/Util/CustomCallUtil.h"
 #include "byteir/Dialect/mhlo/Util/Util.h"
 #include "byteir/Utils/Utils.h"
 #include "mhlo/IR/hlo_ops.h"
@@ -31,6 +32,9 @@
 
 #include "./PassDetail.h"
 
+#include <cstring>
+#include <optional>
+
 using namespace mlir;
 using namespace llvm;
 
@@ -159,6 +163,172 @@ DenseIntElementsAttr createNCDHW2NDHWCAttr2(PatternRewriter &rewriter,
                             {5, 2}, &rewriter);
 }
 
+// Parse blocked layouts of the form NCHW<b>c, such as NCHW8c and NCHW16c, and
+// return the block size b
+std::optional<int64_t> parseNCHWcLayout(StringRef layout) {
+  int64_t blockSize;
+  if (!layout.consume_front("NCHW") || !layout.consume_back("c") ||
+      layout.getAsInteger(10, blockSize) || blockSize <= 1) {
+    return std::nullopt;
+  }
+  return blockSize;
+}
+
+// [N, C/b, H, W, b] => [N, C, H, W]
+Value createNCHWc2NCHWValue(PatternRewriter &rewriter, Location loc,
+                            Value input) {
+  auto inputType = cast<RankedTensorType>(input.getType());
+  assert(inputType.getRank() == 5);
+  auto shape = inputType.getShape();
+  RankedTensorType transposeType =
+      RankedTensorType::get({shape[0], shape[1], shape[4], shape[2], shape[3]},
+                            inputType.getElementType());
+  Value transpose = rewriter.create<mhlo::TransposeOp>(
+      loc, transposeType, input, rewriter.getI64TensorAttr({0, 1, 4, 2, 3}));
+  RankedTensorType newType =
+      RankedTensorType::get({shape[0], shape[1] * shape[4], shape[2], shape[3]},
+                            inputType.getElementType());
+  return rewriter.create<mhlo::ReshapeOp>(loc, newType, transpose);
+}
+
+// return the blocked value when `value` is produced by
+// createNCHWc2NCHWValue, which lets adjacent reorders cancel out
+Value getNCHWcSource(Value value, int64_t blockSize) {
+  auto reshapeOp = value.getDefiningOp<mhlo::ReshapeOp>();
+  if (!reshapeOp) {
+    return nullptr;
+  }
+  auto transposeOp = reshapeOp.getOperand().getDefiningOp<mhlo::TransposeOp>();
+  if (!transposeOp ||
+      !llvm::equal(transposeOp.getPermutation().getValues<int64_t>(),
+                   ArrayRef<int64_t>{0, 1, 4, 2, 3})) {
+    return nullptr;
+  }
+  auto sourceType =
+      dyn_cast<RankedTensorType>(transposeOp.getOperand().getType());
+  auto resultType = dyn_cast<RankedTensorType>(reshapeOp.getType());
+  if (!sourceType || !resultType || sourceType.getDimSize(4) != blockSize ||
+      resultType.getRank() != 4 ||
+      resultType.getDimSize(1) != sourceType.getDimSize(1) * blockSize) {
+    return nullptr;
+  }
+  return transposeOp.getOperand();
+}
+
+RankedTensorType createNCHW2NCHWcType(Type type, int64_t blockSize) {
+  auto rankedTy = cast<RankedTensorType>(type);
+  assert(rankedTy.getRank() == 4 && rankedTy.getDimSize(1) % blockSize == 0);
+  auto shape = rankedTy.getShape();
+  return RankedTensorType::get(
+      {shape[0], shape[1] / blockSize, shape[2], shape[3], blockSize},
+      rankedTy.getElementType());
+}
+
+// [N, C, H, W] => [N, C/b, H, W, b]
+Value createNCHW2NCHWcValue(PatternRewriter &rewriter, Location loc,
+                            Value input, int64_t blockSize) {
+  if (Value source = getNCHWcSource(input, blockSize)) {
+    return source;
+  }
+  auto inputType = cast<RankedTensorType>(input.getType());
+  auto shape = inputType.getShape();
+  RankedTensorType reshapeType = RankedTensorType::get(
+      {shape[0], shape[1] / blockSize, blockSize, shape[2], shape[3]},
+      inputType.getElementType());
+  Value reshape = rewriter.create<mhlo::ReshapeOp>(loc, reshapeType, input);
+  return rewriter.create<mhlo::TransposeOp>(
+      loc, createNCHW2NCHWcType(inputType, blockSize), reshape,
+      rewriter.getI64TensorAttr({0, 1, 3, 4, 2}));
+}
+
+// [C] => [N, C/b, H, W, b] along the channel dims
+Value createChannel2NCHWcValue(PatternRewriter &rewriter, Location loc,
+                               Value channel, RankedTensorType blockedType) {
+  auto channelType = cast<RankedTensorType>(channel.getType());
+  int64_t blockSize = blockedType.getDimSize(4);
+  RankedTensorType reshapeType =
+      RankedTensorType::get({blockedType.getDimSize(1), blockSize},
+                            channelType.getElementType());
+  Value reshape = rewriter.create<mhlo::ReshapeOp>(loc, reshapeType, channel);
+  return rewriter.create<mhlo::BroadcastInDimOp>(
+      loc, blockedType.clone(channelType.getElementType()), reshape,
+      rewriter.getI64TensorAttr({1, 4}));
+}
+
+// Permute a dense constant, viewed with `shape`, by `permutation` at compile
+// time. Return nullptr when the element type is not byte addressable.
+DenseElementsAttr permuteDenseElementsAttr(DenseElementsAttr attr,
+                                           ArrayRef<int64_t> shape,
+                                           ArrayRef<int64_t> permutation,
+                                           RankedTensorType resultType) {
+  if (attr.isSplat()) {
+    return DenseElementsAttr::get(resultType,
+                                  attr.getSplatValue<Attribute>());
+  }
+  Type elementType = attr.getElementType();
+  if (!elementType.isIntOrFloat() ||
+      elementType.getIntOrFloatBitWidth() % 8 != 0) {
+    return nullptr;
+  }
+  size_t elementBytes = elementType.getIntOrFloatBitWidth() / 8;
+  int64_t rank = shape.size();
+  SmallVector<int64_t> strides(rank, 1);
+  for (int64_t i = rank - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * shape[i + 1];
+  }
+
+  ArrayRef<char> rawData = attr.getRawData();
+  SmallVector<char> newData(rawData.size());
+  SmallVector<int64_t> outputIndices(rank, 0);
+  auto outputShape = resultType.getShape();
+  for (int64_t i = 0; i < resultType.getNumElements(); ++i) {
+    int64_t inputIndex = 0;
+    for (int64_t k = 0; k < rank; ++k) {
+      inputIndex += outputIndices[k] * strides[permutation[k]];
+    }
+    std::memcpy(newData.data() + i * elementBytes,
+                rawData.data() + inputIndex * elementBytes, elementBytes);
+    // advance output indices in row-major order
+    for (int64_t k = rank - 1; k >= 0; --k) {
+      if (++outputIndices[k] < outputShape[k]) {
+        break;
+      }
+      outputIndices[k] = 0;
+    }
+  }
+  return DenseElementsAttr::getFromRawBuffer(resultType, newData);
+}
+
+// OIHW => [O/b, I/b, H, W, b(I), b(O)], folded at compile time for constant
+// weights
+Value createOIHW2OIHWioValue(PatternRewriter &rewriter, Location loc,
+                             Value weight, int64_t blockSize) {
+  auto weightType = cast<RankedTensorType>(weight.getType());
+  auto shape = weightType.getShape();
+  SmallVector<int64_t> reshapeShape{shape[0] / blockSize, blockSize,
+                                    shape[1] / blockSize, blockSize,
+                                    shape[2],             shape[3]};
+  SmallVector<int64_t> permutation{0, 2, 4, 5, 3, 1};
+  RankedTensorType newType = RankedTensorType::get(
+      {shape[0] / blockSize, shape[1] / blockSize, shape[2], shape[3],
+       blockSize, blockSize},
+      weightType.getElementType());
+
+  if (auto constOp = weight.getDefiningOp<mhlo::ConstantOp>()) {
+    if (auto denseAttr = dyn_cast<DenseElementsAttr>(constOp.getValue())) {
+      if (auto newAttr = permuteDenseElementsAttr(denseAttr, reshapeShape,
+                                                  permutation, newType)) {
+        return rewriter.create<mhlo::ConstantOp>(loc, newAttr);
+      }
+    }
+  }
+  Value reshape = rewriter.create<mhlo::ReshapeOp>(
+      loc, RankedTensorType::get(reshapeShape, weightType.getElementType()),
+      weight);
+  return rewriter.create<mhlo::TransposeOp>(
+      loc, newType, reshape, rewriter.getI64TensorAttr(permutation));
+}
+
 struct ConvLayoutTransformationNCHWPattern
     : public OpRewritePattern<mhlo::ConvolutionOp> {
   ConvLayoutTransformationNCHWPattern(MLIRContext *context,
@@ -671,6 +841,309 @@ struct BatchNormGradLayoutTransformationPattern
   std::string targetLayout;
 };
 
+struct ConvLayoutTransformationNCHWcPattern
+    : public OpRewritePattern<mhlo::ConvolutionOp> {
+  ConvLayoutTransformationNCHWcPattern(MLIRContext *context, int64_t blockSize)
+      : OpRewritePattern<mhlo::ConvolutionOp>(context), blockSize(blockSize) {
+  }
+
+  LogicalResult matchAndRewrite(mhlo::ConvolutionOp op,
+                                PatternRewriter &rewriter) const override {
+    if (op->getParentOfType<mhlo::FusionOp>()) {
+      return failure();
+    }
+    auto convLayout = getConvLayout(op.getDimensionNumbers());
+    if (std::get<0>(convLayout) != byteir::NamedLayout::NCHW ||
+        std::get<1>(convLayout) != byteir::NamedLayout::NCHW ||
+        std::get<2>(convLayout) != byteir::NamedLayout::NCHW) {
+      return failure();
+    }
+    auto lhsType = cast<RankedTensorType>(op.getLhs().getType());
+    auto rhsType = cast<RankedTensorType>(op.getRhs().getType());
+    auto resultType = cast<RankedTensorType>(op.getResult().getType());
+    if (!lhsType.hasStaticShape() || !rhsType.hasStaticShape() ||
+        !resultType.hasStaticShape() || lhsType.getRank() != 4) {
+      return failure();
+    }
+    if (op.getFeatureGroupCount() != 1 || op.getBatchGroupCount() != 1 ||
+        lhsType.getDimSize(1) % blockSize != 0 ||
+        rhsType.getDimSize(0) % blockSize != 0) {
+      return failure();
+    }
+    if (op.getLhsDilationAttr() && !isSplatValue(op.getLhsDilationAttr(), 1)) {
+      return failure();
+    }
+    if (op.getWindowReversalAttr() &&
+        llvm::is_contained(op.getWindowReversalAttr().getValues<bool>(),
+                           true)) {
+      return failure();
+    }
+    SmallVector<int64_t> padding(4, 0);
+    if (auto paddingAttr = op.getPaddingAttr()) {
+      padding = llvm::to_vector(paddingAttr.getValues<int64_t>());
+    }
+    if (llvm::any_of(padding, [](int64_t p) { return p < 0; })) {
+      return failure();
+    }
+    SmallVector<int64_t> strides(2, 1), rhsDilation(2, 1);
+    if (auto stridesAttr = op.getWindowStridesAttr()) {
+      strides = llvm::to_vector(stridesAttr.getValues<int64_t>());
+    }
+    if (auto rhsDilationAttr = op.getRhsDilationAttr()) {
+      rhsDilation = llvm::to_vector(rhsDilationAttr.getValues<int64_t>());
+    }
+
+    Location loc = op->getLoc();
+    Value input = createNCHW2NCHWcValue(rewriter, loc, op.getLhs(), blockSize);
+    if (llvm::any_of(padding, [](int64_t p) { return p != 0; })) {
+      auto inputType = cast<RankedTensorType>(input.getType());
+      SmallVector<int64_t> paddedShape(inputType.getShape());
+      paddedShape[2] += padding[0] + padding[1];
+      paddedShape[3] += padding[2] + padding[3];
+      Value zero = rewriter.create<mhlo::ConstantOp>(
+          loc, rewriter.getZeroAttr(
+                   RankedTensorType::get({}, inputType.getElementType())));
+      input = rewriter.create<mhlo::PadOp>(
+          loc, inputType.clone(paddedShape), input, zero,
+          rewriter.getI64TensorAttr({0, 0, padding[0], padding[2], 0}),
+          rewriter.getI64TensorAttr({0, 0, padding[1], padding[3], 0}),
+          rewriter.getI64TensorAttr({0, 0, 0, 0, 0}));
+    }
+    Value weight =
+        createOIHW2OIHWioValue(rewriter, loc, op.getRhs(), blockSize);
+
+    auto customCallOp = rewriter.create<mhlo::CustomCallOp>(
+        loc, ArrayRef<Type>{createNCHW2NCHWcType(resultType, blockSize)},
+        ValueRange{input, weight}, getConv2dNCHWcName(), false,
+        rewriter.getStringAttr(""),
+        mhlo::CustomCallApiVersion{
+            mhlo::CustomCallApiVersion::API_VERSION_ORIGINAL},
+        rewriter.getArrayAttr(ArrayRef<Attribute>{}),
+        mhlo::CustomCallSchedule{mhlo::CustomCallSchedule::NONE}, nullptr,
+        nullptr, rewriter.getArrayAttr(ArrayRef<Attribute>{}));
+    customCallOp->setAttr(
+        getCustomCallAttrName(),
+        rewriter.getDictionaryAttr(
+            {rewriter.getNamedAttr("window_strides",
+                                   rewriter.getI64ArrayAttr(strides)),
+             rewriter.getNamedAttr("rhs_dilation",
+                                   rewriter.getI64ArrayAttr(rhsDilation))}));
+    Value output =
+        createNCHWc2NCHWValue(rewriter, loc, customCallOp->getResult(0));
+    rewriter.replaceOp(op, output);
+    return success();
+  }
+  int64_t blockSize;
+};
+
+// Propagate the blocked layout through elementwise ops which have at least
+// one operand already in blocked layout. The remaining operands should be
+// splat constants, scalars or per-channel vectors broadcasted along dim 1.
+struct ElementwiseLayoutTransformationNCHWcPattern : public RewritePattern {
+  ElementwiseLayoutTransformationNCHWcPattern(MLIRContext *context,
+                                              int64_t blockSize)
+      : RewritePattern(MatchAnyOpTypeTag(), /*benefit=*/1, context),
+        blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(Operation *op,
+                                PatternRewriter &rewriter) const override {
+    if (!isMhlo(op) || !op->hasTrait<OpTrait::Elementwise>() ||
+        op->getNumResults() != 1 || op->getNumRegions() != 0 ||
+        op->getParentOfType<mhlo::FusionOp>()) {
+      return failure();
+    }
+    auto resultType = dyn_cast<RankedTensorType>(op->getResult(0).getType());
+    if (!resultType || resultType.getRank() != 4 ||
+        !resultType.hasStaticShape()) {
+      return failure();
+    }
+
+    bool hasBlockedOperand = false;
+    for (Value operand : op->getOperands()) {
+      if (getNCHWcSource(operand, blockSize)) {
+        hasBlockedOperand = true;
+      } else if (!getBroadcastedSource(operand)) {
+        return failure();
+      }
+    }
+    if (!hasBlockedOperand) {
+      return failure();
+    }
+
+    Location loc = op->getLoc();
+    RankedTensorType blockedType = createNCHW2NCHWcType(resultType, blockSize);
+    SmallVector<Value> newOperands;
+    for (Value operand : op->getOperands()) {
+      Type elementType = getElementTypeOrSelf(operand.getType());
+      if (Value source = getNCHWcSource(operand, blockSize)) {
+        newOperands.push_back(source);
+      } else if (auto constOp = operand.getDefiningOp<mhlo::ConstantOp>()) {
+        newOperands.push_back(rewriter.create<mhlo::ConstantOp>(
+            loc, cast<DenseElementsAttr>(constOp.getValue())
+                     .resizeSplat(blockedType.clone(elementType))));
+      } else {
+        auto broadcastOp = operand.getDefiningOp<mhlo::BroadcastInDimOp>();
+        Value source = broadcastOp.getOperand();
+        if (cast<RankedTensorType>(source.getType()).getRank() == 0) {
+          newOperands.push_back(rewriter.create<mhlo::BroadcastInDimOp>(
+              loc, blockedType.clone(elementType), source,
+              rewriter.getI64TensorAttr({})));
+        } else {
+          newOperands.push_back(
+              createChannel2NCHWcValue(rewriter, loc, source, blockedType));
+        }
+      }
+    }
+    OperationState state(loc, op->getName(), newOperands,
+                         TypeRange{blockedType}, op->getAttrs());
+    Operation *newOp = rewriter.create(state);
+    Value output = createNCHWc2NCHWValue(rewriter, loc, newOp->getResult(0));
+    rewriter.replaceOp(op, output);
+    return success();
+  }
+
+  // return the defining op of `value` if it is a splat constant, or a
+  // broadcast_in_dim of a scalar or of a vector along the channel dim
+  Operation *getBroadcastedSource(Value value) const {
+    if (auto constOp = value.getDefiningOp<mhlo::ConstantOp>()) {
+      auto denseAttr = dyn_cast<DenseElementsAttr>(constOp.getValue());
+      return denseAttr && denseAttr.isSplat() ? constOp : nullptr;
+    }
+    auto broadcastOp = value.getDefiningOp<mhlo::BroadcastInDimOp>();
+    if (!broadcastOp) {
+      return nullptr;
+    }
+    auto sourceType =
+        dyn_cast<RankedTensorType>(broadcastOp.getOperand().getType());
+    auto dims = llvm::to_vector(
+        broadcastOp.getBroadcastDimensions().getValues<int64_t>());
+    if (!sourceType || !sourceType.hasStaticShape()) {
+      return nullptr;
+    }
+    if (sourceType.getRank() == 0) {
+      return broadcastOp;
+    }
+    if (sourceType.getRank() == 1 && dims == SmallVector<int64_t>{1} &&
+        sourceType.getDimSize(0) ==
+            cast<RankedTensorType>(value.getType()).getDimSize(1)) {
+      return broadcastOp;
+    }
+    return nullptr;
+  }
+  int64_t blockSize;
+};
+
+struct ReduceWindownLayoutTransformationNCHWcPattern
+    : public OpRewritePattern<mhlo::ReduceWindowOp> {
+  ReduceWindownLayoutTransformationNCHWcPattern(MLIRContext *context,
+                                                int64_t blockSize)
+      : OpRewritePattern<mhlo::ReduceWindowOp>(context), blockSize(blockSize) {
+  }
+  LogicalResult matchAndRewrite(mhlo::ReduceWindowOp op,
+                                PatternRewriter &rewriter) const override {
+    if (op->getParentOfType<mhlo::FusionOp>()) {
+      return failure();
+    }
+    if (op.getInputs().size() != 1 || op.getInitValues().size() != 1 ||
+        op->getResults().size() != 1) {
+      return failure();
+    }
+    // only propagate an existing blocked layout, pooling alone isn't worth
+    // the reorders
+    Value source = getNCHWcSource(*(op.getInputs().begin()), blockSize);
+    if (!source || !isValidPoolOrPoolGradLayout(op)) {
+      return failure();
+    }
+    auto window = llvm::to_vector(op.getWindowDimensions().getValues<int64_t>());
+    SmallVector<int64_t> strides(4, 1);
+    if (auto stridesAttr = op.getWindowStridesAttr()) {
+      strides = llvm::to_vector(stridesAttr.getValues<int64_t>());
+    }
+    SmallVector<int64_t> padding(8, 0);
+    if (auto paddingAttr = op.getPaddingAttr()) {
+      padding = llvm::to_vector(paddingAttr.getValues<int64_t>());
+    }
+    if (window.size() != 4 || window[0] != 1 || window[1] != 1 ||
+        strides[0] != 1 || strides[1] != 1 ||
+        llvm::any_of(ArrayRef<int64_t>(padding).take_front(4),
+                     [](int64_t p) { return p != 0; })) {
+      return failure();
+    }
+
+    Type outputType =
+        createNCHW2NCHWcType(op->getResults()[0].getType(), blockSize);
+    auto newOp = rewriter.create<mhlo::ReduceWindowOp>(
+        op->getLoc(), ArrayRef<Type>{outputType}, ArrayRef<Value>{source},
+        op.getInitValues(),
+        rewriter.getI64TensorAttr({1, 1, window[2], window[3], 1}),
+        rewriter.getI64TensorAttr({1, 1, strides[2], strides[3], 1}),
+        /*base_dilations=*/DenseIntElementsAttr(),
+        /*window_dilations=*/DenseIntElementsAttr(),
+        getI64ElementsAttr({0, 0, 0, 0, padding[4], padding[5], padding[6],
+                            padding[7], 0, 0},
+                           {5, 2}, &rewriter));
+    // clone body
+    IRMapping emptyBvm;
+    op.getBody().cloneInto(&newOp.getBody(), emptyBvm);
+    Value outputTranspose =
+        createNCHWc2NCHWValue(rewriter, op->getLoc(), newOp->getResults()[0]);
+    rewriter.replaceOp(op, outputTranspose);
+    return success();
+  }
+  int64_t blockSize;
+};
+
+// rewrite batch_norm_inference on a blocked input into multiply and add with
+// per-channel factors, which then fuse with the neighbouring elementwise ops
+struct BatchNormInferenceLayoutTransformationNCHWcPattern
+    : public OpRewritePattern<mhlo::BatchNormInferenceOp> {
+  BatchNormInferenceLayoutTransformationNCHWcPattern(MLIRContext *context,
+                                                     int64_t blockSize)
+      : OpRewritePattern<mhlo::BatchNormInferenceOp>(context),
+        blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(mhlo::BatchNormInferenceOp op,
+                                PatternRewriter &rewriter) const override {
+    if (op->getParentOfType<mhlo::FusionOp>()) {
+      return failure();
+    }
+    Value source = getNCHWcSource(op.getOperand(), blockSize);
+    if (!source || op.getFeatureIndex() != 1) {
+      return failure();
+    }
+    auto paramType = dyn_cast<RankedTensorType>(op.getScale().getType());
+    if (!paramType || !paramType.hasStaticShape()) {
+      return failure();
+    }
+
+    // factor = scale / sqrt(variance + epsilon)
+    // bias = offset - mean * factor
+    Location loc = op->getLoc();
+    Value epsilon = rewriter.create<mhlo::ConstantOp>(
+        loc, DenseElementsAttr::get(
+                 paramType, rewriter.getFloatAttr(
+                                paramType.getElementType(),
+                                op.getEpsilonAttr().getValueAsDouble())));
+    Value variance =
+        rewriter.create<mhlo::AddOp>(loc, op.getVariance(), epsilon);
+    Value rsqrt = rewriter.create<mhlo::RsqrtOp>(loc, variance);
+    Value factor = rewriter.create<mhlo::MulOp>(loc, op.getScale(), rsqrt);
+    Value meanFactor = rewriter.create<mhlo::MulOp>(loc, op.getMean(), factor);
+    Value bias =
+        rewriter.create<mhlo::SubtractOp>(loc, op.getOffset(), meanFactor);
+
+    auto blockedType = cast<RankedTensorType>(source.getType());
+    Value mul = rewriter.create<mhlo::MulOp>(
+        loc, source,
+        createChannel2NCHWcValue(rewriter, loc, factor, blockedType));
+    Value add = rewriter.create<mhlo::AddOp>(
+        loc, mul, createChannel2NCHWcValue(rewriter, loc, bias, blockedType));
+    rewriter.replaceOp(op, createNCHWc2NCHWValue(rewriter, loc, add));
+    return success();
+  }
+  int64_t blockSize;
+};
+
 // return NamedLayout::UNKNOWN when there is no conv op in funcOp
 // or when there are different layout between conv ops in funcOp
 // return the input layout of conv op when there are conv op which have
@@ -712,10 +1185,18 @@ struct LayoutTransformationPass
       byteir::NamedLayout globalLayout = findGlobalLayout(funcOp);
       globalLayoutStr = stringifyEnum(globalLayout);
     }
+    bool isBlocked = parseNCHWcLayout(this->targetLayout).has_value();
     if (globalLayoutStr == "UNKNOWN") {
       funcOp.emitWarning("LayoutTransformationPass: global layout is unknown");
       return;
-    } else if (globalLayoutStr.size() != this->targetLayout.size()) {
+    } else if (isBlocked && globalLayoutStr != "NCHW") {
+      funcOp.emitWarning("LayoutTransformationPass only supports blocked "
+                         "target layout for global layout NCHW, the global "
+                         "layout is ")
+          << globalLayoutStr;
+      return;
+    } else if (!isBlocked &&
+               globalLayoutStr.size() != this->targetLayout.size()) {
       funcOp.emitWarning(
           "LayoutTransformationPass doesn't support that the dimension numbers "
           "of global layout and target layout are different. The global layout "
@@ -723,7 +1204,8 @@ struct LayoutTransformationPass
           << globalLayoutStr << ", the target layout is " << this->targetLayout;
       return;
     }
-    if (this->targetLayout != "NHWC" && this->targetLayout != "NDHWC") {
+    if (this->targetLayout != "NHWC" && this->targetLayout != "NDHWC" &&
+        !isBlocked) {
       funcOp.emitError(
           "LayoutTransformationPass doesn't support target layout: ")
           << this->targetLayout;
@@ -754,6 +1236,16 @@ void mlir::populateLayoutTransformationPattern(
     patterns.add<ConvLayoutTransformationNHWCPattern>(patterns.getContext(),
                                                       targetLayout);
   } else if (globalLayoutStr == "NCHW") {
+    if (auto blockSize = parseNCHWcLayout(targetLayout)) {
+      // clang-format off
+      patterns.add<ConvLayoutTransformationNCHWcPattern,
+                  ElementwiseLayoutTransformationNCHWcPattern,
+                  ReduceWindownLayoutTransformationNCHWcPattern,
+                  BatchNormInferenceLayoutTransformationNCHWcPattern>(patterns.getContext(),
+                                                          *blockSize);
+      // clang-format on
+      return;
+    }
     // clang-format off
     patterns.add<ConvLayoutTransformationNCHWPattern,
                 ConvBackwardLayoutTransformationPattern,
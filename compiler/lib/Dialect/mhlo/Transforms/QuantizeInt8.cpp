@@ -0,0 +1,270 @@
+//===- QuantizeInt8.cpp ---------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/mhlo/Transforms/QuantizeInt8.h"
+
+#include "mhlo/IR/hlo_ops.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "PassDetail.h"
+
+#include <cmath>
+#include <optional>
+
+using namespace mlir;
+
+namespace {
+
+constexpr float kInt8Max = 127.0f;
+
+struct QuantCandidate {
+  Operation *op;
+  // output channel dim of rhs and the corresponding dim of result, used for
+  // per-channel weight scales
+  std::optional<int64_t> rhsChannelDim;
+  std::optional<int64_t> resultChannelDim;
+};
+
+std::optional<QuantCandidate> getQuantCandidate(Operation *op) {
+  if (!isa<mhlo::DotOp, mhlo::DotGeneralOp, mhlo::ConvolutionOp>(op))
+    return std::nullopt;
+
+  Value lhs = op->getOperand(0), rhs = op->getOperand(1);
+  auto lhsType = dyn_cast<RankedTensorType>(lhs.getType());
+  auto rhsType = dyn_cast<RankedTensorType>(rhs.getType());
+  auto resultType = dyn_cast<RankedTensorType>(op->getResult(0).getType());
+  if (!lhsType || !rhsType || !resultType || !lhsType.hasStaticShape() ||
+      !rhsType.hasStaticShape() || !resultType.hasStaticShape())
+    return std::nullopt;
+  if (!lhsType.getElementType().isF32() || !rhsType.getElementType().isF32() ||
+      !resultType.getElementType().isF32())
+    return std::nullopt;
+
+  auto constOp = rhs.getDefiningOp<mhlo::ConstantOp>();
+  if (!constOp || !isa<DenseIntOrFPElementsAttr>(constOp.getValue()))
+    return std::nullopt;
+
+  QuantCandidate candidate{op, std::nullopt, std::nullopt};
+  if (isa<mhlo::DotOp>(op)) {
+    if (rhsType.getRank() == 2) {
+      candidate.rhsChannelDim = 1;
+      candidate.resultChannelDim = resultType.getRank() - 1;
+    }
+  } else if (auto dotGeneral = dyn_cast<mhlo::DotGeneralOp>(op)) {
+    auto dimNumbers = dotGeneral.getDotDimensionNumbers();
+    SmallVector<int64_t> rhsFreeDims;
+    for (int64_t i = 0; i < rhsType.getRank(); ++i) {
+      if (!llvm::is_contained(dimNumbers.getRhsContractingDimensions(), i) &&
+          !llvm::is_contained(dimNumbers.getRhsBatchingDimensions(), i))
+        rhsFreeDims.push_back(i);
+    }
+    // free dims of rhs are the trailing dims of result
+    if (rhsFreeDims.size() == 1 &&
+        dimNumbers.getRhsBatchingDimensions().empty()) {
+      candidate.rhsChannelDim = rhsFreeDims.front();
+      candidate.resultChannelDim = resultType.getRank() - 1;
+    }
+  } else if (auto conv = dyn_cast<mhlo::ConvolutionOp>(op)) {
+    auto dimNumbers = conv.getDimensionNumbers();
+    candidate.rhsChannelDim = dimNumbers.getKernelOutputFeatureDimension();
+    candidate.resultChannelDim = dimNumbers.getOutputFeatureDimension();
+  }
+  return candidate;
+}
+
+// Quantize a f32 weight symmetrically into int8, returning the quantized
+// weight and the scale of each channel (a single scale if per-tensor)
+DenseElementsAttr quantizeWeight(DenseElementsAttr weight,
+                                 std::optional<int64_t> channelDim,
+                                 SmallVectorImpl<float> &scales) {
+  auto type = cast<RankedTensorType>(weight.getType());
+  ArrayRef<int64_t> shape = type.getShape();
+  int64_t numChannels = channelDim ? shape[*channelDim] : 1;
+  int64_t stride = 1;
+  if (channelDim) {
+    for (int64_t i = *channelDim + 1; i < type.getRank(); ++i)
+      stride *= shape[i];
+  }
+  auto channelOf = [&](int64_t idx) -> int64_t {
+    return channelDim ? (idx / stride) % numChannels : 0;
+  };
+
+  SmallVector<float> values(weight.getValues<float>());
+  SmallVector<float> absMax(numChannels, 0.0f);
+  for (auto it : llvm::enumerate(values)) {
+    float &cur = absMax[channelOf(it.index())];
+    cur = std::max(cur, std::fabs(it.value()));
+  }
+
+  scales.clear();
+  for (float v : absMax)
+    scales.push_back(v > 0.0f ? v / kInt8Max : 1.0f);
+
+  SmallVector<int8_t> quantized;
+  quantized.reserve(values.size());
+  for (auto it : llvm::enumerate(values)) {
+    float q = std::nearbyint(it.value() / scales[channelOf(it.index())]);
+    quantized.push_back(
+        static_cast<int8_t>(std::min(std::max(q, -kInt8Max), kInt8Max)));
+  }
+  auto i8Type = type.clone(IntegerType::get(type.getContext(), 8));
+  return DenseElementsAttr::get(i8Type, ArrayRef<int8_t>(quantized));
+}
+
+Value createSplatConstant(OpBuilder &b, Location loc, RankedTensorType type,
+                          Attribute value) {
+  return b.create<mhlo::ConstantOp>(loc, DenseElementsAttr::get(type, value));
+}
+
+void quantizeCandidate(const QuantCandidate &candidate, float actAbsMax,
+                       bool perChannel) {
+  Operation *op = candidate.op;
+  OpBuilder b(op);
+  Location loc = op->getLoc();
+  MLIRContext *ctx = op->getContext();
+  Type f32 = Float32Type::get(ctx);
+  Type i8 = IntegerType::get(ctx, 8);
+  Type i32 = IntegerType::get(ctx, 32);
+
+  // quantize activation: clamp(round(x / scale), -128, 127)
+  Value lhs = op->getOperand(0);
+  auto lhsType = cast<RankedTensorType>(lhs.getType());
+  float actScale = actAbsMax / kInt8Max;
+  Value scaled = b.create<mhlo::MulOp>(
+      loc, lhs,
+      createSplatConstant(b, loc, lhsType, b.getF32FloatAttr(1.0f / actScale)));
+  Value rounded = b.create<mhlo::RoundNearestEvenOp>(loc, scaled);
+  auto scalarType = RankedTensorType::get({}, f32);
+  Value minVal =
+      createSplatConstant(b, loc, scalarType, b.getF32FloatAttr(-128.0f));
+  Value maxVal =
+      createSplatConstant(b, loc, scalarType, b.getF32FloatAttr(kInt8Max));
+  Value clamped = b.create<mhlo::ClampOp>(loc, minVal, rounded, maxVal);
+  Value lhsQuant = b.create<mhlo::ConvertOp>(loc, clamped, i8);
+
+  // quantize weight at compile time
+  auto constOp = op->getOperand(1).getDefiningOp<mhlo::ConstantOp>();
+  std::optional<int64_t> rhsChannelDim =
+      perChannel ? candidate.rhsChannelDim : std::nullopt;
+  SmallVector<float> weightScales;
+  DenseElementsAttr weightQuant = quantizeWeight(
+      cast<DenseElementsAttr>(constOp.getValue()), rhsChannelDim, weightScales);
+  Value rhsQuant = b.create<mhlo::ConstantOp>(loc, weightQuant);
+
+  // int8 x int8 -> int32
+  auto resultType = cast<RankedTensorType>(op->getResult(0).getType());
+  Operation *quantOp = b.clone(*op);
+  quantOp->setOperand(0, lhsQuant);
+  quantOp->setOperand(1, rhsQuant);
+  quantOp->getResult(0).setType(resultType.clone(i32));
+
+  // dequantize: convert(int32) * (actScale * weightScale)
+  Value dequant = b.create<mhlo::ConvertOp>(loc, quantOp->getResult(0), f32);
+  Value scale;
+  if (rhsChannelDim) {
+    SmallVector<float> outScales;
+    for (float s : weightScales)
+      outScales.push_back(actScale * s);
+    auto scaleType =
+        RankedTensorType::get({static_cast<int64_t>(outScales.size())}, f32);
+    Value scale1d = b.create<mhlo::ConstantOp>(
+        loc, DenseElementsAttr::get(scaleType, ArrayRef<float>(outScales)));
+    scale = b.create<mhlo::BroadcastInDimOp>(
+        loc, resultType, scale1d,
+        b.getI64TensorAttr({*candidate.resultChannelDim}));
+  } else {
+    scale = createSplatConstant(b, loc, resultType,
+                                b.getF32FloatAttr(actScale * weightScales[0]));
+  }
+  Value result = b.create<mhlo::MulOp>(loc, dequant, scale);
+
+  op->getResult(0).replaceAllUsesWith(result);
+  op->erase();
+  if (constOp->use_empty())
+    constOp->erase();
+}
+
+void appendActivationsToResults(func::FuncOp funcOp,
+                                ArrayRef<QuantCandidate> candidates) {
+  SmallVector<Value> activations;
+  for (auto &candidate : candidates)
+    activations.push_back(candidate.op->getOperand(0));
+  if (activations.empty())
+    return;
+
+  funcOp.walk([&](func::ReturnOp retOp) {
+    retOp->insertOperands(retOp->getNumOperands(), activations);
+  });
+
+  FunctionType funcType = funcOp.getFunctionType();
+  SmallVector<Type> resultTypes(funcType.getResults());
+  for (Value v : activations)
+    resultTypes.push_back(v.getType());
+  funcOp.setType(FunctionType::get(funcOp.getContext(), funcType.getInputs(),
+                                   resultTypes));
+
+  if (ArrayAttr resAttrs = funcOp.getResAttrsAttr()) {
+    SmallVector<Attribute> newResAttrs(resAttrs.getValue());
+    newResAttrs.append(activations.size(),
+                       DictionaryAttr::get(funcOp.getContext()));
+    funcOp.setResAttrsAttr(ArrayAttr::get(funcOp.getContext(), newResAttrs));
+  }
+}
+
+struct QuantizeInt8Pass : public QuantizeInt8Base<QuantizeInt8Pass> {
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+    auto funcOp = moduleOp.lookupSymbol<func::FuncOp>(entryFuncName);
+    if (!funcOp) {
+      moduleOp.emitError() << "entry function " << entryFuncName
+                           << " not found";
+      return signalPassFailure();
+    }
+
+    SmallVector<QuantCandidate> candidates;
+    funcOp.walk([&](Operation *op) {
+      if (auto candidate = getQuantCandidate(op))
+        candidates.push_back(*candidate);
+    });
+
+    if (exposeActivations) {
+      appendActivationsToResults(funcOp, candidates);
+      return;
+    }
+
+    for (auto it : llvm::enumerate(candidates)) {
+      if (it.index() >= actAbsMax.size())
+        break;
+      float absMax = static_cast<float>(actAbsMax[it.index()]);
+      if (!(absMax > 0.0f) || !std::isfinite(absMax))
+        continue;
+      quantizeCandidate(it.value(), absMax, perChannel);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> mlir::createQuantizeInt8Pass() {
+  return std::make_unique<QuantizeInt8Pass>();
+}
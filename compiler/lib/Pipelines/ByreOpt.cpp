@@ -36,26 +36,49 @@ using namespace mlir::byre;
 namespace {
 
 void createByreOptPipelineImpl(OpPassManager &pm, const std::string &entryFunc,
-                               bool appendArgTypes,
-                               bool disableMemoryPlanning) {
+                               bool appendArgTypes, bool disableMemoryPlanning,
+                               bool enableInPlaceConcatSlice,
+                               bool enableSessionInitHoisting,
+                               bool enableAsyncCollectives,
+                               bool enableOpDependency, int64_t numaStages) {
   pm.addPass(createFuncTagPass(
       /*anchorTag=*/"",
       getAttrPlaceholderName(ByreDialect::getEntryPointFunctionAttrName()),
       entryFunc));
 
+  // merge byte-identical constants before they become weights
+  pm.addPass(createDedupGlobalConstantPass());
   pm.addPass(createConvertFuncAndCallToByrePass(appendArgTypes));
 
   // remove copy
   pm.addNestedPass<func::FuncOp>(createRemoveCopyPass());
+  // write concat operands and read slices in place
+  if (enableInPlaceConcatSlice) {
+    pm.addNestedPass<func::FuncOp>(createInPlaceConcatSlicePass());
+  }
+
+  // evaluate weight-only computes once per session
+  if (enableSessionInitHoisting) {
+    pm.addPass(createSessionInitHoistingPass());
+  }
+
+  // split collectives into start and wait before their buffers get reused
+  if (enableAsyncCollectives) {
+    pm.addNestedPass<func::FuncOp>(createAsyncCollectivesPass());
+  }
 
   // only applied on entry point function
   OpPassManager anchoredPM(func::FuncOp::getOperationName());
   if (!disableMemoryPlanning) {
-    // underlying memory of constant op cannot be reused
-    anchoredPM.addPass(createMemoryPlanningPass(/* alignment */ 128,
-                                                /* alloca */ false,
-                                                /* memory space */ 0,
-                                                /* callback */ nullptr));
+    // underlying memory of constant op cannot be reused, neither can
+    // session-internal buffers which outlive a single request
+    anchoredPM.addPass(createMemoryPlanningPass(
+        /* alignment */ 128, /* alloca */ false, /* memory space */ 0,
+        /* callback */ [](Value v) {
+          auto defOp = v.getDefiningOp();
+          return !defOp ||
+                 !defOp->hasAttr(ByreDialect::getSessionInitAttrName());
+        }));
     anchoredPM.addPass(createCanonicalizerPass());
   }
   anchoredPM.addPass(createConvertMemrefToByrePass());
@@ -65,6 +88,16 @@ void createByreOptPipelineImpl(OpPassManager &pm, const std::string &entryFunc,
       ByreDialect::getEntryPointFunctionAttrName(), anchoredPM));
 
   pm.addPass(createCSEPass());
+
+  // annotate dependencies once aliasing of planned buffers is final
+  if (enableOpDependency) {
+    pm.addNestedPass<func::FuncOp>(createOpDependencyPass());
+  }
+
+  // pin contiguous stages of balanced cost to numa nodes
+  if (numaStages > 1) {
+    pm.addNestedPass<func::FuncOp>(createNumaStagePass(numaStages));
+  }
 }
 } // namespace
 
@@ -72,5 +105,9 @@ void mlir::createByreOptPipeline(OpPassManager &pm,
                                  const ByreOptPipelineOptions &options) {
   invokeOpPassPipelineBuilder(createByreOptPipelineImpl, pm, options.entryFunc,
                               options.appendArgTypes,
-                              options.disableMemoryPlanning);
+                              options.disableMemoryPlanning,
+                              options.enableInPlaceConcatSlice,
+                              options.enableSessionInitHoisting,
+                              options.enableAsyncCollectives,
+                              options.enableOpDependency, options.numaStages);
 }
\ No newline at end of file
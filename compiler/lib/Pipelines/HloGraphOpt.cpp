@@ -33,7 +33,8 @@ using namespace mlir;
 namespace {
 void createHloGraphOptPipelineImpl(OpPassManager &pm,
                                    const std::string &entryFunc,
-                                   const std::string &target) {
+                                   const std::string &target,
+                                   const std::string &convLayout) {
   pm.addPass(createInlinerPass());
   pm.addPass(createCanonicalizerPass());
 
@@ -58,6 +59,13 @@ void createHloGraphOptPipelineImpl(OpPassManager &pm,
     pm.addNestedPass<func::FuncOp>(
         createDecomposeMhloCustomCallOpsPass(/*legalOps=*/{}));
     pm.addPass(createCanonicalizerPass());
+
+    // transform convolutions to a blocked layout, e.g. NCHW8c
+    if (!convLayout.empty()) {
+      pm.addNestedPass<func::FuncOp>(
+          createLayoutTransformationPass(convLayout));
+      pm.addPass(createCanonicalizerPass());
+    }
   }
 
   // convert mhlo.rng to mhlo.custom_call
@@ -76,5 +84,6 @@ void createHloGraphOptPipelineImpl(OpPassManager &pm,
 void mlir::createHloGraphOptPipeline(
     OpPassManager &pm, const HloGraphOptPipelineOptions &options) {
   invokeOpPassPipelineBuilder(createHloGraphOptPipelineImpl, pm,
-                              options.entryFunc, options.target);
+                              options.entryFunc, options.target,
+                              options.convLayout);
 }
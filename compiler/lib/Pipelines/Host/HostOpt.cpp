@@ -18,6 +18,7 @@
 #include "byteir/Pipelines/Host/HostOpt.h"
 
 #include "byteir/Conversion/ToLLVM/ToLLVM.h"
+#include "byteir/Dialect/SCF/Transforms/SoftwarePrefetch.h"
 #include "byteir/Pipelines/Common/Utils.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -25,7 +26,16 @@
 using namespace mlir;
 
 namespace {
-void createHostOptPipelineImpl(OpPassManager &pm, const std::string &fileName) {
+void createHostOptPipelineImpl(OpPassManager &pm, const std::string &fileName,
+                               bool enableKernelMerge, bool enablePrefetch,
+                               int64_t prefetchDistance) {
+  if (enableKernelMerge) {
+    pm.addPass(createMergeHostKernelsPass());
+  }
+  if (enablePrefetch) {
+    pm.addNestedPass<func::FuncOp>(
+        createSoftwarePrefetchPass(/*anchorTag=*/"", prefetchDistance));
+  }
   pm.addNestedPass<func::FuncOp>(createGenLLVMConfigPass(fileName));
   pm.addPass(createCollectFuncToLLVMPass());
 }
@@ -33,5 +43,7 @@ void createHostOptPipelineImpl(OpPassManager &pm, const std::string &fileName) {
 
 void mlir::createHostOptPipeline(OpPassManager &pm,
                                  const HostOptPipelineOptions &options) {
-  invokeOpPassPipelineBuilder(createHostOptPipelineImpl, pm, options.fileName);
+  invokeOpPassPipelineBuilder(createHostOptPipelineImpl, pm, options.fileName,
+                              options.enableKernelMerge, options.enablePrefetch,
+                              options.prefetchDistance);
 }
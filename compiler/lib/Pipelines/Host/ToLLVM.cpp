@@ -76,9 +76,10 @@ struct CollectLLVMSubmodulePass
 };
 } // namespace
 
-void mlir::createToLLVMPipeline(OpPassManager &pm) {
+void mlir::createToLLVMPipeline(OpPassManager &pm,
+                                const ToLLVMPipelineOptions &options) {
   invokeOpPassPipelineBuilder(
-      [](OpPassManager &pm) {
+      [](OpPassManager &pm, bool emulateBF16) {
         pm.addPass(std::make_unique<CollectLLVMSubmodulePass>());
         {
           // vector lowerings
@@ -96,7 +97,11 @@ void mlir::createToLLVMPipeline(OpPassManager &pm) {
         }
         pm.addNestedPass<func::FuncOp>(createConvertSCFToCFPass());
         pm.addPass(createCanonicalizerPass());
-        pm.addPass(arith::createArithExpandOpsPass());
+        {
+          arith::ArithExpandOpsOptions expandOptions;
+          expandOptions.includeBf16 = emulateBF16;
+          pm.addPass(arith::createArithExpandOpsPass(expandOptions));
+        }
         pm.addPass(memref::createExpandStridedMetadataPass());
         pm.addPass(createLowerAffinePass());
         {
@@ -112,5 +117,5 @@ void mlir::createToLLVMPipeline(OpPassManager &pm) {
 
         pm.addPass(createCanonicalizerPass());
       },
-      pm);
+      pm, options.emulateBF16);
 }
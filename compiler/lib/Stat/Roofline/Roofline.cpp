@@ -0,0 +1,655 @@
+//===- Roofline.cpp -------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Stat/Roofline/Roofline.h"
+
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Stat/Common/Reg.h"
+#include "mhlo/IR/hlo_ops.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Interfaces/CastInterfaces.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FormatVariadic.h"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+using namespace byteir;
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+// Polynomial over symbols of dynamic dimensions with integer coefficients,
+// e.g. 128*s0*s1 + 64
+class SymbolicCount {
+public:
+  SymbolicCount(int64_t value = 0) {
+    if (value != 0)
+      terms[{}] = value;
+  }
+
+  static SymbolicCount symbol(StringRef name) {
+    SymbolicCount count;
+    count.terms[{name.str()}] = 1;
+    return count;
+  }
+
+  SymbolicCount &operator+=(const SymbolicCount &other) {
+    for (auto &term : other.terms)
+      addTerm(term.first, term.second);
+    return *this;
+  }
+
+  friend SymbolicCount operator+(SymbolicCount lhs, const SymbolicCount &rhs) {
+    lhs += rhs;
+    return lhs;
+  }
+
+  friend SymbolicCount operator*(const SymbolicCount &lhs,
+                                 const SymbolicCount &rhs) {
+    SymbolicCount result;
+    for (auto &l : lhs.terms) {
+      for (auto &r : rhs.terms) {
+        Monomial monomial(l.first);
+        monomial.insert(monomial.end(), r.first.begin(), r.first.end());
+        llvm::sort(monomial);
+        result.addTerm(monomial, l.second * r.second);
+      }
+    }
+    return result;
+  }
+
+  bool isZero() const { return terms.empty(); }
+
+  /// Returns the value if every symbol could be substituted by
+  /// `dynamicDimSize`, i.e. there is no symbol or it is positive.
+  std::optional<double> evaluate(int64_t dynamicDimSize) const {
+    double result = 0;
+    for (auto &term : terms) {
+      if (!term.first.empty() && dynamicDimSize <= 0)
+        return std::nullopt;
+      double value = static_cast<double>(term.second);
+      for (size_t i = 0; i < term.first.size(); ++i)
+        value *= static_cast<double>(dynamicDimSize);
+      result += value;
+    }
+    return result;
+  }
+
+  void print(raw_ostream &os) const {
+    if (terms.empty()) {
+      os << 0;
+      return;
+    }
+    // higher degree first
+    bool first = true;
+    for (auto it = terms.rbegin(); it != terms.rend(); ++it) {
+      if (!first)
+        os << " + ";
+      first = false;
+      if (it->second != 1 || it->first.empty()) {
+        os << it->second;
+        if (!it->first.empty())
+          os << "*";
+      }
+      llvm::interleave(it->first, os, "*");
+    }
+  }
+
+private:
+  using Monomial = std::vector<std::string>;
+
+  void addTerm(const Monomial &monomial, int64_t coeff) {
+    int64_t &cur = terms[monomial];
+    cur += coeff;
+    if (cur == 0)
+      terms.erase(monomial);
+  }
+
+  std::map<Monomial, int64_t> terms;
+};
+
+raw_ostream &operator<<(raw_ostream &os, const SymbolicCount &count) {
+  count.print(os);
+  return os;
+}
+
+struct Cost {
+  SymbolicCount flops;
+  SymbolicCount bytesRead;
+  SymbolicCount bytesWritten;
+
+  Cost &operator+=(const Cost &other) {
+    flops += other.flops;
+    bytesRead += other.bytesRead;
+    bytesWritten += other.bytesWritten;
+    return *this;
+  }
+};
+
+int64_t getElementBytes(Type type) {
+  if (type.isIntOrFloat())
+    return llvm::divideCeil(type.getIntOrFloatBitWidth(), 8);
+  if (type.isIndex())
+    return 8;
+  if (auto complexType = dyn_cast<ComplexType>(type))
+    return 2 * getElementBytes(complexType.getElementType());
+  return 0;
+}
+
+// Names dynamic dimensions, which are `argN[d]` for arguments of functions,
+// shared by elementwise ops with their operands and fresh otherwise
+class DimSymbols {
+public:
+  SymbolicCount getDim(Value value, int64_t dim) {
+    auto type = cast<ShapedType>(value.getType());
+    if (!type.isDynamicDim(dim))
+      return type.getDimSize(dim);
+    return SymbolicCount::symbol(getSymbol(value, dim));
+  }
+
+  SymbolicCount getNumElements(Value value) {
+    auto type = dyn_cast<ShapedType>(value.getType());
+    if (!type || !type.hasRank())
+      return 0;
+    SymbolicCount result(1);
+    for (int64_t i = 0; i < type.getRank(); ++i)
+      result = result * getDim(value, i);
+    return result;
+  }
+
+  SymbolicCount getNumBytes(Value value) {
+    auto type = dyn_cast<ShapedType>(value.getType());
+    if (!type)
+      return 0;
+    return getNumElements(value) * getElementBytes(type.getElementType());
+  }
+
+private:
+  std::string getSymbol(Value value, int64_t dim) {
+    auto key = std::make_pair(value, dim);
+    auto it = symbols.find(key);
+    if (it != symbols.end())
+      return it->second;
+
+    std::string name;
+    auto arg = dyn_cast<BlockArgument>(value);
+    Operation *defOp = value.getDefiningOp();
+    if (arg && isa<func::FuncOp>(arg.getOwner()->getParentOp())) {
+      name = formatv("arg{0}[{1}]", arg.getArgNumber(), dim);
+    } else if (defOp && defOp->getNumOperands() > 0 &&
+               (defOp->hasTrait<OpTrait::Elementwise>() ||
+                defOp->hasTrait<OpTrait::SameOperandsAndResultShape>()) &&
+               isDynamicDimOf(defOp->getOperand(0), dim)) {
+      name = getSymbol(defOp->getOperand(0), dim);
+    } else {
+      name = formatv("s{0}", numFreshSymbols++);
+    }
+    symbols[key] = name;
+    return name;
+  }
+
+  static bool isDynamicDimOf(Value value, int64_t dim) {
+    auto type = dyn_cast<ShapedType>(value.getType());
+    return type && type.hasRank() && dim < type.getRank() &&
+           type.isDynamicDim(dim);
+  }
+
+  DenseMap<std::pair<Value, int64_t>, std::string> symbols;
+  int64_t numFreshSymbols = 0;
+};
+
+class RooflineAnalysis {
+public:
+  explicit RooflineAnalysis(ModuleOp moduleOp) : symbolTable(moduleOp) {}
+
+  /// Returns the cost of `op`, or std::nullopt if `op` isn't modeled, e.g. it
+  /// moves no data or it is a region op whose nested ops should be visited.
+  std::optional<Cost> getOpCost(Operation *op);
+
+  /// Returns whether `op` is reported as a kernel, i.e. its bytes only count
+  /// its operands and results.
+  static bool isKernel(Operation *op) {
+    return isa<mhlo::FusionOp, func::CallOp, byre::ComputeOp>(op);
+  }
+
+  SymbolicCount getRegionFlops(Region &region);
+
+private:
+  Cost getBoundaryBytes(Operation *op);
+
+  SymbolicCount getLinalgFlops(linalg::LinalgOp linalgOp);
+
+  SymbolicCount getByreComputeFlops(byre::ComputeOp computeOp);
+
+  SymbolTable symbolTable;
+  DimSymbols dims;
+  SmallPtrSet<Operation *, 4> callStack;
+};
+
+// number of scalar arithmetic ops of a payload, i.e. FLOPs per iteration
+int64_t getNumPayloadOps(Block &block) {
+  int64_t numOps = 0;
+  for (Operation &op : block) {
+    if (op.hasTrait<OpTrait::IsTerminator>() ||
+        op.hasTrait<OpTrait::ConstantLike>() || isa<CastOpInterface>(op) ||
+        isa<linalg::IndexOp>(op))
+      continue;
+    ++numOps;
+  }
+  return std::max<int64_t>(numOps, 1);
+}
+
+bool isShaped(Type type) { return isa<ShapedType>(type); }
+
+// whether `op` only allocates or frees buffers, e.g. memref.alloc
+bool isAllocOrFree(Operation *op) {
+  auto memEffect = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!memEffect)
+    return false;
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  memEffect.getEffects(effects);
+  return !effects.empty() && llvm::all_of(effects, [](auto &effect) {
+    return isa<MemoryEffects::Allocate, MemoryEffects::Free>(
+        effect.getEffect());
+  });
+}
+
+Cost RooflineAnalysis::getBoundaryBytes(Operation *op) {
+  Cost cost;
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  if (auto memEffect = dyn_cast<MemoryEffectOpInterface>(op))
+    memEffect.getEffects(effects);
+
+  for (Value operand : op->getOperands()) {
+    if (!isShaped(operand.getType()))
+      continue;
+    // tensors are read, buffers follow the memory effects
+    bool isRead = true, isWrite = false;
+    if (isa<MemRefType>(operand.getType())) {
+      bool hasRead = false;
+      for (auto &effect : effects) {
+        if (effect.getValue() != operand)
+          continue;
+        hasRead |= isa<MemoryEffects::Read>(effect.getEffect());
+        isWrite |= isa<MemoryEffects::Write>(effect.getEffect());
+      }
+      isRead = hasRead || !isWrite;
+    }
+    SymbolicCount bytes = dims.getNumBytes(operand);
+    if (isRead)
+      cost.bytesRead += bytes;
+    if (isWrite)
+      cost.bytesWritten += bytes;
+  }
+  for (Value result : op->getResults()) {
+    if (isShaped(result.getType()))
+      cost.bytesWritten += dims.getNumBytes(result);
+  }
+  return cost;
+}
+
+SymbolicCount RooflineAnalysis::getLinalgFlops(linalg::LinalgOp linalgOp) {
+  // size of the iteration space, dynamic loops take the symbol of the first
+  // operand dimension indexed by them
+  SmallVector<int64_t> staticLoopRanges = linalgOp.getStaticLoopRanges();
+  SymbolicCount iterations(1);
+  for (auto it : llvm::enumerate(staticLoopRanges)) {
+    if (!ShapedType::isDynamic(it.value())) {
+      iterations = iterations * it.value();
+      continue;
+    }
+    std::optional<SymbolicCount> loopSize;
+    for (OpOperand &operand : linalgOp->getOpOperands()) {
+      AffineMap map = linalgOp.getMatchingIndexingMap(&operand);
+      for (auto expr : llvm::enumerate(map.getResults())) {
+        auto dimExpr = dyn_cast<AffineDimExpr>(expr.value());
+        if (!loopSize && dimExpr && dimExpr.getPosition() == it.index())
+          loopSize = dims.getDim(operand.get(), expr.index());
+      }
+    }
+    iterations = iterations * loopSize.value_or(SymbolicCount(1));
+  }
+  return iterations * getNumPayloadOps(*linalgOp.getBlock());
+}
+
+SymbolicCount RooflineAnalysis::getByreComputeFlops(byre::ComputeOp computeOp) {
+  SmallVector<Value> inputs, outputs;
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  cast<MemoryEffectOpInterface>(computeOp.getOperation()).getEffects(effects);
+  for (Value operand : computeOp.getOperands()) {
+    bool isWrite = llvm::any_of(effects, [&](auto &effect) {
+      return effect.getValue() == operand &&
+             isa<MemoryEffects::Write>(effect.getEffect());
+    });
+    if (isShaped(operand.getType()))
+      (isWrite ? outputs : inputs).push_back(operand);
+  }
+
+  SymbolicCount outElements;
+  for (Value output : outputs)
+    outElements += dims.getNumElements(output);
+
+  // matmuls take 2*K FLOPs per output element, other kernels are estimated
+  // by one FLOP per output element
+  if (computeOp.getCallee().contains("Matmul") && !inputs.empty()) {
+    auto lhsType = cast<ShapedType>(inputs.front().getType());
+    int64_t contractingDim = lhsType.getRank() - 1;
+    if (auto attr =
+            computeOp->getAttrOfType<IntegerAttr>("lhs_contracting_dimension"))
+      contractingDim = attr.getInt();
+    if (contractingDim >= 0 && contractingDim < lhsType.getRank())
+      return outElements * dims.getDim(inputs.front(), contractingDim) * 2;
+  }
+  return outElements;
+}
+
+SymbolicCount RooflineAnalysis::getRegionFlops(Region &region) {
+  SymbolicCount flops;
+  region.walk<WalkOrder::PreOrder>([&](Operation *op) {
+    auto cost = getOpCost(op);
+    if (!cost)
+      return WalkResult::advance();
+    flops += cost->flops;
+    return WalkResult::skip();
+  });
+  return flops;
+}
+
+std::optional<Cost> RooflineAnalysis::getOpCost(Operation *op) {
+  if (isa<func::FuncOp, byre::AliasOp, mhlo::ReshapeOp, mhlo::DynamicReshapeOp,
+          tensor::EmptyOp, ViewLikeOpInterface>(op) ||
+      op->hasTrait<OpTrait::ConstantLike>() ||
+      op->hasTrait<OpTrait::IsTerminator>() ||
+      isAllocOrFree(op))
+    return std::nullopt;
+  if (llvm::none_of(op->getOperandTypes(), isShaped) &&
+      llvm::none_of(op->getResultTypes(), isShaped))
+    return std::nullopt;
+
+  Cost cost = getBoundaryBytes(op);
+
+  // kernels
+  if (auto fusionOp = dyn_cast<mhlo::FusionOp>(op)) {
+    cost.flops = getRegionFlops(fusionOp.getFusedComputation());
+    return cost;
+  }
+  if (auto callOp = dyn_cast<func::CallOp>(op)) {
+    auto callee = symbolTable.lookup<func::FuncOp>(callOp.getCallee());
+    if (callee && !callee.isExternal() && callStack.insert(callee).second) {
+      cost.flops = getRegionFlops(callee.getBody());
+      callStack.erase(callee);
+    }
+    return cost;
+  }
+  if (auto computeOp = dyn_cast<byre::ComputeOp>(op)) {
+    cost.flops = getByreComputeFlops(computeOp);
+    return cost;
+  }
+
+  // linalg ops carry their payload, inits are read only if the payload uses
+  // them
+  if (auto linalgOp = dyn_cast<linalg::LinalgOp>(op)) {
+    cost = Cost();
+    for (OpOperand *input : linalgOp.getDpsInputOperands())
+      cost.bytesRead += dims.getNumBytes(input->get());
+    for (OpOperand &init : linalgOp.getDpsInitsMutable()) {
+      if (linalgOp.payloadUsesValueFromOperand(&init))
+        cost.bytesRead += dims.getNumBytes(init.get());
+      cost.bytesWritten += dims.getNumBytes(init.get());
+    }
+    cost.flops = getLinalgFlops(linalgOp);
+    return cost;
+  }
+
+  // mhlo compute ops
+  if (auto dotOp = dyn_cast<mhlo::DotOp>(op)) {
+    auto lhsType = cast<ShapedType>(dotOp.getLhs().getType());
+    cost.flops = dims.getNumElements(dotOp.getResult()) *
+                 dims.getDim(dotOp.getLhs(), lhsType.getRank() - 1) * 2;
+    return cost;
+  }
+  if (auto dotGeneralOp = dyn_cast<mhlo::DotGeneralOp>(op)) {
+    SymbolicCount contractingSize(1);
+    for (int64_t dim : dotGeneralOp.getDotDimensionNumbers()
+                           .getLhsContractingDimensions())
+      contractingSize = contractingSize * dims.getDim(dotGeneralOp.getLhs(), dim);
+    cost.flops =
+        dims.getNumElements(dotGeneralOp.getResult()) * contractingSize * 2;
+    return cost;
+  }
+  if (auto convOp = dyn_cast<mhlo::ConvolutionOp>(op)) {
+    // each output element accumulates over the kernel except its output
+    // feature dimension
+    int64_t outFeatureDim =
+        convOp.getDimensionNumbers().getKernelOutputFeatureDimension();
+    auto rhsType = cast<ShapedType>(convOp.getRhs().getType());
+    SymbolicCount kernelSize(1);
+    for (int64_t i = 0; i < rhsType.getRank(); ++i) {
+      if (i != outFeatureDim)
+        kernelSize = kernelSize * dims.getDim(convOp.getRhs(), i);
+    }
+    cost.flops = dims.getNumElements(convOp.getResult()) * kernelSize * 2;
+    return cost;
+  }
+  if (auto reduceOp = dyn_cast<mhlo::ReduceOp>(op)) {
+    cost.flops = dims.getNumElements(reduceOp.getInputs().front()) *
+                 getNumPayloadOps(reduceOp.getBody().front());
+    return cost;
+  }
+  if (auto reduceWindowOp = dyn_cast<mhlo::ReduceWindowOp>(op)) {
+    int64_t windowSize = 1;
+    for (int64_t size : reduceWindowOp.getWindowDimensions())
+      windowSize *= size;
+    cost.flops = dims.getNumElements(reduceWindowOp->getResult(0)) *
+                 windowSize *
+                 getNumPayloadOps(reduceWindowOp.getBody().front());
+    return cost;
+  }
+  if (op->hasTrait<OpTrait::Elementwise>() && !isa<mhlo::ConvertOp>(op) &&
+      !isa<CastOpInterface>(op) && op->getNumResults() == 1) {
+    cost.flops = dims.getNumElements(op->getResult(0));
+    return cost;
+  }
+
+  // region ops, e.g. loops, are visited through their nested ops
+  if (op->getNumRegions() > 0)
+    return std::nullopt;
+
+  // data movement, e.g. transpose, slice, concatenate and copy
+  return cost;
+}
+
+//===----------------------------------------------------------------------===//
+// Report
+//===----------------------------------------------------------------------===//
+
+struct Entry {
+  unsigned count = 0;
+  Cost cost;
+  // sum of roofline time of each op, which is std::nullopt if symbolic
+  std::optional<double> timeUs = 0.0;
+};
+
+struct Reporter {
+  const MachineProfile &machine;
+  int64_t dynamicDimSize;
+
+  // returns roofline time in us of `cost`
+  std::optional<double> getTimeUs(const Cost &cost) const {
+    auto flops = cost.flops.evaluate(dynamicDimSize);
+    auto bytes =
+        (cost.bytesRead + cost.bytesWritten).evaluate(dynamicDimSize);
+    if (!flops || !bytes)
+      return std::nullopt;
+    return std::max(*flops / (machine.peakGFlops * 1e3),
+                    *bytes / (machine.peakBandwidth * 1e3));
+  }
+
+  void add(Entry &entry, const Cost &cost) const {
+    entry.count += 1;
+    entry.cost += cost;
+    auto time = getTimeUs(cost);
+    if (entry.timeUs && time)
+      *entry.timeUs += *time;
+    else
+      entry.timeUs = std::nullopt;
+  }
+
+  void printRow(raw_ostream &os, StringRef name, const Entry &entry,
+                bool printCount) const {
+    const Cost &cost = entry.cost;
+    os << name << "\t";
+    if (printCount)
+      os << entry.count << "\t";
+    os << cost.flops << "\t" << cost.bytesRead << "\t" << cost.bytesWritten
+       << "\t";
+    auto flops = cost.flops.evaluate(dynamicDimSize);
+    auto bytes =
+        (cost.bytesRead + cost.bytesWritten).evaluate(dynamicDimSize);
+    if (!flops || !bytes || !entry.timeUs) {
+      os << "symbolic\tsymbolic\tNA\n";
+      return;
+    }
+    double intensity = *bytes > 0 ? *flops / *bytes : 0.0;
+    double ridge = machine.peakGFlops / machine.peakBandwidth;
+    os << formatv("{0:F3}", intensity) << "\t"
+       << formatv("{0:F3}", *entry.timeUs) << "\t"
+       << (intensity >= ridge ? "compute" : "memory") << "\n";
+  }
+};
+
+LogicalResult statFunc(RooflineAnalysis &analysis, const Reporter &reporter,
+                       func::FuncOp funcOp, bool topOnly, raw_ostream &os) {
+  MapVector<StringRef, Entry> byOpType;
+  SmallVector<std::pair<std::string, Entry>> kernels;
+  Entry total;
+
+  auto visit = [&](Operation *op) {
+    auto cost = analysis.getOpCost(op);
+    if (!cost)
+      return WalkResult::advance();
+    reporter.add(byOpType[op->getName().getStringRef()], *cost);
+    reporter.add(total, *cost);
+    if (RooflineAnalysis::isKernel(op)) {
+      std::string name = op->getName().getStringRef().str();
+      if (auto callOp = dyn_cast<func::CallOp>(op))
+        name = callOp.getCallee().str();
+      else if (auto kernelName = op->getAttrOfType<StringAttr>("kernel_name"))
+        name = kernelName.str();
+      else if (auto computeOp = dyn_cast<byre::ComputeOp>(op))
+        name = computeOp.getCallee().str();
+      else
+        name += formatv("#{0}", kernels.size());
+      Entry entry;
+      reporter.add(entry, *cost);
+      kernels.emplace_back(name, entry);
+    }
+    return WalkResult::skip();
+  };
+
+  if (topOnly) {
+    for (Operation &op : funcOp.getOps())
+      visit(&op);
+  } else {
+    funcOp.getBody().walk<WalkOrder::PreOrder>(visit);
+  }
+
+  os << "---------- Function " << funcOp.getSymName() << " ----------\n";
+  os << "Operation Type \t Numbers \t FLOPs \t Bytes Read \t Bytes Written \t "
+        "Intensity \t Time (us) \t Bound\n";
+  SmallVector<StringRef> sorted(byOpType.keys());
+  llvm::sort(sorted);
+  for (StringRef opType : sorted)
+    reporter.printRow(os, opType, byOpType[opType], /*printCount=*/true);
+  reporter.printRow(os, "Total", total, /*printCount=*/true);
+
+  if (!kernels.empty()) {
+    os << "Kernel \t FLOPs \t Bytes Read \t Bytes Written \t Intensity \t "
+          "Time (us) \t Bound\n";
+    for (auto &kernel : kernels)
+      reporter.printRow(os, kernel.first, kernel.second, /*printCount=*/false);
+  }
+  return success();
+}
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// Roofline registration
+//===----------------------------------------------------------------------===//
+
+void byteir::registerRooflineStatistics() {
+  static llvm::cl::opt<double> peakGFlops(
+      "peak-gflops", llvm::cl::desc("Peak compute throughput in GFLOP/s"),
+      llvm::cl::init(MachineProfile().peakGFlops));
+
+  static llvm::cl::opt<double> peakBandwidth(
+      "peak-bandwidth", llvm::cl::desc("Peak memory bandwidth in GB/s"),
+      llvm::cl::init(MachineProfile().peakBandwidth));
+
+  static llvm::cl::opt<int64_t> dynamicDimSize(
+      "dynamic-dim-size",
+      llvm::cl::desc("Size of dynamic dimensions, counts are kept symbolic if "
+                     "not positive"),
+      llvm::cl::init(0));
+
+  MLIRStatRegistration reg(
+      "roofline", [](ModuleOp module, raw_ostream &output) {
+        MachineProfile machine;
+        machine.peakGFlops = peakGFlops;
+        machine.peakBandwidth = peakBandwidth;
+        return byteir::rooflineStatistics(
+            module, output, machine, MLIRStatRegistration::fucnName,
+            MLIRStatRegistration::topOnly, dynamicDimSize);
+      });
+}
+
+mlir::LogicalResult byteir::rooflineStatistics(ModuleOp moduleOp,
+                                               llvm::raw_ostream &os,
+                                               const MachineProfile &machine,
+                                               const std::string &funcName,
+                                               bool topOnly,
+                                               int64_t dynamicDimSize) {
+  if (machine.peakGFlops <= 0 || machine.peakBandwidth <= 0)
+    return moduleOp.emitError("peak GFLOPS and bandwidth must be positive");
+
+  RooflineAnalysis analysis(moduleOp);
+  Reporter reporter{machine, dynamicDimSize};
+  os << "========== Roofline Statistics ============\n";
+  os << "Peak GFLOPS \t " << machine.peakGFlops << " \t Peak Bandwidth (GB/s) \t "
+     << machine.peakBandwidth << " \t Ridge Point (FLOP/Byte) \t "
+     << formatv("{0:F3}", machine.peakGFlops / machine.peakBandwidth) << "\n";
+
+  for (func::FuncOp funcOp : moduleOp.getOps<func::FuncOp>()) {
+    if (funcOp.isExternal())
+      continue;
+    if (!funcName.empty() && funcOp.getSymName() != funcName)
+      continue;
+    if (failed(statFunc(analysis, reporter, funcOp, topOnly, os)))
+      return failure();
+  }
+  return success();
+}
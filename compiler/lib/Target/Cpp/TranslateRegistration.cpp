@@ -23,11 +23,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "byteir/Dialect/Byre/ByreDialect.h"
 #include "byteir/Target/Cpp/ToCpp.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/ControlFlow/IR/ControlFlowOps.h"
 #include "mlir/Dialect/EmitC/IR/EmitC.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -67,4 +69,37 @@ void byteir::registerToCppTranslation() {
                         scf::SCFDialect>();
         // clang-format on
       });
+
+  static llvm::cl::opt<std::string> aotEntryName(
+      "aot-entry-name",
+      llvm::cl::desc("Name of the entry function of standalone C++"),
+      llvm::cl::init("run"), llvm::cl::cat(CppCat));
+
+  auto registerStandaloneDialects = [](DialectRegistry &registry) {
+    // clang-format off
+    registry.insert<arith::ArithDialect,
+                    byre::ByreDialect,
+                    func::FuncDialect,
+                    math::MathDialect,
+                    memref::MemRefDialect,
+                    scf::SCFDialect>();
+    // clang-format on
+  };
+
+  TranslateFromMLIRRegistration aotReg(
+      "emit-cpp-aot", "translate from byre module to standalone cpp source",
+      [](ModuleOp module, raw_ostream &output) {
+        return byteir::translateToStandaloneCpp(
+            module, output, /*emitHeader=*/false, aotEntryName);
+      },
+      registerStandaloneDialects);
+
+  TranslateFromMLIRRegistration aotHeaderReg(
+      "emit-cpp-aot-header",
+      "translate from byre module to standalone cpp header",
+      [](ModuleOp module, raw_ostream &output) {
+        return byteir::translateToStandaloneCpp(
+            module, output, /*emitHeader=*/true, aotEntryName);
+      },
+      registerStandaloneDialects);
 }
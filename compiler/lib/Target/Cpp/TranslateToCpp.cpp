@@ -113,11 +113,17 @@ static LogicalResult checkMemRefType(MemRefType memrefType) {
     return failure();
   }
 
-  // Also disallow affine maps
+  // Only allow identity or static strided layouts
   // TODO extend it
   if (!memrefType.getLayout().isIdentity()) {
-    llvm::errs() << "<<MemRefType with affine maps is not supported>>";
-    return failure();
+    int64_t offset;
+    SmallVector<int64_t> strides;
+    if (failed(getStridesAndOffset(memrefType, strides, offset)) ||
+        ShapedType::isDynamic(offset) ||
+        llvm::any_of(strides, ShapedType::isDynamic)) {
+      llvm::errs() << "<<MemRefType with affine maps is not supported>>";
+      return failure();
+    }
   }
 
   return success();
@@ -128,10 +134,17 @@ static LogicalResult printMemRefAccess(CppEmitter &emitter, Value memref,
                                        Operation::operand_range indices) {
   raw_ostream &os = emitter.ostream();
 
+  // strided layouts are relative to the base pointer of the buffer, which
+  // views share with their source
+  int64_t offset = 0;
+  SmallVector<int64_t, 8> strides;
+  if (failed(getStridesAndOffset(memRefType, strides, offset)))
+    return failure();
+
   auto rank = memRefType.getRank();
   // early return if rank is 0, i.e. we are accessing an array of size
   // 1
-  if (rank == 0) {
+  if (rank == 0 && offset == 0) {
     os << "*" << emitter.getOrCreateName(memref);
     return success();
   }
@@ -140,14 +153,8 @@ static LogicalResult printMemRefAccess(CppEmitter &emitter, Value memref,
   RETURN_IF_FAILED(
       emitter.emitType(memref.getLoc(), memRefType.getElementType()));
   os << "*)" << emitter.getOrCreateName(memref);
-
-  // TODO add affine map support
-  auto shape = memRefType.getShape();
-  SmallVector<int64_t, 8> strides(rank);
-  strides[rank - 1] = 1;
-  for (int i = static_cast<int>(rank) - 2; i >= 0; i--) {
-    strides[i] = strides[i + 1] * static_cast<int64_t>(shape[i + 1]);
-  }
+  if (offset != 0)
+    os << " + " << offset;
 
   for (int i = 0; i < rank; i++) {
     auto idx = emitter.getOrCreateName(indices[i]);
@@ -0,0 +1,724 @@
+//===- TranslateToStandaloneCpp.cpp ---------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Dialect/Byre/ByreDialect.h"
+#include "byteir/Target/Cpp/CppEmitter.h"
+#include "byteir/Target/Cpp/ToCpp.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include "mlir/Support/IndentedOstream.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/FormatVariadic.h"
+
+#define DEBUG_TYPE "translate-to-standalone-cpp"
+
+using namespace byteir;
+using namespace mlir;
+using llvm::formatv;
+
+#define RETURN_IF_FAILED(call)                                                 \
+  if (failed(call)) {                                                          \
+    return failure();                                                          \
+  }
+
+namespace {
+
+// byre.compute callee of host kernels compiled from the nested llvm module
+constexpr StringRef kLLVMJITOpName = "LLVMJITOp";
+constexpr StringRef kKernelNameAttrName = "kernel_name";
+constexpr int64_t kBufferAlignment = 64;
+
+/// Emits a whole byre module, i.e. host kernels, constants, the memory plan
+/// and the entry function, as C++ source without any runtime dependency.
+class StandaloneCppEmitter : public CppEmitter {
+public:
+  StandaloneCppEmitter(raw_ostream &os, StringRef entryName)
+      : CppEmitter(os, /*declareVariablesAtTop=*/false), entryName(entryName) {}
+
+  LogicalResult emitOperation(Operation &op, bool trailingSemicolon) override;
+
+  LogicalResult emitSource(ModuleOp moduleOp);
+
+  LogicalResult emitHeader(ModuleOp moduleOp);
+
+  /// Binds `result` to an existing C++ expression, e.g. the base pointer of
+  /// the source of a view.
+  void bindName(Value result, StringRef name) {
+    valueMapper.insert(result, name.str());
+  }
+
+  StringRef getEntryName() { return entryName; }
+
+private:
+  std::string entryName;
+};
+
+std::string getGlobalName(StringRef symName) {
+  std::string name = "g_";
+  for (char c : symName)
+    name.push_back(llvm::isAlnum(c) ? c : '_');
+  return name;
+}
+
+func::FuncOp getEntryFunc(ModuleOp moduleOp) {
+  for (auto funcOp : moduleOp.getOps<func::FuncOp>()) {
+    if (funcOp->hasAttr(byre::ByreDialect::getEntryPointFunctionAttrName()))
+      return funcOp;
+  }
+  return nullptr;
+}
+
+std::optional<byre::EntryFuncArgType> getArgType(func::FuncOp funcOp,
+                                                 unsigned idx) {
+  auto attr = funcOp.getArgAttrOfType<byre::EntryFuncArgTypeAttr>(
+      idx, byre::ByreDialect::getEntryPointFuncArgTypeAttrName());
+  if (!attr)
+    return std::nullopt;
+  return attr.getValue();
+}
+
+bool isOutputArg(func::FuncOp funcOp, unsigned idx) {
+  auto argType = getArgType(funcOp, idx);
+  return argType &&
+         bitEnumContainsAll(*argType, byre::EntryFuncArgType::Output);
+}
+
+// value of a weight argument, which is compiled into the source instead of
+// being passed in `inputs`
+ElementsAttr getWeightValue(func::FuncOp funcOp, unsigned idx) {
+  auto argType = getArgType(funcOp, idx);
+  if (!argType ||
+      !bitEnumContainsAll(*argType, byre::EntryFuncArgType::Weight))
+    return nullptr;
+  return funcOp.getArgAttrOfType<ElementsAttr>(
+      idx, byre::ByreDialect::getEntryPointFuncArgWeightValueAttrName());
+}
+
+std::string getWeightName(unsigned idx) {
+  return "g_weight" + std::to_string(idx);
+}
+
+LogicalResult checkStaticMemRef(Location loc, Type type) {
+  auto memrefType = dyn_cast<MemRefType>(type);
+  if (!memrefType || !memrefType.hasStaticShape())
+    return emitError(loc, "expected memref with static shape, but got ")
+           << type;
+  return success();
+}
+
+// *((T*)name + offset + i0 * s0 + ...)
+LogicalResult printElement(StandaloneCppEmitter &emitter, Location loc,
+                           StringRef name, MemRefType type,
+                           ArrayRef<std::string> indices) {
+  raw_ostream &os = emitter.ostream();
+  int64_t offset;
+  SmallVector<int64_t> strides;
+  if (failed(getStridesAndOffset(type, strides, offset)) ||
+      ShapedType::isDynamic(offset) ||
+      llvm::any_of(strides, ShapedType::isDynamic))
+    return emitError(loc, "cannot emit access of memref type ") << type;
+
+  os << "*((";
+  RETURN_IF_FAILED(emitter.emitType(loc, type.getElementType()));
+  os << "*)" << name;
+  if (offset != 0)
+    os << " + " << offset;
+  for (auto it : llvm::zip(indices, strides))
+    os << " + " << std::get<0>(it) << " * " << std::get<1>(it);
+  os << ")";
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// Host kernels
+//===----------------------------------------------------------------------===//
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    memref::GlobalOp globalOp) {
+  raw_indented_ostream &os = emitter.ostream();
+  MemRefType type = globalOp.getType();
+  RETURN_IF_FAILED(checkStaticMemRef(globalOp.getLoc(), type));
+
+  os << "alignas(" << kBufferAlignment << ") static ";
+  if (globalOp.getConstant())
+    os << "const ";
+  RETURN_IF_FAILED(emitter.emitType(globalOp.getLoc(), type.getElementType()));
+  os << " " << getGlobalName(globalOp.getSymName()) << "["
+     << std::max<int64_t>(type.getNumElements(), 1) << "]";
+
+  auto initialValue = globalOp.getInitialValue();
+  if (initialValue && !isa<UnitAttr>(*initialValue)) {
+    auto dense = dyn_cast<DenseElementsAttr>(*initialValue);
+    if (!dense)
+      return globalOp.emitOpError("only dense initial values are supported");
+    os << " = ";
+    RETURN_IF_FAILED(emitter.emitAttribute(globalOp.getLoc(), dense));
+  }
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    memref::GetGlobalOp getGlobalOp) {
+  emitter.bindName(getGlobalOp.getResult(),
+                   getGlobalName(getGlobalOp.getName()));
+  return success();
+}
+
+// local buffers of host kernels live in static storage, same as the arena of
+// the entry function
+static LogicalResult printAlloc(StandaloneCppEmitter &emitter, Operation *op,
+                                bool isStatic) {
+  raw_indented_ostream &os = emitter.ostream();
+  Value result = op->getResult(0);
+  auto type = cast<MemRefType>(result.getType());
+  RETURN_IF_FAILED(checkStaticMemRef(op->getLoc(), type));
+  if (!type.getLayout().isIdentity())
+    return op->emitOpError("with non-identity layout is not supported");
+
+  os << "alignas(" << kBufferAlignment << ") ";
+  if (isStatic)
+    os << "static ";
+  RETURN_IF_FAILED(emitter.emitType(op->getLoc(), type.getElementType()));
+  os << " " << emitter.getOrCreateName(result) << "["
+     << std::max<int64_t>(type.getNumElements(), 1) << "]";
+  return success();
+}
+
+// views share the base pointer with their source, the offset and strides are
+// taken from the layout of the view at each access
+static LogicalResult printViewOp(StandaloneCppEmitter &emitter, Operation *op,
+                                 Value source) {
+  if (!emitter.hasValueInScope(source))
+    return op->emitOpError("source is not in scope");
+  emitter.bindName(op->getResult(0), emitter.getOrCreateName(source));
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    memref::CopyOp copyOp) {
+  raw_indented_ostream &os = emitter.ostream();
+  Location loc = copyOp.getLoc();
+  auto srcType = cast<MemRefType>(copyOp.getSource().getType());
+  auto dstType = cast<MemRefType>(copyOp.getTarget().getType());
+  RETURN_IF_FAILED(checkStaticMemRef(loc, srcType));
+  StringRef src = emitter.getOrCreateName(copyOp.getSource());
+  StringRef dst = emitter.getOrCreateName(copyOp.getTarget());
+
+  if (srcType.getLayout().isIdentity() && dstType.getLayout().isIdentity()) {
+    os << "std::memcpy(" << dst << ", " << src << ", "
+       << srcType.getNumElements() << " * sizeof(";
+    RETURN_IF_FAILED(emitter.emitType(loc, srcType.getElementType()));
+    os << "))";
+    return success();
+  }
+
+  // element-wise copy between strided views
+  SmallVector<std::string> indices;
+  for (auto it : llvm::enumerate(srcType.getShape())) {
+    std::string idx = formatv("i{0}", it.index());
+    os << "for (size_t " << idx << " = 0; " << idx << " < " << it.value()
+       << "; ++" << idx << ") ";
+    indices.push_back(idx);
+  }
+  RETURN_IF_FAILED(printElement(emitter, loc, dst, dstType, indices));
+  os << " = ";
+  return printElement(emitter, loc, src, srcType, indices);
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    memref::PrefetchOp prefetchOp) {
+  raw_indented_ostream &os = emitter.ostream();
+  SmallVector<std::string> indices;
+  for (Value idx : prefetchOp.getIndices())
+    indices.push_back(emitter.getOrCreateName(idx).str());
+  os << "BYTEIR_PREFETCH(&";
+  RETURN_IF_FAILED(printElement(
+      emitter, prefetchOp.getLoc(),
+      emitter.getOrCreateName(prefetchOp.getMemref()),
+      prefetchOp.getMemRefType(), indices));
+  os << ", " << (prefetchOp.getIsWrite() ? 1 : 0) << ", "
+     << prefetchOp.getLocalityHint() << ")";
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    arith::SelectOp selectOp) {
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*selectOp.getOperation()));
+  emitter.ostream() << emitter.getOrCreateName(selectOp.getCondition())
+                    << " ? " << emitter.getOrCreateName(selectOp.getTrueValue())
+                    << " : "
+                    << emitter.getOrCreateName(selectOp.getFalseValue());
+  return success();
+}
+
+static LogicalResult printExtIntOp(StandaloneCppEmitter &emitter, Operation *op,
+                                   bool isSigned) {
+  raw_indented_ostream &os = emitter.ostream();
+  Value input = op->getOperand(0);
+  auto inType = dyn_cast<IntegerType>(input.getType());
+  if (!inType)
+    return op->emitOpError("only scalar integers are supported");
+
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*op));
+  // sign-extending an i1 gives 0 or -1
+  if (isSigned && inType.getWidth() == 1)
+    os << "-";
+  os << "(";
+  RETURN_IF_FAILED(emitter.emitType(op->getLoc(), op->getResult(0).getType()));
+  os << ")";
+  if (!isSigned && inType.getWidth() != 1)
+    os << "(uint" << inType.getWidth() << "_t)";
+  os << emitter.getOrCreateName(input);
+  return success();
+}
+
+static LogicalResult printCallLikeOp(StandaloneCppEmitter &emitter,
+                                     Operation *op, StringRef callee) {
+  raw_indented_ostream &os = emitter.ostream();
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*op));
+  os << callee << "(";
+  llvm::interleaveComma(op->getOperands(), os, [&](Value operand) {
+    os << emitter.getOrCreateName(operand);
+  });
+  os << ")";
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    math::RsqrtOp rsqrtOp) {
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*rsqrtOp.getOperation()));
+  emitter.ostream() << "1 / std::sqrt("
+                    << emitter.getOrCreateName(rsqrtOp.getOperand()) << ")";
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    arith::NegFOp negOp) {
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*negOp.getOperation()));
+  emitter.ostream() << "-" << emitter.getOrCreateName(negOp.getOperand());
+  return success();
+}
+
+// integer min/max, unsigned ones compare through the unsigned type
+static LogicalResult printIntMinMaxOp(StandaloneCppEmitter &emitter,
+                                      Operation *op, StringRef cmp,
+                                      bool isUnsigned) {
+  raw_indented_ostream &os = emitter.ostream();
+  auto type = dyn_cast<IntegerType>(op->getResult(0).getType());
+  if (!type)
+    return op->emitOpError("only scalar integers are supported");
+  StringRef lhs = emitter.getOrCreateName(op->getOperand(0));
+  StringRef rhs = emitter.getOrCreateName(op->getOperand(1));
+  std::string cast =
+      isUnsigned ? formatv("(uint{0}_t)", type.getWidth()).str() : "";
+
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*op));
+  os << "(" << cast << lhs << " " << cmp << " " << cast << rhs << ") ? " << lhs
+     << " : " << rhs;
+  return success();
+}
+
+// maximumf/minimumf propagate NaN, unlike std::fmax/std::fmin
+static LogicalResult printFloatMinMaxOp(StandaloneCppEmitter &emitter,
+                                        Operation *op, StringRef callee,
+                                        bool propagateNaN) {
+  raw_indented_ostream &os = emitter.ostream();
+  StringRef lhs = emitter.getOrCreateName(op->getOperand(0));
+  StringRef rhs = emitter.getOrCreateName(op->getOperand(1));
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*op));
+  if (propagateNaN)
+    os << "std::isnan(" << lhs << ") || std::isnan(" << rhs << ") ? " << lhs
+       << " + " << rhs << " : ";
+  os << callee << "(" << lhs << ", " << rhs << ")";
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// Entry function
+//===----------------------------------------------------------------------===//
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    byre::AliasOp aliasOp) {
+  raw_indented_ostream &os = emitter.ostream();
+  Location loc = aliasOp.getLoc();
+  auto srcType = cast<MemRefType>(aliasOp.getSource().getType());
+  auto dstType = cast<MemRefType>(aliasOp.getTarget().getType());
+
+  RETURN_IF_FAILED(emitter.emitAssignPrefix(*aliasOp.getOperation()));
+  os << "(";
+  RETURN_IF_FAILED(emitter.emitType(loc, dstType));
+  os << ")((";
+  RETURN_IF_FAILED(emitter.emitType(loc, srcType));
+  os << ")" << emitter.getOrCreateName(aliasOp.getSource()) << " + "
+     << aliasOp.getOffset() << ")";
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    byre::CopyOp copyOp) {
+  raw_indented_ostream &os = emitter.ostream();
+  Location loc = copyOp.getLoc();
+  auto srcType = cast<MemRefType>(copyOp.getSource().getType());
+  RETURN_IF_FAILED(checkStaticMemRef(loc, srcType));
+  os << "std::memcpy(" << emitter.getOrCreateName(copyOp.getTarget()) << ", "
+     << emitter.getOrCreateName(copyOp.getSource()) << ", "
+     << srcType.getNumElements() << " * sizeof(";
+  RETURN_IF_FAILED(emitter.emitType(loc, srcType.getElementType()));
+  os << "))";
+  return success();
+}
+
+static LogicalResult printOperation(StandaloneCppEmitter &emitter,
+                                    byre::ComputeOp computeOp) {
+  if (computeOp.getCallee() != kLLVMJITOpName)
+    return computeOp.emitOpError("unsupported callee ")
+           << computeOp.getCallee() << " in standalone C++";
+  auto kernelName = computeOp->getAttrOfType<StringAttr>(kKernelNameAttrName);
+  if (!kernelName)
+    return computeOp.emitOpError("expected ") << kKernelNameAttrName;
+  return printCallLikeOp(emitter, computeOp, kernelName.getValue());
+}
+
+static LogicalResult printWeight(StandaloneCppEmitter &emitter,
+                                 BlockArgument arg, ElementsAttr value) {
+  raw_indented_ostream &os = emitter.ostream();
+  Location loc = arg.getOwner()->getParentOp()->getLoc();
+  auto type = cast<MemRefType>(arg.getType());
+  os << "alignas(" << kBufferAlignment << ") static const ";
+  if (auto dense = dyn_cast<DenseElementsAttr>(value)) {
+    RETURN_IF_FAILED(emitter.emitType(loc, type.getElementType()));
+    os << " " << getWeightName(arg.getArgNumber()) << "["
+       << std::max<int64_t>(type.getNumElements(), 1) << "] = ";
+    RETURN_IF_FAILED(emitter.emitAttribute(loc, dense));
+    os << ";\n";
+    return success();
+  }
+
+  // blobs hold the raw little-endian payload, which is emitted as bytes
+  auto resource = dyn_cast<DenseResourceElementsAttr>(value);
+  AsmResourceBlob *blob =
+      resource ? resource.getRawHandle().getBlob() : nullptr;
+  if (!blob)
+    return emitError(loc, "unsupported weight value of argument ")
+           << arg.getArgNumber();
+  ArrayRef<char> data = blob->getData();
+  os << "uint8_t " << getWeightName(arg.getArgNumber()) << "["
+     << std::max<size_t>(data.size(), 1) << "] = {";
+  llvm::interleaveComma(data, os, [&](char c) {
+    os << static_cast<unsigned>(static_cast<uint8_t>(c));
+  });
+  os << "};\n";
+  return success();
+}
+
+static LogicalResult printEntryFunc(StandaloneCppEmitter &emitter,
+                                    func::FuncOp funcOp) {
+  if (funcOp.getBlocks().size() != 1)
+    return funcOp.emitOpError("with multiple blocks is not supported");
+  if (funcOp.getNumResults() != 0)
+    return funcOp.emitOpError("with results is not supported");
+
+  CppEmitter::Scope scope(emitter);
+  raw_indented_ostream &os = emitter.ostream();
+  os << "extern \"C\" void " << emitter.getEntryName()
+     << "(const void *const *inputs, void *const *outputs) {\n";
+  os.indent();
+
+  // inputs come in `inputs`, outputs in `outputs`, both following the order
+  // of arguments. Weights with values were emitted as static arrays.
+  int64_t numInputs = 0, numOutputs = 0;
+  for (BlockArgument arg : funcOp.getArguments()) {
+    RETURN_IF_FAILED(checkStaticMemRef(funcOp.getLoc(), arg.getType()));
+    RETURN_IF_FAILED(emitter.emitType(funcOp.getLoc(), arg.getType()));
+    os << " " << emitter.getOrCreateName(arg) << " = (";
+    RETURN_IF_FAILED(emitter.emitType(funcOp.getLoc(), arg.getType()));
+    if (getWeightValue(funcOp, arg.getArgNumber()))
+      os << ")" << getWeightName(arg.getArgNumber()) << ";\n";
+    else if (isOutputArg(funcOp, arg.getArgNumber()))
+      os << ")outputs[" << numOutputs++ << "];\n";
+    else
+      os << ")inputs[" << numInputs++ << "];\n";
+  }
+
+  for (Operation &op : funcOp.getBody().front()) {
+    // the memory plan was emitted as static arena
+    if (isa<memref::AllocOp>(op))
+      continue;
+    RETURN_IF_FAILED(emitter.emitOperation(op, /*trailingSemicolon=*/true));
+  }
+  os.unindent() << "}\n";
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// Header
+//===----------------------------------------------------------------------===//
+
+void printArgComment(raw_ostream &os, StringRef name, Type type) {
+  auto memrefType = cast<MemRefType>(type);
+  os << "//   \"" << name << "\": " << memrefType.getElementType() << "[";
+  llvm::interleaveComma(memrefType.getShape(), os);
+  os << "]\n";
+}
+
+} // namespace
+
+LogicalResult StandaloneCppEmitter::emitOperation(Operation &op,
+                                                  bool trailingSemicolon) {
+  bool callEmitter = false;
+  bool earlyTerminate = false;
+  LogicalResult status =
+      llvm::TypeSwitch<Operation *, LogicalResult>(&op)
+          // MemRef ops
+          .Case<memref::GlobalOp, memref::CopyOp, memref::PrefetchOp>(
+              [&](auto op) { return printOperation(*this, op); })
+          .Case<memref::GetGlobalOp>([&](auto op) {
+            earlyTerminate = true;
+            return printOperation(*this, op);
+          })
+          .Case<memref::AllocOp>(
+              [&](auto op) { return printAlloc(*this, op, /*isStatic=*/true); })
+          .Case<memref::AllocaOp>([&](auto op) {
+            return printAlloc(*this, op, /*isStatic=*/false);
+          })
+          .Case<memref::CollapseShapeOp, memref::ExpandShapeOp,
+                memref::SubViewOp, memref::CastOp, memref::ReinterpretCastOp>(
+              [&](auto op) {
+                earlyTerminate = true;
+                return printViewOp(*this, op, op.getViewSource());
+              })
+          .Case<memref::DeallocOp>([&](auto) {
+            earlyTerminate = true;
+            return success();
+          })
+          // Arith ops
+          .Case<arith::SelectOp, arith::NegFOp>(
+              [&](auto op) { return printOperation(*this, op); })
+          .Case<arith::ExtUIOp>([&](auto op) {
+            return printExtIntOp(*this, op, /*isSigned=*/false);
+          })
+          .Case<arith::ExtSIOp>([&](auto op) {
+            return printExtIntOp(*this, op, /*isSigned=*/true);
+          })
+          .Case<arith::MaxSIOp>([&](auto op) {
+            return printIntMinMaxOp(*this, op, ">", /*isUnsigned=*/false);
+          })
+          .Case<arith::MinSIOp>([&](auto op) {
+            return printIntMinMaxOp(*this, op, "<", /*isUnsigned=*/false);
+          })
+          .Case<arith::MaxUIOp>([&](auto op) {
+            return printIntMinMaxOp(*this, op, ">", /*isUnsigned=*/true);
+          })
+          .Case<arith::MinUIOp>([&](auto op) {
+            return printIntMinMaxOp(*this, op, "<", /*isUnsigned=*/true);
+          })
+          .Case<arith::MaxNumFOp>([&](auto op) {
+            return printFloatMinMaxOp(*this, op, "std::fmax", false);
+          })
+          .Case<arith::MinNumFOp>([&](auto op) {
+            return printFloatMinMaxOp(*this, op, "std::fmin", false);
+          })
+          .Case<arith::MaximumFOp>([&](auto op) {
+            return printFloatMinMaxOp(*this, op, "std::fmax", true);
+          })
+          .Case<arith::MinimumFOp>([&](auto op) {
+            return printFloatMinMaxOp(*this, op, "std::fmin", true);
+          })
+          .Case<arith::RemFOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::fmod"); })
+          // Math ops
+          .Case<math::RsqrtOp>(
+              [&](auto op) { return printOperation(*this, op); })
+          .Case<math::AbsFOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::fabs"); })
+          .Case<math::CeilOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::ceil"); })
+          .Case<math::CosOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::cos"); })
+          .Case<math::ErfOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::erf"); })
+          .Case<math::ExpOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::exp"); })
+          .Case<math::FloorOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::floor"); })
+          .Case<math::FmaOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::fma"); })
+          .Case<math::Log1pOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::log1p"); })
+          .Case<math::LogOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::log"); })
+          .Case<math::PowFOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::pow"); })
+          .Case<math::RoundOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::round"); })
+          .Case<math::RoundEvenOp>([&](auto op) {
+            return printCallLikeOp(*this, op, "std::nearbyint");
+          })
+          .Case<math::SinOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::sin"); })
+          .Case<math::SqrtOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::sqrt"); })
+          .Case<math::TanhOp>(
+              [&](auto op) { return printCallLikeOp(*this, op, "std::tanh"); })
+          // Byre ops
+          .Case<byre::AliasOp, byre::CopyOp, byre::ComputeOp>(
+              [&](auto op) { return printOperation(*this, op); })
+          .Default([&](Operation *) {
+            callEmitter = true;
+            return success();
+          });
+
+  RETURN_IF_FAILED(status)
+  if (earlyTerminate)
+    return success();
+  if (callEmitter)
+    return CppEmitter::emitOperation(op, trailingSemicolon);
+  os << (trailingSemicolon ? ";\n" : "\n");
+  return success();
+}
+
+LogicalResult StandaloneCppEmitter::emitSource(ModuleOp moduleOp) {
+  func::FuncOp entryFunc = getEntryFunc(moduleOp);
+  if (!entryFunc)
+    return moduleOp.emitError("no byre entry function found");
+
+  CppEmitter::Scope scope(*this);
+  os << "// Generated by ByteIR, do not edit.\n"
+     << "#include <cmath>\n"
+     << "#include <cstddef>\n"
+     << "#include <cstdint>\n"
+     << "#include <cstring>\n\n"
+     << "#if defined(__GNUC__) || defined(__clang__)\n"
+     << "#define BYTEIR_PREFETCH(addr, rw, locality) "
+        "__builtin_prefetch(addr, rw, locality)\n"
+     << "#else\n"
+     << "#define BYTEIR_PREFETCH(addr, rw, locality) ((void)0)\n"
+     << "#endif\n\n"
+     << "namespace {\n\n";
+
+  // host kernels and their constants live in nested modules
+  SmallVector<ModuleOp> kernelModules(moduleOp.getOps<ModuleOp>());
+  for (ModuleOp kernelModule : kernelModules) {
+    for (auto globalOp : kernelModule.getOps<memref::GlobalOp>())
+      RETURN_IF_FAILED(emitOperation(*globalOp, /*trailingSemicolon=*/true));
+  }
+  os << "\n";
+  for (ModuleOp kernelModule : kernelModules) {
+    for (auto funcOp : kernelModule.getOps<func::FuncOp>()) {
+      RETURN_IF_FAILED(emitOperation(*funcOp, /*trailingSemicolon=*/false));
+      os << "\n";
+    }
+  }
+
+  // memory plan of the entry function
+  for (auto allocOp : entryFunc.getBody().getOps<memref::AllocOp>())
+    RETURN_IF_FAILED(emitOperation(*allocOp, /*trailingSemicolon=*/true));
+
+  for (BlockArgument arg : entryFunc.getArguments()) {
+    if (ElementsAttr value = getWeightValue(entryFunc, arg.getArgNumber())) {
+      RETURN_IF_FAILED(checkStaticMemRef(entryFunc.getLoc(), arg.getType()));
+      RETURN_IF_FAILED(printWeight(*this, arg, value));
+    }
+  }
+
+  os << "\n} // namespace\n\n";
+  return printEntryFunc(*this, entryFunc);
+}
+
+LogicalResult StandaloneCppEmitter::emitHeader(ModuleOp moduleOp) {
+  func::FuncOp entryFunc = getEntryFunc(moduleOp);
+  if (!entryFunc)
+    return moduleOp.emitError("no byre entry function found");
+
+  SmallVector<std::pair<StringRef, Type>> inputs, outputs;
+  for (BlockArgument arg : entryFunc.getArguments()) {
+    RETURN_IF_FAILED(checkStaticMemRef(entryFunc.getLoc(), arg.getType()));
+    auto nameAttr = entryFunc.getArgAttrOfType<StringAttr>(
+        arg.getArgNumber(),
+        byre::ByreDialect::getEntryPointFuncArgNameAttrName());
+    StringRef name = nameAttr ? nameAttr.getValue() : "";
+    if (getWeightValue(entryFunc, arg.getArgNumber()))
+      continue;
+    if (isOutputArg(entryFunc, arg.getArgNumber()))
+      outputs.emplace_back(name, arg.getType());
+    else
+      inputs.emplace_back(name, arg.getType());
+  }
+
+  std::string guard = "BYTEIR_AOT_" + StringRef(entryName).upper() + "_H";
+  os << "// Generated by ByteIR, do not edit.\n"
+     << "#ifndef " << guard << "\n"
+     << "#define " << guard << "\n\n"
+     << "#include <cstddef>\n\n";
+
+  // shapes are static, buffers are dense row-major
+  os << "// inputs:\n";
+  for (auto &input : inputs)
+    printArgComment(os, input.first, input.second);
+  os << "// outputs:\n";
+  for (auto &output : outputs)
+    printArgComment(os, output.first, output.second);
+  os << "// Not reentrant, intermediate buffers live in static storage.\n"
+     << "extern \"C\" void " << entryName
+     << "(const void *const *inputs, void *const *outputs);\n\n";
+
+  auto printMeta = [&](StringRef prefix,
+                       ArrayRef<std::pair<StringRef, Type>> args) {
+    os << "constexpr size_t k" << prefix << "Num = " << args.size() << ";\n";
+    if (args.empty())
+      return;
+    os << "constexpr const char *k" << prefix << "Names[] = {";
+    llvm::interleaveComma(args, os, [&](auto &arg) {
+      os << "\"" << arg.first << "\"";
+    });
+    os << "};\n"
+       << "constexpr size_t k" << prefix << "Bytes[] = {";
+    llvm::interleaveComma(args, os, [&](auto &arg) {
+      auto type = cast<MemRefType>(arg.second);
+      os << type.getNumElements() *
+                llvm::divideCeil(type.getElementTypeBitWidth(), 8);
+    });
+    os << "};\n";
+  };
+  os << "namespace byteir_aot {\n"
+     << "namespace " << entryName << " {\n";
+  printMeta("Input", inputs);
+  printMeta("Output", outputs);
+  os << "} // namespace " << entryName << "\n"
+     << "} // namespace byteir_aot\n\n"
+     << "#endif // " << guard << "\n";
+  return success();
+}
+
+LogicalResult byteir::translateToStandaloneCpp(Operation *op, raw_ostream &os,
+                                               bool emitHeader,
+                                               StringRef entryName) {
+  auto moduleOp = dyn_cast<ModuleOp>(op);
+  if (!moduleOp)
+    return op->emitError("expected builtin.module");
+  StandaloneCppEmitter emitter(os, entryName);
+  if (emitHeader)
+    return emitter.emitHeader(moduleOp);
+  return emitter.emitSource(moduleOp);
+}
@@ -0,0 +1,336 @@
+//===- TranslateToLLVMArchive.cpp -------------------------------*- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Target/LLVM/ToLLVMArchive.h"
+#include "mlir/Dialect/DLTI/DLTI.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Target/LLVMIR/Dialect/All.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include "mlir/Tools/mlir-translate/Translation.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Object/ArchiveWriter.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace mlir;
+
+namespace {
+
+// must be consistent with the packed function name of LLVMJITOp in brt, which
+// only packs functions itself when loading LLVM IR
+std::string makePackedFunctionName(llvm::StringRef name) {
+  return "_packed_" + name.str();
+}
+
+// Given a function `foo(<...>)`, define `_packed_foo(i8**)` which unpacks the
+// type-erased argument list and calls `foo`
+void packFunctionArguments(llvm::Module &module) {
+  auto &ctx = module.getContext();
+  llvm::IRBuilder<> builder(ctx);
+  llvm::SmallVector<llvm::Function *> funcs;
+  for (auto &func : module.functions()) {
+    if (!func.isDeclaration())
+      funcs.push_back(&func);
+  }
+
+  for (llvm::Function *func : funcs) {
+    auto *newType = llvm::FunctionType::get(builder.getVoidTy(),
+                                            builder.getPtrTy()->getPointerTo(),
+                                            /*isVarArg=*/false);
+    auto funcCst = module.getOrInsertFunction(
+        makePackedFunctionName(func->getName()), newType);
+    auto *interfaceFunc = llvm::cast<llvm::Function>(funcCst.getCallee());
+
+    auto *bb = llvm::BasicBlock::Create(ctx);
+    bb->insertInto(interfaceFunc);
+    builder.SetInsertPoint(bb);
+    llvm::Value *argList = interfaceFunc->arg_begin();
+    llvm::SmallVector<llvm::Value *, 8> args;
+    for (auto &&indexedArg : llvm::enumerate(func->args())) {
+      llvm::Value *argIndex = llvm::Constant::getIntegerValue(
+          builder.getInt64Ty(), llvm::APInt(64, indexedArg.index()));
+      llvm::Value *argPtrPtr =
+          builder.CreateGEP(builder.getPtrTy(), argList, argIndex);
+      llvm::Value *argPtr = builder.CreateLoad(builder.getPtrTy(), argPtrPtr);
+      args.push_back(
+          builder.CreateLoad(indexedArg.value().getType(), argPtr));
+    }
+
+    llvm::Value *result = builder.CreateCall(func, args);
+    if (!result->getType()->isVoidTy()) {
+      llvm::Value *retIndex = llvm::Constant::getIntegerValue(
+          builder.getInt64Ty(), llvm::APInt(64, llvm::size(func->args())));
+      llvm::Value *retPtrPtr =
+          builder.CreateGEP(builder.getPtrTy(), argList, retIndex);
+      llvm::Value *retPtr = builder.CreateLoad(builder.getPtrTy(), retPtrPtr);
+      builder.CreateStore(result, retPtr);
+    }
+    builder.CreateRetVoid();
+  }
+}
+
+// Assign each defined function to one of `numPartitions` partitions, largest
+// first onto the least loaded partition. Ties are broken by name and
+// partition index, so that the result only depends on the module.
+llvm::DenseMap<const llvm::Function *, unsigned>
+partitionFunctions(llvm::Module &module, unsigned numPartitions) {
+  llvm::SmallVector<std::pair<const llvm::Function *, size_t>> funcs;
+  for (auto &func : module.functions()) {
+    if (func.isDeclaration())
+      continue;
+    size_t numInsts = 0;
+    for (auto &block : func)
+      numInsts += block.size();
+    funcs.emplace_back(&func, numInsts);
+  }
+  llvm::stable_sort(funcs, [](const auto &lhs, const auto &rhs) {
+    if (lhs.second != rhs.second)
+      return lhs.second > rhs.second;
+    return lhs.first->getName() < rhs.first->getName();
+  });
+
+  llvm::SmallVector<size_t> loads(numPartitions, 0);
+  llvm::DenseMap<const llvm::Function *, unsigned> assignment;
+  for (auto &[func, numInsts] : funcs) {
+    unsigned partition = std::min_element(loads.begin(), loads.end()) -
+                         loads.begin();
+    assignment[func] = partition;
+    // count empty functions as well, which keeps them spread out
+    loads[partition] += std::max<size_t>(numInsts, 1);
+  }
+  return assignment;
+}
+
+// Make symbols with local linkage visible to other partitions
+void externalizeLocals(llvm::Module &module) {
+  unsigned numAnonymous = 0;
+  for (llvm::GlobalValue &gv : module.global_values()) {
+    if (!gv.hasLocalLinkage())
+      continue;
+    if (!gv.hasName())
+      gv.setName("__byteir_anon_" + llvm::Twine(numAnonymous++));
+    gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+    gv.setVisibility(llvm::GlobalValue::DefaultVisibility);
+  }
+}
+
+std::optional<llvm::OptimizationLevel> getOptimizationLevel(unsigned level) {
+  switch (level) {
+  case 0:
+    return llvm::OptimizationLevel::O0;
+  case 1:
+    return llvm::OptimizationLevel::O1;
+  case 2:
+    return llvm::OptimizationLevel::O2;
+  case 3:
+    return llvm::OptimizationLevel::O3;
+  default:
+    return std::nullopt;
+  }
+}
+
+// Optimize and emit the object of a partition in bitcode, in its own context
+llvm::Error emitObject(llvm::MemoryBufferRef bitcode,
+                       llvm::orc::JITTargetMachineBuilder jtmb,
+                       llvm::OptimizationLevel optLevel,
+                       llvm::SmallVectorImpl<char> &object) {
+  llvm::LLVMContext ctx;
+  auto moduleOrErr = llvm::parseBitcodeFile(bitcode, ctx);
+  if (!moduleOrErr)
+    return moduleOrErr.takeError();
+  std::unique_ptr<llvm::Module> module = std::move(*moduleOrErr);
+
+  auto tmOrErr = jtmb.createTargetMachine();
+  if (!tmOrErr)
+    return tmOrErr.takeError();
+  std::unique_ptr<llvm::TargetMachine> tm = std::move(*tmOrErr);
+  module->setTargetTriple(tm->getTargetTriple().str());
+  module->setDataLayout(tm->createDataLayout());
+  packFunctionArguments(*module);
+
+  llvm::LoopAnalysisManager lam;
+  llvm::FunctionAnalysisManager fam;
+  llvm::CGSCCAnalysisManager cgam;
+  llvm::ModuleAnalysisManager mam;
+  llvm::PassBuilder pb(tm.get());
+  pb.registerModuleAnalyses(mam);
+  pb.registerCGSCCAnalyses(cgam);
+  pb.registerFunctionAnalyses(fam);
+  pb.registerLoopAnalyses(lam);
+  pb.crossRegisterProxies(lam, fam, cgam, mam);
+  llvm::ModulePassManager mpm =
+      optLevel != llvm::OptimizationLevel::O0
+          ? pb.buildPerModuleDefaultPipeline(optLevel)
+          : pb.buildO0DefaultPipeline(optLevel);
+  mpm.run(*module, mam);
+
+  llvm::raw_svector_ostream os(object);
+  llvm::legacy::PassManager codegen;
+  if (tm->addPassesToEmitFile(codegen, os, nullptr,
+                              llvm::CodeGenFileType::ObjectFile))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "target can't emit object file");
+  codegen.run(*module);
+  return llvm::Error::success();
+}
+
+} // namespace
+
+LogicalResult byteir::translateToLLVMArchive(Operation *op,
+                                             llvm::raw_ostream &os,
+                                             const LLVMArchiveOptions &options) {
+  auto optLevel = getOptimizationLevel(options.optLevel);
+  if (!optLevel)
+    return op->emitError() << "invalid optimization level "
+                           << options.optLevel;
+
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+  auto jtmbOrErr = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!jtmbOrErr)
+    return op->emitError() << llvm::toString(jtmbOrErr.takeError());
+  llvm::orc::JITTargetMachineBuilder jtmb = std::move(*jtmbOrErr);
+  if (!options.cpu.empty())
+    jtmb.setCPU(options.cpu);
+  // objects are linked at arbitrary distance by the jit linker
+  jtmb.setRelocationModel(llvm::Reloc::PIC_);
+
+  llvm::LLVMContext llvmContext;
+  auto llvmModule = translateModuleToLLVMIR(op, llvmContext);
+  if (!llvmModule)
+    return failure();
+  externalizeLocals(*llvmModule);
+
+  // split by function, global variables all go to the first partition
+  unsigned numFuncs = llvm::count_if(
+      llvmModule->functions(), [](auto &func) { return !func.isDeclaration(); });
+  unsigned numPartitions =
+      std::max(1u, std::min(options.numPartitions, numFuncs));
+  auto assignment = partitionFunctions(*llvmModule, numPartitions);
+  llvm::SmallVector<llvm::SmallVector<char, 0>> bitcodes(numPartitions);
+  for (unsigned i = 0; i < numPartitions; ++i) {
+    llvm::ValueToValueMapTy vmap;
+    auto partition =
+        llvm::CloneModule(*llvmModule, vmap, [&](const llvm::GlobalValue *gv) {
+          if (auto func = llvm::dyn_cast<llvm::Function>(gv))
+            return assignment.lookup(func) == i;
+          return i == 0;
+        });
+    partition->setModuleIdentifier("part" + std::to_string(i));
+    llvm::raw_svector_ostream bitcodeOS(bitcodes[i]);
+    llvm::WriteBitcodeToFile(*partition, bitcodeOS);
+  }
+
+  // partitions are independent of each other and of the number of threads
+  unsigned numThreads = options.numThreads
+                            ? options.numThreads
+                            : llvm::hardware_concurrency().compute_thread_count();
+  numThreads = std::max(1u, std::min(numThreads, numPartitions));
+  llvm::SmallVector<llvm::SmallVector<char, 0>> objects(numPartitions);
+  llvm::SmallVector<std::string> errors(numPartitions);
+  std::atomic<unsigned> next{0};
+  auto worker = [&]() {
+    for (unsigned i = next++; i < numPartitions; i = next++) {
+      llvm::MemoryBufferRef bitcode(
+          llvm::StringRef(bitcodes[i].data(), bitcodes[i].size()),
+          "part" + std::to_string(i));
+      if (auto err = emitObject(bitcode, jtmb, *optLevel, objects[i]))
+        errors[i] = llvm::toString(std::move(err));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto &error : errors) {
+    if (!error.empty())
+      return op->emitError() << "failed to emit llvm object: " << error;
+  }
+
+  std::vector<std::string> memberNames;
+  for (unsigned i = 0; i < numPartitions; ++i)
+    memberNames.push_back("part" + std::to_string(i) + ".o");
+  std::vector<llvm::NewArchiveMember> members;
+  for (unsigned i = 0; i < numPartitions; ++i) {
+    members.emplace_back(llvm::MemoryBufferRef(
+        llvm::StringRef(objects[i].data(), objects[i].size()),
+        memberNames[i]));
+  }
+  auto kind = jtmb.getTargetTriple().isOSDarwin()
+                  ? llvm::object::Archive::K_DARWIN
+                  : llvm::object::Archive::K_GNU;
+  auto archiveOrErr = llvm::writeArchiveToBuffer(
+      members, llvm::SymtabWritingMode::NormalSymtab, kind,
+      /*Deterministic=*/true, /*Thin=*/false);
+  if (!archiveOrErr)
+    return op->emitError() << llvm::toString(archiveOrErr.takeError());
+  os << (*archiveOrErr)->getBuffer();
+  return success();
+}
+
+void byteir::registerToLLVMArchiveTranslation() {
+  static llvm::cl::opt<unsigned> numPartitions(
+      "llvm-partitions",
+      llvm::cl::desc("Number of partitions of the llvm module"),
+      llvm::cl::init(1));
+  static llvm::cl::opt<unsigned> numThreads(
+      "llvm-codegen-threads",
+      llvm::cl::desc("Number of threads of llvm code generation, 0 for all "
+                     "cores"),
+      llvm::cl::init(0));
+  static llvm::cl::opt<unsigned> optLevel(
+      "llvm-opt-level", llvm::cl::desc("Optimization level of llvm"),
+      llvm::cl::init(3));
+  static llvm::cl::opt<std::string> cpu(
+      "llvm-cpu", llvm::cl::desc("Target cpu, host cpu if empty"),
+      llvm::cl::init(""));
+
+  TranslateFromMLIRRegistration registration(
+      "mlir-to-llvm-archive",
+      "Translate MLIR to a static archive of llvm objects",
+      [](Operation *op, raw_ostream &output) {
+        LLVMArchiveOptions options;
+        options.numPartitions = numPartitions;
+        options.numThreads = numThreads;
+        options.optLevel = optLevel;
+        options.cpu = cpu;
+        return translateToLLVMArchive(op, output, options);
+      },
+      [](DialectRegistry &registry) {
+        registry.insert<DLTIDialect, func::FuncDialect>();
+        registerAllToLLVMIRTranslations(registry);
+      });
+}
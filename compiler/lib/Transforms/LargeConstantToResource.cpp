@@ -0,0 +1,96 @@
+//===- LargeConstantToResource.cpp ----------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Transforms/LargeConstantToResource.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/AsmState.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include "mlir/IR/OpDefinition.h"
+#include <cstddef>
+
+#include "PassDetail.h"
+
+using namespace llvm;
+using namespace mlir;
+
+namespace {
+
+// return a resource attr holding the payload of `attr` if it is large enough,
+// or null otherwise
+DenseResourceElementsAttr toResourceIfLarge(Attribute attr,
+                                            int64_t sizeThreshold,
+                                            StringRef blobNameHint) {
+  auto denseAttr = dyn_cast<DenseIntOrFPElementsAttr>(attr);
+  if (!denseAttr || denseAttr.isSplat())
+    return nullptr;
+
+  // i1 is bit-packed in DenseElementsAttr, which isn't the layout of blobs
+  auto shapedType = denseAttr.getType();
+  if (!shapedType.hasStaticShape() || shapedType.getElementType().isInteger(1))
+    return nullptr;
+
+  ArrayRef<char> rawData = denseAttr.getRawData();
+  if (static_cast<int64_t>(rawData.size()) < sizeThreshold)
+    return nullptr;
+
+  AsmResourceBlob blob = HeapAsmResourceBlob::allocateAndCopyWithAlign(
+      rawData, alignof(std::max_align_t));
+  return DenseResourceElementsAttr::get(shapedType, blobNameHint,
+                                        std::move(blob));
+}
+
+struct LargeConstantToResourcePass
+    : public LargeConstantToResourceBase<LargeConstantToResourcePass> {
+  LargeConstantToResourcePass(int64_t sizeThreshold)
+      : LargeConstantToResourceBase() {
+    this->sizeThreshold = sizeThreshold;
+  }
+
+  void runOnOperation() override {
+    ModuleOp m = getOperation();
+    m.walk([&](Operation *op) {
+      if (auto globalOp = dyn_cast<memref::GlobalOp>(op)) {
+        if (!globalOp.getConstant())
+          return;
+        if (auto resource =
+                toResourceIfLarge(globalOp.getInitialValueAttr(),
+                                  sizeThreshold, globalOp.getSymName())) {
+          globalOp.setInitialValueAttr(resource);
+        }
+        return;
+      }
+
+      if (!op->hasTrait<OpTrait::ConstantLike>())
+        return;
+
+      for (NamedAttribute namedAttr : op->getAttrs()) {
+        if (auto resource = toResourceIfLarge(
+                namedAttr.getValue(), sizeThreshold, "__byteir_constant")) {
+          op->setAttr(namedAttr.getName(), resource);
+        }
+      }
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+mlir::createLargeConstantToResourcePass(int64_t sizeThreshold) {
+  return std::make_unique<LargeConstantToResourcePass>(sizeThreshold);
+}
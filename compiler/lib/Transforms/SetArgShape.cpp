@@ -72,13 +72,16 @@ struct SetArgShapePass : public SetArgShapeBase<SetArgShapePass> {
     newArgTypes.reserve(funcOp.getNumArguments());
     for (unsigned i = 0, e = funcOp.getNumArguments(); i < e; ++i) {
       auto arg = funcOp.getArgument(i);
-      if ((this->shouldSetShape && this->shouldSetShape(arg)) ||
+      if (this->allDynamicArgs ||
+          (this->shouldSetShape && this->shouldSetShape(arg)) ||
           funcOp.getArgAttr(i, this->argAttrName)) {
         if (auto inputTy = dyn_cast<RankedTensorType>(arg.getType())) {
           Type elementType = inputTy.getElementType();
           llvm::SmallVector<int64_t> shape(inputTy.getShape().begin(),
                                            inputTy.getShape().end());
-          if (this->dim < int(shape.size())) {
+          if (this->dim < int(shape.size()) &&
+              (!this->allDynamicArgs ||
+               ShapedType::isDynamic(shape[this->dim]))) {
             shape[this->dim] = this->size;
             auto newArgType = RankedTensorType::get(shape, elementType,
                                                     inputTy.getEncoding());
@@ -90,7 +93,9 @@ struct SetArgShapePass : public SetArgShapeBase<SetArgShapePass> {
           Type elementType = inputTy.getElementType();
           llvm::SmallVector<int64_t> shape(inputTy.getShape().begin(),
                                            inputTy.getShape().end());
-          if (this->dim < int(shape.size())) {
+          if (this->dim < int(shape.size()) &&
+              (!this->allDynamicArgs ||
+               ShapedType::isDynamic(shape[this->dim]))) {
             shape[this->dim] = this->size;
             auto newArgType =
                 MemRefType::get(shape, elementType, inputTy.getLayout(),
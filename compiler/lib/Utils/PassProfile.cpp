@@ -0,0 +1,146 @@
+//===- PassProfile.cpp ------------------------------------------*- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "byteir/Utils/PassProfile.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/Pass/PassInstrumentation.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <chrono>
+
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+using namespace mlir;
+
+namespace {
+
+int64_t countOps(Operation *op) {
+  int64_t numOps = 0;
+  op->walk([&](Operation *) { ++numOps; });
+  return numOps;
+}
+
+// adaptors run nested pass managers, whose passes are recorded individually
+bool isPassAdaptor(Pass *pass) {
+  return pass->getArgument().empty() &&
+         pass->getName().starts_with("Pipeline Collection");
+}
+
+class PassProfileInstrumentation : public PassInstrumentation {
+public:
+  explicit PassProfileInstrumentation(std::shared_ptr<PassProfile> profile)
+      : profile(std::move(profile)) {}
+
+  void runBeforePass(Pass *pass, Operation *op) override {
+    if (isPassAdaptor(pass))
+      return;
+    Running running{countOps(op), getCurrentRSSKB(),
+                    std::chrono::steady_clock::now()};
+    std::lock_guard<std::mutex> lock(mutex);
+    inFlight[{pass, op}] = running;
+  }
+
+  void runAfterPass(Pass *pass, Operation *op) override {
+    finish(pass, op);
+  }
+
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    finish(pass, op);
+  }
+
+private:
+  struct Running {
+    int64_t opsBefore;
+    int64_t rssBeforeKB;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  void finish(Pass *pass, Operation *op) {
+    if (isPassAdaptor(pass))
+      return;
+    auto end = std::chrono::steady_clock::now();
+    Running running;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = inFlight.find({pass, op});
+      if (it == inFlight.end())
+        return;
+      running = it->second;
+      inFlight.erase(it);
+    }
+
+    PassProfileRecord record;
+    record.passName = pass->getName().str();
+    record.passArgument = pass->getArgument().str();
+    record.anchorName = op->getName().getStringRef().str();
+    record.opsBefore = running.opsBefore;
+    record.opsAfter = countOps(op);
+    record.wallSeconds =
+        std::chrono::duration<double>(end - running.start).count();
+    record.rssDeltaKB = getCurrentRSSKB() - running.rssBeforeKB;
+    profile->addRecord(std::move(record));
+  }
+
+  std::shared_ptr<PassProfile> profile;
+  std::mutex mutex;
+  llvm::DenseMap<std::pair<Pass *, Operation *>, Running> inFlight;
+};
+
+} // namespace
+
+void PassProfile::addRecord(PassProfileRecord record) {
+  std::lock_guard<std::mutex> lock(mutex);
+  records.push_back(std::move(record));
+}
+
+std::vector<PassProfileRecord> PassProfile::takeRecords() {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<PassProfileRecord> result;
+  result.swap(records);
+  return result;
+}
+
+void mlir::attachPassProfile(PassManager &pm,
+                             std::shared_ptr<PassProfile> profile) {
+  pm.addInstrumentation(
+      std::make_unique<PassProfileInstrumentation>(std::move(profile)));
+}
+
+int64_t mlir::getCurrentRSSKB() {
+#if defined(__linux__)
+  // the second field of statm is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  int64_t size = 0, resident = 0;
+  if (!(statm >> size >> resident))
+    return 0;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    return 0;
+  return static_cast<int64_t>(info.resident_size) / 1024;
+#else
+  return 0;
+#endif
+}
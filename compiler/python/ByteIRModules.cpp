@@ -172,6 +172,36 @@ struct PyOperationBuilderGuard {
   py::object oldBuilder;
 };
 
+struct PyPassProfile {
+  PyPassProfile() : profile(byteirPassProfileCreate()) {}
+  PyPassProfile(const PyPassProfile &) = delete;
+  ~PyPassProfile() { byteirPassProfileDestroy(profile); }
+
+  py::list takeRecords() {
+    py::list records;
+    byteirPassProfileTakeRecords(
+        profile,
+        [](MlirPassProfileRecord record, void *userData) {
+          auto toStr = [](MlirStringRef s) {
+            return py::str(s.data, s.length);
+          };
+          py::dict dict;
+          dict["pass"] = toStr(record.passName);
+          dict["argument"] = toStr(record.passArgument);
+          dict["anchor"] = toStr(record.anchorName);
+          dict["ops_before"] = record.opsBefore;
+          dict["ops_after"] = record.opsAfter;
+          dict["wall_seconds"] = record.wallSeconds;
+          dict["rss_delta_kb"] = record.rssDeltaKB;
+          static_cast<py::list *>(userData)->append(std::move(dict));
+        },
+        &records);
+    return records;
+  }
+
+  MlirPassProfile profile;
+};
+
 PYBIND11_MODULE(_byteir, m) {
   byteirRegisterAllPasses();
   mlirRegisterAllMhloPasses();
@@ -275,6 +305,42 @@ PYBIND11_MODULE(_byteir, m) {
         return;
       },
       py::arg("module"), py::arg("output_file"));
+  m.def(
+      "translate_to_llvm_archive",
+      [](MlirModule module, const std::string &outputFile,
+         unsigned numPartitions, unsigned numThreads, const std::string &cpu) {
+        bool ok;
+        {
+          // partitions are compiled by native threads
+          py::gil_scoped_release release;
+          ok = byteirTranslateToLLVMArchive(module, toMlirStringRef(outputFile),
+                                            numPartitions, numThreads,
+                                            toMlirStringRef(cpu));
+        }
+        if (!ok) {
+          PyErr_SetString(PyExc_ValueError,
+                          "failed to translate to llvm archive");
+          return;
+        }
+        return;
+      },
+      py::arg("module"), py::arg("output_file"), py::arg("num_partitions") = 1,
+      py::arg("num_threads") = 0, py::arg("cpu") = "");
+  m.def(
+      "translate_to_standalone_cpp",
+      [](MlirModule module, const std::string &sourceFile,
+         const std::string &headerFile, const std::string &entryName) {
+        if (!byteirTranslateToStandaloneCpp(
+                module, toMlirStringRef(sourceFile),
+                toMlirStringRef(headerFile), toMlirStringRef(entryName))) {
+          PyErr_SetString(PyExc_ValueError,
+                          "failed to translate to standalone cpp");
+          return;
+        }
+        return;
+      },
+      py::arg("module"), py::arg("source_file"), py::arg("header_file"),
+      py::arg("entry_name") = "run");
 
   //============ Byre Serialization ==============
   m.def(
@@ -406,6 +472,19 @@ PYBIND11_MODULE(_byteir, m) {
       py::arg("context"), py::arg("name"), py::arg("fn"),
       py::arg("result_types"), py::arg("override") = true);
 
+  //========== Pass Profiling ============
+  py::class_<PyPassProfile>(m, "PassProfile")
+      .def(py::init<>())
+      .def(
+          "attach",
+          [](PyPassProfile &self, MlirPassManager passManager) {
+            byteirPassManagerAttachProfile(passManager, self.profile);
+          },
+          py::arg("pass_manager"),
+          "record every pass run by the given PassManager")
+      .def("take_records", &PyPassProfile::takeRecords,
+           "return and clear the records of pass runs collected so far");
+
   py::enum_<MlirPDLValueKind>(m, "PDLValueKind")
       .value("Attribute", MlirPDLValueAttribute)
       .value("Operation", MlirPDLValueOperation)
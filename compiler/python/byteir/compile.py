@@ -1,10 +1,14 @@
 from enum import Enum
 from pathlib import Path
+import io
+import json
 import os
-from typing import Union
+import re
+from typing import Optional, Union
 
 from . import ir
 from .passmanager import PassManager
+from .pass_profile import PassProfiler
 from ._backend_registry import register_byteir_compiler_backend, get_target_device, look_up_backend
 from .utils import detect_gpu_arch_with_nvidia_smi
 
@@ -30,6 +34,7 @@ class CompileOptions:
                  enable_tf32: bool = False,
                  parallelism: int = 1,
                  disable_byteir_ait_cache: bool = False,
+                 pass_profiler: Optional[PassProfiler] = None,
                  **kwargs):
         self.target = target
         self.module = module
@@ -45,6 +50,8 @@ class CompileOptions:
         self.enable_tf32 = enable_tf32
         self.parallelism = parallelism
         self.disable_byteir_ait_cache = disable_byteir_ait_cache
+        # profiler of this compilation, if pass profiling is enabled
+        self.pass_profiler = pass_profiler
         self.kwargs = kwargs
 
 class DebugType(Enum):
@@ -74,6 +81,55 @@ def _get_debug_parameters(debug: DebugType):
                             "large_elements_limit":10}
     return debug_parameters
 
+def _run_pass_pipeline(pipeline: str, op, pass_profiler: Optional[PassProfiler] = None):
+    pm = PassManager.parse(pipeline)
+    if pass_profiler is not None:
+        pass_profiler.run(pm, op, pipeline)
+    else:
+        pm.run(op)
+
+def _get_entry_func_type(module: ir.Module, entry_func: str):
+    for op in module.body.operations:
+        if op.operation.name == "func.func" and ir.StringAttr(op.attributes["sym_name"]).value == entry_func:
+            return ir.FunctionType(ir.TypeAttr(op.attributes["function_type"]).value)
+    return None
+
+def _has_dynamic_shape(module: ir.Module, entry_func: str) -> bool:
+    func_type = _get_entry_func_type(module, entry_func)
+    if func_type is None:
+        return False
+    for ty in list(func_type.inputs) + list(func_type.results):
+        if ir.ShapedType.isinstance(ty) and not ir.ShapedType(ty).has_static_shape:
+            return True
+    return False
+
+def _get_byre_opt_extra_str(compile_options: CompileOptions) -> str:
+    extra_str = ""
+    if compile_options.kwargs.get("enable_inplace_concat_slice", False):
+        extra_str += " enable-inplace-concat-slice"
+    if compile_options.kwargs.get("enable_session_init_hoisting", False):
+        extra_str += " enable-session-init-hoisting"
+    if compile_options.kwargs.get("enable_async_collectives", False):
+        extra_str += " enable-async-collectives"
+    if compile_options.kwargs.get("enable_op_dependency", False):
+        extra_str += " enable-op-dependency"
+    # split ops into stages of balanced cost, each run on its own numa node
+    numa_stages = compile_options.kwargs.get("numa_stages", 0)
+    if numa_stages > 1:
+        extra_str += " numa-stages={}".format(numa_stages)
+    return extra_str
+
+def _get_round_trip_asm(module: ir.Module, compile_options: CompileOptions) -> str:
+    asm = module.operation.get_asm()
+    if compile_options.kwargs.get("large_constant_threshold") is None:
+        return asm
+    # resource keys are renamed when deserialized into the same context, so
+    # refer to each blob by its payload instead
+    asm, _, resources = asm.partition("{-#")
+    payloads = dict(re.findall(r'^\s*"?([^\s":]+)"?\s*:\s*"(0x[0-9A-Fa-f]*)"', resources, flags=re.MULTILINE))
+    return re.sub(r"dense_resource<([^>]*)>",
+                  lambda m: "dense_resource<{}>".format(payloads.get(m.group(1).strip('"'), m.group(1))), asm)
+
 def _print_verbose(module: ir.Module, pipeline_msg: str):
     print(pipeline_msg)
     print(module.operation.get_asm(large_elements_limit=10))
@@ -84,6 +140,7 @@ def _print_verbose(module: ir.Module, pipeline_msg: str):
 def _compile_cuda(
     compile_options: CompileOptions,
 ) -> None:
+    pass_profiler = compile_options.pass_profiler
     target = compile_options.target
     module = compile_options.module
     entry_func = compile_options.entry_func
@@ -94,51 +151,53 @@ def _compile_cuda(
     output_file_dir = compile_options.output_dir
     output_file_prefix = compile_options.output_file_prefix
     output_type = compile_options.output_type
-    useBarePtrCallConv = True # all tensor must have static shapes if True
+    # all tensor must have static shapes if True
+    useBarePtrCallConv = not _has_dynamic_shape(module, entry_func)
 
     context = module.context
 
     entry_func_str = "entry-func={}".format(entry_func)
+    byre_opt_extra_str = _get_byre_opt_extra_str(compile_options)
     target_str = "target={}".format(target)
     with context:
-        PassManager().parse("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Hlo Graph Opt:") if verbose else ...
     with context:
-        PassManager().parse("builtin.module(hlo-fusion-opt{outline-single-elemwise-op})").run(module.operation)
+        _run_pass_pipeline("builtin.module(hlo-fusion-opt{outline-single-elemwise-op})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Hlo Fusion Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(linalg-tensor-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(linalg-tensor-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Linalg Tensor Opt:") if verbose else ...
     with context:
         if enable_tf32:
-            PassManager.parse("builtin.module(byre-tensor-opt{{append-arg-types enable-tf32 {}}})".format(entry_func_str)).run(module.operation)
+            _run_pass_pipeline("builtin.module(byre-tensor-opt{{append-arg-types enable-tf32 {}}})".format(entry_func_str), module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str)).run(module.operation)
+            _run_pass_pipeline("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str), module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Tensor Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byteir-bufferize-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(byteir-bufferize-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After ByteIR Bufferize Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(linalg-memref-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(linalg-memref-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Linalg Memref Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(scf-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(scf-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After SCF Opt:") if verbose else ...
     with context:
         if useBarePtrCallConv:
-            PassManager.parse("builtin.module(gpu-opt{use-bare-ptr-memref-call-conv=true  device-file-name="+ output_file_prefix + ".ptx" + "})").run(module.operation)
+            _run_pass_pipeline("builtin.module(gpu-opt{use-bare-ptr-memref-call-conv=true  device-file-name="+ output_file_prefix + ".ptx" + "})", module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(gpu-opt{device-file-name=" + output_file_prefix + ".ptx" + "})").run(module.operation)
+            _run_pass_pipeline("builtin.module(gpu-opt{device-file-name=" + output_file_prefix + ".ptx" + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After GPU Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(inline)").run(module.operation)
-        PassManager.parse("builtin.module(func.func(lccl-to-byre))").run(module.operation)
-        PassManager.parse("builtin.module(func.func(gpu-launch-func-to-byre))").run(module.operation)
-        PassManager.parse("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))").run(module.operation)
-        PassManager.parse("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(inline)", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(lccl-to-byre))", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(gpu-launch-func-to-byre))", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Set Space Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byre-opt{append-arg-types " + entry_func_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-opt{append-arg-types " + entry_func_str + byre_opt_extra_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Opt:") if verbose else ...
 
     # create device module
@@ -146,18 +205,18 @@ def _compile_cuda(
     device_module = ir.Module.parse(module_str, context)
     with context:
         if useBarePtrCallConv:
-            PassManager.parse("builtin.module(nvvm-codegen{use-bare-ptr-memref-call-conv=true " + f" gpu-arch={gpu_arch}" + "})").run(device_module.operation)
+            _run_pass_pipeline("builtin.module(nvvm-codegen{use-bare-ptr-memref-call-conv=true " + f" gpu-arch={gpu_arch}" + "})", device_module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(nvvm-codegen{" + f" gpu-arch= {gpu_arch}"  + "})").run(device_module.operation)
+            _run_pass_pipeline("builtin.module(nvvm-codegen{" + f" gpu-arch= {gpu_arch}"  + "})", device_module.operation, pass_profiler)
         _print_verbose(device_module, "// IR Dump After NVVM Codegen:") if verbose else ...
     # write to output device ptx file
     byteir.translate_to_ptx(device_module, output_file_dir + "/" + output_file_prefix, gpu_arch)
 
     # create host module
     with context:
-        PassManager.parse("builtin.module(byre-host)").run(module.operation)
-        PassManager.parse("builtin.module(remove-module-tag{attr-name=gpu.container_module})").run(module.operation)
-        PassManager.parse("builtin.module(remove-module-tag{attr-name=torch.debug_module_name})").run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-host)", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(remove-module-tag{attr-name=gpu.container_module})", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(remove-module-tag{attr-name=torch.debug_module_name})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Host:") if verbose else ...
     
     output_host_mlir_path = os.path.join(output_file_dir, output_file_prefix + "." + OutputType.MLIR.value)
@@ -168,7 +227,7 @@ def _compile_cuda(
     if output_type is OutputType.MLIRBC:
         byteir.serialize_byre(module, compile_options.byre_serial_version, output_host_mlirbc_path)
         deserialized_module = byteir.deserialize_byre(open(output_host_mlirbc_path, "rb").read(), context)
-        if (module.operation.get_asm() != deserialized_module.operation.get_asm()):
+        if _get_round_trip_asm(module, compile_options) != _get_round_trip_asm(deserialized_module, compile_options):
             raise ValueError("module asm has be changed after byre serialization")
 
 
@@ -176,6 +235,7 @@ def _compile_cuda(
 def _compile_cuda_with_ait(
     compile_options: CompileOptions,
 ) -> None:
+    pass_profiler = compile_options.pass_profiler
     from .dialects.cat import IRProcessor
 
     target = "cuda"
@@ -196,10 +256,11 @@ def _compile_cuda_with_ait(
     context = module.context
 
     entry_func_str = "entry-func={}".format(entry_func)
+    byre_opt_extra_str = _get_byre_opt_extra_str(compile_options)
     target_str = "target={}".format(target)
 
     with context:
-        PassManager().parse("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Hlo Graph Opt:") if verbose else ...
 
     processor = IRProcessor(name, 
@@ -214,46 +275,45 @@ def _compile_cuda_with_ait(
     processor.cat_opt_pass(anchor_only=False)
 
     with context:
-        pm = PassManager().parse("builtin.module(hlo-fusion-opt{outline-single-elemwise-op outline-cat-op})")
-        pm.run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(hlo-fusion-opt{outline-single-elemwise-op outline-cat-op})", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Hlo Fusion Opt (with Cat):") if verbose else ...
 
     # generate ait lib .so for cat functions
     module = processor.ait_opt_pass(output_file_dir)
 
     with context:
-        PassManager.parse("builtin.module(linalg-tensor-opt)").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(linalg-tensor-opt)", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Linalg Tensor Opt:") if verbose else ...
     with context:
         if enable_tf32:
-            PassManager.parse("builtin.module(byre-tensor-opt{{append-arg-types enable-tf32 {}}})".format(entry_func_str)).run(processor.module.operation)
+            _run_pass_pipeline("builtin.module(byre-tensor-opt{{append-arg-types enable-tf32 {}}})".format(entry_func_str), processor.module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str)).run(processor.module.operation)
+            _run_pass_pipeline("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str), processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Byre Tensor Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byteir-bufferize-opt)").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(byteir-bufferize-opt)", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After ByteIR Bufferize Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(linalg-memref-opt)").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(linalg-memref-opt)", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Linalg Memref Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(scf-opt)").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(scf-opt)", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After SCF Opt:") if verbose else ...
     with context:
         if useBarePtrCallConv:
-            PassManager.parse("builtin.module(gpu-opt{use-bare-ptr-memref-call-conv=true  device-file-name="+ output_file_prefix + ".ptx" + "})").run(module.operation)
+            _run_pass_pipeline("builtin.module(gpu-opt{use-bare-ptr-memref-call-conv=true  device-file-name="+ output_file_prefix + ".ptx" + "})", module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(gpu-opt{device-file-name=" + output_file_prefix + ".ptx" + "})").run(module.operation)
+            _run_pass_pipeline("builtin.module(gpu-opt{device-file-name=" + output_file_prefix + ".ptx" + "})", module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After GPU Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(inline)").run(processor.module.operation)
-        PassManager.parse("builtin.module(func.func(lccl-to-byre))").run(module.operation)
-        PassManager.parse("builtin.module(func.func(gpu-launch-func-to-byre))").run(processor.module.operation)
-        PassManager.parse("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))").run(processor.module.operation)
-        PassManager.parse("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(inline)", processor.module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(lccl-to-byre))", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(gpu-launch-func-to-byre))", processor.module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))", processor.module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Set Space Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byre-opt{append-arg-types " + entry_func_str + "})").run(processor.module.operation)
+        _run_pass_pipeline("builtin.module(byre-opt{append-arg-types " + entry_func_str + byre_opt_extra_str + "})", processor.module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Byre Opt:") if verbose else ...
 
     # create device module
@@ -261,18 +321,18 @@ def _compile_cuda_with_ait(
     device_module = ir.Module.parse(module_str, context)
     with context:
         if useBarePtrCallConv:
-            PassManager.parse("builtin.module(nvvm-codegen{use-bare-ptr-memref-call-conv=true " + f" gpu-arch={gpu_arch}" + "})").run(device_module.operation)
+            _run_pass_pipeline("builtin.module(nvvm-codegen{use-bare-ptr-memref-call-conv=true " + f" gpu-arch={gpu_arch}" + "})", device_module.operation, pass_profiler)
         else:
-            PassManager.parse("builtin.module(nvvm-codegen{" + f" gpu-arch= {gpu_arch}" + "})").run(device_module.operation)
+            _run_pass_pipeline("builtin.module(nvvm-codegen{" + f" gpu-arch= {gpu_arch}" + "})", device_module.operation, pass_profiler)
         _print_verbose(device_module, "// IR Dump After NVVM Codegen:") if verbose else ...
     # write to output device ptx
     byteir.translate_to_ptx(device_module, output_file_dir + "/" + output_file_prefix, gpu_arch)
 
     # create host module
     with context:
-        PassManager.parse("builtin.module(byre-host)").run(processor.module.operation)
-        PassManager.parse("builtin.module(remove-module-tag{attr-name=gpu.container_module})").run(module.operation)
-        PassManager.parse("builtin.module(remove-module-tag{attr-name=torch.debug_module_name})").run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-host)", processor.module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(remove-module-tag{attr-name=gpu.container_module})", module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(remove-module-tag{attr-name=torch.debug_module_name})", module.operation, pass_profiler)
         _print_verbose(processor.module, "// IR Dump After Byre Host:") if verbose else ...
     
     output_host_mlir_path = os.path.join(output_file_dir, output_file_prefix + "." + OutputType.MLIR.value)
@@ -283,7 +343,7 @@ def _compile_cuda_with_ait(
     if output_type is OutputType.MLIRBC:
         byteir.serialize_byre(module, compile_options.byre_serial_version, output_host_mlirbc_path)
         deserialized_module = byteir.deserialize_byre(open(output_host_mlirbc_path, "rb").read(), context)
-        if (module.operation.get_asm() != deserialized_module.operation.get_asm()):
+        if _get_round_trip_asm(module, compile_options) != _get_round_trip_asm(deserialized_module, compile_options):
             raise ValueError("module asm has be changed after byre serialization")
 
 
@@ -291,6 +351,7 @@ def _compile_cuda_with_ait(
 def _compile_cpu(
     compile_options: CompileOptions,
 ) -> None:
+    pass_profiler = compile_options.pass_profiler
     target = compile_options.target
     module = compile_options.module
     entry_func = compile_options.entry_func
@@ -302,64 +363,103 @@ def _compile_cpu(
     output_type = compile_options.output_type
     bc_file_name = output_file_prefix + ".kernel.ll.bc"
     llir_file_name = output_file_prefix + ".kernel.ll"
-    useBarePtrCallConv = True # all tensor must have static shapes if True
+    # optimize and emit host kernels ahead of time in parallel partitions,
+    # which LLVMJITOp loads as a static archive instead of llvm bitcode
+    codegen_partitions = compile_options.kwargs.get("codegen_partitions", 0)
+    if codegen_partitions > 0:
+        bc_file_name = output_file_prefix + ".kernel.a"
+    # host kernels use the bare pointer calling convention, which requires
+    # static shapes
+    if _has_dynamic_shape(module, entry_func):
+        raise ValueError("cpu target requires static shapes, but {} has dynamic shapes".format(entry_func))
 
     context = module.context
 
     entry_func_str = "entry-func={}".format(entry_func)
+    byre_opt_extra_str = _get_byre_opt_extra_str(compile_options)
     target_str = "target={}".format(target)
     arch_str="arch={}".format(cpu_arch)
+    # optional blocked layout of convolutions, e.g. conv_layout="NCHW8c"
+    conv_layout = compile_options.kwargs.get("conv_layout", None)
+    hlo_graph_opt_extra_str = " conv-layout={}".format(conv_layout) if conv_layout else ""
     with context:
-        PassManager().parse("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(hlo-graph-opt{" + entry_func_str + " " + target_str + hlo_graph_opt_extra_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Hlo Graph Opt:") if verbose else ...
+    if compile_options.kwargs.get("enable_bf16", False):
+        with context:
+            _run_pass_pipeline("builtin.module(func.func(bf16-mixed-precision))", module.operation, pass_profiler)
+            _print_verbose(module, "// IR Dump After BF16 Mixed Precision:") if verbose else ...
     with context:
-        PassManager().parse("builtin.module(hlo-fusion-opt{" + entry_func_str + " " + target_str + " outline-single-elemwise-op})").run(module.operation)
+        _run_pass_pipeline("builtin.module(hlo-fusion-opt{" + entry_func_str + " " + target_str + " outline-single-elemwise-op})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Hlo Fusion Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(linalg-tensor-opt{" + target_str + " " + arch_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(linalg-tensor-opt{" + target_str + " " + arch_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Linalg Tensor Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str)).run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-tensor-opt{{append-arg-types {}}})".format(entry_func_str), module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Tensor Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(byteir-bufferize-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(byteir-bufferize-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After ByteIR Bufferize Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(linalg-memref-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(linalg-memref-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Linalg Memref Opt:") if verbose else ...
     with context:
-        PassManager.parse("builtin.module(scf-opt)").run(module.operation)
+        _run_pass_pipeline("builtin.module(scf-opt)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After SCF Opt:") if verbose else ...
 
     with context:
-        PassManager.parse("builtin.module(host-opt{" + "file-name={}".format(bc_file_name) + "})").run(module.operation)
+        # opt-in software prefetch of host kernel loops, with distance 0 for the cost model
+        prefetch_distance = compile_options.kwargs.get("prefetch_distance", None)
+        host_opt_extra_str = ""
+        if prefetch_distance is not None:
+            host_opt_extra_str = " enable-prefetch prefetch-distance={}".format(prefetch_distance)
+        if compile_options.kwargs.get("enable_host_kernel_merge", False):
+            host_opt_extra_str += " enable-kernel-merge"
+        _run_pass_pipeline("builtin.module(host-opt{" + "file-name={}".format(bc_file_name) + host_opt_extra_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Host Opt:") if verbose else ...
 
-        PassManager.parse("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))").run(module.operation)
+        _run_pass_pipeline("builtin.module(func.func(set-op-space{" + entry_func_str + " space={}".format(target) +  "}))", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Set Op Space Opt:") if verbose else ...
-        PassManager.parse("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(set-arg-space{" + entry_func_str + " all-space={}".format(target) + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Set Space Opt:") if verbose else ...
 
     with context:
-        PassManager.parse("builtin.module(byre-opt{append-arg-types " + entry_func_str + "})").run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-opt{append-arg-types " + entry_func_str + byre_opt_extra_str + "})", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Opt:") if verbose else ...
 
-    module_str = module.operation.get_asm(print_generic_op_form=True)
-    llvm_module = ir.Module.parse(module_str, context)
+    # self-contained c++ of the whole model, which runs without brt
+    if compile_options.kwargs.get("emit_standalone_cpp", False):
+        output_cpp_path = os.path.join(output_file_dir, output_file_prefix + ".aot.cpp")
+        output_header_path = os.path.join(output_file_dir, output_file_prefix + ".aot.h")
+        byteir.translate_to_standalone_cpp(module, output_cpp_path, output_header_path)
+
+    # clone through bytecode, which keeps large constants as blobs
+    module_bytes = io.BytesIO()
+    module.operation.write_bytecode(module_bytes)
+    llvm_module = ir.Module.parse(module_bytes.getvalue(), context)
     with context:
-        PassManager.parse("builtin.module(to-llvm)").run(llvm_module.operation)
+        # native bf16 relies on the target cpu, e.g. avx512-bf16, otherwise emulate
+        emulate_bf16_str = "false" if compile_options.kwargs.get("native_bf16", False) else "true"
+        _run_pass_pipeline("builtin.module(to-llvm{emulate-bf16=" + emulate_bf16_str + "})", llvm_module.operation, pass_profiler)
         _print_verbose(llvm_module, "// IR Dump After To LLVM:") if verbose else ...
 
     output_bc_path = output_file_dir + "/" + bc_file_name
     output_llir_path = output_file_dir + "/" + llir_file_name
-    # write to output llvmbc file
-    byteir.translate_to_llvmbc(llvm_module, output_bc_path)
+    if codegen_partitions > 0:
+        # the archive only depends on the number of partitions, not on threads
+        byteir.translate_to_llvm_archive(llvm_module, output_bc_path,
+                                         num_partitions=codegen_partitions,
+                                         num_threads=compile_options.kwargs.get("codegen_threads", 0))
+    else:
+        # write to output llvmbc file
+        byteir.translate_to_llvmbc(llvm_module, output_bc_path)
     # write to llvm ir file for debug
     byteir.translate_to_llvmir(llvm_module, output_llir_path)
 
     # create host module
     with context:
-        PassManager.parse("builtin.module(byre-host)").run(module.operation)
+        _run_pass_pipeline("builtin.module(byre-host)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Byre Host:") if verbose else ...
 
     output_host_mlir_path = os.path.join(output_file_dir, output_file_prefix + "." + OutputType.MLIR.value)
@@ -370,9 +470,71 @@ def _compile_cpu(
     if output_type is OutputType.MLIRBC:
         byteir.serialize_byre(module, compile_options.byre_serial_version, output_host_mlirbc_path)
         deserialized_module = byteir.deserialize_byre(open(output_host_mlirbc_path, "rb").read(), context)
-        if (module.operation.get_asm() != deserialized_module.operation.get_asm()):
+        if _get_round_trip_asm(module, compile_options) != _get_round_trip_asm(deserialized_module, compile_options):
             raise ValueError("module asm has be changed after byre serialization")
 
+def _set_shape_bucket(input_string_or_bytes: Union[str, bytes],
+                      entry_func: str,
+                      bucket: dict,
+                      canonicalize: bool = True,
+                      pass_profiler: Optional[PassProfiler] = None) -> ir.Module:
+    context = ir.Context()
+    module = ir.Module.parse(input_string_or_bytes, context)
+    with context:
+        _run_pass_pipeline("builtin.module(canonicalize,stablehlo-legalize-to-hlo,canonicalize)", module.operation, pass_profiler)
+        for dim, size in sorted(bucket.items()):
+            _run_pass_pipeline("builtin.module(set-arg-shape{{dim={} size={} entry-func-name={} all-dynamic-args}})".format(dim, size, entry_func), module.operation, pass_profiler)
+        _run_pass_pipeline("builtin.module(func.func(static-shape-infer){})".format(",canonicalize" if canonicalize else ""), module.operation, pass_profiler)
+    return module
+
+def _probe_shape_bucket_dims(input_string_or_bytes: Union[str, bytes],
+                             entry_func: str,
+                             dims: list,
+                             pass_profiler: Optional[PassProfiler] = None) -> dict:
+    # set every bucket dim to a distinct odd size, which unlikely appears
+    # elsewhere, and record the input and output dims taking that size. A dim
+    # changing with the probe sizes without following any bucket dim makes
+    # zero-padding unsafe
+    def probe(base):
+        sizes = {dim: base - 2 * i for i, dim in enumerate(sorted(dims))}
+        module = _set_shape_bucket(input_string_or_bytes, entry_func, sizes, canonicalize=False,
+                                   pass_profiler=pass_profiler)
+        func_type = _get_entry_func_type(module, entry_func)
+        return sizes, [list(func_type.inputs), list(func_type.results)]
+
+    def get_shape(ty):
+        if ir.ShapedType.isinstance(ty) and ir.ShapedType(ty).has_rank:
+            return ir.ShapedType(ty).shape
+        return []
+
+    sizes0, types0 = probe(997)
+    sizes1, types1 = probe(991)
+    paddable = True
+    follow = []
+    for tys0, tys1 in zip(types0, types1):
+        arg_dims = []
+        for ty0, ty1 in zip(tys0, tys1):
+            mapping = {}
+            for idx, (size0, size1) in enumerate(zip(get_shape(ty0), get_shape(ty1))):
+                bucket_dim = [dim for dim in dims if sizes0[dim] == size0 and sizes1[dim] == size1]
+                if bucket_dim:
+                    mapping[idx] = bucket_dim[0]
+                elif size0 != size1 or ir.ShapedType.is_dynamic_size(size0):
+                    paddable = False
+            arg_dims.append(mapping)
+        follow.append(arg_dims)
+    return {"input_dims": follow[0], "output_dims": follow[1], "paddable": paddable}
+
+def _specialize_shape_bucket(input_string_or_bytes: Union[str, bytes],
+                             entry_func: str,
+                             bucket: dict,
+                             pass_profiler: Optional[PassProfiler] = None) -> bytes:
+    module = _set_shape_bucket(input_string_or_bytes, entry_func, bucket, pass_profiler=pass_profiler)
+    # use bytecode to avoid printing large constants into asm
+    buffer = io.BytesIO()
+    module.operation.write_bytecode(buffer)
+    return buffer.getvalue()
+
 def compile_from_string(
     input_string_or_bytes: Union[str, bytes],
     output_file_path: str,
@@ -380,13 +542,42 @@ def compile_from_string(
     target: str = "cuda",
     gpu_arch: str = "local",
     cpu_arch: str = "x86_64",
-    byre_serial_version: str = "1.0.0",
+    byre_serial_version: Optional[str] = None,
     verbose: bool = False,
     enable_tf32: bool = False,
     parallelism: int = 1,
     disable_byteir_ait_cache: bool = False,
     **kwargs,
 ) -> None:
+    ### profile all pass pipelines into a json report, including those of
+    ### shape buckets, e.g. pass_profile_file="model.pass_profile.json"
+    pass_profile_file = kwargs.pop("pass_profile_file", None)
+    superlinear_threshold = kwargs.pop("pass_profile_superlinear_threshold", 1.5)
+    pass_profiler = kwargs.pop("pass_profiler", None)
+    if pass_profile_file is not None:
+        pass_profiler = PassProfiler(superlinear_threshold=superlinear_threshold)
+        try:
+            compile_from_string(input_string_or_bytes,
+                                output_file_path=output_file_path,
+                                entry_func=entry_func,
+                                target=target,
+                                gpu_arch=gpu_arch,
+                                cpu_arch=cpu_arch,
+                                byre_serial_version=byre_serial_version,
+                                verbose=verbose,
+                                enable_tf32=enable_tf32,
+                                parallelism=parallelism,
+                                disable_byteir_ait_cache=disable_byteir_ait_cache,
+                                pass_profiler=pass_profiler,
+                                **kwargs)
+        finally:
+            pass_profiler.dump(pass_profile_file)
+        return
+
+    shape_buckets = kwargs.pop("shape_buckets", None)
+    ### resource blobs are serialized by reference since byre 1.1.0
+    if byre_serial_version is None:
+        byre_serial_version = "1.0.0" if kwargs.get("large_constant_threshold") is None else "1.1.0"
     _device = get_target_device(target)
     ### optional detecting gpu type from nvidia-smi
     if _device == "cuda" and gpu_arch == "local":
@@ -407,9 +598,34 @@ def compile_from_string(
 
     ### legalize stablehlo to mhlo
     with context:
-        PassManager.parse("builtin.module(canonicalize,stablehlo-legalize-to-hlo,canonicalize)").run(module.operation)
+        _run_pass_pipeline("builtin.module(canonicalize,stablehlo-legalize-to-hlo,canonicalize)", module.operation, pass_profiler)
         _print_verbose(module, "// IR Dump After Legalize to HLO:") if verbose else ...
 
+    ### int8 post-training quantization with calibrated activation ranges
+    int8_act_absmax = kwargs.get("int8_act_absmax", None)
+    if int8_act_absmax:
+        with context:
+            act_absmax_str = ",".join(str(float(v)) for v in int8_act_absmax)
+            _run_pass_pipeline("builtin.module(quantize-int8{{entry-func={} act-absmax={}}})".format(entry_func, act_absmax_str), module.operation, pass_profiler)
+            _print_verbose(module, "// IR Dump After Quantize Int8:") if verbose else ...
+
+    ### move large constants to resource blobs, after int8 quantization which
+    ### needs dense weights, and release the original dense payloads
+    large_constant_threshold = kwargs.get("large_constant_threshold", None)
+    if large_constant_threshold is not None:
+        with context:
+            _run_pass_pipeline("builtin.module(large-constant-to-resource{{size-threshold={}}})".format(large_constant_threshold), module.operation, pass_profiler)
+        # uniqued attributes live as long as their context, so drop the old
+        # context before re-parsing the module from bytecode
+        buffer = io.BytesIO()
+        module.operation.write_bytecode(buffer)
+        del module, context
+        module_bytes = buffer.getvalue()
+        del buffer
+        context = ir.Context()
+        module = ir.Module.parse(module_bytes, context)
+        del module_bytes
+
     ### parse output options from output_file_path
     output_dir = os.path.dirname(os.path.abspath(output_file_path))
     os.makedirs(output_dir, exist_ok=True)
@@ -436,14 +652,49 @@ def compile_from_string(
         enable_tf32=enable_tf32,
         parallelism=parallelism,
         disable_byteir_ait_cache=disable_byteir_ait_cache,
-        kwargs=kwargs)
+        pass_profiler=pass_profiler,
+        **kwargs)
 
-    ### compiling
+    ### compiling, the cpu target requires static shapes, so a dynamic shape
+    ### model with shape buckets is compiled without the fallback
     _compile_fn = look_up_backend(compile_options.target)
-    if _compile_fn is not None:
+    compile_fallback = not (shape_buckets is not None and _device == "cpu" and _has_dynamic_shape(module, entry_func))
+    if _compile_fn is None:
+        raise NotImplementedError("not implemented target: {}".format(target))
+    elif compile_fallback:
         _compile_fn(compile_options)
     else:
-        raise NotImplementedError("not implemented target: {}".format(target))
+        print(f"[ByteIR] Skipping dynamic shape fallback on {target}, shapes out of buckets are rejected")
+
+    ### compile static specializations for shape buckets, the artifact above
+    ### is kept as the fallback for shapes not covered by any bucket
+    if shape_buckets is not None:
+        shape_buckets = [{int(dim): int(size) for dim, size in bucket.items()} for bucket in shape_buckets]
+        bucket_dims = sorted(set(dim for bucket in shape_buckets for dim in bucket))
+        manifest = {"entry_func": entry_func, "fallback": output_file_basename if compile_fallback else None,
+                    "buckets": []}
+        manifest.update(_probe_shape_bucket_dims(input_string_or_bytes, entry_func, bucket_dims,
+                                                 pass_profiler=pass_profiler))
+        output_file_ext = os.path.splitext(output_file_basename)[1]
+        for idx, bucket in enumerate(shape_buckets):
+            bucket_file_basename = "{}.bucket{}{}".format(output_file_prefix, idx, output_file_ext)
+            print(f"[ByteIR] Compiling shape bucket {bucket} to {bucket_file_basename}")
+            compile_from_string(_specialize_shape_bucket(input_string_or_bytes, entry_func, bucket, pass_profiler),
+                                output_file_path=os.path.join(output_dir, bucket_file_basename),
+                                entry_func=entry_func,
+                                target=target,
+                                gpu_arch=gpu_arch,
+                                cpu_arch=cpu_arch,
+                                byre_serial_version=byre_serial_version,
+                                verbose=verbose,
+                                enable_tf32=enable_tf32,
+                                parallelism=parallelism,
+                                disable_byteir_ait_cache=disable_byteir_ait_cache,
+                                pass_profiler=pass_profiler,
+                                **kwargs)
+            manifest["buckets"].append({"dims": bucket, "file": bucket_file_basename})
+        with open(os.path.join(output_dir, output_file_prefix + ".buckets.json"), "w") as f:
+            json.dump(manifest, f, indent=2)
 
 def compile(
     input_file_path: str,
@@ -452,7 +703,7 @@ def compile(
     target: str = "cuda",
     gpu_arch: str = "local",
     cpu_arch: str = "x86_64",
-    byre_serial_version: str = "1.0.0",
+    byre_serial_version: Optional[str] = None,
     verbose: bool = False,
     enable_tf32: bool = False,
     parallelism: int = 1,
@@ -477,4 +728,4 @@ def compile(
                         enable_tf32=enable_tf32,
                         parallelism=parallelism,
                         disable_byteir_ait_cache=disable_byteir_ait_cache,
-                        kwargs=kwargs)    
+                        **kwargs)    
@@ -0,0 +1,144 @@
+# Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+import json
+import math
+import resource
+import sys
+import time
+from typing import Dict, List, Optional
+
+from ._mlir_libs._byteir import PassProfile
+
+
+def _get_peak_rss_kb() -> int:
+    peak_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # bytes on macOS, KB on linux
+    return peak_rss // 1024 if sys.platform == "darwin" else peak_rss
+
+
+def _fit_scaling_exponent(samples: List[tuple]) -> Optional[float]:
+    """Least squares slope of log(wall time) over log(op count), i.e. k of
+    time ~ ops^k, or None if the op counts don't span a wide enough range."""
+    samples = [(ops, seconds) for ops, seconds in samples if ops > 0 and seconds > 0]
+    if len(samples) < 3:
+        return None
+    min_ops = min(ops for ops, _ in samples)
+    max_ops = max(ops for ops, _ in samples)
+    if max_ops < 2 * min_ops:
+        return None
+    xs = [math.log(ops) for ops, _ in samples]
+    ys = [math.log(seconds) for _, seconds in samples]
+    mean_x = sum(xs) / len(xs)
+    mean_y = sum(ys) / len(ys)
+    var_x = sum((x - mean_x) ** 2 for x in xs)
+    if var_x == 0:
+        return None
+    return sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys)) / var_x
+
+
+class PassProfiler:
+    """Collects wall time, op count before and after, and RSS change of every
+    pass across all pass pipelines run by byteir.compile.
+
+    Wall time and RSS change of a pass are summed over its runs, e.g. on each
+    func.func, so they may exceed those of its pipeline when passes run
+    multithreaded.
+    """
+
+    def __init__(self, superlinear_threshold: float = 1.5, min_seconds: float = 1e-3):
+        # passes whose time grows faster than ops^superlinear_threshold are
+        # reported, ignoring runs shorter than min_seconds as noise
+        self.superlinear_threshold = superlinear_threshold
+        self.min_seconds = min_seconds
+        self.stages: List[Dict] = []
+        self._profile = PassProfile()
+        self._start = time.perf_counter()
+
+    def run(self, pm, op, pipeline: str):
+        self._profile.attach(pm)
+        start = time.perf_counter()
+        try:
+            pm.run(op)
+        finally:
+            wall_seconds = time.perf_counter() - start
+            self.stages.append({
+                "pipeline": pipeline,
+                "wall_seconds": wall_seconds,
+                "records": self._profile.take_records(),
+            })
+
+    def _aggregate(self, records: List[Dict], keys: tuple) -> List[Dict]:
+        entries: Dict[tuple, Dict] = {}
+        for record in records:
+            key = tuple(record[k] for k in keys)
+            entry = entries.setdefault(key, {
+                **{k: record[k] for k in keys},
+                "runs": 0,
+                "wall_seconds": 0.0,
+                "ops_before": 0,
+                "ops_after": 0,
+                "rss_delta_kb": 0,
+            })
+            entry["runs"] += 1
+            entry["wall_seconds"] += record["wall_seconds"]
+            entry["ops_before"] += record["ops_before"]
+            entry["ops_after"] += record["ops_after"]
+            entry["rss_delta_kb"] += record["rss_delta_kb"]
+        return list(entries.values())
+
+    def report(self) -> Dict:
+        stages = []
+        all_records = []
+        for stage in self.stages:
+            stages.append({
+                "pipeline": stage["pipeline"],
+                "wall_seconds": stage["wall_seconds"],
+                "passes": self._aggregate(stage["records"], ("pass", "argument", "anchor")),
+            })
+            all_records += stage["records"]
+
+        # the same pass runs on IR of different sizes across pipelines and
+        # anchors, which tells how its cost scales with op count
+        passes = sorted(self._aggregate(all_records, ("pass", "argument")),
+                        key=lambda entry: entry["wall_seconds"], reverse=True)
+        warnings = []
+        for entry in passes:
+            samples = [(record["ops_before"], record["wall_seconds"])
+                       for record in all_records
+                       if record["pass"] == entry["pass"] and
+                       record["wall_seconds"] >= self.min_seconds]
+            exponent = _fit_scaling_exponent(samples)
+            entry["scaling_exponent"] = exponent
+            if exponent is not None and exponent > self.superlinear_threshold:
+                warnings.append("pass {} scales as ops^{:.2f} over {} runs, {:.3f}s in total".format(
+                    entry["argument"] or entry["pass"], exponent, len(samples), entry["wall_seconds"]))
+
+        return {
+            "total_wall_seconds": time.perf_counter() - self._start,
+            "pipeline_wall_seconds": sum(stage["wall_seconds"] for stage in stages),
+            "peak_rss_kb": _get_peak_rss_kb(),
+            "superlinear_threshold": self.superlinear_threshold,
+            "passes": passes,
+            "stages": stages,
+            "warnings": warnings,
+        }
+
+    def dump(self, path: str) -> Dict:
+        report = self.report()
+        with open(path, "w") as f:
+            json.dump(report, f, indent=2)
+        for warning in report["warnings"]:
+            print(f"[ByteIR] Warning: {warning}")
+        return report
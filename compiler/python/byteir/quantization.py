@@ -0,0 +1,83 @@
+# Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+import io
+import os
+from typing import List, Sequence, Union
+
+import numpy as np
+
+from . import ir
+from .passmanager import PassManager
+from .compile import compile_from_string
+
+
+def _get_num_results(module: ir.Module, entry_func: str) -> int:
+    for op in module.body.operations:
+        if "sym_name" in op.attributes and ir.StringAttr(op.attributes["sym_name"]).value == entry_func:
+            func_type = ir.FunctionType(ir.TypeAttr(op.attributes["function_type"]).value)
+            return len(func_type.results)
+    raise ValueError("entry function {} not found".format(entry_func))
+
+
+def calibrate_int8(
+    input_string_or_bytes: Union[str, bytes],
+    calib_inputs: Sequence[Sequence[np.ndarray]],
+    workdir: str,
+    entry_func: str = "main",
+    target: str = "cpu",
+) -> List[float]:
+    """
+    Collect the activation absolute maximum of every int8 quantization
+    candidate by running the model on `calib_inputs` through the runtime.
+    The returned list could be passed to `byteir.compile` as `int8_act_absmax`.
+    """
+    import brt
+
+    context = ir.Context()
+    module = ir.Module.parse(input_string_or_bytes, context)
+    with context:
+        PassManager.parse("builtin.module(canonicalize,stablehlo-legalize-to-hlo,canonicalize)").run(module.operation)
+        num_results = _get_num_results(module, entry_func)
+        PassManager.parse("builtin.module(quantize-int8{{entry-func={} expose-activations}})".format(entry_func)).run(module.operation)
+        num_candidates = _get_num_results(module, entry_func) - num_results
+    if num_candidates == 0:
+        return []
+
+    module_bytes = io.BytesIO()
+    module.operation.write_bytecode(module_bytes)
+    calib_file_path = os.path.join(workdir, "calib.mlir")
+    compile_from_string(module_bytes.getvalue(), calib_file_path, entry_func=entry_func, target=target)
+
+    session = brt.Session(device=target.upper())
+    session.load(calib_file_path)
+    req = session.new_request_context(None)
+    input_offsets = session.get_input_arg_offsets()
+    output_offsets = session.get_output_arg_offsets()
+
+    abs_max = [0.0] * num_candidates
+    for inputs in calib_inputs:
+        assert len(inputs) == len(input_offsets)
+        inputs = [np.ascontiguousarray(i) for i in inputs]
+        outputs = [np.empty(session.get_static_shape(offset),
+                            dtype=session.get_data_type(offset).numpy())
+                   for offset in output_offsets]
+        req.bind_args([(offset, i.ctypes.data) for offset, i in zip(input_offsets, inputs)])
+        req.bind_args([(offset, o.ctypes.data) for offset, o in zip(output_offsets, outputs)])
+        req.finish_io_binding()
+        req.run()
+        req.sync()
+        for idx, activation in enumerate(outputs[num_results:]):
+            abs_max[idx] = max(abs_max[idx], float(np.abs(activation).max()))
+    return abs_max
@@ -25,6 +25,7 @@ if __name__ == "__main__":
                         help="specify target cpu arch")
     parser.add_argument("--serial_version", type=str, default="1.0.0", help="byre serialize version")
     parser.add_argument("-v", "--verbose", default=False, action="store_true")
+    parser.add_argument("--pass_profile_file", type=str, default=None, help="write per-pass time, op count and peak rss into this json file")
 
     # gpu options
     parser.add_argument("--enable_tf32", default=False, action="store_true")
@@ -42,4 +43,5 @@ if __name__ == "__main__":
                    verbose=args.verbose,
                    enable_tf32=args.enable_tf32,
                    parallelism=args.ait_parallelism,
-                   disable_byteir_ait_cache=args.disable_byteir_cache)
+                   disable_byteir_ait_cache=args.disable_byteir_cache,
+                   pass_profile_file=args.pass_profile_file)
@@ -30,6 +30,112 @@ def test_compile_mlp_inference_cpu_mlirbc():
     path = TEST_ROOT_DIR + "E2E/Host/Case0/00_Input.mlir"
     byteir.compile(path, temp_dir + "/test_cpu.mlirbc", entry_func="main", target="cpu")
 
+def test_compile_cpu_with_pass_profile():
+    import json
+    path = TEST_ROOT_DIR + "E2E/Host/Case0/00_Input.mlir"
+    profile_path = temp_dir + "/test_cpu.pass_profile.json"
+    byteir.compile(path, temp_dir + "/test_cpu_profile.mlir", entry_func="main", target="cpu",
+                   pass_profile_file=profile_path)
+    report = json.load(open(profile_path))
+    assert len(report["stages"]) > 0
+    assert any(p["argument"] == "canonicalize" for p in report["passes"])
+    assert all(p["wall_seconds"] >= 0 and p["ops_before"] > 0 for p in report["passes"])
+    assert all("rss_delta_kb" in p and "peak_rss_kb" not in p for p in report["passes"])
+
+# ==============================================================================
+# test int8 calibration
+
+def test_calibrate_int8():
+    import pytest
+    import numpy as np
+    from byteir.passmanager import PassManager
+    from byteir.quantization import calibrate_int8
+    from byteir.utils import mlir_attr_to_pyobj
+    pytest.importorskip("brt")
+
+    model = """
+func.func @main(%arg0 : tensor<4x2xf32>) -> tensor<4x2xf32> {
+  %0 = mhlo.constant dense<[[1.0, -2.0], [0.5, 4.0]]> : tensor<2x2xf32>
+  %1 = "mhlo.dot"(%arg0, %0) : (tensor<4x2xf32>, tensor<2x2xf32>) -> tensor<4x2xf32>
+  return %1 : tensor<4x2xf32>
+}
+"""
+    calib_inputs = [[np.full((4, 2), -3.0, dtype=np.float32)],
+                    [np.linspace(-1.0, 5.0, 8, dtype=np.float32).reshape(4, 2)]]
+    act_absmax = calibrate_int8(model, calib_inputs, tempfile.mkdtemp(), target="cpu")
+    assert np.allclose(act_absmax, [5.0])
+
+    context = ir.Context()
+    module = ir.Module.parse(model, context)
+    with context:
+        PassManager.parse("builtin.module(quantize-int8{{act-absmax={}}})".format(act_absmax[0])).run(module.operation)
+    ops = {}
+    for op in module.body.operations[0].regions[0].blocks[0].operations:
+        ops.setdefault(op.operation.name, []).append(op)
+
+    def const_value(value):
+        return mlir_attr_to_pyobj(value.owner.attributes["value"])
+
+    # activation: per-tensor symmetric scale, so zero point is 0 and the
+    # scaled activation is clamped to the full int8 range without an offset
+    act_scale = act_absmax[0] / 127.0
+    quant_mul = ops["mhlo.multiply"][0]
+    assert np.allclose(const_value(quant_mul.operands[1]), 1.0 / act_scale)
+    clamp = ops["mhlo.clamp"][0]
+    assert const_value(clamp.operands[0]) == -128.0
+    assert const_value(clamp.operands[2]) == 127.0
+    assert "mhlo.add" not in ops and "mhlo.subtract" not in ops
+
+    # weight: per-output-channel symmetric scales with channel abs max [1, 4]
+    weight = [op for op in ops["mhlo.constant"]
+              if ir.IntegerType.isinstance(ir.ShapedType(op.result.type).element_type)]
+    assert np.array_equal(const_value(weight[0].result), [[127, -64], [64, 127]])
+    dequant_scale = const_value(ops["mhlo.broadcast_in_dim"][0].operands[0])
+    assert np.allclose(dequant_scale, [act_scale * 1.0 / 127.0, act_scale * 4.0 / 127.0])
+
+# ==============================================================================
+# test shape buckets
+
+_dynamic_add = """
+func.func @main(%arg0 : tensor<?x4xf32>, %arg1 : tensor<?x4xf32>) -> tensor<?x4xf32> {
+  %0 = mhlo.add %arg0, %arg1 : tensor<?x4xf32>
+  return %0 : tensor<?x4xf32>
+}
+"""
+
+def _run_shape_buckets(target, batches):
+    import pytest
+    torch = pytest.importorskip("torch")
+    pytest.importorskip("brt")
+    from brt.backend import BRTShapeBucketBackend
+    output_dir = tempfile.mkdtemp()
+    byteir.compile_from_string(_dynamic_add, os.path.join(output_dir, "add.mlir"), target=target,
+                               shape_buckets=[{0: 2}])
+    backend = BRTShapeBucketBackend(os.path.join(output_dir, "add.buckets.json"), target)
+    for batch in batches:
+        lhs = torch.rand(batch, 4, device=target)
+        rhs = torch.rand(batch, 4, device=target)
+        outputs = backend.run([lhs, rhs])
+        assert torch.allclose(outputs[0], lhs + rhs)
+    return backend
+
+def test_shape_buckets_cpu():
+    import pytest
+    import torch
+    backend = _run_shape_buckets("cpu", [2])
+    # batch 3 matches no bucket, and the cpu target compiles no fallback
+    assert backend.fallback_path is None
+    with pytest.raises(AssertionError, match="no fallback"):
+        backend.run([torch.rand(3, 4), torch.rand(3, 4)])
+
+def test_shape_buckets_cuda_fallback():
+    import pytest
+    torch = pytest.importorskip("torch")
+    if not torch.cuda.is_available():
+        pytest.skip("cuda is not available")
+    backend = _run_shape_buckets("cuda", [2, 3, 2])
+    assert backend.fallback is not None
+
 # ==============================================================================
 # test merge two modules
 
@@ -0,0 +1,77 @@
+// RUN: byteir-opt %s -merge-host-kernels | FileCheck %s
+// RUN: byteir-opt %s -merge-host-kernels="fuse-loops=false" | FileCheck %s --check-prefix=NOFUSE
+
+module {
+  func.func private @Unknown0(%arg0: memref<1024xf32>) -> memref<1024xf32> attributes {__byteir_elementwise_fusion__} {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c1024 = arith.constant 1024 : index
+    %alloc = memref.alloc() : memref<1024xf32>
+    scf.for %arg1 = %c0 to %c1024 step %c1 {
+      %0 = memref.load %arg0[%arg1] : memref<1024xf32>
+      %1 = arith.negf %0 : f32
+      memref.store %1, %alloc[%arg1] : memref<1024xf32>
+    }
+    return %alloc : memref<1024xf32>
+  }
+  func.func private @Unknown1(%arg0: memref<1024xf32>, %arg1: memref<1024xf32>) -> memref<1024xf32> attributes {__byteir_elementwise_fusion__} {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c1024 = arith.constant 1024 : index
+    %alloc = memref.alloc() : memref<1024xf32>
+    scf.for %arg2 = %c0 to %c1024 step %c1 {
+      %0 = memref.load %arg0[%arg2] : memref<1024xf32>
+      %1 = memref.load %arg1[%arg2] : memref<1024xf32>
+      %2 = arith.addf %0, %1 : f32
+      memref.store %2, %alloc[%arg2] : memref<1024xf32>
+    }
+    return %alloc : memref<1024xf32>
+  }
+  func.func private @Unknown2(%arg0: memref<1024xf32>) -> memref<1024xf32> attributes {__byteir_elementwise_fusion__} {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c1023 = arith.constant 1023 : index
+    %c1024 = arith.constant 1024 : index
+    %alloc = memref.alloc() : memref<1024xf32>
+    scf.for %arg1 = %c0 to %c1024 step %c1 {
+      %0 = arith.subi %c1023, %arg1 : index
+      %1 = memref.load %arg0[%0] : memref<1024xf32>
+      memref.store %1, %alloc[%arg1] : memref<1024xf32>
+    }
+    return %alloc : memref<1024xf32>
+  }
+  func.func @main(%arg0: memref<1024xf32>) -> (memref<1024xf32>, memref<1024xf32>) attributes {__placeholder__byre.entry_point} {
+    %0 = call @Unknown0(%arg0) : (memref<1024xf32>) -> memref<1024xf32>
+    %1 = call @Unknown1(%0, %arg0) : (memref<1024xf32>, memref<1024xf32>) -> memref<1024xf32>
+    %2 = call @Unknown2(%1) : (memref<1024xf32>) -> memref<1024xf32>
+    return %1, %2 : memref<1024xf32>, memref<1024xf32>
+  }
+}
+
+// CHECK-LABEL: func.func private @Unknown0
+// CHECK-SAME: (%[[ARG0:.*]]: memref<1024xf32>) -> (memref<1024xf32>, memref<1024xf32>)
+// CHECK-SAME: __byteir_elementwise_fusion__
+// CHECK: scf.for %[[IV:.*]] =
+// CHECK-NEXT:   memref.load %[[ARG0]][%[[IV]]]
+// CHECK-NEXT:   arith.negf
+// CHECK-NEXT:   memref.store
+// CHECK-NEXT:   memref.load
+// CHECK-NEXT:   memref.load %[[ARG0]][%[[IV]]]
+// CHECK-NEXT:   arith.addf
+// CHECK-NEXT:   memref.store
+// CHECK-NEXT: }
+// reversed access could not be fused
+// CHECK: scf.for
+// CHECK: arith.subi
+// CHECK-NOT: scf.for
+// CHECK: return
+// CHECK-NOT: func.func private
+// CHECK-LABEL: func.func @main
+// CHECK-NEXT: %[[RES:.*]]:2 = call @Unknown0(%{{.*}}) : (memref<1024xf32>) -> (memref<1024xf32>, memref<1024xf32>)
+// CHECK-NEXT: return %[[RES]]#0, %[[RES]]#1
+
+// NOFUSE-LABEL: func.func private @Unknown0
+// NOFUSE-COUNT-3: scf.for
+// NOFUSE-LABEL: func.func @main
+// NOFUSE-NEXT: call @Unknown0
+// NOFUSE-NEXT: return
@@ -0,0 +1,16 @@
+// RUN: byteir-opt -hlo-fusion-to-linalg %s | FileCheck %s
+
+func.func @convert_conv2d_nchwc(%arg0: tensor<1x2x16x16x8xf32>, %arg1: tensor<2x2x3x3x8x8xf32>) -> tensor<1x2x7x7x8xf32> attributes {__byteir_hlo_aggressive_fusion__} {
+  %0 = mhlo.custom_call @byteir.conv2d_nchwc(%arg0, %arg1) {backend_config = "", byteir_attrs = {rhs_dilation = [1, 1], window_strides = [2, 2]}} : (tensor<1x2x16x16x8xf32>, tensor<2x2x3x3x8x8xf32>) -> tensor<1x2x7x7x8xf32>
+  return %0 : tensor<1x2x7x7x8xf32>
+}
+// CHECK-DAG: #[[IN:.*]] = affine_map<(d0, d1, d2, d3, d4, d5, d6, d7, d8) -> (d0, d5, d2 * 2 + d6, d3 * 2 + d7, d8)>
+// CHECK-DAG: #[[W:.*]] = affine_map<(d0, d1, d2, d3, d4, d5, d6, d7, d8) -> (d1, d5, d6, d7, d8, d4)>
+// CHECK-DAG: #[[OUT:.*]] = affine_map<(d0, d1, d2, d3, d4, d5, d6, d7, d8) -> (d0, d1, d2, d3, d4)>
+// CHECK-LABEL: func.func @convert_conv2d_nchwc
+// CHECK:  tensor.empty() : tensor<1x2x7x7x8xf32>
+// CHECK:  linalg.fill
+// CHECK:  linalg.generic {indexing_maps = [#[[IN]], #[[W]], #[[OUT]]], iterator_types = ["parallel", "parallel", "parallel", "parallel", "parallel", "reduction", "reduction", "reduction", "reduction"]}
+// CHECK:  arith.mulf
+// CHECK:  arith.addf
+// CHECK:  linalg.yield
@@ -0,0 +1,29 @@
+// RUN: byteir-opt --byre-to-byre-serial %s | FileCheck %s --check-prefix=SERIAL
+// RUN: byteir-opt --dump-byre="file-name=%t version=1.1.0" %s &>/dev/null && byteir-opt -load-byre %t | FileCheck %s
+// RUN: byteir-opt --dump-byre="file-name=%t0 version=1.0.0" %s &>/dev/null && byteir-opt -load-byre %t0 | FileCheck %s --check-prefix=V100
+
+module attributes {byre.container_module} {
+  func.func @test_resource(%arg0: memref<4xf32> {byre.argtype = 2: i32, byre.argname = "A"}) attributes {byre.entry_point} {
+    byre.compute @FillOp(%arg0) {value = dense_resource<blob> : tensor<4xf32>} : memref<4xf32>
+    return
+  }
+}
+
+{-#
+  dialect_resources: {
+    builtin: {
+      blob: "0x040000000000803F000000400000404000008040"
+    }
+  }
+#-}
+
+// SERIAL: dense_resource_elements_v1<{{.*}}, blob>
+// SERIAL: blob: "0x040000000000803F000000400000404000008040"
+
+// CHECK-LABEL: func.func @test_resource
+// CHECK: byre.compute @FillOp(%arg0) {value = dense_resource<blob> : tensor<4xf32>}
+// CHECK: blob: "0x040000000000803F000000400000404000008040"
+
+// V100-LABEL: func.func @test_resource
+// V100: byre.compute @FillOp(%arg0) {value = dense<[1.000000e+00, 2.000000e+00, 3.000000e+00, 4.000000e+00]> : tensor<4xf32>}
+// V100-NOT: dialect_resources
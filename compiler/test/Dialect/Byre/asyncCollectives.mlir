@@ -0,0 +1,109 @@
+// RUN: byteir-opt %s -byre-async-collectives -split-input-file | FileCheck %s
+
+module attributes {byre.container_module} {
+  func.func @overlap_all_reduce(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32},
+                                %arg1: memref<4xf32, "cuda"> {byre.argname = "Input1", byre.argtype = 1 : i32},
+                                %arg2: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32},
+                                %arg3: memref<4xf32, "cuda"> {byre.argname = "Output1", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Neg(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    %alloc_0 = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Exp(%arg1, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    %alloc_1 = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @nccl.AllReduce(%alloc, %alloc_1) {memory_effects = [1 : i32, 2 : i32], reduction = "sum", replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Log(%alloc_0, %arg3) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Abs(%alloc_1, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @overlap_all_reduce
+// CHECK: byre.compute @Neg(%{{.*}}, %[[SRC:[^)]*]])
+// CHECK-NEXT: %[[DST:.*]] = memref.alloc
+// CHECK-NEXT: byre.compute @nccl.AllReduce(%[[SRC]], %[[DST]]) {async_id = 0 : i64, memory_effects = [1 : i32, 2 : i32], {{.*}}synchronous = false}
+// CHECK-NEXT: memref.alloc
+// CHECK-NEXT: byre.compute @Exp
+// CHECK-NEXT: byre.compute @Log
+// CHECK-NEXT: byre.compute @nccl.Wait(%[[SRC]], %[[DST]]) {async_id = 0 : i64, memory_effects = [1 : i32, 2 : i32]}
+// CHECK-NEXT: byre.compute @Abs(%[[DST]]
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @nothing_to_overlap(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32},
+                                %arg1: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Neg(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @nccl.Broadcast(%alloc) {memory_effects = [3 : i32], replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">
+    byre.compute @Abs(%alloc, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @nothing_to_overlap
+// CHECK: byre.compute @nccl.Broadcast
+// CHECK-SAME: synchronous = true
+// CHECK-NOT: async_id
+// CHECK-NOT: nccl.Wait
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @keep_collective_order(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32},
+                                   %arg1: memref<4xf32, "cuda"> {byre.argname = "Input1", byre.argtype = 1 : i32},
+                                   %arg2: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32},
+                                   %arg3: memref<4xf32, "cuda"> {byre.argname = "Output1", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @nccl.AllReduce(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32], reduction = "sum", replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    %alloc_0 = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Neg(%arg1, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    %alloc_1 = memref.alloc() : memref<8xf32, "cuda">
+    byre.compute @nccl.AllGather(%arg1, %alloc_1) {axis = 0 : i64, memory_effects = [1 : i32, 2 : i32], replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">, memref<8xf32, "cuda">
+    byre.compute @Abs(%alloc_0, %arg3) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Exp(%alloc, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @keep_collective_order
+// CHECK: byre.compute @nccl.AllReduce
+// CHECK-SAME: async_id = 0 : i64
+// CHECK: byre.compute @nccl.AllGather
+// CHECK-SAME: async_id = 1 : i64
+// CHECK: byre.compute @Neg
+// CHECK: byre.compute @Abs
+// CHECK-NEXT: byre.compute @nccl.Wait
+// CHECK-SAME: async_id = 0 : i64
+// CHECK-NEXT: byre.compute @Exp
+// CHECK: byre.compute @nccl.Wait
+// CHECK-SAME: async_id = 1 : i64
+// CHECK-NEXT: return
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @wait_before_synchronous_collective(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32},
+                                                %arg1: memref<4xf32, "cuda"> {byre.argname = "Input1", byre.argtype = 1 : i32},
+                                                %arg2: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32},
+                                                %arg3: memref<4xf32, "cuda"> {byre.argname = "Output1", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @nccl.AllReduce(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32], reduction = "sum", replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    %alloc_0 = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Neg(%arg1, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @nccl.Broadcast(%alloc_0) {memory_effects = [3 : i32], replica_group = [0, 1], synchronous = true} : memref<4xf32, "cuda">
+    byre.compute @Abs(%alloc_0, %arg3) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Exp(%alloc, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @wait_before_synchronous_collective
+// CHECK: byre.compute @nccl.AllReduce
+// CHECK-SAME: async_id = 0 : i64
+// CHECK: byre.compute @Neg
+// CHECK-NEXT: byre.compute @nccl.Wait
+// CHECK-SAME: async_id = 0 : i64
+// CHECK-NEXT: byre.compute @nccl.Broadcast
+// CHECK-SAME: synchronous = true
+// CHECK-NEXT: byre.compute @Abs
+// CHECK-NEXT: byre.compute @Exp
@@ -0,0 +1,50 @@
+// RUN: byteir-opt %s -byre-numa-stage="num-stages=2" -split-input-file | FileCheck %s
+
+module attributes {byre.container_module} {
+  func.func @balanced(%arg0: memref<4xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<4xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<48xi8, "cpu">
+    %0 = "byre.alias"(%alloc) <{offset = 0 : i64}> : (memref<48xi8, "cpu">) -> memref<4xf32, "cpu">
+    %1 = "byre.alias"(%alloc) <{offset = 16 : i64}> : (memref<48xi8, "cpu">) -> memref<4xf32, "cpu">
+    %2 = "byre.alias"(%alloc) <{offset = 32 : i64}> : (memref<48xi8, "cpu">) -> memref<4xf32, "cpu">
+    byre.compute @Exp(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    byre.compute @Neg(%0, %1) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    byre.compute @Abs(%1, %2) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    byre.compute @Exp(%2, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @balanced
+// CHECK-NOT: byre.numa_node
+// CHECK: byre.compute @Exp
+// CHECK-SAME: byre.numa_node = 0
+// CHECK: byre.compute @Neg
+// CHECK-SAME: byre.numa_node = 0
+// CHECK: byre.compute @Abs
+// CHECK-SAME: byre.numa_node = 1
+// CHECK: byre.compute @Exp
+// CHECK-SAME: byre.numa_node = 1
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @matmul_flops(%arg0: memref<64x64xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<64x64xf32, "cpu"> {byre.argname = "Input1", byre.argtype = 1 : i32}, %arg2: memref<64x64xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<64x64xf32, "cpu">
+    %alloc_0 = memref.alloc() : memref<64x64xf32, "cpu">
+    byre.compute @MatmulOp(%arg0, %arg1, %alloc) {lhs_contracting_dimension = 1 : i64, memory_effects = [1 : i32, 1 : i32, 2 : i32], rhs_contracting_dimension = 0 : i64} : memref<64x64xf32, "cpu">, memref<64x64xf32, "cpu">, memref<64x64xf32, "cpu">
+    byre.compute @Exp(%alloc, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<64x64xf32, "cpu">, memref<64x64xf32, "cpu">
+    byre.compute @Neg(%alloc_0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<64x64xf32, "cpu">, memref<64x64xf32, "cpu">
+    byre.compute @Abs(%alloc, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<64x64xf32, "cpu">, memref<64x64xf32, "cpu">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @matmul_flops
+// CHECK: byre.compute @MatmulOp
+// CHECK-SAME: byre.numa_node = 0
+// CHECK: byre.compute @Exp
+// CHECK-SAME: byre.numa_node = 1
+// CHECK: byre.compute @Neg
+// CHECK-SAME: byre.numa_node = 1
+// CHECK: byre.compute @Abs
+// CHECK-SAME: byre.numa_node = 1
@@ -0,0 +1,65 @@
+// RUN: byteir-opt %s -byre-op-dependency -split-input-file | FileCheck %s
+
+module attributes {byre.container_module} {
+  func.func @planned_buffer(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<32xi8, "cuda">
+    %0 = "byre.alias"(%alloc) <{offset = 0 : i64}> : (memref<32xi8, "cuda">) -> memref<4xf32, "cuda">
+    %1 = "byre.alias"(%alloc) <{offset = 16 : i64}> : (memref<32xi8, "cuda">) -> memref<4xf32, "cuda">
+    byre.compute @Exp(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Neg(%arg0, %1) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Add(%0, %1, %arg1) {memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Abs(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @planned_buffer
+// CHECK: byre.compute @Exp
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.compute @Neg
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.compute @Add
+// CHECK-SAME: byre.dependency = [0, 1]
+// CHECK: byre.compute @Abs
+// CHECK-SAME: byre.dependency = [2]
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @aliased_argument(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<4xf32, "cuda"> {byre.argname = "Input1", byre.argtype = 1 : i32}, %arg2: memref<4xf32, "cuda"> {byre.arg_alias_index = 0 : i64, byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    %alloc_0 = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @Exp(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Neg(%arg1, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.copy(%alloc_0, %arg2) {callee = "cuda2cuda"} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @aliased_argument
+// CHECK: byre.compute @Exp
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.compute @Neg
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.copy
+// CHECK-SAME: byre.dependency = [0, 1]
+
+// -----
+
+module attributes {byre.container_module} {
+  func.func @keep_collective_order(%arg0: memref<4xf32, "cuda"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<4xf32, "cuda"> {byre.argname = "Output0", byre.argtype = 2 : i32}, %arg2: memref<4xf32, "cuda"> {byre.argname = "Output1", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<4xf32, "cuda">
+    byre.compute @nccl.AllReduce(%arg0, %arg1) {memory_effects = [1 : i32, 2 : i32], reduction = "sum", replica_group = [0, 1]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @Neg(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    byre.compute @nccl.Broadcast(%alloc, %arg2) {memory_effects = [1 : i32, 2 : i32], replica_group = [0, 1]} : memref<4xf32, "cuda">, memref<4xf32, "cuda">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @keep_collective_order
+// CHECK: byre.compute @nccl.AllReduce
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.compute @Neg
+// CHECK-SAME: byre.dependency = []
+// CHECK: byre.compute @nccl.Broadcast
+// CHECK-SAME: byre.dependency = [0, 1]
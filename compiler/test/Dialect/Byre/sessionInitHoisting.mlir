@@ -0,0 +1,32 @@
+// RUN: byteir-opt %s -byre-session-init-hoisting | FileCheck %s
+
+module attributes {byre.container_module} {
+  func.func @weight_transpose(%arg0: memref<4x8xf32, "cpu"> {byre.argname = "Weight0", byre.argtype = 4 : i32, byre.weight_value = dense<1.000000e+00> : tensor<4x8xf32>},
+                              %arg1: memref<2x4xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32},
+                              %arg2: memref<2x8xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<8x4xf32, "cpu">
+    byre.compute @TransposeOp_f32_f32(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32], permutation = dense<[1, 0]> : tensor<2xi64>} : memref<4x8xf32, "cpu">, memref<8x4xf32, "cpu">
+    %alloc_0 = memref.alloc() : memref<8x4xf16, "cpu">
+    byre.compute @Typecvt_f32_f16(%alloc, %alloc_0) {memory_effects = [1 : i32, 2 : i32]} : memref<8x4xf32, "cpu">, memref<8x4xf16, "cpu">
+    %alloc_1 = memref.alloc() : memref<2x4xf16, "cpu">
+    byre.compute @Typecvt_f32_f16(%arg1, %alloc_1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32, "cpu">, memref<2x4xf16, "cpu">
+    byre.compute @MatmulOp_f16f16_f32(%alloc_1, %alloc_0, %arg2) {lhs_contracting_dimension = 1 : i64, rhs_contracting_dimension = 1 : i64, memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<2x4xf16, "cpu">, memref<8x4xf16, "cpu">, memref<2x8xf32, "cpu">
+    return
+  }
+}
+
+// CHECK-LABEL: func.func @weight_transpose
+// CHECK-SAME: %[[W0:[^:]*]]: memref<4x8xf32, "cpu"> {byre.argname = "Weight0", byre.argtype = 4 : i32
+// CHECK-SAME: %[[IN:[^:]*]]: memref<2x4xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32}
+// CHECK-SAME: %[[OUT:[^:]*]]: memref<2x8xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}
+// CHECK: %[[S0:.*]] = memref.alloc() {byre.session_init} : memref<8x4xf32, "cpu">
+// CHECK: byre.compute @TransposeOp_f32_f32(%[[W0]], %[[S0]])
+// CHECK-SAME: byre.session_init
+// CHECK: %[[S1:.*]] = memref.alloc() {byre.session_init} : memref<8x4xf16, "cpu">
+// CHECK: byre.compute @Typecvt_f32_f16(%[[S0]], %[[S1]])
+// CHECK-SAME: byre.session_init
+// CHECK: %[[ALLOC:.*]] = memref.alloc() : memref<2x4xf16, "cpu">
+// CHECK: byre.compute @Typecvt_f32_f16(%[[IN]], %[[ALLOC]])
+// CHECK-NOT: byre.session_init
+// CHECK: byre.compute @MatmulOp_f16f16_f32(%[[ALLOC]], %[[S1]], %[[OUT]])
+// CHECK-NOT: byre.session_init
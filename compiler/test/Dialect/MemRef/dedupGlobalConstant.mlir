@@ -0,0 +1,35 @@
+// RUN: byteir-opt %s -dedup-global-constant | FileCheck %s
+
+module {
+  memref.global "private" constant @embedding : memref<2x4xf32> = dense<[[1.0, 2.0, 3.0, 4.0], [5.0, 6.0, 7.0, 8.0]]>
+  memref.global "private" constant @embedding_tied : memref<2x4xf32> = dense<[[1.0, 2.0, 3.0, 4.0], [5.0, 6.0, 7.0, 8.0]]>
+  memref.global "private" constant @embedding_flat : memref<8xf32> = dense<[1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]> {alignment = 64 : i64}
+  memref.global "private" constant @other : memref<2x4xf32> = dense<[[1.0, 2.0, 3.0, 4.0], [5.0, 6.0, 7.0, 9.0]]>
+  memref.global "private" constant @splat0 : memref<2x4xf32> = dense<1.0>
+  memref.global "private" constant @splat1 : memref<2x4xf32> = dense<1.0>
+  func.func @tied_weights() -> (memref<2x4xf32>, memref<2x4xf32>, memref<8xf32>, memref<2x4xf32>, memref<2x4xf32>, memref<2x4xf32>) {
+    %0 = memref.get_global @embedding : memref<2x4xf32>
+    %1 = memref.get_global @embedding_tied : memref<2x4xf32>
+    %2 = memref.get_global @embedding_flat : memref<8xf32>
+    %3 = memref.get_global @other : memref<2x4xf32>
+    %4 = memref.get_global @splat0 : memref<2x4xf32>
+    %5 = memref.get_global @splat1 : memref<2x4xf32>
+    return %0, %1, %2, %3, %4, %5 : memref<2x4xf32>, memref<2x4xf32>, memref<8xf32>, memref<2x4xf32>, memref<2x4xf32>, memref<2x4xf32>
+  }
+}
+
+// CHECK: memref.global "private" constant @embedding : memref<2x4xf32> = dense<{{.*}}> {alignment = 64 : i64}
+// CHECK-NOT: @embedding_tied
+// CHECK-NOT: @embedding_flat
+// CHECK: memref.global "private" constant @other
+// CHECK: memref.global "private" constant @splat0
+// CHECK: memref.global "private" constant @splat1
+// CHECK-LABEL: func.func @tied_weights
+// CHECK: %[[V0:.*]] = memref.get_global @embedding : memref<2x4xf32>
+// CHECK: %[[V1:.*]] = memref.get_global @embedding : memref<2x4xf32>
+// CHECK: %[[V2:.*]] = memref.get_global @embedding : memref<2x4xf32>
+// CHECK: %[[FLAT:.*]] = memref.collapse_shape %[[V2]] {{\[}}[0, 1]] : memref<2x4xf32> into memref<8xf32>
+// CHECK: %[[V3:.*]] = memref.get_global @other
+// CHECK: %[[V4:.*]] = memref.get_global @splat0
+// CHECK: %[[V5:.*]] = memref.get_global @splat1
+// CHECK: return %[[V0]], %[[V1]], %[[FLAT]], %[[V3]], %[[V4]], %[[V5]]
@@ -0,0 +1,122 @@
+// RUN: byteir-opt %s -inplace-concat-slice -split-input-file | FileCheck %s
+
+func.func @concat_operands(%arg0: memref<2x4xf32>, %arg1: memref<4x4xf32>) attributes {__placeholder__byre.entry_point} {
+  %0 = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  %1 = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  %2 = memref.alloc() : memref<4x4xf32>
+  %subview = memref.subview %2[0, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1]>>
+  memref.copy %0, %subview : memref<2x4xf32> to memref<2x4xf32, strided<[4, 1]>>
+  %subview_0 = memref.subview %2[2, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  memref.copy %1, %subview_0 : memref<2x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  byre.compute @bar(%2, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<4x4xf32>, memref<4x4xf32>
+  return
+}
+// CHECK-LABEL: func.func @concat_operands
+// CHECK:  %[[ALLOC:.*]] = memref.alloc() : memref<4x4xf32>
+// CHECK:  %[[ALIAS0:.*]] = "byre.alias"(%[[ALLOC]]) {{.*}}offset = 0
+// CHECK:  byre.compute @foo(%{{.*}}, %[[ALIAS0]])
+// CHECK:  %[[ALIAS1:.*]] = "byre.alias"(%[[ALLOC]]) {{.*}}offset = 8
+// CHECK:  byre.compute @foo(%{{.*}}, %[[ALIAS1]])
+// CHECK-NOT:  memref.copy
+// CHECK:  byre.compute @bar(%[[ALLOC]], %{{.*}})
+
+// -----
+
+func.func @concat_strided_operand() -> memref<2x8xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = memref.alloc() : memref<2x4xf32>
+  linalg.fill ins(%cst : f32) outs(%0 : memref<2x4xf32>)
+  %1 = memref.alloc() : memref<2x8xf32>
+  %subview = memref.subview %1[0, 4] [2, 4] [1, 1] : memref<2x8xf32> to memref<2x4xf32, strided<[8, 1], offset: 4>>
+  memref.copy %0, %subview : memref<2x4xf32> to memref<2x4xf32, strided<[8, 1], offset: 4>>
+  return %1 : memref<2x8xf32>
+}
+// CHECK-LABEL: func.func @concat_strided_operand
+// CHECK:  %[[ALLOC:.*]] = memref.alloc() : memref<2x8xf32>
+// CHECK:  %[[VIEW:.*]] = memref.subview %[[ALLOC]][0, 4] [2, 4] [1, 1]
+// CHECK:  linalg.fill {{.*}}outs(%[[VIEW]]
+// CHECK-NOT:  memref.copy
+// CHECK:  return %[[ALLOC]]
+
+// -----
+
+func.func @concat_strided_operand_of_byre(%arg0: memref<2x4xf32>, %arg1: memref<2x8xf32>) attributes {__placeholder__byre.entry_point} {
+  %0 = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  %1 = memref.alloc() : memref<2x8xf32>
+  %subview = memref.subview %1[0, 4] [2, 4] [1, 1] : memref<2x8xf32> to memref<2x4xf32, strided<[8, 1], offset: 4>>
+  memref.copy %0, %subview : memref<2x4xf32> to memref<2x4xf32, strided<[8, 1], offset: 4>>
+  byre.compute @bar(%1, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x8xf32>, memref<2x8xf32>
+  return
+}
+// CHECK-LABEL: func.func @concat_strided_operand_of_byre
+// CHECK-NOT:  byre.alias
+// CHECK:  memref.copy
+
+// -----
+
+func.func @concat_operand_overwritten(%arg0: memref<2x4xf32>, %arg1: memref<4x4xf32>) attributes {__placeholder__byre.entry_point} {
+  %0 = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %0) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  %1 = memref.alloc() : memref<4x4xf32>
+  byre.compute @bar(%arg1, %1) {memory_effects = [1 : i32, 2 : i32]} : memref<4x4xf32>, memref<4x4xf32>
+  %subview = memref.subview %1[0, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1]>>
+  memref.copy %0, %subview : memref<2x4xf32> to memref<2x4xf32, strided<[4, 1]>>
+  byre.compute @bar(%1, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<4x4xf32>, memref<4x4xf32>
+  return
+}
+// CHECK-LABEL: func.func @concat_operand_overwritten
+// CHECK:  memref.alloc() : memref<2x4xf32>
+// CHECK:  byre.compute @foo
+// CHECK:  memref.alloc() : memref<4x4xf32>
+// CHECK-NOT:  byre.alias
+// CHECK:  memref.copy
+
+// -----
+
+func.func @slice(%arg0: memref<4x4xf32>, %arg1: memref<2x4xf32>) attributes {__placeholder__byre.entry_point} {
+  %subview = memref.subview %arg0[2, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  %0 = memref.alloc() : memref<2x4xf32>
+  memref.copy %subview, %0 : memref<2x4xf32, strided<[4, 1], offset: 8>> to memref<2x4xf32>
+  byre.compute @foo(%0, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  return
+}
+// CHECK-LABEL: func.func @slice
+// CHECK:  %[[ALIAS:.*]] = "byre.alias"(%arg0) {{.*}}offset = 8
+// CHECK-NOT:  memref.copy
+// CHECK:  byre.compute @foo(%[[ALIAS]], %arg1)
+
+// -----
+
+func.func @slice_overwritten(%arg0: memref<4x4xf32>, %arg1: memref<2x4xf32>) attributes {__placeholder__byre.entry_point} {
+  %subview = memref.subview %arg0[2, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  %0 = memref.alloc() : memref<2x4xf32>
+  memref.copy %subview, %0 : memref<2x4xf32, strided<[4, 1], offset: 8>> to memref<2x4xf32>
+  byre.compute @foo(%arg1, %arg0) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<4x4xf32>
+  byre.compute @foo(%0, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  return
+}
+// CHECK-LABEL: func.func @slice_overwritten
+// CHECK-NOT:  byre.alias
+// CHECK:  memref.copy
+
+// -----
+
+func.func @slice_overwritten_through_sibling_view(%arg0: memref<4x4xf32>, %arg1: memref<2x4xf32>) {
+  %cst = arith.constant 0.000000e+00 : f32
+  %outer = memref.subview %arg0[2, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  %subview = memref.subview %outer[0, 0] [2, 4] [1, 1] : memref<2x4xf32, strided<[4, 1], offset: 8>> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  %0 = memref.alloc() : memref<2x4xf32>
+  memref.copy %subview, %0 : memref<2x4xf32, strided<[4, 1], offset: 8>> to memref<2x4xf32>
+  %sibling = memref.subview %arg0[2, 0] [2, 4] [1, 1] : memref<4x4xf32> to memref<2x4xf32, strided<[4, 1], offset: 8>>
+  linalg.fill ins(%cst : f32) outs(%sibling : memref<2x4xf32, strided<[4, 1], offset: 8>>)
+  memref.copy %0, %arg1 : memref<2x4xf32> to memref<2x4xf32>
+  return
+}
+// CHECK-LABEL: func.func @slice_overwritten_through_sibling_view
+// CHECK:  %[[ALLOC:.*]] = memref.alloc() : memref<2x4xf32>
+// CHECK:  memref.copy %{{.*}}, %[[ALLOC]]
+// CHECK:  linalg.fill
+// CHECK:  memref.copy %[[ALLOC]], %arg1
@@ -687,3 +687,53 @@ func.func @byre_alias(%arg0: memref<512x200xf32>, %arg1: memref<512x200xf32>) ->
 // CHECK-LABEL: func.func @byre_alias
 // CHECK-NOT:  memref.copy
 // CHECK:      byre.alias
+
+// -----
+
+func.func @forward_byre_copy_to_output(%arg0: memref<2x4xf32>, %arg1: memref<2x4xf32>, %arg2: memref<8xf32>) attributes {__placeholder__byre.entry_point} {
+  %alloc = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  byre.copy(%alloc, %arg2) {callee = "cpu2cpu"} : memref<2x4xf32>, memref<8xf32>
+  byre.compute @bar(%alloc, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  return
+}
+
+// CHECK-LABEL: func.func @forward_byre_copy_to_output
+// CHECK:  %[[ALIAS:.*]] = "byre.alias"(%arg2) {{.*}}offset = 0
+// CHECK:  byre.compute @foo(%arg0, %[[ALIAS]])
+// CHECK-NOT:  byre.copy
+// CHECK:  byre.compute @bar(%[[ALIAS]], %arg1)
+
+// -----
+
+func.func @forward_copy_to_reused_output(%arg0: memref<2x4xf32>, %arg1: memref<2x4xf32>, %arg2: memref<2x4xf32>, %arg3: memref<2x4xf32>) attributes {__placeholder__byre.entry_point} {
+  byre.compute @scratch(%arg0, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  byre.compute @consume(%arg2, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  %alloc = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  memref.copy %alloc, %arg2 : memref<2x4xf32> to memref<2x4xf32>
+  byre.compute @bar(%alloc, %arg3) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  return
+}
+
+// CHECK-LABEL: func.func @forward_copy_to_reused_output
+// CHECK:  byre.compute @scratch(%arg0, %arg2)
+// CHECK:  byre.compute @consume(%arg2, %arg1)
+// CHECK:  byre.compute @foo(%arg0, %arg2)
+// CHECK-NOT:  memref.copy
+// CHECK:  byre.compute @bar(%arg2, %arg3)
+
+// -----
+
+func.func @cannot_forward_copy_to_output(%arg0: memref<2x4xf32>, %arg1: memref<2x4xf32>, %arg2: memref<8xf32>) attributes {__placeholder__byre.entry_point} {
+  %alloc = memref.alloc() : memref<2x4xf32>
+  byre.compute @foo(%arg0, %alloc) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  byre.copy(%alloc, %arg2) {callee = "cpu2cpu"} : memref<2x4xf32>, memref<8xf32>
+  byre.compute @baz(%arg0, %arg2) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<8xf32>
+  byre.compute @bar(%alloc, %arg1) {memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32>, memref<2x4xf32>
+  return
+}
+
+// CHECK-LABEL: func.func @cannot_forward_copy_to_output
+// CHECK-NOT:  byre.alias
+// CHECK:  byre.copy
@@ -17,3 +17,29 @@ func.func @conv_bn_inference(%arg0: tensor<1x1x2x2xf32>) -> tensor<1x2x2x2xf32>
 // CHECK-NEXT:  "mhlo.broadcast_in_dim"
 // CHECK-NEXT:  mhlo.add
 // CHECK-NEXT:  return
+
+func.func @conv_bn_inference_resource_weight(%arg0: tensor<1x1x2x2xf32>) -> tensor<1x2x2x2xf32> {
+  %weight = mhlo.constant dense_resource<conv_weight> : tensor<1x1x1x2xf32>
+  %scale = mhlo.constant dense<[2.000000e+00, 1.000000e+00]> : tensor<2xf32>
+  %offset = mhlo.constant dense<[1.000000e+00, 2.000000e+00]> : tensor<2xf32>
+  %mean = mhlo.constant dense<[2.000000e+00, 1.000000e+00]> : tensor<2xf32>
+  %variance = mhlo.constant dense<[1.000000e+00, 2.000000e+00]> : tensor<2xf32>
+  %conv = mhlo.convolution(%arg0, %weight) dim_numbers = [b, f, 0, 1]x[0, 1, i, o]->[b, f, 0, 1], window = {stride = [1, 1], pad = [[0, 0], [0, 0]], rhs_dilate = [1, 1]} {batch_group_count = 1 : i64, feature_group_count = 1 : i64} : (tensor<1x1x2x2xf32>, tensor<1x1x1x2xf32>) -> tensor<1x2x2x2xf32>
+  %bn = "mhlo.batch_norm_inference"(%conv, %scale, %offset, %mean, %variance) {epsilon = 1.001000e-05 : f32, feature_index = 1 : i64} : (tensor<1x2x2x2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>, tensor<2xf32>) -> tensor<1x2x2x2xf32>
+  return %bn : tensor<1x2x2x2xf32>
+}
+// resource blobs are never folded into new constants
+// CHECK-LABEL: func.func @conv_bn_inference_resource_weight
+// CHECK:  %[[WEIGHT:.*]] = mhlo.constant dense_resource<conv_weight> : tensor<1x1x1x2xf32>
+// CHECK:  mhlo.convolution(%arg0, %[[WEIGHT]])
+// CHECK:  mhlo.multiply
+// CHECK:  mhlo.add
+// CHECK:  return
+
+{-#
+  dialect_resources: {
+    builtin: {
+      conv_weight: "0x040000000000803F00000040"
+    }
+  }
+#-}
@@ -0,0 +1,21 @@
+// RUN: byteir-opt %s -bf16-mixed-precision | FileCheck %s
+
+func.func @dot_with_weight(%arg0 : tensor<4x2xf32>) -> tensor<4x3xf32> {
+  %0 = mhlo.constant dense<1.0> : tensor<2x3xf32>
+  %1 = "mhlo.dot"(%arg0, %0) : (tensor<4x2xf32>, tensor<2x3xf32>) -> tensor<4x3xf32>
+  %2 = mhlo.add %1, %1 : tensor<4x3xf32>
+  return %2 : tensor<4x3xf32>
+}
+// CHECK-LABEL: func.func @dot_with_weight
+// CHECK-DAG: %[[WEIGHT:.*]] = mhlo.constant dense<1.000000e+00> : tensor<2x3xbf16>
+// CHECK-DAG: %[[LHS:.*]] = mhlo.convert %arg0 : (tensor<4x2xf32>) -> tensor<4x2xbf16>
+// CHECK: %[[DOT:.*]] = {{.*}}mhlo.dot{{.*}}%[[LHS]], %[[WEIGHT]]
+// CHECK-SAME: (tensor<4x2xbf16>, tensor<2x3xbf16>) -> tensor<4x3xf32>
+// CHECK: mhlo.add %[[DOT]], %[[DOT]] : tensor<4x3xf32>
+
+func.func @f16_dot(%arg0 : tensor<4x2xf16>, %arg1 : tensor<2x3xf16>) -> tensor<4x3xf16> {
+  %0 = "mhlo.dot"(%arg0, %arg1) : (tensor<4x2xf16>, tensor<2x3xf16>) -> tensor<4x3xf16>
+  return %0 : tensor<4x3xf16>
+}
+// CHECK-LABEL: func.func @f16_dot
+// CHECK-NOT: mhlo.convert
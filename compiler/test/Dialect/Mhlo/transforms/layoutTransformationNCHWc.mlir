@@ -0,0 +1,57 @@
+// RUN: byteir-opt %s -transform-layout="target-layout=NCHW8c" | FileCheck %s
+
+func.func @conv_bias_relu(%arg0: tensor<1x16x14x14xf32>, %arg1: tensor<16xf32>) -> tensor<1x16x14x14xf32> attributes {byteir.layout = "NCHW"} {
+  %0 = mhlo.constant dense<1.000000e+00> : tensor<16x16x3x3xf32>
+  %1 = mhlo.convolution(%arg0, %0) dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1], window = {stride = [1, 1], pad = [[1, 1], [1, 1]], rhs_dilate = [1, 1]} {batch_group_count = 1 : i64, feature_group_count = 1 : i64} : (tensor<1x16x14x14xf32>, tensor<16x16x3x3xf32>) -> tensor<1x16x14x14xf32>
+  %2 = "mhlo.broadcast_in_dim"(%arg1) {broadcast_dimensions = dense<1> : tensor<1xi64>} : (tensor<16xf32>) -> tensor<1x16x14x14xf32>
+  %3 = mhlo.add %1, %2 : tensor<1x16x14x14xf32>
+  %4 = mhlo.constant dense<0.000000e+00> : tensor<1x16x14x14xf32>
+  %5 = mhlo.maximum %3, %4 : tensor<1x16x14x14xf32>
+  return %5 : tensor<1x16x14x14xf32>
+}
+// CHECK-LABEL: @conv_bias_relu
+// CHECK:  mhlo.reshape{{.*}}-> tensor<1x2x8x14x14xf32>
+// CHECK:  mhlo.transpose{{.*}}permutation = dense<[0, 1, 3, 4, 2]>
+// CHECK:  mhlo.pad{{.*}}-> tensor<1x2x16x16x8xf32>
+// CHECK:  mhlo.custom_call @byteir.conv2d_nchwc{{.*}}byteir_attrs = {rhs_dilation = [1, 1], window_strides = [1, 1]}
+// CHECK-SAME:  (tensor<1x2x16x16x8xf32>, tensor<2x2x3x3x8x8xf32>) -> tensor<1x2x14x14x8xf32>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.reshape{{.*}}(tensor<16xf32>) -> tensor<2x8xf32>
+// CHECK:  mhlo.broadcast_in_dim{{.*}}broadcast_dimensions = dense<[1, 4]>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.add{{.*}}tensor<1x2x14x14x8xf32>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.maximum{{.*}}tensor<1x2x14x14x8xf32>
+// CHECK:  mhlo.transpose{{.*}}permutation = dense<[0, 1, 4, 2, 3]>
+// CHECK:  mhlo.reshape{{.*}}-> tensor<1x16x14x14xf32>
+// CHECK:  return
+
+func.func @conv_bn_pool(%arg0: tensor<1x8x8x8xf32>, %arg1: tensor<16x8x1x1xf32>, %arg2: tensor<16xf32>, %arg3: tensor<16xf32>, %arg4: tensor<16xf32>, %arg5: tensor<16xf32>) -> tensor<1x16x4x4xf32> attributes {byteir.layout = "NCHW"} {
+  %0 = mhlo.convolution(%arg0, %arg1) dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1], window = {stride = [1, 1], pad = [[0, 0], [0, 0]], rhs_dilate = [1, 1]} {batch_group_count = 1 : i64, feature_group_count = 1 : i64} : (tensor<1x8x8x8xf32>, tensor<16x8x1x1xf32>) -> tensor<1x16x8x8xf32>
+  %1 = "mhlo.batch_norm_inference"(%0, %arg2, %arg3, %arg4, %arg5) {epsilon = 9.99999974E-6 : f32, feature_index = 1 : i64} : (tensor<1x16x8x8xf32>, tensor<16xf32>, tensor<16xf32>, tensor<16xf32>, tensor<16xf32>) -> tensor<1x16x8x8xf32>
+  %2 = mhlo.constant dense<0xFF800000> : tensor<f32>
+  %3 = "mhlo.reduce_window"(%1, %2) ({
+  ^bb0(%arg6: tensor<f32>, %arg7: tensor<f32>):
+    %4 = mhlo.maximum %arg6, %arg7 : tensor<f32>
+    mhlo.return %4 : tensor<f32>
+  }) {padding = dense<0> : tensor<4x2xi64>, window_dimensions = dense<[1, 1, 2, 2]> : tensor<4xi64>, window_strides = dense<[1, 1, 2, 2]> : tensor<4xi64>} : (tensor<1x16x8x8xf32>, tensor<f32>) -> tensor<1x16x4x4xf32>
+  return %3 : tensor<1x16x4x4xf32>
+}
+// CHECK-LABEL: @conv_bn_pool
+// CHECK:  mhlo.transpose{{.*}}permutation = dense<[0, 1, 3, 4, 2]>
+// CHECK:  mhlo.reshape{{.*}}(tensor<16x8x1x1xf32>) -> tensor<2x8x1x8x1x1xf32>
+// CHECK:  mhlo.transpose{{.*}}permutation = dense<[0, 2, 4, 5, 3, 1]>
+// CHECK:  mhlo.custom_call @byteir.conv2d_nchwc{{.*}}-> tensor<1x2x8x8x8xf32>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.rsqrt
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.multiply{{.*}}tensor<1x2x8x8x8xf32>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.add{{.*}}tensor<1x2x8x8x8xf32>
+// CHECK-NOT:  mhlo.transpose
+// CHECK:  mhlo.reduce_window
+// CHECK:  window_dimensions = dense<[1, 1, 2, 2, 1]>
+// CHECK-SAME:  -> tensor<1x2x4x4x8xf32>
+// CHECK:  mhlo.transpose{{.*}}permutation = dense<[0, 1, 4, 2, 3]>
+// CHECK:  mhlo.reshape{{.*}}-> tensor<1x16x4x4xf32>
+// CHECK:  return
@@ -0,0 +1,32 @@
+// RUN: byteir-opt %s -quantize-int8="act-absmax=127.0,0.0" | FileCheck %s
+// RUN: byteir-opt %s -quantize-int8="expose-activations" | FileCheck %s --check-prefix=EXPOSE
+
+func.func @main(%arg0 : tensor<4x2xf32>, %arg1 : tensor<1x3x8x8xf32>) -> (tensor<4x2xf32>, tensor<1x2x8x8xf32>) {
+  %0 = mhlo.constant dense<[[1.0, -2.0], [0.5, 4.0]]> : tensor<2x2xf32>
+  %1 = "mhlo.dot"(%arg0, %0) : (tensor<4x2xf32>, tensor<2x2xf32>) -> tensor<4x2xf32>
+  %2 = mhlo.constant dense<1.0> : tensor<2x3x3x3xf32>
+  %3 = mhlo.convolution(%arg1, %2) dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1], window = {stride = [1, 1], pad = [[1, 1], [1, 1]], rhs_dilate = [1, 1]} {batch_group_count = 1 : i64, feature_group_count = 1 : i64} : (tensor<1x3x8x8xf32>, tensor<2x3x3x3xf32>) -> tensor<1x2x8x8xf32>
+  return %1, %3 : tensor<4x2xf32>, tensor<1x2x8x8xf32>
+}
+// CHECK-LABEL: func.func @main
+// CHECK: %[[INV_SCALE:.*]] = mhlo.constant dense<1.000000e+00> : tensor<4x2xf32>
+// CHECK: %[[SCALED:.*]] = mhlo.multiply %arg0, %[[INV_SCALE]]
+// CHECK: %[[ROUNDED:.*]] = mhlo.round_nearest_even %[[SCALED]]
+// CHECK: %[[CLAMPED:.*]] = mhlo.clamp %{{.*}}, %[[ROUNDED]], %{{.*}}
+// CHECK: %[[QUANT:.*]] = mhlo.convert %[[CLAMPED]] : (tensor<4x2xf32>) -> tensor<4x2xi8>
+// CHECK: %[[WEIGHT:.*]] = mhlo.constant dense<{{\[\[}}127, -64], [64, 127]]> : tensor<2x2xi8>
+// CHECK: %[[DOT:.*]] = {{.*}}mhlo.dot{{.*}}%[[QUANT]], %[[WEIGHT]]
+// CHECK-SAME: (tensor<4x2xi8>, tensor<2x2xi8>) -> tensor<4x2xi32>
+// CHECK: %[[DEQUANT:.*]] = mhlo.convert %[[DOT]] : (tensor<4x2xi32>) -> tensor<4x2xf32>
+// CHECK: %[[SCALE:.*]] = "mhlo.broadcast_in_dim"
+// CHECK-SAME: broadcast_dimensions = dense<1>
+// CHECK: %[[RES:.*]] = mhlo.multiply %[[DEQUANT]], %[[SCALE]]
+// CHECK: mhlo.convolution
+// CHECK-SAME: (tensor<1x3x8x8xf32>, tensor<2x3x3x3xf32>) -> tensor<1x2x8x8xf32>
+// CHECK: return %[[RES]]
+
+// EXPOSE-LABEL: func.func @main
+// EXPOSE-SAME: -> (tensor<4x2xf32>, tensor<1x2x8x8xf32>, tensor<4x2xf32>, tensor<1x3x8x8xf32>)
+// EXPOSE: mhlo.dot{{.*}}%arg0
+// EXPOSE-SAME: -> tensor<4x2xf32>
+// EXPOSE: return %{{.*}}, %{{.*}}, %arg0, %arg1
@@ -0,0 +1,105 @@
+// RUN: byteir-opt %s -scf-software-prefetch="distance=4" | FileCheck %s
+
+func.func @strided(%arg0: memref<128x64xf32>, %arg1: memref<128xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c128 = arith.constant 128 : index
+  scf.for %arg2 = %c0 to %c128 step %c1 {
+    %0 = memref.load %arg0[%arg2, %c0] : memref<128x64xf32>
+    memref.store %0, %arg1[%arg2] : memref<128xf32>
+  }
+  return
+}
+// CHECK-LABEL: func.func @strided
+// CHECK: %[[DIST:.*]] = arith.constant 4 : index
+// CHECK: %[[OFFSET:.*]] = arith.muli %{{.*}}, %[[DIST]] : index
+// CHECK: scf.for %[[IV:.*]] = %{{.*}} to %[[UB:.*]] step
+// CHECK-NEXT:   %[[NEXT:.*]] = arith.addi %[[IV]], %[[OFFSET]] : index
+// CHECK-NEXT:   %[[INB:.*]] = arith.cmpi slt, %[[NEXT]], %[[UB]] : index
+// CHECK-NEXT:   %[[AHEAD:.*]] = arith.select %[[INB]], %[[NEXT]], %[[IV]] : index
+// CHECK-NEXT:   memref.prefetch %arg0[%[[AHEAD]], %{{.*}}], read, locality<3>, data : memref<128x64xf32>
+// CHECK-NEXT:   memref.load
+// CHECK-NEXT:   memref.store
+
+func.func @embedding(%arg0: memref<1000x64xf32>, %arg1: memref<16xi64>, %arg2: memref<16x64xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c16 = arith.constant 16 : index
+  %c64 = arith.constant 64 : index
+  scf.for %arg3 = %c0 to %c16 step %c1 {
+    %0 = memref.load %arg1[%arg3] : memref<16xi64>
+    %1 = arith.index_cast %0 : i64 to index
+    scf.for %arg4 = %c0 to %c64 step %c1 {
+      %2 = memref.load %arg0[%1, %arg4] : memref<1000x64xf32>
+      memref.store %2, %arg2[%arg3, %arg4] : memref<16x64xf32>
+    }
+  }
+  return
+}
+// CHECK-LABEL: func.func @embedding
+// CHECK: scf.for %[[IV:.*]] = %[[LB:.*]] to %{{.*}} step
+// CHECK-NEXT:   %[[NEXT:.*]] = arith.addi %[[IV]]
+// CHECK-NEXT:   %[[INB:.*]] = arith.cmpi slt, %[[NEXT]]
+// CHECK-NEXT:   %[[AHEAD:.*]] = arith.select %[[INB]], %[[NEXT]], %[[IV]] : index
+// CHECK-NEXT:   %[[IDX:.*]] = memref.load %arg1[%[[AHEAD]]] : memref<16xi64>
+// CHECK-NEXT:   %[[ROW:.*]] = arith.index_cast %[[IDX]] : i64 to index
+// CHECK-NEXT:   memref.prefetch %arg0[%[[ROW]], %[[LB]]], read, locality<3>, data : memref<1000x64xf32>
+// CHECK-NEXT:   %[[C16:.*]] = arith.constant 16 : index
+// CHECK-NEXT:   %[[COL1:.*]] = arith.addi %[[LB]], %[[C16]] : index
+// CHECK-NEXT:   memref.prefetch %arg0[%[[ROW]], %[[COL1]]]
+// CHECK:        memref.prefetch %arg0[%[[ROW]], %{{.*}}]
+// CHECK:        memref.prefetch %arg0[%[[ROW]], %{{.*}}]
+// CHECK-NOT:    memref.prefetch
+// CHECK:        memref.load %arg1[%[[IV]]]
+// CHECK:        scf.for
+// CHECK-NOT:    memref.prefetch
+// CHECK:        memref.load %arg0
+// CHECK:        memref.store
+
+func.func @contiguous(%arg0: memref<1024xf32>, %arg1: memref<1024xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c1024 = arith.constant 1024 : index
+  scf.for %arg2 = %c0 to %c1024 step %c1 {
+    %0 = memref.load %arg0[%arg2] : memref<1024xf32>
+    memref.store %0, %arg1[%arg2] : memref<1024xf32>
+  }
+  return
+}
+// CHECK-LABEL: func.func @contiguous
+// CHECK-NOT: memref.prefetch
+
+func.func @distance_attr(%arg0: memref<128x64xf32>, %arg1: memref<128x64xf32>, %arg2: memref<128xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c128 = arith.constant 128 : index
+  scf.for %arg3 = %c0 to %c128 step %c1 {
+    %0 = memref.load %arg0[%arg3, %c0] : memref<128x64xf32>
+    memref.store %0, %arg2[%arg3] : memref<128xf32>
+  } {__byteir_prefetch_distance__ = 2 : i64}
+  scf.for %arg3 = %c0 to %c128 step %c1 {
+    %0 = memref.load %arg1[%arg3, %c0] : memref<128x64xf32>
+    memref.store %0, %arg2[%arg3] : memref<128xf32>
+  } {__byteir_prefetch_distance__ = 0 : i64}
+  return
+}
+// CHECK-LABEL: func.func @distance_attr
+// CHECK: arith.constant 2 : index
+// CHECK: memref.prefetch %arg0
+// CHECK-NOT: memref.prefetch %arg1
+
+func.func @index_elements(%arg0: memref<1000xindex>, %arg1: memref<16xi64>, %arg2: memref<16xindex>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c16 = arith.constant 16 : index
+  scf.for %arg3 = %c0 to %c16 step %c1 {
+    %0 = memref.load %arg1[%arg3] : memref<16xi64>
+    %1 = arith.index_cast %0 : i64 to index
+    %2 = memref.load %arg0[%1] : memref<1000xindex>
+    memref.store %2, %arg2[%arg3] : memref<16xindex>
+  }
+  return
+}
+// CHECK-LABEL: func.func @index_elements
+// CHECK-NOT:   memref.prefetch
+// CHECK:       return
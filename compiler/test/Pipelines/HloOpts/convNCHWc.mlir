@@ -0,0 +1,19 @@
+// RUN: byteir-opt %s -hlo-graph-opt="target=cpu conv-layout=NCHW8c" | FileCheck %s
+// RUN: byteir-opt %s -hlo-graph-opt="target=cpu" | FileCheck %s --check-prefix=NOLAYOUT
+
+func.func @main(%arg0: tensor<1x16x14x14xf32>) -> tensor<1x16x14x14xf32> attributes {byteir.layout = "NCHW"} {
+  %0 = mhlo.constant dense<1.000000e+00> : tensor<16x16x3x3xf32>
+  %1 = mhlo.convolution(%arg0, %0) dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1], window = {stride = [1, 1], pad = [[1, 1], [1, 1]], rhs_dilate = [1, 1]} {batch_group_count = 1 : i64, feature_group_count = 1 : i64} : (tensor<1x16x14x14xf32>, tensor<16x16x3x3xf32>) -> tensor<1x16x14x14xf32>
+  %2 = mhlo.constant dense<0.000000e+00> : tensor<1x16x14x14xf32>
+  %3 = mhlo.maximum %1, %2 : tensor<1x16x14x14xf32>
+  return %3 : tensor<1x16x14x14xf32>
+}
+// CHECK-LABEL: func.func @main
+// CHECK:  mhlo.custom_call @byteir.conv2d_nchwc
+// CHECK-SAME:  -> tensor<1x2x14x14x8xf32>
+// CHECK:  mhlo.maximum{{.*}}tensor<1x2x14x14x8xf32>
+// CHECK:  return
+
+// NOLAYOUT-LABEL: func.func @main
+// NOLAYOUT-NOT:  byteir.conv2d_nchwc
+// NOLAYOUT:  mhlo.convolution
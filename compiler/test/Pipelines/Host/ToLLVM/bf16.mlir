@@ -0,0 +1,30 @@
+// RUN: byteir-opt --to-llvm %s | FileCheck %s
+// RUN: byteir-opt --to-llvm="emulate-bf16=false" %s | FileCheck %s --check-prefix=NATIVE
+
+module attributes {byteir.llvm_module} {
+  func.func @Unknown0(%arg0: memref<32xbf16>, %arg1: memref<32xbf16>) attributes {llvm.emit_c_interface} {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c32 = arith.constant 32 : index
+    %cst = arith.constant 2.000000e+00 : f32
+    scf.for %arg2 = %c0 to %c32 step %c1 {
+      %0 = memref.load %arg0[%arg2] : memref<32xbf16>
+      %1 = arith.extf %0 : bf16 to f32
+      %2 = arith.mulf %1, %cst : f32
+      %3 = arith.truncf %2 : f32 to bf16
+      memref.store %3, %arg1[%arg2] : memref<32xbf16>
+    }
+    return
+  }
+  // CHECK-LABEL: llvm.func @Unknown0
+  // CHECK-NOT: llvm.fpext
+  // CHECK: llvm.shl
+  // CHECK: llvm.fmul
+  // CHECK-NOT: llvm.fptrunc
+  // CHECK: llvm.lshr
+
+  // NATIVE-LABEL: llvm.func @Unknown0
+  // NATIVE: llvm.fpext
+  // NATIVE: llvm.fmul
+  // NATIVE: llvm.fptrunc
+}
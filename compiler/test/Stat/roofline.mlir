@@ -0,0 +1,39 @@
+// RUN: byteir-stat -roofline %s | FileCheck %s -check-prefix=DEFAULT
+// RUN: byteir-stat -roofline -func-name="dynamic" -dynamic-dim-size=8 %s | FileCheck %s -check-prefix=EVAL
+// RUN: byteir-stat -roofline -peak-gflops=10 -peak-bandwidth=10 -func-name="static" %s | FileCheck %s -check-prefix=MACHINE
+
+module {
+  func.func @static(%arg0 : tensor<4x8xf32>, %arg1 : tensor<8x16xf32>, %arg2 : tensor<4x16xf32>) -> tensor<4x16xf32> {
+    %0 = "mhlo.dot"(%arg0, %arg1) : (tensor<4x8xf32>, tensor<8x16xf32>) -> tensor<4x16xf32>
+    %1 = "mhlo.add"(%0, %arg2) : (tensor<4x16xf32>, tensor<4x16xf32>) -> tensor<4x16xf32>
+    %2 = "mhlo.fusion"(%1, %arg2) ({
+      %3 = "mhlo.add"(%1, %arg2) : (tensor<4x16xf32>, tensor<4x16xf32>) -> tensor<4x16xf32>
+      %4 = "mhlo.multiply"(%3, %arg2) : (tensor<4x16xf32>, tensor<4x16xf32>) -> tensor<4x16xf32>
+      "mhlo.return"(%4) : (tensor<4x16xf32>) -> ()
+    }) {__byteir_elementwise_fusion__} : (tensor<4x16xf32>, tensor<4x16xf32>) -> tensor<4x16xf32>
+    return %2 : tensor<4x16xf32>
+  }
+  func.func @dynamic(%arg0 : tensor<?x4xf32>, %arg1 : tensor<?x4xf32>) -> tensor<?x4xf32> {
+    %0 = "mhlo.add"(%arg0, %arg1) : (tensor<?x4xf32>, tensor<?x4xf32>) -> tensor<?x4xf32>
+    return %0 : tensor<?x4xf32>
+  }
+}
+
+// DEFAULT: ========== Roofline Statistics ============
+// DEFAULT: Peak GFLOPS 	 1000 	 Peak Bandwidth (GB/s) 	 100 	 Ridge Point (FLOP/Byte) 	 10.000
+// DEFAULT-LABEL: ---------- Function static ----------
+// DEFAULT: mhlo.add	1	64	512	256	0.083	0.008	memory
+// DEFAULT: mhlo.dot	1	1024	640	256	1.143	0.009	memory
+// DEFAULT: mhlo.fusion	1	128	512	256	0.167	0.008	memory
+// DEFAULT: Total	3	1216	1664	768	0.500	0.024	memory
+// DEFAULT: Kernel
+// DEFAULT: mhlo.fusion#0	128	512	256	0.167	0.008	memory
+// DEFAULT-LABEL: ---------- Function dynamic ----------
+// DEFAULT: mhlo.add	1	4*arg0[0]	16*arg1[0] + 16*arg0[0]	16*arg0[0]	symbolic	symbolic	NA
+
+// EVAL-NOT: Function static
+// EVAL-LABEL: ---------- Function dynamic ----------
+// EVAL: mhlo.add	1	4*arg0[0]	16*arg1[0] + 16*arg0[0]	16*arg0[0]	0.083	0.004	memory
+
+// MACHINE: Ridge Point (FLOP/Byte) 	 1.000
+// MACHINE: mhlo.dot	1	1024	640	256	1.143	0.102	compute
@@ -0,0 +1,133 @@
+// RUN: byteir-translate -split-input-file -emit-cpp-aot %s | FileCheck %s
+// RUN: byteir-translate -split-input-file -emit-cpp-aot-header %s | FileCheck %s --check-prefix=HEADER
+
+module attributes {byre.container_module} {
+  module attributes {byteir.llvm_module} {
+    memref.global "private" constant @__constant_4xf32 : memref<4xf32> = dense<[1.0, 2.0, 3.0, 4.0]>
+    func.func @Unknown0(%arg0: memref<2x4xf32>, %arg1: memref<8xf32>) attributes {__byre__kernel_name = "Unknown0", __byteir_hlo_aggressive_fusion__, byre_compute_name = "LLVMJITOp", llvm.emit_c_interface} {
+      %c0 = arith.constant 0 : index
+      %c1 = arith.constant 1 : index
+      %c4 = arith.constant 4 : index
+      %c8 = arith.constant 8 : index
+      %cst = arith.constant 0.000000e+00 : f32
+      %0 = memref.get_global @__constant_4xf32 : memref<4xf32>
+      %collapse_shape = memref.collapse_shape %arg0 [[0, 1]] : memref<2x4xf32> into memref<8xf32>
+      scf.for %arg2 = %c0 to %c8 step %c1 {
+        %1 = arith.remui %arg2, %c4 : index
+        %2 = memref.load %collapse_shape[%arg2] : memref<8xf32>
+        %3 = memref.load %0[%1] : memref<4xf32>
+        %4 = arith.mulf %2, %3 : f32
+        %5 = arith.maxnumf %4, %cst : f32
+        memref.store %5, %arg1[%arg2] : memref<8xf32>
+      }
+      return
+    }
+    func.func @Unknown1(%arg0: memref<8xf32>, %arg1: memref<4xf32>) attributes {__byre__kernel_name = "Unknown1", __byteir_hlo_aggressive_fusion__, byre_compute_name = "LLVMJITOp", llvm.emit_c_interface} {
+      %c0 = arith.constant 0 : index
+      %c1 = arith.constant 1 : index
+      %c4 = arith.constant 4 : index
+      %alloc = memref.alloc() : memref<4xf32>
+      %subview = memref.subview %arg0[4] [4] [1] : memref<8xf32> to memref<4xf32, strided<[1], offset: 4>>
+      scf.for %arg2 = %c0 to %c4 step %c1 {
+        %0 = memref.load %subview[%arg2] : memref<4xf32, strided<[1], offset: 4>>
+        %1 = math.exp %0 : f32
+        memref.store %1, %alloc[%arg2] : memref<4xf32>
+      }
+      memref.copy %alloc, %arg1 : memref<4xf32> to memref<4xf32>
+      memref.dealloc %alloc : memref<4xf32>
+      return
+    }
+  }
+  func.func @main(%arg0: memref<2x4xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg1: memref<4xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}, %arg2: memref<2x4xf32, "cpu"> {byre.argname = "Output1", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    %alloc = memref.alloc() : memref<32xi8, "cpu">
+    %0 = "byre.alias"(%alloc) <{offset = 0 : i64}> : (memref<32xi8, "cpu">) -> memref<8xf32, "cpu">
+    byre.compute @LLVMJITOp(%arg0, %0) {kernel_name = "Unknown0", llvm_file_name = "host_kernels.ll", memory_effects = [1 : i32, 2 : i32]} : memref<2x4xf32, "cpu">, memref<8xf32, "cpu">
+    byre.compute @LLVMJITOp(%0, %arg1) {kernel_name = "Unknown1", llvm_file_name = "host_kernels.ll", memory_effects = [1 : i32, 2 : i32]} : memref<8xf32, "cpu">, memref<4xf32, "cpu">
+    %1 = "byre.alias"(%alloc) <{offset = 0 : i64}> : (memref<32xi8, "cpu">) -> memref<2x4xf32, "cpu">
+    byre.copy(%1, %arg2) {callee = "cpu2cpu"} : memref<2x4xf32, "cpu">, memref<2x4xf32, "cpu">
+    return
+  }
+}
+
+// CHECK: #include <cmath>
+// CHECK: namespace {
+// CHECK: alignas(64) static const float g___constant_4xf32[4] = {(float)1.000000e+00, (float)2.000000e+00, (float)3.000000e+00, (float)4.000000e+00};
+
+// CHECK-LABEL: void Unknown0(float* [[A0:[^ ]*]], float* [[A1:[^ ]*]]) {
+// CHECK: for (size_t [[IV:[^ ]*]] =
+// CHECK: float [[L0:[^ ]*]] = *((float*)[[A0]] + [[IV]] * 1);
+// CHECK: float [[L1:[^ ]*]] = *((float*)g___constant_4xf32 + {{.*}} * 1);
+// CHECK: float [[MUL:[^ ]*]] = [[L0]] * [[L1]];
+// CHECK: float [[MAX:[^ ]*]] = std::fmax([[MUL]], {{.*}});
+// CHECK: *((float*)[[A1]] + [[IV]] * 1) = [[MAX]];
+
+// CHECK-LABEL: void Unknown1(float* [[B0:[^ ]*]], float* [[B1:[^ ]*]]) {
+// CHECK: alignas(64) static float [[BUF:[^ ]*]][4];
+// CHECK: float [[L2:[^ ]*]] = *((float*)[[B0]] + 4 + {{.*}} * 1);
+// CHECK: float [[EXP:[^ ]*]] = std::exp([[L2]]);
+// CHECK: std::memcpy([[B1]], [[BUF]], 4 * sizeof(float));
+// CHECK-NOT: dealloc
+// CHECK: return;
+
+// CHECK: alignas(64) static int8_t [[ARENA:[^ ]*]][32];
+// CHECK: } // namespace
+
+// CHECK-LABEL: extern "C" void run(const void *const *inputs, void *const *outputs) {
+// CHECK-NEXT: float* [[IN0:[^ ]*]] = (float*)inputs[0];
+// CHECK-NEXT: float* [[OUT0:[^ ]*]] = (float*)outputs[0];
+// CHECK-NEXT: float* [[OUT1:[^ ]*]] = (float*)outputs[1];
+// CHECK-NEXT: float* [[V0:[^ ]*]] = (float*)((int8_t*)[[ARENA]] + 0);
+// CHECK-NEXT: Unknown0([[IN0]], [[V0]]);
+// CHECK-NEXT: Unknown1([[V0]], [[OUT0]]);
+// CHECK-NEXT: float* [[V1:[^ ]*]] = (float*)((int8_t*)[[ARENA]] + 0);
+// CHECK-NEXT: std::memcpy([[OUT1]], [[V1]], 8 * sizeof(float));
+// CHECK-NEXT: return;
+
+// HEADER: extern "C" void run(const void *const *inputs, void *const *outputs);
+// HEADER: namespace run {
+// HEADER-NEXT: constexpr size_t kInputNum = 1;
+// HEADER-NEXT: constexpr const char *kInputNames[] = {"Input0"};
+// HEADER-NEXT: constexpr size_t kInputBytes[] = {32};
+// HEADER-NEXT: constexpr size_t kOutputNum = 2;
+// HEADER-NEXT: constexpr const char *kOutputNames[] = {"Output0", "Output1"};
+// HEADER-NEXT: constexpr size_t kOutputBytes[] = {16, 32};
+
+// -----
+
+module attributes {byre.container_module} {
+  module attributes {byteir.llvm_module} {
+    func.func @Unknown0(%arg0: memref<4xf32>, %arg1: memref<4xf32>, %arg2: memref<4xf32>) attributes {__byre__kernel_name = "Unknown0", byre_compute_name = "LLVMJITOp", llvm.emit_c_interface} {
+      %c0 = arith.constant 0 : index
+      %c1 = arith.constant 1 : index
+      %c4 = arith.constant 4 : index
+      scf.for %arg3 = %c0 to %c4 step %c1 {
+        %0 = memref.load %arg0[%arg3] : memref<4xf32>
+        %1 = memref.load %arg1[%arg3] : memref<4xf32>
+        %2 = arith.mulf %0, %1 : f32
+        memref.store %2, %arg2[%arg3] : memref<4xf32>
+      }
+      return
+    }
+  }
+  func.func @main(%arg0: memref<4xf32, "cpu"> {byre.argname = "Weight0", byre.argtype = 4 : i32, byre.weight_value = dense<[1.0, 2.0, 3.0, 4.0]> : tensor<4xf32>}, %arg1: memref<4xf32, "cpu"> {byre.argname = "Input0", byre.argtype = 1 : i32}, %arg2: memref<4xf32, "cpu"> {byre.argname = "Output0", byre.argtype = 2 : i32}) attributes {byre.entry_point} {
+    byre.compute @LLVMJITOp(%arg1, %arg0, %arg2) {kernel_name = "Unknown0", llvm_file_name = "host_kernels.ll", memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    return
+  }
+}
+
+// weights are compiled into the source and not passed in `inputs`
+// CHECK: alignas(64) static const float g_weight0[4] = {(float)1.000000e+00, (float)2.000000e+00, (float)3.000000e+00, (float)4.000000e+00};
+// CHECK: } // namespace
+// CHECK-LABEL: extern "C" void run(const void *const *inputs, void *const *outputs) {
+// CHECK-NEXT: float* [[W0:[^ ]*]] = (float*)g_weight0;
+// CHECK-NEXT: float* [[IN0:[^ ]*]] = (float*)inputs[0];
+// CHECK-NEXT: float* [[OUT0:[^ ]*]] = (float*)outputs[0];
+// CHECK-NEXT: Unknown0([[IN0]], [[W0]], [[OUT0]]);
+
+// HEADER: // inputs:
+// HEADER-NEXT: //   "Input0": f32[4]
+// HEADER-NEXT: // outputs:
+// HEADER-NEXT: //   "Output0": f32[4]
+// HEADER: constexpr size_t kInputNum = 1;
+// HEADER-NEXT: constexpr const char *kInputNames[] = {"Input0"};
+// HEADER-NEXT: constexpr size_t kInputBytes[] = {16};
@@ -0,0 +1,28 @@
+// RUN: byteir-translate %s --mlir-to-llvm-archive --llvm-partitions=2 --llvm-codegen-threads=1 -o %t.1
+// RUN: byteir-translate %s --mlir-to-llvm-archive --llvm-partitions=2 --llvm-codegen-threads=4 -o %t.4
+// RUN: cmp %t.1 %t.4
+// RUN: llvm-nm %t.1 | FileCheck %s
+
+module {
+  llvm.mlir.global private constant @__constant_4xf32(dense<[1.0, 2.0, 3.0, 4.0]> : tensor<4xf32>) {addr_space = 0 : i32} : !llvm.array<4 x f32>
+  llvm.func @Unknown0(%arg0: !llvm.ptr, %arg1: !llvm.ptr) {
+    %0 = llvm.mlir.addressof @__constant_4xf32 : !llvm.ptr
+    %1 = llvm.load %0 : !llvm.ptr -> f32
+    %2 = llvm.load %arg0 : !llvm.ptr -> f32
+    %3 = llvm.fadd %1, %2 : f32
+    llvm.store %3, %arg1 : f32, !llvm.ptr
+    llvm.return
+  }
+  llvm.func @Unknown1(%arg0: !llvm.ptr, %arg1: !llvm.ptr) {
+    %0 = llvm.load %arg0 : !llvm.ptr -> f32
+    %1 = llvm.fmul %0, %0 : f32
+    llvm.store %1, %arg1 : f32, !llvm.ptr
+    llvm.return
+  }
+}
+
+// CHECK-LABEL: part0.o:
+// CHECK-DAG: {{[DR]}} __constant_4xf32
+// CHECK-DAG: T _packed_{{Unknown[01]}}
+// CHECK-LABEL: part1.o:
+// CHECK-DAG: T _packed_{{Unknown[01]}}
@@ -0,0 +1,26 @@
+// RUN: byteir-opt %s -large-constant-to-resource="size-threshold=16" | FileCheck %s
+
+module {
+  memref.global "private" constant @large_global : memref<8xf32> = dense<[1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]>
+  memref.global "private" constant @small_global : memref<2xf32> = dense<[1.0, 2.0]>
+  memref.global "private" @mutable_global : memref<8xf32> = dense<[1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]>
+  func.func @constants() -> (tensor<8xf32>, tensor<2xf32>, tensor<8xf32>, tensor<8xi1>) {
+    %0 = mhlo.constant dense<[1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]> : tensor<8xf32>
+    %1 = mhlo.constant dense<[1.0, 2.0]> : tensor<2xf32>
+    %2 = mhlo.constant dense<1.0> : tensor<8xf32>
+    %3 = mhlo.constant dense<[true, false, true, false, true, false, true, false]> : tensor<8xi1>
+    return %0, %1, %2, %3 : tensor<8xf32>, tensor<2xf32>, tensor<8xf32>, tensor<8xi1>
+  }
+}
+
+// CHECK: memref.global "private" constant @large_global : memref<8xf32> = dense_resource<large_global>
+// CHECK: memref.global "private" constant @small_global : memref<2xf32> = dense<[1.000000e+00, 2.000000e+00]>
+// CHECK: memref.global "private" @mutable_global : memref<8xf32> = dense<
+// CHECK-LABEL: func.func @constants
+// CHECK: mhlo.constant dense_resource<__byteir_constant> : tensor<8xf32>
+// CHECK: mhlo.constant dense<[1.000000e+00, 2.000000e+00]> : tensor<2xf32>
+// CHECK: mhlo.constant dense<1.000000e+00> : tensor<8xf32>
+// CHECK: mhlo.constant dense<[true, false, true, false, true, false, true, false]> : tensor<8xi1>
+// CHECK: dialect_resources
+// CHECK: large_global: "0x
+// CHECK: __byteir_constant: "0x
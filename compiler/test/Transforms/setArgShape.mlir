@@ -1,4 +1,7 @@
 // RUN: byteir-opt %s -allow-unregistered-dialect -set-arg-shape="dim=0 size=3 entry-func-name=tf_add arg-attr-name=__placeholder__byre.argname" | FileCheck %s
+// RUN: byteir-opt %s -allow-unregistered-dialect -set-arg-shape="dim=0 size=3 entry-func-name=tf_add all-dynamic-args" | FileCheck %s
+// RUN: byteir-opt %s -allow-unregistered-dialect -set-arg-shape="dim=0 size=3 entry-func-name=tf_add_static all-dynamic-args" | FileCheck %s --check-prefix=DYNAMIC
+// RUN: byteir-opt %s -allow-unregistered-dialect -set-arg-shape="dim=0 size=3 entry-func-name=tf_add_static" | FileCheck %s --check-prefix=NONE
 
 func.func @tf_add(%arg0 : tensor<?x4xf32> {__placeholder__byre.argname = "A"}, %arg1 : tensor<?x4xf32> {__placeholder__byre.argname = "B"}) -> (tensor<*xf32> {__placeholder__byre.argname = "C"}) attributes { __placeholder__byre.entry_point} {
     %res = "tf.Add"(%arg0, %arg1) : (tensor<?x4xf32>, tensor<?x4xf32>) -> tensor<*xf32>
@@ -6,3 +9,12 @@ func.func @tf_add(%arg0 : tensor<?x4xf32> {__placeholder__byre.argname = "A"}, %
 }
 // CHECK-LABEL: func.func @tf_add
 // CHECK-NEXT: %[[RES0:.*]] = "tf.Add"(%arg0, %arg1) : (tensor<3x4xf32>, tensor<3x4xf32>) -> tensor<*xf32>
+
+func.func @tf_add_static(%arg0 : tensor<?x4xf32>, %arg1 : tensor<1x4xf32>) -> tensor<*xf32> {
+    %res = "tf.Add"(%arg0, %arg1) : (tensor<?x4xf32>, tensor<1x4xf32>) -> tensor<*xf32>
+    return %res : tensor<*xf32>
+}
+// DYNAMIC-LABEL: func.func @tf_add_static
+// DYNAMIC-NEXT: "tf.Add"(%arg0, %arg1) : (tensor<3x4xf32>, tensor<1x4xf32>) -> tensor<*xf32>
+// NONE-LABEL: func.func @tf_add_static
+// NONE-NEXT: "tf.Add"(%arg0, %arg1) : (tensor<?x4xf32>, tensor<1x4xf32>) -> tensor<*xf32>
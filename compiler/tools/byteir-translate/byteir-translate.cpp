@@ -13,6 +13,7 @@
 
 #include "byteir/Target/CUDA/ToCUDA.h"
 #include "byteir/Target/Cpp/ToCpp.h"
+#include "byteir/Target/LLVM/ToLLVMArchive.h"
 #include "byteir/Target/LLVM/ToLLVMBC.h"
 #include "byteir/Target/PTX/ToPTX.h"
 #include "mlir/InitAllTranslations.h"
@@ -27,6 +28,7 @@ int main(int argc, char **argv) {
   byteir::registerToCppTranslation();
   byteir::registerToCUDATranslation();
   byteir::registerToLLVMBCTranslation();
+  byteir::registerToLLVMArchiveTranslation();
 
   return failed(
       mlirTranslateMain(argc, argv, "ByteIR Translation Testing Tool"));
@@ -68,4 +68,18 @@ llvm::cl::opt<int> ofRepeatDynamicMax(
         "static iterations will be used"),
     llvm::cl::init(3), llvm::cl::cat(OnnxFrontendOptions));
 
+llvm::cl::opt<bool> keepExternalData(
+    "keep-external-data",
+    llvm::cl::desc("Keep initializers stored in external data files out of "
+                   "memory during conversion, and emit them as resource "
+                   "blobs memory-mapped from these files"),
+    llvm::cl::init(false), llvm::cl::cat(OnnxFrontendOptions));
+
+llvm::cl::opt<int64_t> externalDataSizeThreshold(
+    "external-data-size-threshold",
+    llvm::cl::desc("Minimum byte size of external initializers kept out of "
+                   "memory by -keep-external-data (default=1024), smaller ones "
+                   "are imported and folded as usual"),
+    llvm::cl::init(1024), llvm::cl::cat(OnnxFrontendOptions));
+
 } // namespace onnx_frontend
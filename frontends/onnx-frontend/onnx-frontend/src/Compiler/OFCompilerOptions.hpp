@@ -31,5 +31,7 @@ extern llvm::cl::opt<std::string> inputShapes;
 extern llvm::cl::opt<std::string> serialVersion;
 extern llvm::cl::opt<int> ofRepeatStatic;
 extern llvm::cl::opt<int> ofRepeatDynamicMax;
+extern llvm::cl::opt<bool> keepExternalData;
+extern llvm::cl::opt<int64_t> externalDataSizeThreshold;
 
 } // namespace onnx_frontend
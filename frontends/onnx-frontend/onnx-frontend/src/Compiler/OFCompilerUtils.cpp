@@ -268,7 +268,8 @@ std::string dirName(llvm::StringRef inputFilename) {
 // Return 0 on success, error number on failure.
 int processInputFile(std::string inputFilename, mlir::MLIRContext &context,
                      mlir::OwningOpRef<mlir::ModuleOp> &module,
-                     std::string *errorMessage) {
+                     std::string *errorMessage,
+                     std::vector<ExternalTensor> *externalTensors) {
   // Decide if the input file is an ONNX model or a model specified
   // in MLIR. The extension of the file is the decider.
   std::string extension =
@@ -306,6 +307,11 @@ int processInputFile(std::string inputFilename, mlir::MLIRContext &context,
   if (!inputShapes.empty()) {
     SetInputShapes(model);
   }
+  // after batch size and input shapes are set, which skip initializers
+  if (keepExternalData && externalTensors) {
+    DetachExternalInitializers(model, options.externalDataDir,
+                               externalDataSizeThreshold, *externalTensors);
+  }
   onnx_mlir::ImportFrontendModelInternal(model, context, module, options);
   return onnx_mlir::CompilerSuccess;
 }
@@ -386,8 +392,15 @@ int emitOutput(mlir::OwningOpRef<mlir::ModuleOp> &module,
 int compileModule(mlir::OwningOpRef<mlir::ModuleOp> &module,
                   mlir::PassManager &pm, std::string outputFilename,
                   onnx_frontend::EmissionTargetType emissionTarget,
-                  bool emitElide, std::string serialVersion) {
+                  bool emitElide, std::string serialVersion,
+                  llvm::ArrayRef<ExternalTensor> externalTensors) {
   bool runFailure = mlir::failed(pm.run(*module));
+  // weights are attached after all passes, so they are never folded or
+  // copied, and only paged in when printed
+  if (!runFailure &&
+      mlir::failed(AttachExternalTensors(*module, externalTensors,
+                                         emissionTarget)))
+    return onnx_mlir::CompilerFailure;
   int outputStatus = emitOutput(module, outputFilename, emissionTarget,
                                 emitElide, serialVersion);
   if (runFailure)
@@ -16,12 +16,16 @@
 #include "mlir/Pass/PassManager.h"
 
 #include "onnx-frontend/src/Compiler/OFCompilerTypes.hpp"
+#include "onnx-frontend/src/Compiler/OFExternalData.hpp"
 
 namespace onnx_frontend {
 
+// Initializers detached by -keep-external-data are appended to
+// `externalTensors` if provided.
 int processInputFile(std::string inputFilename, mlir::MLIRContext &context,
                      mlir::OwningOpRef<mlir::ModuleOp> &module,
-                     std::string *errorMessage);
+                     std::string *errorMessage,
+                     std::vector<ExternalTensor> *externalTensors = nullptr);
 
 void getStablehloSerialVersion(const std::string &inputVersion,
                                std::string &outputVersion);
@@ -29,6 +33,7 @@ void getStablehloSerialVersion(const std::string &inputVersion,
 int compileModule(mlir::OwningOpRef<mlir::ModuleOp> &module,
                   mlir::PassManager &pm, std::string outputFilename,
                   onnx_frontend::EmissionTargetType emissionTarget,
-                  bool emitElide, const std::string serialVersion);
+                  bool emitElide, const std::string serialVersion,
+                  llvm::ArrayRef<ExternalTensor> externalTensors = {});
 
 } // namespace onnx_frontend
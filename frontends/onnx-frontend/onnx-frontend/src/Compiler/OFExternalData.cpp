@@ -0,0 +1,245 @@
+//===- OFExternalData.cpp -------------------------------------------------===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "onnx-frontend/src/Compiler/OFExternalData.hpp"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/AsmState.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include "onnx/onnx_pb.h"
+#include "stablehlo/dialect/StablehloOps.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "third_party/onnx-mlir/src/Dialect/ONNX/DialectBuilder.hpp"
+
+#include <climits>
+#include <optional>
+#include <set>
+
+#define DEBUG_TYPE "OFExternalData"
+
+using namespace mlir;
+
+namespace onnx_frontend {
+
+namespace {
+
+// Return byte width of elements of `dataType`, or 0 if the data of
+// `dataType` isn't stored as a plain little-endian array.
+int64_t getElementByteWidth(int32_t dataType) {
+  switch (dataType) {
+  case onnx::TensorProto_DataType_INT8:
+  case onnx::TensorProto_DataType_UINT8:
+    return 1;
+  case onnx::TensorProto_DataType_INT16:
+  case onnx::TensorProto_DataType_UINT16:
+  case onnx::TensorProto_DataType_FLOAT16:
+  case onnx::TensorProto_DataType_BFLOAT16:
+    return 2;
+  case onnx::TensorProto_DataType_INT32:
+  case onnx::TensorProto_DataType_UINT32:
+  case onnx::TensorProto_DataType_FLOAT:
+    return 4;
+  case onnx::TensorProto_DataType_INT64:
+  case onnx::TensorProto_DataType_UINT64:
+  case onnx::TensorProto_DataType_DOUBLE:
+    return 8;
+  default:
+    // bool, string and sub-byte types
+    return 0;
+  }
+}
+
+FailureOr<DenseResourceElementsAttr>
+loadExternalTensor(const ExternalTensor &tensor, RankedTensorType type,
+                   Location loc) {
+  int64_t byteWidth = llvm::divideCeil(type.getElementTypeBitWidth(), CHAR_BIT);
+  if (type.getNumElements() * byteWidth != static_cast<int64_t>(tensor.size))
+    return emitError(loc) << "size of external data of " << tensor.name
+                          << " mismatches " << type;
+
+  // large slices are mmap'ed, so the data is paged in by the printer on demand
+  auto bufferOr = llvm::MemoryBuffer::getFileSlice(tensor.path, tensor.size,
+                                                   tensor.offset,
+                                                   /*IsVolatile=*/false);
+  if (std::error_code ec = bufferOr.getError())
+    return emitError(loc) << "failed to map external data of " << tensor.name
+                          << " from " << tensor.path << ": " << ec.message();
+  std::unique_ptr<llvm::MemoryBuffer> buffer = std::move(*bufferOr);
+  ArrayRef<char> data(buffer->getBufferStart(), buffer->getBufferSize());
+
+  size_t alignment = std::max<size_t>(byteWidth, 1);
+  AsmResourceBlob blob;
+  if (llvm::isAddrAligned(llvm::Align(alignment), data.data())) {
+    blob = UnmanagedAsmResourceBlob::allocateWithAlign(
+        data, alignment,
+        [buffer = std::move(buffer)](void *, size_t, size_t) mutable {
+          buffer.reset();
+        });
+  } else {
+    // external data written without alignment, which is rare for large ones
+    blob = HeapAsmResourceBlob::allocateAndCopyWithAlign(data, alignment);
+  }
+  return DenseResourceElementsAttr::get(type, tensor.name, std::move(blob));
+}
+
+void eraseEntryPointInputs(func::FuncOp funcOp,
+                           const std::set<std::string> &names) {
+  auto entryPoint = funcOp->getAttrOfType<DictionaryAttr>("byteir.entry_point");
+  if (!entryPoint)
+    return;
+  auto inputs = entryPoint.getAs<ArrayAttr>("inputs");
+  if (!inputs)
+    return;
+  SmallVector<Attribute> newInputs;
+  for (Attribute input : inputs) {
+    auto name = llvm::dyn_cast<StringAttr>(input);
+    if (!name || !names.count(name.getValue().str()))
+      newInputs.push_back(input);
+  }
+  NamedAttrList attrs(entryPoint);
+  attrs.set("inputs", ArrayAttr::get(funcOp.getContext(), newInputs));
+  funcOp->setAttr("byteir.entry_point",
+                  attrs.getDictionary(funcOp.getContext()));
+}
+
+} // namespace
+
+void DetachExternalInitializers(onnx::ModelProto &model,
+                                const std::string &externalDataDir,
+                                int64_t sizeThreshold,
+                                std::vector<ExternalTensor> &detached) {
+  onnx::GraphProto *graph = model.mutable_graph();
+  std::set<std::string> inputNames;
+  for (const auto &input : graph->input())
+    inputNames.insert(input.name());
+
+  auto *initializers = graph->mutable_initializer();
+  for (int i = 0; i < initializers->size();) {
+    const onnx::TensorProto &initializer = initializers->Get(i);
+    int64_t byteWidth = getElementByteWidth(initializer.data_type());
+    if (initializer.data_location() !=
+            onnx::TensorProto_DataLocation_EXTERNAL ||
+        byteWidth == 0) {
+      ++i;
+      continue;
+    }
+
+    ExternalTensor tensor;
+    tensor.name = initializer.name();
+    std::string location;
+    std::optional<uint64_t> length;
+    for (const auto &kv : initializer.external_data()) {
+      if (kv.key() == "location")
+        location = kv.value();
+      else if (kv.key() == "offset")
+        tensor.offset = std::stoull(kv.value());
+      else if (kv.key() == "length")
+        length = std::stoull(kv.value());
+    }
+    int64_t numElements = 1;
+    for (int64_t dim : initializer.dims())
+      numElements *= dim;
+    tensor.size = numElements * byteWidth;
+    if (location.empty() || (length && *length != tensor.size) ||
+        static_cast<int64_t>(tensor.size) < sizeThreshold) {
+      // left to the importer, which reports malformed external data
+      ++i;
+      continue;
+    }
+    llvm::SmallString<256> path(externalDataDir);
+    llvm::sys::path::append(path, location);
+    tensor.path = path.str().str();
+
+    // models of ir version < 4 list initializers in graph inputs as well
+    if (!inputNames.count(tensor.name)) {
+      onnx::ValueInfoProto *input = graph->add_input();
+      input->set_name(tensor.name);
+      auto *tensorType = input->mutable_type()->mutable_tensor_type();
+      tensorType->set_elem_type(initializer.data_type());
+      auto *shape = tensorType->mutable_shape();
+      for (int64_t dim : initializer.dims())
+        shape->add_dim()->set_dim_value(dim);
+    }
+    LLVM_DEBUG(llvm::dbgs() << "detach external initializer " << tensor.name
+                            << " of " << tensor.size << " bytes\n");
+    detached.push_back(std::move(tensor));
+    initializers->DeleteSubrange(i, 1);
+  }
+}
+
+LogicalResult
+AttachExternalTensors(ModuleOp module, llvm::ArrayRef<ExternalTensor> detached,
+                      onnx_frontend::EmissionTargetType emissionTarget) {
+  if (detached.empty())
+    return success();
+
+  llvm::StringMap<const ExternalTensor *> nameToTensor;
+  for (const ExternalTensor &tensor : detached)
+    nameToTensor[tensor.name] = &tensor;
+
+  for (auto funcOp : module.getOps<func::FuncOp>()) {
+    if (funcOp.isExternal())
+      continue;
+    OpBuilder builder = OpBuilder::atBlockBegin(&funcOp.front());
+    llvm::BitVector erased(funcOp.getNumArguments());
+    std::set<std::string> erasedNames;
+    for (BlockArgument arg : funcOp.getArguments()) {
+      auto name =
+          funcOp.getArgAttrOfType<StringAttr>(arg.getArgNumber(), "onnx.name");
+      if (!name)
+        continue;
+      auto it = nameToTensor.find(name.getValue());
+      if (it == nameToTensor.end())
+        continue;
+      auto type = llvm::dyn_cast<RankedTensorType>(arg.getType());
+      if (!type || !type.hasStaticShape())
+        return funcOp.emitError()
+               << "expect static shape of external initializer "
+               << name.getValue();
+
+      FailureOr<DenseResourceElementsAttr> value =
+          loadExternalTensor(*it->second, type, arg.getLoc());
+      if (failed(value))
+        return failure();
+      Value constant;
+      if (emissionTarget == onnx_frontend::EmitStablehloIR) {
+        constant = builder.create<stablehlo::ConstantOp>(arg.getLoc(), *value);
+      } else {
+        constant = onnx_mlir::OnnxBuilder(builder, arg.getLoc())
+                       .constant(llvm::cast<Attribute>(*value));
+      }
+      arg.replaceAllUsesWith(constant);
+      erased.set(arg.getArgNumber());
+      erasedNames.insert(name.getValue().str());
+    }
+    if (erased.none())
+      continue;
+    funcOp.eraseArguments(erased);
+    eraseEntryPointInputs(funcOp, erasedNames);
+  }
+  return success();
+}
+
+} // namespace onnx_frontend
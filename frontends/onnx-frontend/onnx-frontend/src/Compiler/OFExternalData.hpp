@@ -0,0 +1,61 @@
+//===- OFExternalData.hpp -------------------------------------------------===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "onnx-frontend/src/Compiler/OFCompilerTypes.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace onnx {
+class ModelProto;
+} // namespace onnx
+
+namespace onnx_frontend {
+
+// An initializer kept in an external data file instead of the model.
+struct ExternalTensor {
+  std::string name;
+  // absolute or relative to the working directory
+  std::string path;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+};
+
+// Move initializers stored in external data files with at least
+// `sizeThreshold` bytes out of the model and into graph inputs, so that the
+// importer never reads their data. `externalDataDir` is the directory of the
+// model, which external data locations are relative to.
+void DetachExternalInitializers(onnx::ModelProto &model,
+                                const std::string &externalDataDir,
+                                int64_t sizeThreshold,
+                                std::vector<ExternalTensor> &detached);
+
+// Replace the function arguments of `detached` initializers with constants,
+// whose values are resource blobs memory-mapped from the external data files.
+mlir::LogicalResult
+AttachExternalTensors(mlir::ModuleOp module,
+                      llvm::ArrayRef<ExternalTensor> detached,
+                      onnx_frontend::EmissionTargetType emissionTarget);
+
+} // namespace onnx_frontend
@@ -92,8 +92,10 @@ int main(int argc, char *argv[]) {
 
   mlir::OwningOpRef<mlir::ModuleOp> module;
   std::string errorMessage;
+  std::vector<onnx_frontend::ExternalTensor> externalTensors;
   int rc = onnx_frontend::processInputFile(onnx_mlir::inputFilename, context,
-                                           module, &errorMessage);
+                                           module, &errorMessage,
+                                           &externalTensors);
   if (rc != 0) {
     if (!errorMessage.empty())
       std::cerr << errorMessage << std::endl;
@@ -107,8 +109,8 @@ int main(int argc, char *argv[]) {
         pm, onnx_frontend::customCallOps, onnx_frontend::enableUnroll);
     onnx_frontend::addVerifyONNXToStablehloPasses(pm);
   }
-  auto status =
-      onnx_frontend::compileModule(module, pm, onnx_mlir::outputBaseName,
-                                   emissionTarget, emitElide, serializeVersion);
+  auto status = onnx_frontend::compileModule(
+      module, pm, onnx_mlir::outputBaseName, emissionTarget, emitElide,
+      serializeVersion, externalTensors);
   return status;
 }
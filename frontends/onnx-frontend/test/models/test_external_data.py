@@ -0,0 +1,54 @@
+import numpy as np
+import onnx
+import os.path as osp
+import pytest
+import subprocess
+from onnx import helper, numpy_helper, TensorProto
+
+from test.env import ONNX_FRONTEND_PATH
+
+class TestModelsExternalData:
+
+    @pytest.fixture(autouse=True)
+    def setup(self, tmpdir_factory):
+        dir = "test/models/data/external_data"
+        self.tmp_dir = str(tmpdir_factory.mktemp(dir.replace("/", "_")))
+
+    def build_model(self):
+        weight = numpy_helper.from_array(
+            np.random.rand(64, 32).astype(np.float32), name="weight")
+        bias = numpy_helper.from_array(
+            np.random.rand(32).astype(np.float32), name="bias")
+        graph = helper.make_graph(
+            [
+                helper.make_node("MatMul", ["X", "weight"], ["Z"]),
+                helper.make_node("Add", ["Z", "bias"], ["Y"]),
+            ],
+            "external_data",
+            [helper.make_tensor_value_info("X", TensorProto.FLOAT, [4, 64])],
+            [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [4, 32])],
+            initializer=[weight, bias],
+        )
+        return helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+
+    def test_keep_external_data(self):
+        onnx_path = osp.join(self.tmp_dir, "external_data.onnx")
+        # weight (8KB) goes to weights.bin, bias (128B) stays in the model
+        onnx.save_model(self.build_model(), onnx_path, save_as_external_data=True,
+                        all_tensors_to_one_file=True, location="weights.bin",
+                        size_threshold=1024)
+
+        cmd_opts = [ONNX_FRONTEND_PATH]
+        cmd_opts.append("-keep-external-data")
+        cmd_opts.append(onnx_path)
+
+        p = subprocess.run(
+            cmd_opts, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, check=True)
+        out, err = p.stdout, p.stderr
+        assert not err, str(err)
+        # weight is no longer an argument of main, but a resource blob
+        signature = [line for line in out.splitlines() if "func.func @main" in line][0]
+        assert "tensor<64x32xf32>" not in signature
+        assert "dense_resource<weight> : tensor<64x32xf32>" in out
+        assert "dialect_resources" in out
+        assert "inputs = [\"X\"]" in out
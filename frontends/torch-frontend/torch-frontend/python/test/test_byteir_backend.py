@@ -0,0 +1,70 @@
+import threading
+
+import torch
+from torch_frontend.byteir_backend.compiled_function import ByteIRFunction
+
+
+class FakeRequest:
+    def __init__(self):
+        self.bound = {}
+
+    def set_shape(self, offset, shape):
+        pass
+
+    def bind_args(self, offset_and_args):
+        self.bound.update(offset_and_args)
+
+    def finish_io_binding(self):
+        pass
+
+    def run(self):
+        pass
+
+    def sync(self):
+        pass
+
+
+class FakeSession:
+    def new_request_context(self, stream=None):
+        return FakeRequest()
+
+
+def _make_cpu_function(output_pool_size=2):
+    # bypass __init__, which loads a byre module into a brt session
+    fn = ByteIRFunction.__new__(ByteIRFunction)
+    fn._session = FakeSession()
+    fn._none_indices = []
+    fn._target = "cpu"
+    fn._reuse_outputs = True
+    fn._output_pool_size = output_pool_size
+    fn._local = threading.local()
+    fn.input_arg_offsets = [0]
+    fn.output_arg_offsets = [1]
+    fn._output_metas = [((2, 3), torch.float32)]
+    fn._num_rets = 1
+    fn._dynamic_shape_info = None
+    fn._input_dtypes = [torch.float32]
+    return fn
+
+
+def test_reuse_outputs():
+    fn = _make_cpu_function()
+    x = torch.rand(2, 3)
+
+    out = fn(x)
+    ptr = out.data_ptr()
+    # the buffer is still referenced by `out`, so a new one is allocated
+    held = fn(x)
+    assert held.data_ptr() != ptr
+
+    del out
+    reused = fn(x)
+    assert reused.data_ptr() == ptr
+
+    # a view keeps the buffer alive after the returned tensor is released
+    view = held[0]
+    held_ptr = held.data_ptr()
+    del held
+    assert fn(x).data_ptr() not in (ptr, held_ptr)
+    del view
+    assert fn(x).data_ptr() == held_ptr
@@ -64,6 +64,23 @@ def test_mlp():
 
 # ==============================================================================
 
+class DynamicBatchModule(torch.nn.Module):
+    def forward(self, x, y):
+        return torch.relu(x + y).sum(dim=1)
+
+def test_dynamic_batch():
+    inputs = (torch.randn(4, 8), torch.randn(4, 8))
+    batch = torch.export.Dim("batch", min=2, max=1024)
+    prog = torch.export.export(DynamicBatchModule(), inputs,
+                               dynamic_shapes={"x": {0: batch}, "y": {0: batch}})
+    module = compile_dynamo_model(prog, "stablehlo")
+    mlir_str = module.operation.get_asm()
+    print(mlir_str)
+    assert "tensor<?x8xf32>" in mlir_str
+    assert "tensor<?xf32>" in mlir_str
+
+# ==============================================================================
+
 if __name__ == "__main__":
     test_nonzero()
     test_view_dtype()
\ No newline at end of file
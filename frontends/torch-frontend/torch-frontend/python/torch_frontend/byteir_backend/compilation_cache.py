@@ -10,6 +10,7 @@
 
 import os
 import io
+import platform
 import copyreg
 import re
 import hashlib
@@ -33,14 +34,14 @@ from torch._inductor.codecache import (
 from torch._dynamo.utils import counters
 from torch.fx.experimental.symbolic_shapes import ShapeEnv, has_hint, hint_int, SYMPY_INTERP
 from torch._subclasses.fake_tensor import FakeTensor
-from torch.cuda.memory import caching_allocator_alloc, caching_allocator_delete
 
 try:
     import brt
 except ImportError:
     ...
 
-from .compiled_function import (CompiledArtifact, ByteIRFunction)
+from .compiled_function import (CompiledArtifact, ByteIRFunction,
+                                create_byre_session)
 from .utils import (
     dump_tensors_meta_info,
     BypassFxGraphCache,
@@ -56,22 +57,46 @@ from .utils import (
 log = logging.getLogger(__name__)
 
 
-
-def get_system_info() -> Dict[str, Any]:
+def get_host_isa_info() -> Dict[str, Any]:
+    """
+    Get the ISA of host cpu, which decides the code generated by "cpu" target.
+    """
+    isa: Dict[str, Any] = {"machine": platform.machine()}
+    get_cpu_capability = getattr(torch.backends.cpu, "get_cpu_capability",
+                                 None)
+    if get_cpu_capability is not None:
+        isa["capability"] = get_cpu_capability()
     try:
-        system: Dict[str, Any] = {
-            "device": {
-                "name":
-                torch.cuda.get_device_properties(
-                    torch.cuda.current_device()).name,
-            },
-            "version": {
-                "cuda": torch.version.cuda,
-            },
-        }
-    except (AssertionError, RuntimeError):
-        # If cuda is not installed, none of the above config is relevant.
-        system = {}
+        with open("/proc/cpuinfo", "r") as f:
+            for line in f:
+                # "flags" on x86, "Features" on aarch64
+                key, _, value = line.partition(":")
+                if key.strip() in ("flags", "Features"):
+                    isa["features"] = sorted(value.split())
+                    break
+    except OSError:
+        pass
+    return isa
+
+
+def get_system_info(target: str = "cuda") -> Dict[str, Any]:
+    if target == "cpu":
+        system: Dict[str, Any] = {"device": get_host_isa_info()}
+    else:
+        try:
+            system = {
+                "device": {
+                    "name":
+                    torch.cuda.get_device_properties(
+                        torch.cuda.current_device()).name,
+                },
+                "version": {
+                    "cuda": torch.version.cuda,
+                },
+            }
+        except (AssertionError, RuntimeError):
+            # If cuda is not installed, none of the above config is relevant.
+            system = {}
 
     system["hash"] = hashlib.sha256(
         json.dumps(system, sort_keys=True).encode("utf-8")).hexdigest()
@@ -115,16 +140,18 @@ class ByteIRFxGraphHashDetails:
         #     byteir_backend.deterministic.fill_uninitialized_memory,  # type: ignore[attr-defined]
         # )
 
-        # Global settings affecting matmul codegen.
-        self.cuda_matmul_settings = (
-            torch.backends.cuda.matmul.allow_tf32,
-            torch.backends.cuda.matmul.allow_fp16_reduced_precision_reduction,
-            torch.backends.cuda.matmul.allow_bf16_reduced_precision_reduction,
-        )
+        target = fx_kwargs.get("target", "cuda")
+        if target != "cpu":
+            # Global settings affecting matmul codegen.
+            self.cuda_matmul_settings = (
+                torch.backends.cuda.matmul.allow_tf32,
+                torch.backends.cuda.matmul.allow_fp16_reduced_precision_reduction,
+                torch.backends.cuda.matmul.allow_bf16_reduced_precision_reduction,
+            )
 
-        # Also hash on various system info (including the triton compiler version).
+        # Also hash on various system info (including the host isa for cpu target).
         self.torch_version = torch.__version__
-        self.system_info = get_system_info()
+        self.system_info = get_system_info(target)
 
     def debug_str(self) -> str:
         """
@@ -242,7 +269,7 @@ class ByteIRFxGraphCache:
 
     @staticmethod
     def _lookup_func(key: str):
-        ByteIRFxGraphCache.func_table[
+        return ByteIRFxGraphCache.func_table[
             key] if key in ByteIRFxGraphCache.func_table else None
 
     @staticmethod
@@ -468,7 +495,8 @@ class ByteIRFxGraphCache:
                 # cache miss, generate compiled function through `compile_fn`.
                 compiled_artifact = compile_fn(gm,
                                                example_inputs,
-                                               workdir=workdir)
+                                               workdir=workdir,
+                                               **kwargs)
                 compiled_artifact.hash_key = key
                 ByteIRFxGraphCache._save_compiled_artifact(
                     key, compiled_artifact, example_inputs)
@@ -476,11 +504,13 @@ class ByteIRFxGraphCache:
                 counters["byteir"]["fxgraph_artifact_cache_hit"] += 1
 
             # recover/generate `ByteIRFunction` from artifact obj.
-            byre_session = brt.Session(alloc_func=caching_allocator_alloc,
-                                       free_func=caching_allocator_delete)
-            byre_session.load(compiled_artifact.byre_file)
-            compiled_func = ByteIRFunction(byre_session,
-                                           compiled_artifact.none_indices)
+            byre_session = create_byre_session(compiled_artifact.byre_file,
+                                               compiled_artifact.target)
+            compiled_func = ByteIRFunction(
+                byre_session,
+                compiled_artifact.none_indices,
+                target=compiled_artifact.target,
+                dynamic_shape_info=compiled_artifact.dynamic_shape_info)
             # save `ByteIRFunction` obj.
             ByteIRFxGraphCache._save_func(key, compiled_func)
 
@@ -1,8 +1,12 @@
 import dataclasses
 import logging
+import threading
 from typing import Optional, Any, Callable, Dict, List, Sequence, Tuple, Union
 
 import torch
+from torch.fx.experimental.symbolic_shapes import SYMPY_INTERP
+
+from . import config
 
 try:
     import brt
@@ -12,6 +16,82 @@ except ImportError:
 log = logging.getLogger(__name__)
 
 
+# A dim is an int if static, otherwise the string of its sympy expression
+# over symbols of dynamo, e.g. "s0" or "2*s0".
+Dim = Union[int, str]
+
+
+def _dim_repr(d) -> Dim:
+    if isinstance(d, torch.SymInt):
+        expr = d.node.expr
+        if expr.is_number:
+            return int(expr)
+        return str(expr)
+    return int(d)
+
+
+@dataclasses.dataclass
+class DynamicShapeInfo:
+    """
+    Shapes of a graph with symbolic dims, which are compiled into a single
+    dynamic-shape byre module. Shapes of outputs are evaluated from the
+    values of symbols bound by inputs on every call.
+    """
+    # shape of each tensor input, or the symbol of a SymInt input
+    inputs: List[Union[List[Dim], Dim]]
+    # shape of each tensor output, or the expression of a SymInt output,
+    # None outputs excluded
+    outputs: List[Union[List[Dim], Dim]]
+
+    @staticmethod
+    def is_dynamic(example_inputs: List[Any]) -> bool:
+        for t in example_inputs:
+            if isinstance(t, torch.SymInt):
+                return True
+            if isinstance(t, torch.Tensor) and any(
+                    isinstance(d, torch.SymInt) for d in t.shape):
+                return True
+        return False
+
+    @staticmethod
+    def from_graph(gm: torch.fx.GraphModule,
+                   example_inputs: List[Any]) -> "DynamicShapeInfo":
+
+        def _repr(v):
+            if isinstance(v, torch.Tensor):
+                return [_dim_repr(d) for d in v.shape]
+            return _dim_repr(v)
+
+        inputs = [_repr(t) for t in example_inputs]
+        outputs = []
+        for node in gm.graph.nodes:
+            if node.op == "output":
+                rets = node.args[0]
+                if not isinstance(rets, (list, tuple)):
+                    rets = [rets]
+                outputs = [
+                    _repr(ret.meta["val"]) for ret in rets if ret is not None
+                ]
+        return DynamicShapeInfo(inputs, outputs)
+
+    def bind_symbols(self, inputs) -> Dict[str, int]:
+        symbols = {}
+        for info, inp in zip(self.inputs, inputs):
+            if isinstance(info, list):
+                for d, size in zip(info, inp.shape):
+                    if isinstance(d, str) and d.isidentifier():
+                        symbols[d] = int(size)
+            elif isinstance(info, str) and info.isidentifier():
+                symbols[info] = int(inp)
+        return symbols
+
+    @staticmethod
+    def evaluate(d: Dim, symbols: Dict[str, int]) -> int:
+        if isinstance(d, int):
+            return d
+        return int(eval(d, SYMPY_INTERP, symbols))
+
+
 @dataclasses.dataclass
 class CompiledArtifact:
     byre_file: str
@@ -25,77 +105,225 @@ class CompiledArtifact:
     # fx graph. The expression must be generated by:
     # ShapeEnv.produce_guards_expression()
     guards_expr: Optional[str] = None
+    # "cuda" or "cpu", which decides the device of brt session.
+    target: str = "cuda"
+    # Set if byre_file is compiled with dynamic shapes, which serves all
+    # sizes satisfying guards_expr.
+    dynamic_shape_info: Optional[DynamicShapeInfo] = None
+
+
+def create_byre_session(byre_file: str, target: str = "cuda"):
+    """
+    Create a brt session of `target` device and load `byre_file` into it.
+    """
+    if target == "cpu":
+        # host tensors are allocated by torch, so no allocator hooks needed.
+        byre_session = brt.Session(device="CPU")
+    else:
+        from torch.cuda.memory import caching_allocator_alloc, caching_allocator_delete
+        byre_session = brt.Session(alloc_func=caching_allocator_alloc,
+                                   free_func=caching_allocator_delete)
+    byre_session.load(byre_file)
+    return byre_session
+
+
+class _RequestState:
+    """
+    A brt request context with buffers recycled across calls, which is only
+    used by a single thread.
+    """
+
+    def __init__(self, req):
+        self.req = req
+        # staging buffers of non-contiguous inputs, indexed by input
+        self.staging_inputs: Dict[int, torch.Tensor] = {}
+        # output buffer sets which might be handed out again, along with the
+        # use counts of their storages when only the pool holds them
+        self.output_pool: List[Tuple[List[torch.Tensor], List[int]]] = []
+
+
+def _storage_use_count(tensor: torch.Tensor) -> int:
+    return torch._C._storage_Use_Count(tensor.untyped_storage()._cdata)
+
+
+def _is_unreferenced(tensor: torch.Tensor, pooled_use_count: int) -> bool:
+    # Pooled tensors are never handed out, callers get detached tensors which
+    # share the storage instead. So returned tensors, their views and tensors
+    # saved by autograd all hold references to the storage, and a buffer is
+    # free once its use count drops back to the pooled one.
+    return _storage_use_count(tensor) == pooled_use_count
 
 
 class ByteIRFunction:
     """
     Wrap the byteir compiled function and runtime as a callable object for dynamo, as dynamo caches callable in guards.
+
+    Every thread runs the function with its own request contexts, one per cuda
+    stream, so the function could be called concurrently. When
+    `reuse_outputs` is set, output buffers are recycled once all returned
+    tensors of a previous call are released.
+
+    With `dynamic_shape_info`, shapes of inputs and outputs are set to the
+    request context on every call, and SymInt inputs are passed as scalar
+    tensors.
     """
 
-    def __init__(self, module_path_or_session, none_indices):
+    def __init__(self,
+                 module_path_or_session,
+                 none_indices,
+                 target="cuda",
+                 reuse_outputs=None,
+                 output_pool_size=None,
+                 dynamic_shape_info=None):
+        from brt.utils import brt_dtype_to_torch_dtype
+
         if isinstance(module_path_or_session, brt.Session):
             self._session = module_path_or_session
         else:
-            self._session = brt.Session(alloc_func=caching_allocator_alloc,
-                                        free_func=caching_allocator_delete)
-            self._session.load(module_path_or_session)
+            self._session = create_byre_session(module_path_or_session, target)
         self._none_indices = none_indices
-        self._req = self._session.new_request_context(
-            torch.cuda.current_stream()._as_parameter_.value)
+        self._target = target
+        self._reuse_outputs = config.byteir_reuse_outputs if reuse_outputs is None else reuse_outputs
+        self._output_pool_size = config.byteir_output_pool_size if output_pool_size is None else output_pool_size
+        self._local = threading.local()
         self.input_arg_offsets = self._session.get_input_arg_offsets()
         self.output_arg_offsets = self._session.get_output_arg_offsets()
+        # query output metas once instead of on every call
+        self._output_metas = [
+            (tuple(self._session.get_static_shape(offset)),
+             brt_dtype_to_torch_dtype(self._session.get_data_type(offset)))
+            for offset in self.output_arg_offsets
+        ]
+        self._num_rets = len(self._output_metas) + len(self._none_indices)
+        self._dynamic_shape_info = dynamic_shape_info
+        self._input_dtypes = [
+            brt_dtype_to_torch_dtype(self._session.get_data_type(offset))
+            for offset in self.input_arg_offsets
+        ]
 
-    def __call__(self, *inputs):
-        from brt.utils import brt_dtype_to_torch_dtype
+    def _get_request_state(self) -> _RequestState:
+        states = getattr(self._local, "states", None)
+        if states is None:
+            states = self._local.states = {}
+        if self._target == "cpu":
+            stream = None
+        else:
+            stream = torch.cuda.current_stream()._as_parameter_.value
+        state = states.get(stream)
+        if state is None:
+            if stream is None:
+                req = self._session.new_request_context()
+            else:
+                req = self._session.new_request_context(stream)
+            state = states[stream] = _RequestState(req)
+        return state
+
+    def _prepare_input(self, state: _RequestState, idx: int,
+                       tensor: torch.Tensor) -> torch.Tensor:
+        if not isinstance(tensor, torch.Tensor):
+            # SymInt input of a dynamic-shape graph
+            return torch.tensor(tensor,
+                                dtype=self._input_dtypes[idx],
+                                device=self._target)
+        if tensor.device.type != self._target:
+            log.warning(f"device error: type={type(tensor)}, {tensor.device}")
+            tensor = tensor.to(self._target)
+        # a contiguous view is passed as is, including its storage offset
+        if tensor.is_contiguous():
+            return tensor
+        # FIXME. byteir runtime does not support strided tensors yet, copy
+        # them into recycled staging buffers instead of new ones.
+        staging = state.staging_inputs.get(idx)
+        if staging is None or staging.shape != tensor.shape or staging.dtype != tensor.dtype or staging.device != tensor.device:
+            staging = torch.empty(tensor.shape,
+                                  dtype=tensor.dtype,
+                                  device=tensor.device)
+            state.staging_inputs[idx] = staging
+        staging.copy_(tensor)
+        return staging
+
+    def _allocate_outputs(self, state: _RequestState, device: torch.device,
+                          shapes: List[Tuple[int, ...]]) -> List[torch.Tensor]:
+        if self._reuse_outputs:
+            for outputs, use_counts in state.output_pool:
+                if all(_is_unreferenced(t, use_count) and t.shape == shape
+                       for t, use_count, shape in zip(outputs, use_counts,
+                                                      shapes)):
+                    return [t.detach() for t in outputs]
+        outputs = [
+            torch.empty(shape, dtype=dtype, device=device)
+            for shape, (_, dtype) in zip(shapes, self._output_metas)
+        ]
+        if self._reuse_outputs and len(state.output_pool) < self._output_pool_size:
+            state.output_pool.append(
+                (outputs, [_storage_use_count(t) for t in outputs]))
+            return [t.detach() for t in outputs]
+        return outputs
 
+    def __call__(self, *inputs):
         log.debug(f"***** Run function compiled through byteir ******")
 
-        # FIXME. byteir requires all inputs on device side, move host side tensor to device.
-        # Preprocess the strided tensor as byteir does not support yet.
-        new_inputs = []
-
-        for i in range(0, len(inputs)):
-            _t = inputs[i]
-            if not _t.is_cuda:
-                log.warning(f"device error: type={type(_t)}, {_t.device}")
-                _t = _t.to("cuda")
-            new_inputs.append(_t.contiguous())
-
-        device = new_inputs[0].device
-
-        results = [
-            torch.empty(
-                self._session.get_static_shape(offset),
-                dtype=brt_dtype_to_torch_dtype(
-                    self._session.get_data_type(offset)),
-                device=device,
-            ) for offset in self._session.get_output_arg_offsets()
+        state = self._get_request_state()
+        new_inputs = [
+            self._prepare_input(state, idx, t) for idx, t in enumerate(inputs)
+        ]
+        device = new_inputs[0].device if new_inputs else torch.device(
+            self._target)
+        req = state.req
+
+        info = self._dynamic_shape_info
+        if info is None:
+            output_shapes = [shape for shape, _ in self._output_metas]
+        else:
+            symbols = info.bind_symbols(inputs)
+            output_shapes = [
+                tuple(info.evaluate(d, symbols) for d in out)
+                if isinstance(out, list) else () for out in info.outputs
+            ]
+            # shapes must be set before binding, as changing the shape of an
+            # arg unbinds it
+            for offset, inp in zip(self.input_arg_offsets, new_inputs):
+                req.set_shape(offset, list(inp.shape))
+            for offset, shape in zip(self.output_arg_offsets, output_shapes):
+                req.set_shape(offset, list(shape))
+        results = self._allocate_outputs(state, device, output_shapes)
+
+        offsetAndArgs = [
+            (offset, inp.data_ptr())
+            for offset, inp in zip(self.input_arg_offsets, new_inputs)
         ]
+        offsetAndArgs += [
+            (offset, out.data_ptr())
+            for offset, out in zip(self.output_arg_offsets, results)
+        ]
+        req.bind_args(offsetAndArgs)
+        req.finish_io_binding()
+        req.run()
+        req.sync()
 
-        inputOffsetAndArg = [None] * len(new_inputs)
-        outputOffsetAndArg = [None] * len(results)
-        for idx, (offset, inp) in enumerate(zip(self.input_arg_offsets, new_inputs)):
-            inputOffsetAndArg[idx] = (offset, inp.data_ptr())
-        for idx, (offset, out) in enumerate(zip(self.output_arg_offsets, results)):
-            outputOffsetAndArg[idx] = (offset, out.data_ptr())
-        self._req.bind_args(inputOffsetAndArg)
-        self._req.bind_args(outputOffsetAndArg)
-        self._req.finish_io_binding()
-        self._req.run()
-        self._req.sync()
+        if info is not None and any(
+                not isinstance(out, list) for out in info.outputs):
+            # SymInt outputs, e.g. sizes saved for backward, are returned as
+            # ints evaluated from symbols instead of scalar tensors
+            results = [
+                r if isinstance(out, list) else info.evaluate(out, symbols)
+                for r, out in zip(results, info.outputs)
+            ]
 
         # add None results to return values
-        rets = []
-        none_cnt = 0
-        result_cnt = 0
-        for i in range(len(results) + len(self._none_indices)):
-            if none_cnt < len(
-                    self._none_indices) and i == self._none_indices[none_cnt]:
-                rets.append(None)
-                none_cnt += 1
-            else:
-                rets.append(results[result_cnt])
-                result_cnt += 1
+        if not self._none_indices:
+            rets = list(results)
+        else:
+            rets = [None] * self._num_rets
+            none_cnt = 0
+            result_cnt = 0
+            for i in range(self._num_rets):
+                if none_cnt < len(
+                        self._none_indices) and i == self._none_indices[none_cnt]:
+                    none_cnt += 1
+                else:
+                    rets[i] = results[result_cnt]
+                    result_cnt += 1
         if len(rets) == 1:
             return rets[0]
         return rets
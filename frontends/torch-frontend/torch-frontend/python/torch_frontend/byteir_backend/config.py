@@ -1,7 +1,26 @@
 import os
+import platform
+
+# Target of byteir compilation, "cuda" or "cpu". Inferred from the device of
+# graph inputs if not set.
+byteir_target = os.environ.get("BYTEIR_TARGET", "")
+
+# Only used by "cpu" target.
+byteir_cpu_arch = os.environ.get("BYTEIR_CPU_ARCH", platform.machine())
+
+# Compile graphs with symbolic dims marked by dynamo into dynamic-shape byre
+# modules. If disabled, symbolic dims are specialized to the sizes of example
+# inputs and guarded, so dynamo recompiles the graph for other sizes.
+byteir_dynamic_shape = os.environ.get("BYTEIR_DYNAMIC_SHAPE", "1") == "1"
 
 byteir_enable_tf32 = os.environ.get("BYTEIR_ENABLE_TF32") == "1"
 
+# Recycle output buffers of compiled functions once all returned tensors of a
+# previous call are released, at most `byteir_output_pool_size` sets of them
+# per request context.
+byteir_reuse_outputs = os.environ.get("BYTEIR_REUSE_OUTPUTS") == "1"
+byteir_output_pool_size = int(os.environ.get("BYTEIR_OUTPUT_POOL_SIZE", "2"))
+
 byteir_not_use_cache = os.environ.get("BYTEIR_NOT_USE_CACHE") == "1"
 
 # TODO. default not save fx graph.
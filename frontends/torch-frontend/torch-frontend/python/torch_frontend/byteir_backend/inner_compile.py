@@ -10,7 +10,6 @@ from torch._dynamo import (
     utils as dynamo_utils, )
 from torch._dynamo.utils import counters
 from torch._dynamo.utils import detect_fake_mode
-from torch.cuda.memory import caching_allocator_alloc, caching_allocator_delete
 from torch.fx.experimental.proxy_tensor import maybe_disable_fake_tensor_mode
 from torch._subclasses.fake_tensor import (
     FakeTensorMode,
@@ -35,6 +34,8 @@ from .compilation_cache import (
 from .compiled_function import (
     CompiledArtifact,
     ByteIRFunction,
+    DynamicShapeInfo,
+    create_byre_session,
 )
 from .utils import (
     dump_tensors_meta_info,
@@ -50,18 +51,70 @@ log = logging.getLogger(__name__)
 g_graph_counter = count(0)
 
 
+def get_target(example_inputs: List[torch.Tensor]) -> str:
+    """
+    Get byteir target of the graph, which is `config.byteir_target` if set,
+    otherwise "cuda" if any input lives on cuda and "cpu" if not.
+    """
+    if config.byteir_target:
+        return config.byteir_target
+    devices = [
+        t.device.type for t in example_inputs if isinstance(t, torch.Tensor)
+    ]
+    if not devices:
+        return "cuda" if torch.cuda.is_available() else "cpu"
+    return "cuda" if "cuda" in devices else "cpu"
+
+
+def concretize_graph(
+        gm: torch.fx.GraphModule,
+        example_inputs: List[Any]) -> Tuple[torch.fx.GraphModule, List[Any]]:
+    """
+    Retrace `gm` with symbolic dims specialized to the sizes of
+    `example_inputs`, and return it along with fake inputs of those sizes.
+    The sizes are guarded, so dynamo recompiles the graph for inputs of other
+    sizes. SymInt inputs stay placeholders of scalar tensors, which is how
+    ByteIRFunction binds them, but their values are folded into the graph.
+    """
+    from torch.fx.experimental.proxy_tensor import make_fx
+    from torch.fx.experimental.symbolic_shapes import guard_int
+
+    constants = {}
+    fake_mode = FakeTensorMode()
+    inputs = []
+    with fake_mode:
+        for idx, t in enumerate(example_inputs):
+            if isinstance(t, torch.Tensor):
+                inputs.append(
+                    torch.empty_strided([guard_int(d) for d in t.shape],
+                                        [guard_int(s) for s in t.stride()],
+                                        dtype=t.dtype,
+                                        device=t.device))
+            else:
+                constants[idx] = guard_int(t)
+                inputs.append(torch.empty((), dtype=torch.int64))
+
+    def specialized(*args):
+        return gm(*[constants.get(idx, a) for idx, a in enumerate(args)])
+
+    with maybe_disable_fake_tensor_mode():
+        return make_fx(specialized, tracing_mode="fake")(*inputs), inputs
+
+
 #@dynamo_utils.dynamo_timed(phase_name="byteir_compile")
 def inner_compile(gm: torch.fx.GraphModule,
                   example_inputs: List[torch.Tensor],
                   workdir: str = None,
                   compiler_type: str = "forward",
+                  target: str = "cuda",
                   **kwargs) -> CompiledArtifact:
 
     graph_id = next(g_graph_counter)
-    log.info(f"byteir compiling {compiler_type} graph {graph_id}")
+    log.info(f"byteir compiling {compiler_type} graph {graph_id} for {target}")
 
     if workdir is None:
-        key = compiled_fx_graph_hash(gm, example_inputs, kwargs)
+        key = compiled_fx_graph_hash(gm, example_inputs,
+                                     dict(kwargs, target=target))
         workdir = ByteIRFxGraphCache._get_tmp_dir_for_key(key)
 
     stablehlo_fiel_name = f"model.stablehlo.mlir"
@@ -97,20 +150,36 @@ def inner_compile(gm: torch.fx.GraphModule,
             with open(stablehlo_file, "w") as f:
                 print(module.operation.get_asm(), file=f)
         if not os.path.exists(byre_file):
-            byteir.compile(stablehlo_file,
-                           byre_file,
-                           verbose=False,
-                           target="cuda",
-                           enable_tf32=config.byteir_enable_tf32)
+            if target == "cpu":
+                byteir.compile(stablehlo_file,
+                               byre_file,
+                               verbose=False,
+                               target="cpu",
+                               cpu_arch=config.byteir_cpu_arch)
+            else:
+                byteir.compile(stablehlo_file,
+                               byre_file,
+                               verbose=False,
+                               target="cuda",
+                               enable_tf32=config.byteir_enable_tf32)
             #byteir.compile(stablehlo_file, byre_file, verbose=False, target="cuda_with_ait")
 
-        byre_session = brt.Session(alloc_func=caching_allocator_alloc,
-                                   free_func=caching_allocator_delete)
-        byre_session.load(byre_file)
+        byre_session = create_byre_session(byre_file, target)
     log.debug("#### byteir compile success")
     none_indices = get_none_indices(gm)
 
-    compiled_artifact = CompiledArtifact(byre_file, none_indices)
+    # symbolic dims marked by dynamo are kept as dynamic dims of stablehlo, so
+    # the byre module serves all sizes within guards without recompilation
+    dynamic_shape_info = None
+    if config.byteir_dynamic_shape and DynamicShapeInfo.is_dynamic(
+            example_inputs):
+        dynamic_shape_info = DynamicShapeInfo.from_graph(gm, example_inputs)
+        log.info(f"byteir compiled {compiler_type} graph {graph_id} with dynamic shapes")
+
+    compiled_artifact = CompiledArtifact(byre_file,
+                                         none_indices,
+                                         target=target,
+                                         dynamic_shape_info=dynamic_shape_info)
 
     return compiled_artifact
 
@@ -128,17 +197,25 @@ def byteir_fx_compiler(gm: torch.fx.GraphModule,
     )
     log.info(torch._guards.TracingContext.get())
 
+    target = get_target(example_inputs)
+    # the cpu target only compiles static shapes
+    specialize = not config.byteir_dynamic_shape or target == "cpu"
+    if specialize and DynamicShapeInfo.is_dynamic(example_inputs):
+        # specialize before hashing, so each size gets its own cache entry
+        gm, example_inputs = concretize_graph(gm, example_inputs)
     if config.byteir_not_use_cache:
-        compiled_artifact = inner_compile(gm, example_inputs)
-        byre_session = brt.Session(alloc_func=caching_allocator_alloc,
-                                   free_func=caching_allocator_delete)
-        byre_session.load(compiled_artifact.byre_file)
-        byre_func = ByteIRFunction(byre_session,
-                                   compiled_artifact.none_indices)
+        compiled_artifact = inner_compile(gm, example_inputs, target=target)
+        byre_session = create_byre_session(compiled_artifact.byre_file,
+                                           target)
+        byre_func = ByteIRFunction(
+            byre_session,
+            compiled_artifact.none_indices,
+            target=target,
+            dynamic_shape_info=compiled_artifact.dynamic_shape_info)
     else:
         byre_func = ByteIRFxGraphCache.Load(
             functools.partial(inner_compile, compiler_type=compiler_type), gm,
-            example_inputs)
+            example_inputs, target=target)
 
     log.debug(f"Counters:\n{counters}")
     return byre_func
@@ -180,6 +180,9 @@ def dump_tensors_meta_info(tensors: list[torch.Tensor, FakeTensor],
     for t in tensors:
         if t is None:
             _meta_infos.append(None)
+        elif not isinstance(t, torch.Tensor):
+            # SymInt of dynamic shapes
+            _meta_infos.append(str(t))
         else:
             _meta_infos.append(extract_tensor_metadata(t))
     with open(save_path, "wb") as f:
@@ -7,6 +7,10 @@ source_group(TREE ${REPO_ROOT} FILES ${brt_device_cpu_srcs})
 
 brt_add_object_library(brt_device_cpu ${brt_device_cpu_srcs})
 target_link_libraries(brt_device_cpu LLVMOrcJIT LLVMX86CodeGen LLVMX86AsmParser)
+if(UNIX AND NOT APPLE)
+  # shm_open of the shared memory transport of DistributedBackendCPU
+  target_link_libraries(brt_device_cpu rt)
+endif()
 brt_add_include_to_target(brt_device_cpu brt_framework brt_common)
 set_target_properties(brt_device_cpu PROPERTIES FOLDER "Brt")
 
@@ -18,7 +18,13 @@
 #pragma once
 
 #include "brt/core/context/work_queue.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace brt {
@@ -56,5 +62,65 @@ public:
 private:
   std::vector<std::function<void(void)>> tasks;
 };
+
+// WorkQueue which runs host tasks concurrently on a pool of threads, each
+// once the tasks of ops it depends on complete. Dependencies on ops without
+// pending tasks are already satisfied. Tasks of the same op run in order.
+// On NUMA machines threads are bound to nodes round-robin, and prefer tasks
+// enqueued while their node is hinted.
+class CPUParallelWorkQueue : public WorkQueue {
+public:
+  // use all hardware threads if `num_threads` is 0
+  explicit CPUParallelWorkQueue(size_t num_threads = 0,
+                                const std::string &name = "cpu_parallel");
+
+  ~CPUParallelWorkQueue() override;
+
+  common::Status AddTask(int /*task_type*/, const void * /*func*/,
+                         void ** /*args*/, int /*op_id*/,
+                         const std::vector<int> & /*dependency*/) override;
+
+  // wait for all tasks added so far
+  common::Status Sync() override;
+
+  common::Status AddHostTask(const void *task, void **args, int op_id,
+                             const std::vector<int> &dependency) override;
+
+  void SetNumaNode(int numa_node) override;
+
+private:
+  struct Task {
+    std::function<void(void)> func;
+    size_t num_pending_deps = 0;
+    bool done = false;
+    std::vector<size_t> successors;
+    // index of the ready queue
+    size_t queue = 0;
+  };
+
+  void Worker(size_t worker_id);
+
+  void PushReady(size_t index);
+
+  // pop a ready task, preferring `queue`, then tasks of no node
+  size_t PopReady(size_t queue);
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable done_cv_;
+  // tasks added since last Sync, indexed in order of addition
+  std::deque<Task> tasks_;
+  // last task of each op
+  std::unordered_map<int, size_t> op_to_task_;
+  // ready tasks of each NUMA node, followed by those of no node
+  std::vector<std::deque<size_t>> ready_;
+  size_t num_ready_ = 0;
+  size_t num_unfinished_ = 0;
+  size_t num_nodes_ = 1;
+  // hinted node of tasks enqueued from now on, -1 for none
+  std::atomic<int> numa_node_{-1};
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
 } // namespace cpu
 } // namespace brt
@@ -0,0 +1,36 @@
+//===- d_context_cpu.h ----------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "brt/core/distributed/d_context.h"
+
+#include <memory>
+
+namespace brt {
+
+// collective communications on cpu run on the calling thread, so there is
+// nothing like a stream to carry
+class CPUContext : public DContext {
+public:
+  static std::shared_ptr<CPUContext> make() {
+    return std::make_shared<CPUContext>();
+  }
+  std::string type() const override { return "BRT_CTX_CPU"; }
+};
+
+} // namespace brt
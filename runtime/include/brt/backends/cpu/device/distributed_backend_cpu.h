@@ -0,0 +1,123 @@
+//===- distributed_backend_cpu.h ------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "brt/core/common/status.h"
+#include "brt/core/distributed/distributed_backend.h"
+#include "brt/core/framework/dtype.h"
+
+#include <memory>
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+class AsyncQueue;
+} // namespace ccl
+} // namespace cpu
+
+class DistributedBackendCPUPrivate;
+
+// Distributed Backend implemented on host memory
+// Ranks on the same host exchange data through shared memory rings and ranks
+// on other hosts through TCP sockets, both set up via the rendezvous server
+// in do_init(). Collective communications are performed synchronously on the
+// calling thread, or asynchronously on a communication thread by issue_async.
+//
+// Environment variables:
+//   BRT_CCL_DISABLE_SHM=1    use TCP between all ranks
+//   BRT_CCL_SOCKET_ADDR=ip   address other hosts reach this rank at, by
+//                            default the one routing to the rendezvous server
+//   BRT_CCL_TIMEOUT_SECONDS=n
+//                            fail connecting to peers or a transfer without
+//                            progress after n seconds, 600 by default and 0
+//                            to wait forever
+class DistributedBackendCPU : public DistributedBackend {
+public:
+  DistributedBackendCPU(int nranks, int rank);
+
+  ~DistributedBackendCPU();
+
+  common::Status do_init() override;
+  common::Status do_init(BcastCallback cb) override;
+
+  common::Status _send(const void *sendbuff, size_t size, uint32_t rank,
+                       std::shared_ptr<DContext> ctx) override;
+
+  common::Status _recv(void *recvbuff, size_t size, uint32_t rank,
+                       std::shared_ptr<DContext> ctx) override;
+
+  common::Status scatter(const void *sendbuff, void *recvbuff, size_t recvlen,
+                         DTypeEnum dtype, uint32_t root,
+                         std::shared_ptr<DContext> ctx) override;
+
+  common::Status gather(const void *sendbuff, void *recvbuff, size_t sendlen,
+                        DTypeEnum dtype, uint32_t root,
+                        std::shared_ptr<DContext> ctx) override;
+
+  common::Status all_to_all(const void *sendbuff, void *recvbuff, size_t len,
+                            DTypeEnum dtype,
+                            std::shared_ptr<DContext> ctx) override;
+
+  // recursive doubling all gather when the group size is a power of two,
+  // otherwise ring all gather
+  common::Status all_gather(const void *sendbuff, void *recvbuff,
+                            size_t sendlen, DTypeEnum dtype,
+                            std::set<int64_t> replica_group,
+                            std::shared_ptr<DContext> ctx) override;
+
+  // recursive halving reduce scatter followed by recursive doubling all gather
+  // when the group size is a power of two, otherwise ring reduce scatter
+  // followed by ring all gather
+  common::Status all_reduce(const void *sendbuff, void *recvbuff, size_t len,
+                            DTypeEnum dtype, ReduceOp op,
+                            std::set<int64_t> replica_group,
+                            std::shared_ptr<DContext> ctx) override;
+
+  // ring reduce scatter
+  common::Status reduce_scatter(const void *sendbuff, void *recvbuff,
+                                size_t recvlen, DTypeEnum dtype, ReduceOp op,
+                                std::shared_ptr<DContext> ctx) override;
+
+  // pipelined chain broadcast starting from root
+  common::Status broadcast(const void *sendbuff, void *recvbuff, size_t len,
+                           DTypeEnum dtype, uint32_t root,
+                           std::set<int64_t> replica_group,
+                           std::shared_ptr<DContext> ctx) override;
+
+  common::Status reduce(const void *sendbuff, void *recvbuff, size_t len,
+                        DTypeEnum dtype, ReduceOp op, uint32_t root,
+                        std::shared_ptr<DContext> ctx) override;
+
+  // no-op, since every operation completes before returning
+  common::Status group_start() override;
+  common::Status group_end() override;
+
+  // `task` runs on the communication thread. Collectives called on other
+  // threads drain_async first, so that only one thread communicates.
+  void issue_async(int64_t async_id,
+                   std::function<common::Status()> task) override;
+  common::Status wait_async(int64_t async_id) override;
+  common::Status drain_async() override;
+
+private:
+  std::unique_ptr<DistributedBackendCPUPrivate> m_cpu;
+  // destroyed first, since its pending tasks still communicate
+  std::unique_ptr<cpu::ccl::AsyncQueue> m_async;
+};
+
+} // namespace brt
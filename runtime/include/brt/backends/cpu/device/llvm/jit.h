@@ -35,6 +35,7 @@ public:
 
   static std::unique_ptr<LLVMJIT> Create();
 
+  // load LLVM IR (text or bitcode), or a static archive of objects
   common::Status LoadFromFile(const std::string &path);
 
   // \p buf should be a pointer to llvm ThreadSafeModule
@@ -21,7 +21,11 @@
 #include "brt/core/common/status.h"
 #include "brt/core/framework/execution_provider.h"
 
+#include <memory>
+
 namespace brt {
+class DistributedBackendCPU;
+class DistributedSession;
 class Session;
 
 struct CPUExecutionProviderOptions : ProviderOptions {
@@ -39,6 +43,26 @@ protected:
   CPUExecutionProviderOptions options_;
 };
 
+// CPU provider owning a DistributedBackendCPU, which runs the collective ops
+// of a DistributedSession
+class DistributedCPUExecutionProvider : public CPUExecutionProvider {
+public:
+  DistributedCPUExecutionProvider(const CPUExecutionProviderOptions &options,
+                                  int nranks, int rank, const std::string &ip,
+                                  int port,
+                                  const std::string &name = ProviderType::BRT);
+
+  ~DistributedCPUExecutionProvider();
+
+  DistributedBackendCPU *GetDistributedBackend() { return cpu_backend_.get(); }
+
+  const common::Status &GetInitStatus() const { return init_status_; }
+
+protected:
+  std::unique_ptr<DistributedBackendCPU> cpu_backend_;
+  common::Status init_status_;
+};
+
 common::Status NaiveCPUExecutionProviderFactory(Session *session);
 
 // TODO add more option later
@@ -46,4 +70,12 @@ common::Status
 NaiveCPUExecutionProviderFactory(Session *session,
                                  const CPUExecutionProviderOptions &options);
 
+// create a DistributedCPUExecutionProvider connected to the other ranks of
+// `session`, and set its backend as the distributed backend of `session`
+common::Status
+DistributedCPUExecutionProviderFactory(DistributedSession *session);
+
+common::Status DistributedCPUExecutionProviderFactory(
+    DistributedSession *session, const CPUExecutionProviderOptions &options);
+
 } // namespace brt
@@ -20,6 +20,8 @@
 #include "brt/backends/cuda/device/cuda_env.h"
 #include "brt/core/context/work_queue.h"
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 // CUDA forwarding
@@ -52,7 +54,7 @@ public:
       : WorkQueue(name), env_(env) {}
 
   // Undefined what happens to pending work when destructor is called.
-  virtual ~CUDAWorkQueue() {}
+  virtual ~CUDAWorkQueue();
 
   // Enqueue a func call, thread-safe.
   // func is a stateless function
@@ -74,10 +76,25 @@ public:
 
   cuda::CudaEnv &GetCudaEnv() { return env_; }
 
+  // Asynchronous collectives run on a comm stream, created on first use,
+  // so that they overlap with work issued to the compute stream meanwhile.
+  // BeginComm orders the comm stream after work issued to the compute stream
+  // so far and returns it. EndComm records completion of work issued to the
+  // comm stream so far as `async_id`, which WaitComm orders the compute
+  // stream after.
+  CUstream_st *BeginComm();
+  common::Status EndComm(int64_t async_id);
+  common::Status WaitComm(int64_t async_id);
+
 private:
   CUDAWorkQueue(const CUDAWorkQueue &) = delete;
   CUDAWorkQueue &operator=(const CUDAWorkQueue &) = delete;
   cuda::CudaEnv env_;
+
+  std::mutex comm_mutex_;
+  CUstream_st *comm_stream_ = nullptr;
+  CUevent_st *compute_event_ = nullptr;
+  std::unordered_map<int64_t, CUevent_st *> comm_events_;
 };
 
 /**
@@ -0,0 +1,41 @@
+//===- numa.h -------------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace brt {
+namespace numa {
+
+// Return ids of online NUMA nodes in ascending order, which may have gaps,
+// e.g. {0, 2}, or {0} if unknown
+const std::vector<int> &GetNodes();
+
+// Return the number of NUMA nodes, 1 if unknown
+int GetNumNodes();
+
+// Bind the calling thread to the cpus of `node`, return false on failure
+bool BindCurrentThreadToNode(int node);
+
+// Move pages lying entirely within [ptr, ptr + size) to `node` and keep them
+// there, return false on failure. Memory is left where it is on failure.
+bool MoveToNode(void *ptr, size_t size, int node);
+
+} // namespace numa
+} // namespace brt
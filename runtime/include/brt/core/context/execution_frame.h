@@ -311,7 +311,8 @@ private:
  * 1. Graph Weights (stored in Info, Context)
  * 2. Graph Inputs  (stored in Context)
  * 3. Graph Outputs (stored in Context)
- * 4. Intermediate Tensors  (stored Context)
+ * 4. Intermediate Tensors  (stored Context, or in Info for session-internal
+ *    buffers)
  *
  * BRT Inference ExecutionFrame allows weight override.
  * Therefore, info will only copy non-override weights to Context.
@@ -339,6 +340,9 @@ public:
     // allocator offset which indicates the underlying memory of corresponding
     // intermediate tensor is allocated by group allocation
     static constexpr int64_t kGroupAllocationOffset = -1;
+    // allocator offset which indicates the underlying memory of corresponding
+    // intermediate tensor is a session-internal buffer, see session_buffers
+    static constexpr int64_t kSessionAllocationOffset = -3;
 
     const brt::ir::GraphInfo &graph_info;
 
@@ -359,6 +363,10 @@ public:
     // store all buffers of weights
     std::vector<AsyncValue> weights;
 
+    // map an intermediate index to its session-internal buffer, which is
+    // shared by all frames, e.g. outputs of session init kernels
+    std::unordered_map<size_t, AsyncValue> session_buffers;
+
     // store op dependency
     std::unordered_map<mlir::Operation *, std::vector<mlir::Operation *>>
         dependency_graph;
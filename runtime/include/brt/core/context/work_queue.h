@@ -69,6 +69,10 @@ public:
   virtual common::Status AddHostTask(const void *task, void **args, int op_id,
                                      const std::vector<int> &dependency) = 0;
 
+  // Hint the NUMA node where tasks enqueued from now on should run, or -1 for
+  // none, ignored by default
+  virtual void SetNumaNode(int /*numa_node*/) {}
+
   // Enqueue through a functor
   // Note, the functor is called immediately.
   inline common::Status
@@ -109,10 +109,26 @@ public:
   // mark the end of a series of (send recv)
   virtual common::Status group_end() = 0;
 
+  // Run `task`, which calls collectives of this backend, asynchronously after
+  // tasks issued before. wait_async blocks until the task issued as
+  // `async_id` completes, and drain_async until all of them complete.
+  // Backends enqueuing collectives to device streams complete on return, so
+  // the task runs inplace by default.
+  virtual void issue_async(int64_t /*async_id*/,
+                           std::function<common::Status()> task) {
+    task();
+  }
+  virtual common::Status wait_async(int64_t /*async_id*/) {
+    return common::Status::OK();
+  }
+  virtual common::Status drain_async() { return common::Status::OK(); }
+
 protected:
   uint32_t m_nranks;
   uint32_t m_rank;
   std::shared_ptr<RendezvousSocket> m_client;
+  // address of the rendezvous server, empty if initialized by a callback
+  std::string m_master_ip;
 
   // send data to another communicator in the group
   virtual common::Status _send(const void *sendbuff, size_t size, uint32_t rank,
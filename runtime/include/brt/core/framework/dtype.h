@@ -20,6 +20,7 @@
 #include "brt/core/common/common.h"
 #include "brt/core/common/string_view.h"
 #include <cstdint>
+#include <cstring>
 #include <half/half.hpp>
 #include <limits>
 #include <type_traits>
@@ -46,6 +47,33 @@ enum class DTypeEnum : uint32_t {
   Unsupported = LastDType,
 };
 
+// storage type of bfloat16, arithmetic should be done in float
+struct BFloat16 {
+  uint16_t bits;
+
+  BFloat16() = default;
+  explicit BFloat16(float f) : bits(FromFloat(f)) {}
+  explicit operator float() const { return ToFloat(bits); }
+
+  // round to nearest even, keep NaN quiet
+  static uint16_t FromFloat(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    if ((u & 0x7fffffffu) > 0x7f800000u) {
+      return static_cast<uint16_t>((u >> 16) | 0x40u);
+    }
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return static_cast<uint16_t>(u >> 16);
+  }
+
+  static float ToFloat(uint16_t b) {
+    uint32_t u = static_cast<uint32_t>(b) << 16;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+  }
+};
+
 template <DTypeEnum dtype_enum> struct DTypeTraits;
 template <typename ctype> struct ctype_to_dtype;
 
@@ -67,6 +95,7 @@ struct DTypeTraitsImpl<T,
 };
 
 template <> struct DTypeTraitsImpl<StringView, void> {};
+template <> struct DTypeTraitsImpl<BFloat16, void> {};
 } // namespace dtype
 
 #define BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(dtype_enum, ctype)                     \
@@ -88,6 +117,7 @@ BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(UInt8, uint8_t)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(UInt32, uint32_t)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(Float64, double)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(Float16, half_float::half)
+BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(BFloat16, BFloat16)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(Bool, bool)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(StringView, StringView)
 BRT_DEF_DTYPE_TRAITS_FROM_CTYPE(Int8, int8_t)
@@ -127,6 +157,7 @@ inline constexpr DTypeEnum dtype_enum_v = ctype_to_dtype<ctype>::value;
     CASE(UInt32);                                                              \
     CASE(Float64);                                                             \
     CASE(Float16);                                                             \
+    CASE(BFloat16);                                                            \
     CASE(Bool);                                                                \
     CASE(StringView);                                                          \
     CASE(Int8);                                                                \
@@ -25,8 +25,12 @@
 #include "brt/core/framework/dtype.h"
 #include "brt/core/ir/graph_info.h"
 #include "brt/core/ir/ir.h"
+#include "mlir/IR/Attributes.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace brt {
@@ -77,6 +81,10 @@ public:
   virtual common::Status LoadWeights(const std::string &url,
                                      const std::string &fmt) = 0;
 
+  // Reuse weights of \p owner which have the same value instead of keeping a
+  // copy, \p owner must outlive this plan
+  virtual common::Status ShareWeights(ExecutionPlan &owner) = 0;
+
   ExecutionFrame::StateInfo &GetFrameStateInfo() { return frame_state_info_; }
 
   virtual common::Status ProloguePerFrame(const ExecutionContext &) = 0;
@@ -132,6 +140,8 @@ public:
   common::Status LoadWeights(const std::string &url,
                              const std::string &fmt) override;
 
+  common::Status ShareWeights(ExecutionPlan &owner) override;
+
   common::Status ProloguePerFrame(const ExecutionContext &) override;
   common::Status EpiloguePerFrame(const ExecutionContext &) override;
 
@@ -160,6 +170,23 @@ private:
   // concrete tensor data
   std::vector<OpKernel *> shape_op_kernels_;
   std::vector<OpKernel *> compute_op_kernels_;
+
+  // stages of consecutive compute ops assigned to the same NUMA node, as the
+  // index of the first op in compute_op_kernels_ and the node, -1 for none
+  std::vector<std::pair<size_t, int>> numa_stages_;
+
+  // kernels which only depend on weights, they would be run in the first Run
+  // after weights were loaded or exposed for update, and their outputs are
+  // kept in session-internal buffers
+  std::vector<OpKernel *> session_init_op_kernels_;
+  std::atomic<bool> session_init_outdated_{true};
+  std::mutex session_init_mutex_;
+  std::vector<std::pair<IAllocator *, void *>> session_allocations_;
+
+  // weight_value attrs of weights, null if a weight has no initial value
+  std::vector<mlir::Attribute> weight_values_;
+  // weights whose buffers are owned by another plan
+  std::unordered_set<size_t> shared_weights_;
 };
 
 } // namespace brt
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "byteir/Dialect/Byre/ByreDialect.h"
+#include <optional>
 
 namespace brt {
 
@@ -38,4 +39,11 @@ bool IsDynamicAllocOp(mlir::Operation *op,
 
 bool IsShapeComputeOp(mlir::Operation *op);
 
+// return whether op only depends on weights and could be evaluated once per
+// session
+bool IsSessionInitOp(mlir::Operation *op);
+
+// return the NUMA node op is assigned to, if any
+std::optional<int> GetNumaNode(mlir::Operation *op);
+
 } // namespace brt
@@ -68,6 +68,11 @@ public:
   // Load a file to initialize weights
   common::Status LoadWeights(const std::string &url, const std::string &fmt);
 
+  // Reuse weights of \p owner which have the same value instead of keeping a
+  // copy. It must be called before creating any RequestContext, and \p owner
+  // must outlive this session
+  common::Status ShareWeights(Session &owner);
+
   // Create a new RequestContext
   // Note: request_ctx would take the ownership of the \p work_queue if it is
   // not nullptr
@@ -0,0 +1,89 @@
+//===- async_queue.cc -----------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "./async_queue.h"
+
+using namespace brt::common;
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+
+AsyncQueue::~AsyncQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void AsyncQueue::Issue(int64_t id, std::function<Status()> task) {
+  // an id is issued again only after its task completes
+  Wait(id);
+
+  std::packaged_task<Status()> packaged(std::move(task));
+  pending_.emplace(id, packaged.get_future());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(packaged));
+    if (!worker_.joinable())
+      worker_ = std::thread([this] { Loop(); });
+  }
+  cv_.notify_one();
+}
+
+Status AsyncQueue::Wait(int64_t id) {
+  auto found = pending_.find(id);
+  if (found == pending_.end())
+    return Status::OK();
+  Status status = found->second.get();
+  pending_.erase(found);
+  return status;
+}
+
+Status AsyncQueue::Drain() {
+  Status result = Status::OK();
+  for (auto &&it : pending_) {
+    Status status = it.second.get();
+    if (result.IsOK() && !status.IsOK())
+      result = status;
+  }
+  pending_.clear();
+  return result;
+}
+
+void AsyncQueue::Loop() {
+  while (true) {
+    std::packaged_task<Status()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty())
+        return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+} // namespace ccl
+} // namespace cpu
+} // namespace brt
@@ -0,0 +1,72 @@
+//===- async_queue.h ------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include "brt/core/common/status.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+
+// Runs tasks in issue order on a worker thread started on first use, each
+// identified by an id until waited
+class AsyncQueue {
+public:
+  AsyncQueue() = default;
+
+  // join the worker thread after running all issued tasks
+  ~AsyncQueue();
+
+  void Issue(int64_t id, std::function<common::Status()> task);
+
+  // block until the task issued as `id` completes and return its status, or
+  // OK if there is no such task
+  common::Status Wait(int64_t id);
+
+  // block until all issued tasks complete, return the first failed status
+  common::Status Drain();
+
+private:
+  void Loop();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::packaged_task<common::Status()>> tasks_;
+  bool stop_ = false;
+  std::thread worker_;
+
+  // only accessed by the issuing thread
+  std::unordered_map<int64_t, std::future<common::Status>> pending_;
+
+  AsyncQueue(const AsyncQueue &) = delete;
+  AsyncQueue &operator=(const AsyncQueue &) = delete;
+};
+
+} // namespace ccl
+} // namespace cpu
+} // namespace brt
@@ -0,0 +1,112 @@
+//===- reduce.h -----------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "brt/core/common/common.h"
+#include "brt/core/common/enums.h"
+#include "brt/core/framework/dtype.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+
+// dst[i] = f(dst[i], src[i]), written as a plain loop over restrict pointers
+// so that it is vectorized for every arithmetic type
+template <typename T, typename F>
+inline void ReduceLoop(T *__restrict__ dst, const T *__restrict__ src,
+                       size_t n, F f) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = f(dst[i], src[i]);
+  }
+}
+
+template <typename T> struct Reducer {
+  static void Run(T *dst, const T *src, size_t n, ReduceOp op) {
+    switch (op) {
+    case BRT_SUM:
+      return ReduceLoop(dst, src, n, [](T a, T b) { return T(a + b); });
+    case BRT_MAX:
+      return ReduceLoop(dst, src, n, [](T a, T b) { return a < b ? b : a; });
+    case BRT_MIN:
+      return ReduceLoop(dst, src, n, [](T a, T b) { return b < a ? b : a; });
+    default:
+      BRT_THROW("unknown reduce op");
+    }
+  }
+};
+
+// 16 bit floats are widened to float block by block, reduced, and rounded
+// back, which keeps the inner loop vectorized
+template <typename T> struct WidenToFloatReducer {
+  static void Run(T *dst, const T *src, size_t n, ReduceOp op) {
+    constexpr size_t kBlock = 1024;
+    float a[kBlock], b[kBlock];
+    for (size_t i = 0; i < n; i += kBlock) {
+      size_t m = std::min(kBlock, n - i);
+      for (size_t j = 0; j < m; ++j) {
+        a[j] = static_cast<float>(dst[i + j]);
+        b[j] = static_cast<float>(src[i + j]);
+      }
+      Reducer<float>::Run(a, b, m, op);
+      for (size_t j = 0; j < m; ++j) {
+        dst[i + j] = T(a[j]);
+      }
+    }
+  }
+};
+
+template <>
+struct Reducer<half_float::half>
+    : public WidenToFloatReducer<half_float::half> {};
+template <> struct Reducer<BFloat16> : public WidenToFloatReducer<BFloat16> {};
+
+// dst = op(dst, src) elementwise, dst and src must not overlap
+inline void ReduceInplace(void *dst, const void *src, size_t n,
+                          DTypeEnum dtype, ReduceOp op) {
+#define CASE(D)                                                                \
+  case DTypeEnum::D: {                                                         \
+    using T = DTypeTraits<DTypeEnum::D>::type_t;                               \
+    return Reducer<T>::Run(static_cast<T *>(dst),                              \
+                           static_cast<const T *>(src), n, op);                \
+  }
+  switch (dtype) {
+    CASE(Float32);
+    CASE(Float64);
+    CASE(Float16);
+    CASE(BFloat16);
+    CASE(Int8);
+    CASE(Int16);
+    CASE(Int32);
+    CASE(Int64);
+    CASE(UInt8);
+    CASE(UInt16);
+    CASE(UInt32);
+    CASE(UInt64);
+    CASE(Bool);
+  default:
+    BRT_THROW("unsupported dtype of reduction");
+  }
+#undef CASE
+}
+
+} // namespace ccl
+} // namespace cpu
+} // namespace brt
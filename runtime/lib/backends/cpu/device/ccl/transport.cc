@@ -0,0 +1,398 @@
+//===- transport.cc -------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "./transport.h"
+
+#include "brt/core/common/common.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <new>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace brt::common;
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+
+namespace {
+
+Status ErrnoStatus(const std::string &what) {
+  return Status(StatusCategory::BRT, StatusCode::FAIL,
+                what + ": " + std::strerror(errno));
+}
+
+Status TimeoutStatus(const std::string &what, int timeout_ms) {
+  return Status(StatusCategory::BRT, StatusCode::FAIL,
+                what + " timed out after " + std::to_string(timeout_ms) +
+                    "ms");
+}
+
+bool IsExpired(std::chrono::steady_clock::time_point start, int timeout_ms) {
+  return timeout_ms > 0 && std::chrono::steady_clock::now() - start >=
+                               std::chrono::milliseconds(timeout_ms);
+}
+
+//===----------------------------------------------------------------------===//
+// TCP
+//===----------------------------------------------------------------------===//
+
+class TcpChannel : public Channel {
+public:
+  explicit TcpChannel(int fd) : fd_(fd) {
+    int flags = fcntl(fd_, F_GETFL, 0);
+    fcntl(fd_, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  ~TcpChannel() { close(fd_); }
+
+  Status TrySend(const char *buf, size_t len, size_t *copied) override {
+    *copied = 0;
+    ssize_t n = ::send(fd_, buf, len, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return Status::OK();
+      return ErrnoStatus("tcp send");
+    }
+    *copied = static_cast<size_t>(n);
+    return Status::OK();
+  }
+
+  Status TryRecv(char *buf, size_t len, size_t *copied) override {
+    *copied = 0;
+    ssize_t n = ::recv(fd_, buf, len, 0);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return Status::OK();
+      return ErrnoStatus("tcp recv");
+    }
+    if (n == 0 && len > 0) {
+      return Status(StatusCategory::BRT, StatusCode::FAIL,
+                    "tcp connection closed by peer");
+    }
+    *copied = static_cast<size_t>(n);
+    return Status::OK();
+  }
+
+  int PollFd() const override { return fd_; }
+
+private:
+  int fd_;
+};
+
+//===----------------------------------------------------------------------===//
+// Shared memory
+//===----------------------------------------------------------------------===//
+
+constexpr size_t kShmRingBytes = 4 << 20;
+
+// head is only advanced by the writer and tail by the reader, each on its own
+// cache line
+struct ShmRing {
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  alignas(64) char data[kShmRingBytes];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "atomics in shared memory must be lock free");
+
+constexpr size_t kShmMapBytes = sizeof(ShmRing);
+
+class ShmChannel : public Channel {
+public:
+  ShmChannel(void *send_ring, void *recv_ring)
+      : send_(static_cast<ShmRing *>(send_ring)),
+        recv_(static_cast<ShmRing *>(recv_ring)) {}
+
+  ~ShmChannel() {
+    munmap(send_, kShmMapBytes);
+    munmap(recv_, kShmMapBytes);
+  }
+
+  Status TrySend(const char *buf, size_t len, size_t *copied) override {
+    uint64_t head = send_->head.load(std::memory_order_relaxed);
+    uint64_t tail = send_->tail.load(std::memory_order_acquire);
+    size_t n = std::min<size_t>(len, kShmRingBytes - (head - tail));
+    *copied = n;
+    if (n == 0)
+      return Status::OK();
+    size_t pos = head % kShmRingBytes;
+    size_t first = std::min(n, kShmRingBytes - pos);
+    std::memcpy(send_->data + pos, buf, first);
+    std::memcpy(send_->data, buf + first, n - first);
+    send_->head.store(head + n, std::memory_order_release);
+    return Status::OK();
+  }
+
+  Status TryRecv(char *buf, size_t len, size_t *copied) override {
+    uint64_t tail = recv_->tail.load(std::memory_order_relaxed);
+    uint64_t head = recv_->head.load(std::memory_order_acquire);
+    size_t n = std::min<size_t>(len, head - tail);
+    *copied = n;
+    if (n == 0)
+      return Status::OK();
+    size_t pos = tail % kShmRingBytes;
+    size_t first = std::min(n, kShmRingBytes - pos);
+    std::memcpy(buf, recv_->data + pos, first);
+    std::memcpy(buf + first, recv_->data, n - first);
+    recv_->tail.store(tail + n, std::memory_order_release);
+    return Status::OK();
+  }
+
+private:
+  ShmRing *send_;
+  ShmRing *recv_;
+};
+
+Status MapShmRing(const std::string &name, int oflag, void **ring) {
+  int fd = shm_open(name.c_str(), oflag, 0600);
+  if (fd < 0)
+    return ErrnoStatus("shm_open " + name);
+  if ((oflag & O_CREAT) && ftruncate(fd, kShmMapBytes) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    return ErrnoStatus("ftruncate " + name);
+  }
+  void *ptr =
+      mmap(nullptr, kShmMapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED)
+    return ErrnoStatus("mmap " + name);
+  if (oflag & O_CREAT) {
+    auto *shm_ring = static_cast<ShmRing *>(ptr);
+    new (&shm_ring->head) std::atomic<uint64_t>(0);
+    new (&shm_ring->tail) std::atomic<uint64_t>(0);
+  }
+  *ring = ptr;
+  return Status::OK();
+}
+
+} // namespace
+
+std::unique_ptr<Channel> CreateTcpChannel(int fd) {
+  return std::make_unique<TcpChannel>(fd);
+}
+
+std::unique_ptr<Channel> CreateShmChannel(void *send_ring, void *recv_ring) {
+  return std::make_unique<ShmChannel>(send_ring, recv_ring);
+}
+
+Status CreateShmRing(const std::string &name, void **ring) {
+  return MapShmRing(name, O_CREAT | O_EXCL | O_RDWR, ring);
+}
+
+Status OpenShmRing(const std::string &name, void **ring) {
+  return MapShmRing(name, O_RDWR, ring);
+}
+
+void UnlinkShmRing(const std::string &name) { shm_unlink(name.c_str()); }
+
+Status ListenTcp(int backlog, int *fd, int *port) {
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  if (sock < 0)
+    return ErrnoStatus("socket");
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(0);
+  socklen_t len = sizeof(addr);
+  if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      listen(sock, backlog) != 0 ||
+      getsockname(sock, (struct sockaddr *)&addr, &len) != 0) {
+    auto status = ErrnoStatus("listen");
+    close(sock);
+    return status;
+  }
+
+  *fd = sock;
+  *port = ntohs(addr.sin_port);
+  return Status::OK();
+}
+
+Status ConnectTcp(const std::string &ip, int port, int timeout_ms, int *fd) {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
+    return Status(StatusCategory::BRT, StatusCode::INVALID_ARGUMENT,
+                  "invalid ipv4 address " + ip);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  int sock = -1;
+  while (true) {
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0)
+      return ErrnoStatus("socket");
+    if (::connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+      break;
+    close(sock);
+    if (IsExpired(start, timeout_ms)) {
+      return TimeoutStatus(
+          "connect to " + ip + ":" + std::to_string(port), timeout_ms);
+    }
+    usleep(100000); // 100ms
+  }
+
+  int opt = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+  *fd = sock;
+  return Status::OK();
+}
+
+Status AcceptTcp(int listen_fd, int timeout_ms, int *fd) {
+  struct pollfd pfd = {listen_fd, POLLIN, 0};
+  int ready;
+  do {
+    ready = poll(&pfd, 1, timeout_ms > 0 ? timeout_ms : -1);
+  } while (ready < 0 && errno == EINTR);
+  if (ready < 0)
+    return ErrnoStatus("poll");
+  if (ready == 0)
+    return TimeoutStatus("accept", timeout_ms);
+  int sock = accept(listen_fd, nullptr, nullptr);
+  if (sock < 0)
+    return ErrnoStatus("accept");
+  int opt = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+  *fd = sock;
+  return Status::OK();
+}
+
+Status SendAllTcp(int fd, const void *buf, size_t len) {
+  const char *p = static_cast<const char *>(buf);
+  while (len > 0) {
+    ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return ErrnoStatus("send");
+    p += n;
+    len -= n;
+  }
+  return Status::OK();
+}
+
+Status RecvAllTcp(int fd, void *buf, size_t len) {
+  char *p = static_cast<char *>(buf);
+  while (len > 0) {
+    ssize_t n = ::recv(fd, p, len, 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return ErrnoStatus("recv");
+    p += n;
+    len -= n;
+  }
+  return Status::OK();
+}
+
+Status GetRoutingAddress(const std::string &remote, std::string *ip) {
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  struct addrinfo *res = nullptr;
+  if (getaddrinfo(remote.c_str(), "9", &hints, &res) != 0 || res == nullptr) {
+    return Status(StatusCategory::BRT, StatusCode::FAIL,
+                  "cannot resolve " + remote);
+  }
+
+  // connecting an udp socket sends nothing but picks the routing interface
+  int sock = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  bool ok = sock >= 0 && ::connect(sock, res->ai_addr, res->ai_addrlen) == 0 &&
+            getsockname(sock, (struct sockaddr *)&addr, &len) == 0;
+  freeaddrinfo(res);
+  if (sock >= 0)
+    close(sock);
+  if (!ok)
+    return ErrnoStatus("route to " + remote);
+
+  char buf[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &addr.sin_addr, buf, sizeof(buf));
+  *ip = buf;
+  return Status::OK();
+}
+
+Status Progress(std::vector<Transfer> &transfers, int timeout_ms) {
+  std::vector<struct pollfd> fds;
+  auto last_progress = std::chrono::steady_clock::now();
+  while (true) {
+    bool pending = false, progressed = false, spin = false;
+    fds.clear();
+    for (auto &t : transfers) {
+      if (t.done == t.len)
+        continue;
+      size_t n = 0;
+      if (t.is_send) {
+        BRT_RETURN_IF_ERROR(
+            t.channel->TrySend(t.buf + t.done, t.len - t.done, &n));
+      } else {
+        BRT_RETURN_IF_ERROR(
+            t.channel->TryRecv(t.buf + t.done, t.len - t.done, &n));
+      }
+      t.done += n;
+      progressed |= n > 0;
+      if (t.done == t.len)
+        continue;
+      pending = true;
+      int fd = t.channel->PollFd();
+      if (fd < 0) {
+        spin = true;
+      } else {
+        fds.push_back({fd, static_cast<short>(t.is_send ? POLLOUT : POLLIN),
+                       0});
+      }
+    }
+    if (!pending)
+      return Status::OK();
+    if (progressed) {
+      last_progress = std::chrono::steady_clock::now();
+      continue;
+    }
+    if (IsExpired(last_progress, timeout_ms))
+      return TimeoutStatus("ccl transfer without progress", timeout_ms);
+    if (spin) {
+      std::this_thread::yield();
+    } else {
+      poll(fds.data(), fds.size(), 100);
+    }
+  }
+}
+
+} // namespace ccl
+} // namespace cpu
+} // namespace brt
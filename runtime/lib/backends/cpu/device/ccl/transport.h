@@ -0,0 +1,100 @@
+//===- transport.h --------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "brt/core/common/status.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brt {
+namespace cpu {
+namespace ccl {
+
+// A full duplex byte stream to a peer rank, which never blocks
+class Channel {
+public:
+  virtual ~Channel() = default;
+
+  // copy at most len bytes of buf into the channel, set *copied to the bytes
+  // copied, which may be 0. Fail if the channel is broken
+  virtual common::Status TrySend(const char *buf, size_t len,
+                                 size_t *copied) = 0;
+
+  // copy at most len bytes out of the channel into buf, set *copied to the
+  // bytes copied, which may be 0. Fail if the channel is broken or closed by
+  // the peer
+  virtual common::Status TryRecv(char *buf, size_t len, size_t *copied) = 0;
+
+  // file descriptor to poll when no progress could be made, or -1 if the
+  // channel should be spun on instead
+  virtual int PollFd() const { return -1; }
+};
+
+// channel over a connected TCP socket, which it takes the ownership of
+std::unique_ptr<Channel> CreateTcpChannel(int fd);
+
+// channel over two single producer single consumer rings in shared memory,
+// the one written by this rank and the one read by it, see CreateShmRing
+std::unique_ptr<Channel> CreateShmChannel(void *send_ring, void *recv_ring);
+
+// create and map a ring named `name` in shared memory, which should be
+// unlinked by UnlinkShmRing once all peers opened it
+common::Status CreateShmRing(const std::string &name, void **ring);
+common::Status OpenShmRing(const std::string &name, void **ring);
+void UnlinkShmRing(const std::string &name);
+
+// listen on a free port of all interfaces
+common::Status ListenTcp(int backlog, int *fd, int *port);
+// connect to ip:port, retrying until the peer listens, or fail once
+// timeout_ms elapsed. A non-positive timeout_ms waits forever, so does below
+common::Status ConnectTcp(const std::string &ip, int port, int timeout_ms,
+                          int *fd);
+// accept a connection, or fail if none arrives within timeout_ms
+common::Status AcceptTcp(int listen_fd, int timeout_ms, int *fd);
+// blocking exchange of small messages during setup, before the socket is
+// wrapped into a channel
+common::Status SendAllTcp(int fd, const void *buf, size_t len);
+common::Status RecvAllTcp(int fd, void *buf, size_t len);
+
+// address of the local interface which routes to `remote`, which is either
+// an ip or a host name
+common::Status GetRoutingAddress(const std::string &remote, std::string *ip);
+
+struct Transfer {
+  Channel *channel;
+  char *buf;
+  size_t len;
+  bool is_send;
+  size_t done = 0;
+
+  Transfer(Channel *channel, const void *buf, size_t len, bool is_send)
+      : channel(channel), buf(static_cast<char *>(const_cast<void *>(buf))),
+        len(len), is_send(is_send) {}
+};
+
+// progress all transfers concurrently until every one of them is done, so
+// that a rank could send to one peer while receiving from another. Fail if
+// none of them makes progress for timeout_ms, e.g. when a peer is gone
+common::Status Progress(std::vector<Transfer> &transfers, int timeout_ms);
+
+} // namespace ccl
+} // namespace cpu
+} // namespace brt
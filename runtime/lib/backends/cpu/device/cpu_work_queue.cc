@@ -16,6 +16,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "brt/backends/cpu/device/cpu_work_queue.h"
+#include "brt/core/common/utils/numa.h"
+#include <algorithm>
 
 namespace brt {
 namespace cpu {
@@ -67,5 +69,139 @@ CPULazyWorkQueue::AddHostTask(const void *task, void **args, int op_id,
   return common::Status::OK();
 }
 
+CPUParallelWorkQueue::CPUParallelWorkQueue(size_t num_threads,
+                                           const std::string &name)
+    : WorkQueue(name) {
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_nodes_ = static_cast<size_t>(numa::GetNumNodes());
+  ready_.resize(num_nodes_ + 1);
+  for (size_t i = 0; i < num_threads; ++i)
+    workers_.emplace_back([this, i] { Worker(i); });
+}
+
+CPUParallelWorkQueue::~CPUParallelWorkQueue() {
+  Sync();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  ready_cv_.notify_all();
+  for (auto &worker : workers_)
+    worker.join();
+}
+
+common::Status
+CPUParallelWorkQueue::AddTask(int /*task_type*/, const void * /*func*/,
+                              void ** /*args*/, int /*op_id*/,
+                              const std::vector<int> & /*dependency*/) {
+  return common::Status(common::StatusCategory::BRT, common::StatusCode::FAIL,
+                        "Use AddHostTask for cpu work queue");
+}
+
+common::Status
+CPUParallelWorkQueue::AddHostTask(const void *task, void **args, int op_id,
+                                  const std::vector<int> &dependency) {
+  auto func = reinterpret_cast<const std::function<void(void)> *>(task);
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t index = tasks_.size();
+  tasks_.emplace_back();
+  tasks_.back().func = *func;
+  int numa_node = numa_node_.load(std::memory_order_relaxed);
+  tasks_.back().queue =
+      numa_node < 0 ? num_nodes_ : static_cast<size_t>(numa_node) % num_nodes_;
+
+  auto depend_on = [&](int dep_op_id) {
+    auto found = op_to_task_.find(dep_op_id);
+    if (found == op_to_task_.end())
+      return;
+    Task &dep = tasks_[found->second];
+    if (dep.done)
+      return;
+    dep.successors.push_back(index);
+    ++tasks_[index].num_pending_deps;
+  };
+  depend_on(op_id);
+  for (int dep_op_id : dependency)
+    if (dep_op_id != op_id)
+      depend_on(dep_op_id);
+  op_to_task_[op_id] = index;
+
+  ++num_unfinished_;
+  if (tasks_[index].num_pending_deps == 0) {
+    PushReady(index);
+    lock.unlock();
+    ready_cv_.notify_one();
+  }
+  return common::Status::OK();
+}
+
+void CPUParallelWorkQueue::SetNumaNode(int numa_node) {
+  numa_node_.store(numa_node, std::memory_order_relaxed);
+}
+
+common::Status CPUParallelWorkQueue::Sync() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return num_unfinished_ == 0; });
+  tasks_.clear();
+  op_to_task_.clear();
+  return common::Status::OK();
+}
+
+void CPUParallelWorkQueue::PushReady(size_t index) {
+  ready_[tasks_[index].queue].push_back(index);
+  ++num_ready_;
+}
+
+size_t CPUParallelWorkQueue::PopReady(size_t queue) {
+  if (ready_[queue].empty())
+    queue = num_nodes_;
+  // steal from other nodes rather than idle
+  for (size_t i = 0; ready_[queue].empty(); ++i)
+    queue = i;
+  size_t index = ready_[queue].front();
+  ready_[queue].pop_front();
+  --num_ready_;
+  return index;
+}
+
+void CPUParallelWorkQueue::Worker(size_t worker_id) {
+  size_t queue = num_nodes_;
+  if (num_nodes_ > 1) {
+    queue = worker_id % num_nodes_;
+    // a thread not bound to its node still prefers its tasks
+    numa::BindCurrentThreadToNode(numa::GetNodes()[queue]);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ready_cv_.wait(lock, [this] { return stop_ || num_ready_ > 0; });
+    if (num_ready_ == 0)
+      return;
+    size_t index = PopReady(queue);
+    // deque never relocates its elements on emplace_back
+    Task &task = tasks_[index];
+    lock.unlock();
+    task.func();
+    lock.lock();
+
+    task.done = true;
+    task.func = nullptr;
+    size_t num_ready = 0;
+    for (size_t successor : task.successors) {
+      if (--tasks_[successor].num_pending_deps == 0) {
+        PushReady(successor);
+        ++num_ready;
+      }
+    }
+    if (num_ready > 1)
+      ready_cv_.notify_all();
+    else if (num_ready == 1)
+      ready_cv_.notify_one();
+    if (--num_unfinished_ == 0)
+      done_cv_.notify_all();
+  }
+}
+
 } // namespace cpu
 } // namespace brt
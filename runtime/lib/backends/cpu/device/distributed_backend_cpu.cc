@@ -0,0 +1,572 @@
+//===- distributed_backend_cpu.cc -----------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "brt/backends/cpu/device/distributed_backend_cpu.h"
+
+#include "./ccl/async_queue.h"
+#include "./ccl/reduce.h"
+#include "./ccl/transport.h"
+#include "brt/core/common/common.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unistd.h>
+
+using namespace brt::common;
+using namespace brt::cpu;
+
+namespace brt {
+
+namespace {
+
+// chunk size a broadcast is pipelined by along the chain of ranks
+constexpr size_t kBroadcastChunkBytes = 1 << 20;
+
+// how long connecting to peers or a transfer without progress may take before
+// failing, overridden by BRT_CCL_TIMEOUT_SECONDS where 0 waits forever
+constexpr int kDefaultTimeoutSeconds = 600;
+
+struct PeerInfo {
+  // ranks with the same non-empty host_id share /dev/shm
+  char host_id[192];
+  char ip[64];
+  int32_t port;
+};
+
+std::string GetHostId() {
+  char hostname[128] = {0};
+  gethostname(hostname, sizeof(hostname) - 1);
+  std::string boot_id;
+  std::ifstream("/proc/sys/kernel/random/boot_id") >> boot_id;
+  return std::string(hostname) + "/" + boot_id;
+}
+
+std::string GetShmRingName(uint64_t token, uint32_t src, uint32_t dst) {
+  std::ostringstream os;
+  os << "/brt_ccl_" << std::hex << token << std::dec << "_" << src << "_"
+     << dst;
+  return os.str();
+}
+
+bool IsEnvSet(const char *name) {
+  const char *value = std::getenv(name);
+  return value && std::strcmp(value, "0") != 0 && std::strlen(value) > 0;
+}
+
+int GetTimeoutMs() {
+  int seconds = kDefaultTimeoutSeconds;
+  if (const char *value = std::getenv("BRT_CCL_TIMEOUT_SECONDS"))
+    seconds = std::atoi(value);
+  return seconds > 0 ? seconds * 1000 : 0;
+}
+
+// members of a replica group in ascending order of rank, where an empty
+// replica group means all ranks
+struct Group {
+  std::vector<uint32_t> ranks;
+  // position of this rank in the group, -1 if not in the group
+  int64_t pos = -1;
+
+  Group(const std::set<int64_t> &replica_group, uint32_t nranks,
+        uint32_t rank) {
+    if (replica_group.empty()) {
+      for (uint32_t r = 0; r < nranks; ++r)
+        ranks.push_back(r);
+    } else {
+      ranks.assign(replica_group.begin(), replica_group.end());
+    }
+    auto it = std::find(ranks.begin(), ranks.end(), rank);
+    if (it != ranks.end())
+      pos = it - ranks.begin();
+  }
+
+  size_t size() const { return ranks.size(); }
+
+  // block index i modulo the group size
+  size_t Mod(int64_t i) const {
+    int64_t n = static_cast<int64_t>(size());
+    return static_cast<size_t>(((i % n) + n) % n);
+  }
+
+  uint32_t At(int64_t i) const { return ranks[Mod(i)]; }
+};
+
+// `len` elements split into `n` contiguous blocks, the first len % n of
+// which hold one more element
+struct Blocks {
+  size_t len;
+  size_t n;
+  size_t elem_bytes;
+
+  size_t Offset(size_t i) const { return i * (len / n) + std::min(i, len % n); }
+
+  // bytes from the beginning of block lo to the beginning of block hi
+  size_t Bytes(size_t lo, size_t hi) const {
+    return (Offset(hi) - Offset(lo)) * elem_bytes;
+  }
+};
+
+bool IsPowerOfTwo(size_t n) { return (n & (n - 1)) == 0; }
+
+} // namespace
+
+class DistributedBackendCPUPrivate {
+public:
+  // indexed by rank, null for this rank
+  std::vector<std::unique_ptr<ccl::Channel>> channels;
+  int timeout_ms = 0;
+
+  char *Scratch(size_t bytes) {
+    if (scratch.size() < bytes)
+      scratch.resize(bytes);
+    return scratch.data();
+  }
+
+  char *Work(size_t bytes) {
+    if (work.size() < bytes)
+      work.resize(bytes);
+    return work.data();
+  }
+
+  Status SendRecv(const void *sendbuf, size_t send_bytes, uint32_t dst,
+                  void *recvbuf, size_t recv_bytes, uint32_t src) {
+    std::vector<ccl::Transfer> transfers;
+    if (send_bytes > 0)
+      transfers.emplace_back(channels[dst].get(), sendbuf, send_bytes, true);
+    if (recv_bytes > 0)
+      transfers.emplace_back(channels[src].get(), recvbuf, recv_bytes, false);
+    return ccl::Progress(transfers, timeout_ms);
+  }
+
+  // on return, block g.pos of buf is reduced over the group
+  Status ReduceScatterInplace(const Group &g, char *buf, const Blocks &blocks,
+                              DTypeEnum dtype, ReduceOp op) {
+    size_t n = g.size();
+    int64_t pos = g.pos;
+    if (IsPowerOfTwo(n)) {
+      // recursive halving, exchange and reduce half of the remaining blocks
+      // with the peer at distance mask
+      char *tmp = Scratch(blocks.Bytes(0, n / 2));
+      size_t lo = 0, hi = n;
+      for (size_t mask = n / 2; mask > 0; mask >>= 1) {
+        uint32_t peer = g.ranks[pos ^ mask];
+        size_t mid = lo + (hi - lo) / 2;
+        bool upper = pos & mask;
+        size_t keep_lo = upper ? mid : lo, keep_hi = upper ? hi : mid;
+        size_t send_lo = upper ? lo : mid, send_hi = upper ? mid : hi;
+        BRT_RETURN_IF_ERROR(SendRecv(buf + blocks.Bytes(0, send_lo),
+                                     blocks.Bytes(send_lo, send_hi), peer, tmp,
+                                     blocks.Bytes(keep_lo, keep_hi), peer));
+        ccl::ReduceInplace(buf + blocks.Bytes(0, keep_lo), tmp,
+                           blocks.Offset(keep_hi) - blocks.Offset(keep_lo),
+                           dtype, op);
+        lo = keep_lo;
+        hi = keep_hi;
+      }
+      return Status::OK();
+    }
+
+    // ring, pass a partially reduced block to the next rank each step
+    char *tmp = Scratch(blocks.Bytes(0, 1));
+    uint32_t next = g.At(pos + 1), prev = g.At(pos - 1);
+    for (int64_t s = 0; s + 1 < static_cast<int64_t>(n); ++s) {
+      size_t send_blk = g.Mod(pos - s - 1), recv_blk = g.Mod(pos - s - 2);
+      BRT_RETURN_IF_ERROR(SendRecv(buf + blocks.Bytes(0, send_blk),
+                                   blocks.Bytes(send_blk, send_blk + 1), next,
+                                   tmp, blocks.Bytes(recv_blk, recv_blk + 1),
+                                   prev));
+      ccl::ReduceInplace(buf + blocks.Bytes(0, recv_blk), tmp,
+                         blocks.Offset(recv_blk + 1) - blocks.Offset(recv_blk),
+                         dtype, op);
+    }
+    return Status::OK();
+  }
+
+  // on entry block g.pos of buf is valid, on return all blocks are
+  Status AllGatherInplace(const Group &g, char *buf, const Blocks &blocks) {
+    size_t n = g.size();
+    int64_t pos = g.pos;
+    if (IsPowerOfTwo(n)) {
+      // recursive doubling, exchange all blocks gathered so far with the peer
+      // at distance mask
+      size_t lo = pos, hi = pos + 1;
+      for (size_t mask = 1; mask < n; mask <<= 1) {
+        uint32_t peer = g.ranks[pos ^ mask];
+        bool upper = pos & mask;
+        size_t peer_lo = upper ? lo - mask : hi;
+        size_t peer_hi = upper ? lo : hi + mask;
+        BRT_RETURN_IF_ERROR(SendRecv(buf + blocks.Bytes(0, lo),
+                                     blocks.Bytes(lo, hi), peer,
+                                     buf + blocks.Bytes(0, peer_lo),
+                                     blocks.Bytes(peer_lo, peer_hi), peer));
+        lo = std::min(lo, peer_lo);
+        hi = std::max(hi, peer_hi);
+      }
+      return Status::OK();
+    }
+
+    // ring, forward the block received last step to the next rank
+    uint32_t next = g.At(pos + 1), prev = g.At(pos - 1);
+    for (int64_t s = 0; s + 1 < static_cast<int64_t>(n); ++s) {
+      size_t send_blk = g.Mod(pos - s), recv_blk = g.Mod(pos - s - 1);
+      BRT_RETURN_IF_ERROR(SendRecv(buf + blocks.Bytes(0, send_blk),
+                                   blocks.Bytes(send_blk, send_blk + 1), next,
+                                   buf + blocks.Bytes(0, recv_blk),
+                                   blocks.Bytes(recv_blk, recv_blk + 1), prev));
+    }
+    return Status::OK();
+  }
+
+  Status AllReduce(const Group &g, const void *sendbuff, void *recvbuff,
+                   size_t len, DTypeEnum dtype, ReduceOp op) {
+    size_t elem_bytes = GetDTypeByte(dtype);
+    if (sendbuff != recvbuff)
+      std::memcpy(recvbuff, sendbuff, len * elem_bytes);
+    if (g.size() == 1)
+      return Status::OK();
+    Blocks blocks{len, g.size(), elem_bytes};
+    char *buf = static_cast<char *>(recvbuff);
+    BRT_RETURN_IF_ERROR(ReduceScatterInplace(g, buf, blocks, dtype, op));
+    return AllGatherInplace(g, buf, blocks);
+  }
+
+private:
+  std::vector<char> scratch;
+  std::vector<char> work;
+};
+
+DistributedBackendCPU::DistributedBackendCPU(int nranks, int rank)
+    : DistributedBackend(nranks, rank),
+      m_async(std::make_unique<cpu::ccl::AsyncQueue>()) {}
+
+DistributedBackendCPU::~DistributedBackendCPU() {}
+
+Status DistributedBackendCPU::do_init() {
+  if (m_master_ip.empty()) {
+    return Status(StatusCategory::BRT, StatusCode::FAIL,
+                  "cpu backend requires the rendezvous server");
+  }
+
+  int listen_fd, port;
+  auto status = ccl::ListenTcp(m_nranks, &listen_fd, &port);
+  if (!status.IsOK())
+    return status;
+
+  std::string ip;
+  if (const char *addr = std::getenv("BRT_CCL_SOCKET_ADDR")) {
+    ip = addr;
+  } else {
+    status = ccl::GetRoutingAddress(m_master_ip, &ip);
+    if (!status.IsOK())
+      return status;
+  }
+
+  // exchange how every rank is reached
+  PeerInfo self;
+  memset(&self, 0, sizeof(self));
+  if (!IsEnvSet("BRT_CCL_DISABLE_SHM")) {
+    std::string host_id = GetHostId();
+    strncpy(self.host_id, host_id.c_str(), sizeof(self.host_id) - 1);
+  }
+  strncpy(self.ip, ip.c_str(), sizeof(self.ip) - 1);
+  self.port = port;
+  std::vector<PeerInfo> peers(m_nranks);
+  status = m_client->allgather(&self, peers.data(), sizeof(PeerInfo));
+  if (!status.IsOK())
+    return status;
+
+  // shared memory names are made unique per backend by a token from rank 0
+  uint64_t token = 0;
+  if (m_rank == 0) {
+    std::random_device rd;
+    token = (static_cast<uint64_t>(rd()) << 32) ^ rd() ^ getpid();
+  }
+  status = m_client->broadcast(&token, &token, sizeof(token), 0);
+  if (!status.IsOK())
+    return status;
+
+  m_cpu = std::make_unique<DistributedBackendCPUPrivate>();
+  m_cpu->channels.resize(m_nranks);
+  m_cpu->timeout_ms = GetTimeoutMs();
+  auto is_local = [&](uint32_t r) {
+    return r != m_rank && self.host_id[0] != '\0' &&
+           strncmp(self.host_id, peers[r].host_id, sizeof(self.host_id)) == 0;
+  };
+
+  // every rank creates the rings it reads, then maps the rings it writes
+  // once all of them exist, and unlinks its own once all are mapped
+  std::vector<void *> recv_rings(m_nranks, nullptr);
+  for (uint32_t r = 0; r < m_nranks; ++r) {
+    if (!is_local(r))
+      continue;
+    status = ccl::CreateShmRing(GetShmRingName(token, r, m_rank),
+                                &recv_rings[r]);
+    if (!status.IsOK())
+      return status;
+  }
+  m_client->barrier();
+  for (uint32_t r = 0; r < m_nranks; ++r) {
+    if (!is_local(r))
+      continue;
+    void *send_ring;
+    status = ccl::OpenShmRing(GetShmRingName(token, m_rank, r), &send_ring);
+    if (!status.IsOK())
+      return status;
+    m_cpu->channels[r] = ccl::CreateShmChannel(send_ring, recv_rings[r]);
+  }
+  m_client->barrier();
+  for (uint32_t r = 0; r < m_nranks; ++r) {
+    if (is_local(r))
+      ccl::UnlinkShmRing(GetShmRingName(token, r, m_rank));
+  }
+
+  // connect to remote ranks below and accept remote ranks above, which never
+  // deadlocks since every rank listens before the allgather
+  size_t num_accepts = 0;
+  for (uint32_t r = 0; r < m_nranks; ++r) {
+    if (r == m_rank || is_local(r))
+      continue;
+    if (r > m_rank) {
+      ++num_accepts;
+      continue;
+    }
+    int fd;
+    status = ccl::ConnectTcp(peers[r].ip, peers[r].port,
+                             m_cpu->timeout_ms, &fd);
+    if (status.IsOK())
+      status = ccl::SendAllTcp(fd, &m_rank, sizeof(m_rank));
+    if (!status.IsOK())
+      return status;
+    m_cpu->channels[r] = ccl::CreateTcpChannel(fd);
+  }
+  for (size_t i = 0; i < num_accepts; ++i) {
+    int fd;
+    uint32_t r;
+    status = ccl::AcceptTcp(listen_fd, m_cpu->timeout_ms, &fd);
+    if (status.IsOK())
+      status = ccl::RecvAllTcp(fd, &r, sizeof(r));
+    if (!status.IsOK())
+      return status;
+    if (r >= m_nranks || r <= m_rank || m_cpu->channels[r]) {
+      return Status(StatusCategory::BRT, StatusCode::FAIL,
+                    "unexpected connection from rank " + std::to_string(r));
+    }
+    m_cpu->channels[r] = ccl::CreateTcpChannel(fd);
+  }
+  close(listen_fd);
+
+  return m_client->barrier();
+}
+
+Status DistributedBackendCPU::do_init(BcastCallback) {
+  return Status(StatusCategory::BRT, StatusCode::FAIL,
+                "cpu backend requires the rendezvous server");
+}
+
+Status DistributedBackendCPU::_send(const void *sendbuff, size_t size,
+                                    uint32_t rank, std::shared_ptr<DContext>) {
+  if (rank == m_rank || rank >= m_nranks) {
+    return Status(StatusCategory::BRT, StatusCode::INVALID_ARGUMENT,
+                  "invalid peer rank " + std::to_string(rank));
+  }
+  return m_cpu->SendRecv(sendbuff, size, rank, nullptr, 0, rank);
+}
+
+Status DistributedBackendCPU::_recv(void *recvbuff, size_t size, uint32_t rank,
+                                    std::shared_ptr<DContext>) {
+  if (rank == m_rank || rank >= m_nranks) {
+    return Status(StatusCategory::BRT, StatusCode::INVALID_ARGUMENT,
+                  "invalid peer rank " + std::to_string(rank));
+  }
+  return m_cpu->SendRecv(nullptr, 0, rank, recvbuff, size, rank);
+}
+
+Status DistributedBackendCPU::scatter(const void *sendbuff, void *recvbuff,
+                                      size_t recvlen, DTypeEnum dtype,
+                                      uint32_t root,
+                                      std::shared_ptr<DContext>) {
+  size_t bytes = recvlen * GetDTypeByte(dtype);
+  std::vector<ccl::Transfer> transfers;
+  if (m_rank == root) {
+    const char *p = static_cast<const char *>(sendbuff);
+    for (uint32_t r = 0; r < m_nranks; ++r) {
+      if (r == m_rank)
+        std::memmove(recvbuff, p + r * bytes, bytes);
+      else if (bytes > 0)
+        transfers.emplace_back(m_cpu->channels[r].get(), p + r * bytes, bytes,
+                               true);
+    }
+  } else if (bytes > 0) {
+    transfers.emplace_back(m_cpu->channels[root].get(), recvbuff, bytes,
+                           false);
+  }
+  return ccl::Progress(transfers, m_cpu->timeout_ms);
+}
+
+Status DistributedBackendCPU::gather(const void *sendbuff, void *recvbuff,
+                                     size_t sendlen, DTypeEnum dtype,
+                                     uint32_t root,
+                                     std::shared_ptr<DContext>) {
+  size_t bytes = sendlen * GetDTypeByte(dtype);
+  std::vector<ccl::Transfer> transfers;
+  if (m_rank == root) {
+    char *p = static_cast<char *>(recvbuff);
+    for (uint32_t r = 0; r < m_nranks; ++r) {
+      if (r == m_rank)
+        std::memmove(p + r * bytes, sendbuff, bytes);
+      else if (bytes > 0)
+        transfers.emplace_back(m_cpu->channels[r].get(), p + r * bytes, bytes,
+                               false);
+    }
+  } else if (bytes > 0) {
+    transfers.emplace_back(m_cpu->channels[root].get(), sendbuff, bytes, true);
+  }
+  return ccl::Progress(transfers, m_cpu->timeout_ms);
+}
+
+Status DistributedBackendCPU::all_to_all(const void *sendbuff, void *recvbuff,
+                                         size_t len, DTypeEnum dtype,
+                                         std::shared_ptr<DContext>) {
+  size_t bytes = len * GetDTypeByte(dtype);
+  const char *src = static_cast<const char *>(sendbuff);
+  char *dst = static_cast<char *>(recvbuff);
+  std::memmove(dst + m_rank * bytes, src + m_rank * bytes, bytes);
+  // pairwise exchange, send to the rank s above while receiving from the
+  // rank s below
+  for (uint32_t s = 1; s < m_nranks; ++s) {
+    uint32_t to = (m_rank + s) % m_nranks;
+    uint32_t from = (m_rank + m_nranks - s) % m_nranks;
+    BRT_RETURN_IF_ERROR(m_cpu->SendRecv(src + to * bytes, bytes, to,
+                                        dst + from * bytes, bytes, from));
+  }
+  return Status::OK();
+}
+
+Status DistributedBackendCPU::all_gather(const void *sendbuff, void *recvbuff,
+                                         size_t sendlen, DTypeEnum dtype,
+                                         std::set<int64_t> replica_group,
+                                         std::shared_ptr<DContext>) {
+  Group g(replica_group, m_nranks, m_rank);
+  if (g.pos < 0)
+    return Status::OK();
+  size_t elem_bytes = GetDTypeByte(dtype);
+  Blocks blocks{sendlen * g.size(), g.size(), elem_bytes};
+  char *buf = static_cast<char *>(recvbuff);
+  std::memmove(buf + blocks.Bytes(0, g.pos), sendbuff, sendlen * elem_bytes);
+  return m_cpu->AllGatherInplace(g, buf, blocks);
+}
+
+Status DistributedBackendCPU::all_reduce(const void *sendbuff, void *recvbuff,
+                                         size_t len, DTypeEnum dtype,
+                                         ReduceOp op,
+                                         std::set<int64_t> replica_group,
+                                         std::shared_ptr<DContext>) {
+  Group g(replica_group, m_nranks, m_rank);
+  if (g.pos < 0)
+    return Status::OK();
+  return m_cpu->AllReduce(g, sendbuff, recvbuff, len, dtype, op);
+}
+
+Status DistributedBackendCPU::reduce_scatter(const void *sendbuff,
+                                             void *recvbuff, size_t recvlen,
+                                             DTypeEnum dtype, ReduceOp op,
+                                             std::shared_ptr<DContext>) {
+  Group g({}, m_nranks, m_rank);
+  size_t elem_bytes = GetDTypeByte(dtype);
+  size_t bytes = recvlen * elem_bytes;
+  char *work = m_cpu->Work(bytes * m_nranks);
+  std::memcpy(work, sendbuff, bytes * m_nranks);
+  Blocks blocks{recvlen * m_nranks, m_nranks, elem_bytes};
+  BRT_RETURN_IF_ERROR(m_cpu->ReduceScatterInplace(g, work, blocks, dtype, op));
+  std::memcpy(recvbuff, work + m_rank * bytes, bytes);
+  return Status::OK();
+}
+
+Status DistributedBackendCPU::broadcast(const void *sendbuff, void *recvbuff,
+                                        size_t len, DTypeEnum dtype,
+                                        uint32_t root,
+                                        std::set<int64_t> replica_group,
+                                        std::shared_ptr<DContext>) {
+  Group g(replica_group, m_nranks, m_rank);
+  if (g.pos < 0)
+    return Status::OK();
+  auto root_it = std::find(g.ranks.begin(), g.ranks.end(), root);
+  if (root_it == g.ranks.end()) {
+    return Status(StatusCategory::BRT, StatusCode::INVALID_ARGUMENT,
+                  "broadcast root is not in the replica group");
+  }
+  size_t bytes = len * GetDTypeByte(dtype);
+  if (m_rank == root && sendbuff != recvbuff)
+    std::memcpy(recvbuff, sendbuff, bytes);
+  size_t n = g.size();
+  if (n == 1 || bytes == 0)
+    return Status::OK();
+
+  // chain root -> root + 1 -> ... -> root - 1 in the group, where every rank
+  // in the middle forwards a chunk while receiving the next one
+  size_t dist = g.Mod(g.pos - (root_it - g.ranks.begin()));
+  uint32_t next = g.At(g.pos + 1), prev = g.At(g.pos - 1);
+  char *buf = static_cast<char *>(recvbuff);
+  if (dist == 0)
+    return m_cpu->SendRecv(buf, bytes, next, nullptr, 0, prev);
+  if (dist == n - 1)
+    return m_cpu->SendRecv(nullptr, 0, next, buf, bytes, prev);
+  size_t num_chunks = (bytes + kBroadcastChunkBytes - 1) / kBroadcastChunkBytes;
+  auto chunk_bytes = [&](size_t c) {
+    return std::min(kBroadcastChunkBytes, bytes - c * kBroadcastChunkBytes);
+  };
+  for (size_t c = 0; c <= num_chunks; ++c) {
+    size_t send_bytes = c > 0 ? chunk_bytes(c - 1) : 0;
+    size_t recv_bytes = c < num_chunks ? chunk_bytes(c) : 0;
+    char *send_ptr = c > 0 ? buf + (c - 1) * kBroadcastChunkBytes : nullptr;
+    BRT_RETURN_IF_ERROR(m_cpu->SendRecv(send_ptr, send_bytes, next,
+                                        buf + c * kBroadcastChunkBytes,
+                                        recv_bytes, prev));
+  }
+  return Status::OK();
+}
+
+Status DistributedBackendCPU::reduce(const void *sendbuff, void *recvbuff,
+                                     size_t len, DTypeEnum dtype, ReduceOp op,
+                                     uint32_t root,
+                                     std::shared_ptr<DContext>) {
+  Group g({}, m_nranks, m_rank);
+  void *target =
+      m_rank == root ? recvbuff : m_cpu->Work(len * GetDTypeByte(dtype));
+  return m_cpu->AllReduce(g, sendbuff, target, len, dtype, op);
+}
+
+Status DistributedBackendCPU::group_start() { return Status::OK(); }
+
+Status DistributedBackendCPU::group_end() { return Status::OK(); }
+
+void DistributedBackendCPU::issue_async(int64_t async_id,
+                                        std::function<Status()> task) {
+  m_async->Issue(async_id, std::move(task));
+}
+
+Status DistributedBackendCPU::wait_async(int64_t async_id) {
+  return m_async->Wait(async_id);
+}
+
+Status DistributedBackendCPU::drain_async() { return m_async->Drain(); }
+
+} // namespace brt
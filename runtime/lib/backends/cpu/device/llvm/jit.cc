@@ -20,7 +20,9 @@
 #include "brt/core/ir/engine_util.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/LoopAnalysisManager.h"
+#include "llvm/BinaryFormat/Magic.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/Orc/ObjectTransformLayer.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
@@ -313,6 +315,10 @@ public:
 
   common::Status ParseIRFile(const std::string &path);
 
+  // load a static archive of objects, e.g. produced by byteir parallel codegen,
+  // whose members are linked on demand of the symbols they define
+  common::Status LoadArchive(const std::string &path);
+
   common::Status Lookup(const std::string &symbolName, void **symbol);
   common::Status LookupPacked(const std::string &symbolName, void **symbol) {
     return Lookup(makePackedFunctionName(symbolName), symbol);
@@ -420,6 +426,17 @@ common::Status LLVMJITImpl::ParseIRFile(const std::string &path) {
   return LoadTSM({std::move(mod), std::move(ctx)});
 }
 
+common::Status LLVMJITImpl::LoadArchive(const std::string &path) {
+  auto generator = llvm::orc::StaticLibraryDefinitionGenerator::Load(
+      jit->getObjLinkingLayer(), path.c_str());
+  if (!generator) {
+    return LLVMErrorToBRTStatus(generator.takeError(),
+                                "Load LLVM archive failed : ");
+  }
+  jit->getMainJITDylib().addGenerator(std::move(*generator));
+  return common::Status::OK();
+}
+
 common::Status LLVMJITImpl::Lookup(const std::string &symbolName,
                                    void **symbol) {
   auto expectedSymbol = jit->lookup(symbolName);
@@ -480,6 +497,11 @@ LLVMJIT::LLVMJIT()
 LLVMJIT::~LLVMJIT() = default;
 
 common::Status LLVMJIT::LoadFromFile(const std::string &path) {
+  llvm::file_magic magic;
+  if (!llvm::identify_magic(path, magic) &&
+      magic == llvm::file_magic::archive) {
+    return impl->LoadArchive(path);
+  }
   return impl->ParseIRFile(path);
 }
 
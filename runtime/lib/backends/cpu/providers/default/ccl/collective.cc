@@ -0,0 +1,181 @@
+//===- collective.cc ------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "./collective.h"
+#include "brt/backends/cpu/device/d_context_cpu.h"
+#include "brt/core/context/execution_context.h"
+#include "brt/core/context/execution_frame.h"
+#include "brt/core/context/work_queue.h"
+#include "brt/core/distributed/distributed_backend.h"
+#include "brt/core/framework/op_accessor.h"
+
+#include <functional>
+#include <set>
+
+using namespace brt::common;
+
+namespace brt {
+namespace cpu {
+
+namespace {
+
+Status CheckBackend(const ExecutionContext &ctx) {
+  if (ctx.distributed_backend == nullptr) {
+    return Status(StatusCategory::BRT, StatusCode::FAIL,
+                  "collective op requires a DistributedSession");
+  }
+  return Status::OK();
+}
+
+Status GetReplicaGroup(const OpAccessor &accessor,
+                       std::vector<int64_t> *replica_group) {
+  if (!accessor.HasAttr("replica_group")) {
+    return Status(StatusCategory::BRT, StatusCode::NOT_IMPLEMENTED,
+                  "dynamic replica groups are not supported");
+  }
+  *replica_group = accessor.GetAttrAsIntArray("replica_group");
+  return Status::OK();
+}
+
+constexpr const char *kAsyncIdAttrName = "async_id";
+
+// Run `collective` in a host task. If the op has `async_id`, it is issued to
+// the backend asynchronously instead, and completes at the Wait of the id.
+void DispatchCollective(const ExecutionContext &ctx, const OpKernelInfo &info,
+                        const OpAccessor &accessor,
+                        std::function<Status()> collective) {
+  DistributedBackend *backend = ctx.distributed_backend;
+  if (accessor.HasAttr(kAsyncIdAttrName)) {
+    int64_t async_id = accessor.GetAttrAsInt(kAsyncIdAttrName);
+    DispatchHostTask(ctx.work_queue, info.GetOpId(), info.GetDependency(),
+                     { backend->issue_async(async_id, collective); });
+  } else {
+    DispatchHostTask(ctx.work_queue, info.GetOpId(), info.GetDependency(), {
+      backend->drain_async();
+      collective();
+    });
+  }
+}
+
+} // namespace
+
+Status AllReduce::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  std::vector<int64_t> replica_group;
+  BRT_RETURN_IF_ERROR(GetReplicaGroup(accessor, &replica_group));
+  ReduceOp reduce_op = GetReduceOp(accessor.GetAttrAsString("reduction"));
+  if (reduce_op == BRT_REDUCEOP_COUNT) {
+    return Status(StatusCategory::BRT, StatusCode::NOT_IMPLEMENTED,
+                  "unsupported reduction " +
+                      accessor.GetAttrAsString("reduction"));
+  }
+
+  DistributedBackend *backend = ctx.distributed_backend;
+  DTypeEnum dtype = accessor.GetArgDTypeEnum(0);
+  size_t len = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
+  void *src = accessor.GetArgAsyncValueRef(0);
+  void *dst = accessor.GetArgAsyncValueRef(1);
+  std::set<int64_t> group(replica_group.begin(), replica_group.end());
+  DispatchCollective(ctx, info_, accessor, [=]() {
+    return backend->all_reduce(src, dst, len, dtype, reduce_op, group,
+                               CPUContext::make());
+  });
+  return Status::OK();
+}
+
+Status AllGather::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  std::vector<int64_t> replica_group;
+  BRT_RETURN_IF_ERROR(GetReplicaGroup(accessor, &replica_group));
+
+  DistributedBackend *backend = ctx.distributed_backend;
+  DTypeEnum dtype = accessor.GetArgDTypeEnum(0);
+  size_t len = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
+  void *src = accessor.GetArgAsyncValueRef(0);
+  void *dst = accessor.GetArgAsyncValueRef(1);
+  std::set<int64_t> group(replica_group.begin(), replica_group.end());
+  DispatchCollective(ctx, info_, accessor, [=]() {
+    return backend->all_gather(src, dst, len, dtype, group, CPUContext::make());
+  });
+  return Status::OK();
+}
+
+Status Broadcast::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  std::vector<int64_t> replica_group;
+  BRT_RETURN_IF_ERROR(GetReplicaGroup(accessor, &replica_group));
+  if (replica_group.empty()) {
+    return Status(StatusCategory::BRT, StatusCode::INVALID_ARGUMENT,
+                  "broadcast requires a non-empty replica group");
+  }
+
+  DistributedBackend *backend = ctx.distributed_backend;
+  DTypeEnum dtype = accessor.GetArgDTypeEnum(0);
+  size_t len = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
+  void *buf = accessor.GetArgAsyncValueRef(0);
+  uint32_t root = static_cast<uint32_t>(replica_group[0]);
+  std::set<int64_t> group(replica_group.begin(), replica_group.end());
+  DispatchCollective(ctx, info_, accessor, [=]() {
+    return backend->broadcast(buf, buf, len, dtype, root, group,
+                              CPUContext::make());
+  });
+  return Status::OK();
+}
+
+Status Send::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  DistributedBackend *backend = ctx.distributed_backend;
+  DTypeEnum dtype = accessor.GetArgDTypeEnum(0);
+  size_t len = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
+  void *src = accessor.GetArgAsyncValueRef(0);
+  uint32_t rank = static_cast<uint32_t>(accessor.GetAttrAsInt("rank"));
+  DispatchCollective(ctx, info_, accessor, [=]() {
+    return backend->send(src, len, dtype, rank, CPUContext::make());
+  });
+  return Status::OK();
+}
+
+Status Recv::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  DistributedBackend *backend = ctx.distributed_backend;
+  DTypeEnum dtype = accessor.GetArgDTypeEnum(0);
+  size_t len = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
+  void *dst = accessor.GetArgAsyncValueRef(0);
+  uint32_t rank = static_cast<uint32_t>(accessor.GetAttrAsInt("rank"));
+  DispatchCollective(ctx, info_, accessor, [=]() {
+    return backend->recv(dst, len, dtype, rank, CPUContext::make());
+  });
+  return Status::OK();
+}
+
+Status Wait::RunImpl(const ExecutionContext &ctx) {
+  BRT_RETURN_IF_ERROR(CheckBackend(ctx));
+  OpAccessor accessor(info_, ctx.exec_frame);
+  DistributedBackend *backend = ctx.distributed_backend;
+  int64_t async_id = accessor.GetAttrAsInt(kAsyncIdAttrName);
+  DispatchHostTask(ctx.work_queue, info_.GetOpId(), info_.GetDependency(),
+                   { backend->wait_async(async_id); });
+  return Status::OK();
+}
+
+} // namespace cpu
+} // namespace brt
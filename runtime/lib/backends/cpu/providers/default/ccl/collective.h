@@ -0,0 +1,75 @@
+//===- collective.h -------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "brt/core/framework/op_kernel_impl_base.h"
+
+namespace brt {
+namespace cpu {
+
+// Kernels of the byre ops lowered from lccl, which run on the distributed
+// backend of the session, usually a DistributedBackendCPU. Communications
+// are performed in host tasks, so they keep the order of the work queue.
+// Ops with `async_id` are issued asynchronously and completed by the Wait
+// of the same id.
+
+class AllReduce final : public OpKernel {
+public:
+  explicit AllReduce(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+class AllGather final : public OpKernel {
+public:
+  explicit AllGather(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+// broadcast inplace from the first rank of the replica group
+class Broadcast final : public OpKernel {
+public:
+  explicit Broadcast(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+class Send final : public OpKernel {
+public:
+  explicit Send(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+class Recv final : public OpKernel {
+public:
+  explicit Recv(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+class Wait final : public OpKernel {
+public:
+  explicit Wait(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &ctx) override;
+};
+
+} // namespace cpu
+} // namespace brt
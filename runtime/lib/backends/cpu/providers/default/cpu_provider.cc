@@ -17,6 +17,7 @@
 
 #include "brt/backends/cpu/providers/default/cpu_provider.h"
 
+#include "./ccl/collective.h"
 #include "./copy/copy.h"
 #include "./custom_call/non_zero.h"
 #include "./custom_call/repeat.h"
@@ -31,6 +32,8 @@
 #include "./tensor_generate/rng_state.h"
 #include "./typecvt/typecvt.h"
 #include "brt/backends/common.h"
+#include "brt/backends/cpu/device/distributed_backend_cpu.h"
+#include "brt/core/distributed/distributed_session.h"
 #include "brt/core/framework/execution_provider.h"
 #include "brt/core/session/session.h"
 #include "half/half.hpp"
@@ -78,6 +81,22 @@ BRT_STATIC_KERNEL_REGISTRATION(
                 new cpu::Typecvt<DTypeEnum::Float16, DTypeEnum::Float32>(info));
             return kernel;
           });
+      registry->Register(
+          "Typecvt_f32_bf16",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            auto kernel = std::shared_ptr<OpKernel>(
+                new cpu::Typecvt<DTypeEnum::Float32, DTypeEnum::BFloat16>(
+                    info));
+            return kernel;
+          });
+      registry->Register(
+          "Typecvt_bf16_f32",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            auto kernel = std::shared_ptr<OpKernel>(
+                new cpu::Typecvt<DTypeEnum::BFloat16, DTypeEnum::Float32>(
+                    info));
+            return kernel;
+          });
     });
 
 // statcially register all CPU OpKernels
@@ -130,6 +149,38 @@ BRT_STATIC_KERNEL_REGISTRATION(
             return std::make_shared<cpu::NonZero>(info);
           });
 
+      // byre ops lowered from lccl, named after the nccl provider
+      registry->Register(
+          "nccl.AllReduce",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::AllReduce>(info);
+          });
+      registry->Register(
+          "nccl.AllGather",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::AllGather>(info);
+          });
+      registry->Register(
+          "nccl.Broadcast",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::Broadcast>(info);
+          });
+      registry->Register(
+          "nccl.Send",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::Send>(info);
+          });
+      registry->Register(
+          "nccl.Recv",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::Recv>(info);
+          });
+      registry->Register(
+          "nccl.Wait",
+          [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
+            return std::make_shared<cpu::Wait>(info);
+          });
+
       registry->Register(
           "cpu2cpu",
           [](const brt::OpKernelInfo &info) -> std::shared_ptr<OpKernel> {
@@ -187,4 +238,32 @@ NaiveCPUExecutionProviderFactory(Session *session,
   return session->AddExecutionProvider(std::move(cpu_provider));
 }
 
+DistributedCPUExecutionProvider::DistributedCPUExecutionProvider(
+    const CPUExecutionProviderOptions &options, int nranks, int rank,
+    const std::string &ip, int port, const std::string &name)
+    : CPUExecutionProvider(options, name) {
+  cpu_backend_ = std::make_unique<DistributedBackendCPU>(nranks, rank);
+  init_status_ = cpu_backend_->init(ip.c_str(), port);
+}
+
+DistributedCPUExecutionProvider::~DistributedCPUExecutionProvider() {}
+
+common::Status DistributedCPUExecutionProviderFactory(
+    DistributedSession *session, const CPUExecutionProviderOptions &options) {
+  auto provider = std::make_unique<DistributedCPUExecutionProvider>(
+      options, session->GetNRanks(), session->GetRank(), session->GetHost(),
+      session->GetPort());
+  if (!provider->GetInitStatus().IsOK())
+    return provider->GetInitStatus();
+  session->SetDistributedBackend(provider->GetDistributedBackend());
+  // give ownership to the session
+  return session->AddExecutionProvider(std::move(provider));
+}
+
+common::Status
+DistributedCPUExecutionProviderFactory(DistributedSession *session) {
+  return DistributedCPUExecutionProviderFactory(session,
+                                                GetDefaultCPUOptions());
+}
+
 } // namespace brt
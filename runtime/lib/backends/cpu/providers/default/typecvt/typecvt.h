@@ -72,6 +72,61 @@ void TypecvtKernelF16ToF32(const void *src_, void *dst_, const size_t N) {
   }
 }
 
+inline __attribute__((always_inline)) void
+TypecvtKernelF32ToBF16(const void *src_, void *dst_, const size_t N) {
+  const float *src = reinterpret_cast<const float *>(src_);
+  uint16_t *dst = reinterpret_cast<uint16_t *>(dst_);
+  size_t i;
+#if defined(__AVX512BF16__)
+  for (i = 0; i < (N / 16) * 16; i += 16) {
+    __m256bh rst = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), (__m256i)rst);
+  }
+#else
+  // emulated round to nearest even with 128-bit integer ops
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i bias = _mm_set1_epi32(0x7fff);
+  const __m128i qnan = _mm_set1_epi32(0x40);
+  auto cvt4 = [&](__m128 v) {
+    __m128i u = _mm_castps_si128(v);
+    __m128i lsb = _mm_and_si128(_mm_srli_epi32(u, 16), one);
+    __m128i rounded =
+        _mm_srli_epi32(_mm_add_epi32(u, _mm_add_epi32(bias, lsb)), 16);
+    __m128i nan = _mm_or_si128(_mm_srli_epi32(u, 16), qnan);
+    __m128i isnan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+    return _mm_blendv_epi8(rounded, nan, isnan);
+  };
+  for (i = 0; i < (N / 8) * 8; i += 8) {
+    __m128i lo = cvt4(_mm_loadu_ps(src + i));
+    __m128i hi = cvt4(_mm_loadu_ps(src + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_packus_epi32(lo, hi));
+  }
+#endif
+  for (; i < N; ++i) {
+    dst[i] = BFloat16::FromFloat(src[i]);
+  }
+}
+
+inline __attribute__((always_inline)) void
+TypecvtKernelBF16ToF32(const void *src_, void *dst_, const size_t N) {
+  const uint16_t *src = reinterpret_cast<const uint16_t *>(src_);
+  float *dst = reinterpret_cast<float *>(dst_);
+  const __m128i zero = _mm_setzero_si128();
+  size_t i;
+  // bf16 is the upper half of f32, so just interleave with zeros
+  for (i = 0; i < (N / 8) * 8; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_unpacklo_epi16(zero, v));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4),
+                     _mm_unpackhi_epi16(zero, v));
+  }
+  for (; i < N; ++i) {
+    dst[i] = BFloat16::ToFloat(src[i]);
+  }
+}
+
 template <DTypeEnum src_dtype, DTypeEnum dst_dtype> struct TypecvtImpl {
   TypecvtImpl(const OpAccessor &accessor) {
     N = accessor.GetNumElementsOfShape(accessor.GetArgShape(0));
@@ -84,6 +139,12 @@ template <DTypeEnum src_dtype, DTypeEnum dst_dtype> struct TypecvtImpl {
     } else if constexpr (src_dtype == DTypeEnum::Float16 &&
                          dst_dtype == DTypeEnum::Float32) {
       TypecvtKernelF16ToF32(src, dst, N);
+    } else if constexpr (src_dtype == DTypeEnum::Float32 &&
+                         dst_dtype == DTypeEnum::BFloat16) {
+      TypecvtKernelF32ToBF16(src, dst, N);
+    } else if constexpr (src_dtype == DTypeEnum::BFloat16 &&
+                         dst_dtype == DTypeEnum::Float32) {
+      TypecvtKernelBF16ToF32(src, dst, N);
     } else {
       TypecvtKernelNaive(
           reinterpret_cast<const typename DTypeTraits<src_dtype>::type_t *>(
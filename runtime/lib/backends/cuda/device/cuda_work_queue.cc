@@ -123,6 +123,61 @@ common::Status CUDAWorkQueue::Sync() {
   return BRT_CUDA_CALL(cudaDeviceSynchronize());
 }
 
+CUDAWorkQueue::~CUDAWorkQueue() {
+  if (comm_stream_ == nullptr)
+    return;
+  GetCudaEnv().Activate();
+  BRT_CUDA_CHECK(cudaStreamDestroy(comm_stream_));
+  BRT_CUDA_CHECK(cudaEventDestroy(compute_event_));
+  for (auto &&it : comm_events_) {
+    BRT_CUDA_CHECK(cudaEventDestroy(it.second));
+  }
+}
+
+CUstream_st *CUDAWorkQueue::BeginComm() {
+  CUstream_st *compute_stream = GetComputeStream();
+  // nothing to overlap with on the legacy default stream
+  if (compute_stream == nullptr)
+    return nullptr;
+
+  GetCudaEnv().Activate();
+  std::lock_guard<std::mutex> lock(comm_mutex_);
+  if (comm_stream_ == nullptr) {
+    BRT_CUDA_CHECK(cudaStreamCreate(&comm_stream_));
+    BRT_CUDA_CHECK(
+        cudaEventCreateWithFlags(&compute_event_, cudaEventDisableTiming));
+  }
+  BRT_CUDA_CHECK(cudaEventRecord(compute_event_, compute_stream));
+  BRT_CUDA_CHECK(cudaStreamWaitEvent(comm_stream_, compute_event_));
+  return comm_stream_;
+}
+
+common::Status CUDAWorkQueue::EndComm(int64_t async_id) {
+  std::lock_guard<std::mutex> lock(comm_mutex_);
+  if (comm_stream_ == nullptr)
+    return Status::OK();
+
+  GetCudaEnv().Activate();
+  auto found = comm_events_.find(async_id);
+  if (found == comm_events_.end()) {
+    CUevent_st *event;
+    BRT_RETURN_IF_ERROR(BRT_CUDA_CALL(
+        cudaEventCreateWithFlags(&event, cudaEventDisableTiming)));
+    found = comm_events_.emplace(async_id, event).first;
+  }
+  return RecordEvent(found->second, comm_stream_);
+}
+
+common::Status CUDAWorkQueue::WaitComm(int64_t async_id) {
+  std::lock_guard<std::mutex> lock(comm_mutex_);
+  auto found = comm_events_.find(async_id);
+  if (found == comm_events_.end())
+    return Status::OK();
+
+  GetCudaEnv().Activate();
+  return WaitEvent(found->second, GetComputeStream());
+}
+
 CUDASingleStreamWorkQueue::CUDASingleStreamWorkQueue(int device_id)
     : CUDAWorkQueue(device_id, "cuda_signle_stream") {
   GetCudaEnv().Activate();
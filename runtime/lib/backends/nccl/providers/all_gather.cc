@@ -16,6 +16,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "./all_gather.h"
+#include "./wait.h"
 #include "brt/backends/cuda/device/common/util.h"
 #include "brt/backends/cuda/device/cuda_work_queue.h"
 #include "brt/backends/nccl/device/d_context_nccl.h"
@@ -56,15 +57,14 @@ common::Status AllGather::RunImpl(const ExecutionContext &ctx) {
   auto replica_group = accessor.GetAttrAsIntArray("replica_group");
   std::set<int64_t> replica_group_set(replica_group.begin(),
                                       replica_group.end());
-  cudaStream_t stream =
-      static_cast<CUDAWorkQueue *>(ctx.work_queue)->GetComputeStream();
+  cudaStream_t stream = BeginCollective(ctx, accessor);
   std::shared_ptr<DContext> d_context = std::make_shared<CudaContext>(stream);
   auto memref_type =
       cast<mlir::MemRefType>(info_.GetOperation()->getOperand(0).getType());
   nccl_backend->all_gather(src, target, elem_num / nccl_backend->nranks(),
                            ConvertMLIRTypeToDType(memref_type.getElementType()),
                            replica_group_set, d_context);
-  return Status::OK();
+  return EndCollective(ctx, accessor);
 }
 } // namespace cuda
 } // namespace brt
@@ -23,6 +23,7 @@
 #include "./broadcast.h"
 #include "./recv.h"
 #include "./send.h"
+#include "./wait.h"
 #include "brt/core/framework/kernel_registry.h"
 
 namespace brt {
@@ -58,6 +59,12 @@ void RegisterNCCLOps(KernelRegistry *registry) {
       [](const brt::OpKernelInfo &info) -> std::shared_ptr<brt::OpKernel> {
         return std::shared_ptr<OpKernel>(new cuda::Broadcast(info));
       });
+
+  registry->Register(
+      "nccl.Wait",
+      [](const brt::OpKernelInfo &info) -> std::shared_ptr<brt::OpKernel> {
+        return std::shared_ptr<OpKernel>(new cuda::Wait(info));
+      });
 }
 } // namespace cuda
 } // namespace brt
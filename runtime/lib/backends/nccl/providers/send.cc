@@ -16,6 +16,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "./send.h"
+#include "./wait.h"
 #include "brt/backends/cuda/device/common/util.h"
 #include "brt/backends/cuda/device/cuda_work_queue.h"
 #include "brt/backends/nccl/device/d_context_nccl.h"
@@ -54,15 +55,14 @@ common::Status Send::RunImpl(const ExecutionContext &ctx) {
                                   std::multiplies<int64_t>());
   void *src = reinterpret_cast<void *>(accessor.GetArgAsyncValueRef(0));
   int64_t rank = accessor.GetAttrAsInt("rank");
-  cudaStream_t stream =
-      static_cast<CUDAWorkQueue *>(ctx.work_queue)->GetComputeStream();
+  cudaStream_t stream = BeginCollective(ctx, accessor);
   std::shared_ptr<DContext> d_context = std::make_shared<CudaContext>(stream);
   auto memref_type =
       cast<mlir::MemRefType>(info_.GetOperation()->getOperand(0).getType());
   nccl_backend->send(src, elem_num,
                      ConvertMLIRTypeToDType(memref_type.getElementType()), rank,
                      d_context);
-  return Status::OK();
+  return EndCollective(ctx, accessor);
 }
 } // namespace cuda
 } // namespace brt
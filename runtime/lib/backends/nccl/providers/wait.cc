@@ -0,0 +1,58 @@
+//===- wait.cc ------------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "./wait.h"
+#include "brt/backends/cuda/device/cuda_work_queue.h"
+#include "brt/core/context/execution_context.h"
+#include "brt/core/context/execution_frame.h"
+#include "brt/core/framework/op_accessor.h"
+
+using namespace brt;
+using namespace brt::common;
+
+namespace brt {
+namespace cuda {
+
+namespace {
+constexpr const char *kAsyncIdAttrName = "async_id";
+} // namespace
+
+CUstream_st *BeginCollective(const ExecutionContext &ctx,
+                             const OpAccessor &accessor) {
+  auto work_queue = static_cast<CUDAWorkQueue *>(ctx.work_queue);
+  if (accessor.HasAttr(kAsyncIdAttrName))
+    return work_queue->BeginComm();
+  return work_queue->GetComputeStream();
+}
+
+common::Status EndCollective(const ExecutionContext &ctx,
+                             const OpAccessor &accessor) {
+  if (!accessor.HasAttr(kAsyncIdAttrName))
+    return Status::OK();
+  return static_cast<CUDAWorkQueue *>(ctx.work_queue)
+      ->EndComm(accessor.GetAttrAsInt(kAsyncIdAttrName));
+}
+
+common::Status Wait::RunImpl(const ExecutionContext &ctx) {
+  OpAccessor accessor(info_, ctx.exec_frame);
+  return static_cast<CUDAWorkQueue *>(ctx.work_queue)
+      ->WaitComm(accessor.GetAttrAsInt(kAsyncIdAttrName));
+}
+
+} // namespace cuda
+} // namespace brt
@@ -0,0 +1,48 @@
+//===- wait.h -------------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include "brt/core/framework/op_kernel.h"
+
+struct CUstream_st;
+
+namespace brt {
+class OpAccessor;
+
+namespace cuda {
+
+// Return the stream a collective is issued to. A collective with `async_id`
+// runs on the comm stream of the work queue, ordered after prior compute, and
+// must be followed by EndCollective. Others run on the compute stream.
+CUstream_st *BeginCollective(const ExecutionContext &ctx,
+                             const OpAccessor &accessor);
+
+common::Status EndCollective(const ExecutionContext &ctx,
+                             const OpAccessor &accessor);
+
+// order the compute stream after the collective of the same `async_id`
+class Wait final : public OpKernel {
+public:
+  explicit Wait(const OpKernelInfo &info) : OpKernel(info) {}
+
+  common::Status RunImpl(const ExecutionContext &) override;
+};
+
+} // namespace cuda
+} // namespace brt
@@ -0,0 +1,131 @@
+//===- numa.cc ------------------------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "brt/core/common/utils/numa.h"
+
+#if defined(__linux__)
+#include <cstdint>
+#include <fstream>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace brt {
+namespace numa {
+
+#if defined(__linux__)
+
+namespace {
+
+// values of linux/mempolicy.h, which might be missing without libnuma
+constexpr int kMPolBind = 2;
+constexpr unsigned kMPolMFMove = 1 << 1;
+constexpr unsigned kBitsPerWord = sizeof(unsigned long) * 8;
+
+std::string GetNodePath(int node) {
+  return "/sys/devices/system/node/node" + std::to_string(node);
+}
+
+// Parse a cpu or node list of sysfs, e.g. "0-3,8,10-11"
+std::vector<int> ParseList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n")
+      continue;
+    size_t dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = dash == std::string::npos ? first
+                                          : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+} // namespace
+
+const std::vector<int> &GetNodes() {
+  static const std::vector<int> nodes = [] {
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string list;
+    std::vector<int> online;
+    if (file.good() && std::getline(file, list))
+      online = ParseList(list);
+    return online.empty() ? std::vector<int>{0} : online;
+  }();
+  return nodes;
+}
+
+int GetNumNodes() { return static_cast<int>(GetNodes().size()); }
+
+bool BindCurrentThreadToNode(int node) {
+  std::ifstream file(GetNodePath(node) + "/cpulist");
+  std::string list;
+  if (!file.good() || !std::getline(file, list))
+    return false;
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : ParseList(list))
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  if (CPU_COUNT(&set) == 0)
+    return false;
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+bool MoveToNode(void *ptr, size_t size, int node) {
+  if (node < 0)
+    return false;
+  uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  uintptr_t end = begin + size;
+  begin = (begin + page_size - 1) / page_size * page_size;
+  end = end / page_size * page_size;
+  if (begin >= end)
+    return true;
+
+  std::vector<unsigned long> mask(node / kBitsPerWord + 1, 0);
+  mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+  // the kernel reads maxnode - 1 bits
+  unsigned long max_node = mask.size() * kBitsPerWord + 1;
+  return syscall(SYS_mbind, begin, end - begin, kMPolBind, mask.data(),
+                 max_node, kMPolMFMove) == 0;
+}
+
+#else
+
+const std::vector<int> &GetNodes() {
+  static const std::vector<int> nodes{0};
+  return nodes;
+}
+
+int GetNumNodes() { return 1; }
+
+bool BindCurrentThreadToNode(int) { return false; }
+
+bool MoveToNode(void *, size_t, int) { return false; }
+
+#endif
+
+} // namespace numa
+} // namespace brt
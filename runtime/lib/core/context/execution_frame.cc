@@ -282,6 +282,12 @@ AsyncValue BRTInferenceExecutionFrame::GetAsyncValue(size_t idx) const {
 
   idx -= info_.graph_info.arg_alias_to_id_and_offset.size();
 
+  // a session-internal buffer
+  if (info_.intermediate_ids_and_offsets[idx].first ==
+      ConstructInfo::kSessionAllocationOffset) {
+    return info_.session_buffers.at(idx);
+  }
+
   // if intermediate_values not exist, update it by calculateing linear offset
   if (!ctx_.intermediate_values[idx]) {
     if (info_.intermediate_ids_and_offsets[idx].second ==
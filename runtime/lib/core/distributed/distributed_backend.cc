@@ -10,6 +10,7 @@ using namespace brt::common;
 namespace brt {
 
 Status DistributedBackend::init(const char *master_ip, int port) {
+  m_master_ip = master_ip;
   m_client = std::make_shared<RendezvousSocket>(m_nranks, m_rank);
   auto status = m_client->connect(master_ip, port);
   if (status != Status::OK())
@@ -17,6 +17,7 @@
 
 #include "brt/core/framework/execution_plan.h"
 
+#include "brt/core/common/utils/numa.h"
 #include "brt/core/context/work_queue.h"
 #include "brt/core/framework/event.h"
 #include "brt/core/framework/execution_provider.h"
@@ -25,6 +26,8 @@
 #include "brt/core/ir/op_helper.h"
 #include "brt/core/ir/util.h"
 #include "byteir/Dialect/Byre/ByreDialect.h"
+#include "mlir/IR/DialectResourceBlobManager.h"
+#include <optional>
 #include <unordered_set>
 // TODO avoid using BRT_USE_CUDA
 #if BRT_USE_CUDA
@@ -56,6 +59,24 @@ GetAllocator(const std::unordered_map<std::string, std::unique_ptr<IAllocator>>
   return nullptr;
 }
 
+// return raw data of a weight value, which has the same layout for both
+// DenseElementsAttr and DenseResourceElementsAttr except for splats
+static std::optional<std::pair<ArrayRef<char>, bool>>
+GetWeightRawData(Attribute weight_value) {
+  if (auto resource_attr =
+          llvm::dyn_cast_or_null<DenseResourceElementsAttr>(weight_value)) {
+    auto blob = resource_attr.getRawHandle().getBlob();
+    if (blob == nullptr)
+      return std::nullopt;
+    return std::make_pair(blob->getData(), false);
+  }
+  if (auto dense_attr =
+          llvm::dyn_cast_or_null<DenseElementsAttr>(weight_value)) {
+    return std::make_pair(dense_attr.getRawData(), dense_attr.isSplat());
+  }
+  return std::nullopt;
+}
+
 /**
  * ProloguePerSession
  */
@@ -112,35 +133,50 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
             // TODO handle alignment
             auto ptr = cur_allocator->Alloc(allocate_size);
             // load weight from weight_value attr
-            if (arg_attrs.get(mlir::byre::ByreDialect::
-                                  getEntryPointFuncArgWeightValueAttrName())) {
+            auto weight_value =
+                arg_attrs.get(mlir::byre::ByreDialect::
+                                  getEntryPointFuncArgWeightValueAttrName());
+            weight_values_.push_back(weight_value);
+            if (weight_value) {
               auto dtype = ConvertMLIRTypeToDType(memref.getElementType());
-              auto weight_attr = llvm::dyn_cast_or_null<DenseElementsAttr>(
-                  arg_attrs.get(mlir::byre::ByreDialect::
-                                    getEntryPointFuncArgWeightValueAttrName()));
-              // If mlir's data storage changed, fix here like i1 dtype
-              if (weight_attr == nullptr) {
-                return Status(BRT, FAIL,
-                              "weight value is not of type DenseElementsAttr");
-              }
-
               if (device_api == nullptr) {
                 return Status(BRT, FAIL, "nullptr device_api");
               }
 
-              if (dtype == DTypeEnum::Bool) {
-                auto dense_int_attr = cast<DenseIntElementsAttr>(weight_attr);
-                std::vector<char> host_data;
-                host_data.reserve(allocate_size);
-                for (APInt &&i : dense_int_attr) {
-                  host_data.push_back(static_cast<char>(i.getSExtValue()));
+              if (auto resource_attr =
+                      llvm::dyn_cast<DenseResourceElementsAttr>(weight_value)) {
+                // large weights might be kept in resource blobs, whose data
+                // layout is the same as raw data of DenseElementsAttr
+                auto blob = resource_attr.getRawHandle().getBlob();
+                if (blob == nullptr || blob->getData().size() < allocate_size) {
+                  return Status(BRT, FAIL,
+                                "weight value blob is missing or too small");
                 }
-                device_api->MemcpyH2D(dev, ptr, host_data.data(),
-                                      allocate_size);
-              } else {
                 void *host_data_ptr = reinterpret_cast<void *>(
-                    const_cast<char *>(weight_attr.getRawData().data()));
+                    const_cast<char *>(blob->getData().data()));
                 device_api->MemcpyH2D(dev, ptr, host_data_ptr, allocate_size);
+              } else if (auto weight_attr =
+                             llvm::dyn_cast<DenseElementsAttr>(weight_value)) {
+                // If mlir's data storage changed, fix here like i1 dtype
+                if (dtype == DTypeEnum::Bool) {
+                  auto dense_int_attr = cast<DenseIntElementsAttr>(weight_attr);
+                  std::vector<char> host_data;
+                  host_data.reserve(allocate_size);
+                  for (APInt &&i : dense_int_attr) {
+                    host_data.push_back(static_cast<char>(i.getSExtValue()));
+                  }
+                  device_api->MemcpyH2D(dev, ptr, host_data.data(),
+                                        allocate_size);
+                } else {
+                  void *host_data_ptr = reinterpret_cast<void *>(
+                      const_cast<char *>(weight_attr.getRawData().data()));
+                  device_api->MemcpyH2D(dev, ptr, host_data_ptr,
+                                        allocate_size);
+                }
+              } else {
+                return Status(BRT, FAIL,
+                              "weight value is not of type DenseElementsAttr "
+                              "or DenseResourceElementsAttr");
               }
             }
             frame_construct_info_.weights.push_back(ptr);
@@ -309,6 +345,39 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
   if (!status_internal.IsOK())
     return status_internal;
 
+  // prefer dependencies annotated by the compiler if every op kernel has them,
+  // which know about aliasing within planned buffers
+  std::vector<Operation *> kernel_ops;
+  bool has_compiler_dependency = true;
+  graph_.IterateNode([&](Operation *op) {
+    if (llvm::isa<byre::ByreOp>(op) && !IsAliasOp(op)) {
+      kernel_ops.push_back(op);
+      has_compiler_dependency &=
+          op->hasAttr(byre::ByreDialect::getOpDependencyAttrName());
+    }
+    return WalkResult::advance();
+  });
+  if (has_compiler_dependency && !kernel_ops.empty()) {
+    frame_construct_info_.dependency_graph.clear();
+    for (size_t i = 0; i < kernel_ops.size(); ++i) {
+      Operation *op = kernel_ops[i];
+      auto dependency = op->getAttrOfType<ArrayAttr>(
+          byre::ByreDialect::getOpDependencyAttrName());
+      for (size_t j = 0; dependency && j < dependency.size(); ++j) {
+        auto index = llvm::dyn_cast<IntegerAttr>(dependency[j]);
+        // only preceding ops could be depended on
+        if (!index || index.getInt() < 0 ||
+            static_cast<size_t>(index.getInt()) >= i) {
+          const std::string &key =
+              ByREHandle::GetKey(llvm::cast<byre::ByreOp>(op));
+          return Status(BRT, FAIL, "invalid dependency of op " + key);
+        }
+        frame_construct_info_.dependency_graph[op].push_back(
+            kernel_ops[index.getInt()]);
+      }
+    }
+  }
+
   std::unordered_map<Operation *, int> op_to_id_map;
   // create op kernel, generate tensor id and mapping IR value to it
   graph_.IterateNode([&](Operation *op) {
@@ -425,6 +494,8 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
         op_kernels_.push_back(op_ptr);
         if (IsShapeComputeOp(byre_op)) {
           shape_op_kernels_.push_back(op_ptr.get());
+        } else if (IsSessionInitOp(byre_op)) {
+          session_init_op_kernels_.push_back(op_ptr.get());
         } else {
           compute_op_kernels_.push_back(op_ptr.get());
         }
@@ -442,6 +513,41 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
   if (!status_internal.IsOK())
     return status_internal;
 
+  // place host weights on the NUMA node of the first op reading them, op
+  // kernels are created for kernel_ops in order
+  std::unordered_set<size_t> placed_weights;
+  std::unordered_map<OpKernel *, int> kernel_numa_nodes;
+  for (size_t i = 0; i < kernel_ops.size(); ++i) {
+    auto numa_node = GetNumaNode(kernel_ops[i]);
+    if (!numa_node.has_value())
+      continue;
+    kernel_numa_nodes[op_kernels_[i].get()] = *numa_node;
+    if (numa::GetNumNodes() < 2)
+      continue;
+    for (auto operand : kernel_ops[i]->getOperands()) {
+      auto found = graph_info_.tensor_to_id.find(operand.getAsOpaquePointer());
+      if (found == graph_info_.tensor_to_id.end() ||
+          found->second >= graph_info_.weight_count ||
+          !placed_weights.insert(found->second).second)
+        continue;
+      auto memref = llvm::dyn_cast<MemRefType>(operand.getType());
+      if (!memref || GetSpace(memref) != "cpu")
+        continue;
+      // best effort, weights stay where they are on failure
+      numa::MoveToNode(
+          frame_construct_info_.weights[found->second], GetStaticBytes(memref),
+          numa::GetNodes()[*numa_node % numa::GetNumNodes()]);
+    }
+  }
+  if (!kernel_numa_nodes.empty()) {
+    for (size_t i = 0; i < compute_op_kernels_.size(); ++i) {
+      auto found = kernel_numa_nodes.find(compute_op_kernels_[i]);
+      int numa_node = found == kernel_numa_nodes.end() ? -1 : found->second;
+      if (numa_stages_.empty() || numa_stages_.back().second != numa_node)
+        numa_stages_.emplace_back(i, numa_node);
+    }
+  }
+
   frame_construct_info_.intermediate_ids_and_offsets.assign(
       graph_info_.tensors.size() - intermediate_begin,
       {BRTInferenceExecutionFrame::ConstructInfo::kUninitializedAllocatorOffset,
@@ -528,6 +634,22 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
                   BRT, FAIL, "alias of uninitialized intermediate tensor");
               return WalkResult::interrupt();
             }
+            if (p_input_offset.first ==
+                BRTInferenceExecutionFrame::ConstructInfo::
+                    kSessionAllocationOffset) {
+              // alias of session-internal buffer is session-internal too
+              auto &session_buffers = frame_construct_info_.session_buffers;
+              session_buffers[tensor_index] =
+                  static_cast<char *>(
+                      session_buffers[found_input->second -
+                                      intermediate_begin]) +
+                  GetAliasOffsetInByte(defining_op);
+              frame_construct_info_.intermediate_ids_and_offsets[tensor_index] =
+                  {BRTInferenceExecutionFrame::ConstructInfo::
+                       kSessionAllocationOffset,
+                   0 /*don't care*/};
+              continue;
+            }
             if (p_input_offset.first ==
                 BRTInferenceExecutionFrame::ConstructInfo::
                     kGroupAllocationOffset) {
@@ -540,6 +662,23 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
                 p_input_offset.second + GetAliasOffsetInByte(defining_op);
             frame_construct_info_.intermediate_ids_and_offsets[tensor_index] = {
                 p_input_offset.first, tesnor_offset};
+          } else if (defining_op && IsSessionInitOp(defining_op) &&
+                     memref.hasStaticShape()) {
+            // a session-internal buffer, which is allocated once and shared
+            // by all frames
+            auto space = brt::ir::GetSpace(memref);
+            IAllocator *cur_allocator = GetAllocator(allocators, space);
+            if (cur_allocator == nullptr) {
+              status_internal = Status(BRT, FAIL, "nullptr allocator");
+              return WalkResult::interrupt();
+            }
+            void *ptr = cur_allocator->Alloc(GetStaticBytes(memref));
+            session_allocations_.emplace_back(cur_allocator, ptr);
+            frame_construct_info_.session_buffers[tensor_index] = ptr;
+            frame_construct_info_.intermediate_ids_and_offsets[tensor_index] = {
+                BRTInferenceExecutionFrame::ConstructInfo::
+                    kSessionAllocationOffset,
+                0 /*don't care*/};
           } else {
             // a regular Tensor
             // TODO: move alignment support in static memory plan in a util
@@ -581,11 +720,18 @@ common::Status StaticBRTExecutionPlan::ProloguePerSession(
 }
 
 common::Status StaticBRTExecutionPlan::EpiloguePerSession() {
-  // Free weight here
+  // Free weight here, shared weights are freed by their owner
   for (size_t idx = 0; idx < graph_info_.weight_count; ++idx) {
+    if (shared_weights_.count(idx))
+      continue;
     frame_construct_info_.weight_and_ios_allocators[idx]->Free(
         frame_construct_info_.weights[idx]);
   }
+  // Free session-internal buffers
+  for (auto &&[allocator, ptr] : session_allocations_) {
+    allocator->Free(ptr);
+  }
+  session_allocations_.clear();
   return common::Status::OK();
 }
 
@@ -608,6 +754,9 @@ void StaticBRTExecutionPlan::CreateExecutinFrame(
 
 AsyncValue StaticBRTExecutionPlan::GetWeightAsyncValue(size_t idx) {
   BRT_ENFORCE(idx < frame_construct_info_.weights.size());
+  // weights might be updated through the returned buffer, so outputs of
+  // session init kernels must be recomputed in the next Run
+  session_init_outdated_ = true;
   return frame_construct_info_.weights[idx];
 }
 
@@ -635,6 +784,36 @@ std::string StaticBRTExecutionPlan::GetSpace(size_t idx) {
   return maybeSpace.value();
 }
 
+common::Status StaticBRTExecutionPlan::ShareWeights(ExecutionPlan &owner) {
+  auto other = dynamic_cast<StaticBRTExecutionPlan *>(&owner);
+  if (other == nullptr) {
+    return Status(BRT, FAIL, "cannot share weights of a different plan");
+  }
+
+  for (size_t i = 0; i < weight_values_.size(); ++i) {
+    auto data = GetWeightRawData(weight_values_[i]);
+    if (!data.has_value() || shared_weights_.count(i))
+      continue;
+    for (size_t j = 0; j < other->weight_values_.size(); ++j) {
+      auto other_data = GetWeightRawData(other->weight_values_[j]);
+      if (!other_data.has_value() || *data != *other_data ||
+          GetStaticShape(i) != other->GetStaticShape(j) ||
+          GetDType(i) != other->GetDType(j) ||
+          GetSpace(i) != other->GetSpace(j))
+        continue;
+
+      frame_construct_info_.weight_and_ios_allocators[i]->Free(
+          frame_construct_info_.weights[i]);
+      frame_construct_info_.weights[i] =
+          other->frame_construct_info_.weights[j];
+      shared_weights_.insert(i);
+      session_init_outdated_ = true;
+      break;
+    }
+  }
+  return Status::OK();
+}
+
 common::Status StaticBRTExecutionPlan::LoadWeights(const std::string &,
                                                    const std::string &fmt) {
   return Status(BRT, NOT_IMPLEMENTED, "not implemented yet for " + fmt);
@@ -677,13 +856,42 @@ common::Status StaticBRTExecutionPlan::Run(const ExecutionContext &context) {
   // allocate intermediate
   context.exec_frame->AllocIntermediate();
 
-  // dispatch compute kernels
-  for (auto op : compute_op_kernels_) {
-    common::Status status = op->Run(context);
+  // dispatch session init kernels once per weight update, the work queue must
+  // be synced since their outputs would be shared among all following requests
+  if (!session_init_op_kernels_.empty() && session_init_outdated_) {
+    std::lock_guard<std::mutex> lock(session_init_mutex_);
+    if (session_init_outdated_) {
+      for (auto op : session_init_op_kernels_) {
+        common::Status status = op->Run(context);
+        if (!status.IsOK()) {
+          return status;
+        }
+      }
+      if (context.work_queue) {
+        common::Status status = context.work_queue->Sync();
+        if (!status.IsOK()) {
+          return status;
+        }
+      }
+      session_init_outdated_ = false;
+    }
+  }
+
+  // dispatch compute kernels, hinting the NUMA node once per stage
+  auto stage = numa_stages_.begin();
+  for (size_t i = 0; i < compute_op_kernels_.size(); ++i) {
+    if (stage != numa_stages_.end() && stage->first == i) {
+      if (context.work_queue)
+        context.work_queue->SetNumaNode(stage->second);
+      ++stage;
+    }
+    common::Status status = compute_op_kernels_[i]->Run(context);
     if (!status.IsOK()) {
       return status;
     }
   }
+  if (context.work_queue && !numa_stages_.empty())
+    context.work_queue->SetNumaNode(-1);
   context.event_listener_manager->SignalEvent<Events::AfterExecutionPlanRun>(
       {});
 
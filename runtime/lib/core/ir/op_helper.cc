@@ -78,4 +78,16 @@ bool IsShapeComputeOp(Operation *op) {
   return llvm::isa<byre::ComputeShapeOp>(op);
 }
 
+bool IsSessionInitOp(Operation *op) {
+  return op->hasAttr(byre::ByreDialect::getSessionInitAttrName());
+}
+
+std::optional<int> GetNumaNode(Operation *op) {
+  auto node =
+      op->getAttrOfType<IntegerAttr>(byre::ByreDialect::getNumaNodeAttrName());
+  if (!node || node.getInt() < 0)
+    return std::nullopt;
+  return static_cast<int>(node.getInt());
+}
+
 } // namespace brt
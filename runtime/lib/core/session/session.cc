@@ -100,6 +100,11 @@ common::Status Session::LoadWeights(const std::string &url,
   return execution_plan_->LoadWeights(url, fmt);
 }
 
+common::Status Session::ShareWeights(Session &owner) {
+  BRT_ENFORCE(execution_plan_ != nullptr && owner.execution_plan_ != nullptr);
+  return execution_plan_->ShareWeights(*owner.execution_plan_);
+}
+
 common::Status
 Session::NewRequestContext(std::unique_ptr<RequestContext> *request,
                            WorkQueue *work_queue) {
@@ -2,12 +2,15 @@ import brt
 from brt.utils import brt_dtype_to_torch_dtype
 import torch
 
+import json
+import os
 import time
 
 # BRTBackend for static shape and single device
 class BRTBackend:
-    def __init__(self, byre_file_path, device):
+    def __init__(self, byre_file_path, device, num_threads=1, weight_owner=None):
         assert device == "cuda" or device == "cpu"
+        assert device == "cpu" or num_threads == 1
         if device == "cuda":
             from torch.cuda.memory import caching_allocator_alloc, caching_allocator_delete
             _allocator_alloc = caching_allocator_alloc
@@ -23,7 +26,11 @@ class BRTBackend:
             free_func=_allocator_delete,
         )
         self.session.load(byre_file_path)
-        self.req = self.session.new_request_context(_stream)
+        # reuse weights of the same value, the owner is kept alive by reference
+        self.weight_owner = weight_owner
+        if weight_owner is not None:
+            self.session.share_weights(weight_owner.session)
+        self.req = self.session.new_request_context(_stream, num_threads)
         self.device = device
 
         # for static shape model, just cache shape and dtype info
@@ -140,5 +147,192 @@ class BRTBackend:
 
         return avg
 
+    def profile_latencies_with_outputs(self, inputs, outputs, check=True, warmup_trials=10, run_trials=50):
+        """Return latency in ms of each timed run."""
+        if check:
+            self._check_shape_dtype(inputs, self.input_shapes, self.input_dtypes)
+            self._check_shape_dtype(outputs, self.output_shapes, self.output_dtypes)
+
+        self._bind_inputs(inputs)
+        self._bind_outputs(outputs)
+        self.req.finish_io_binding()
+
+        # warmup
+        for _ in range(warmup_trials):
+            self.req.run()
+            self.req.sync()
+
+        latencies = []
+        for _ in range(run_trials):
+            start = time.perf_counter()
+            self.req.run()
+            self.req.sync()
+            latencies.append((time.perf_counter() - start) * 1000)
+
+        return latencies
+
+
+# BRTDynamicShapeBackend runs a dynamic shape model on a single device. As the
+# runtime does not infer shapes of outputs, `output_shape_fn` maps the inputs
+# of each call to the shapes of outputs, which are set along with the shapes of
+# inputs before binding.
+class BRTDynamicShapeBackend(BRTBackend):
+    def __init__(self, byre_file_path, device, output_shape_fn, num_threads=1, weight_owner=None):
+        super().__init__(byre_file_path, device, num_threads=num_threads, weight_owner=weight_owner)
+        self.output_shape_fn = output_shape_fn
+
+    def _check_rank_dtype(self, tensors, shapes, dtypes):
+        assert len(tensors) == len(shapes)
+        assert len(tensors) == len(dtypes)
+        for tensor, shape, dtype in zip(tensors, shapes, dtypes):
+            assert len(shape) == tensor.dim()
+            assert all(size < 0 or size == actual for size, actual in zip(shape, tensor.shape))
+            assert dtype == tensor.dtype
+
+    def _set_shapes(self, offsets, shapes):
+        # changing the shape of an arg unbinds it, so set shapes first
+        for offset, shape in zip(offsets, shapes):
+            self.req.set_shape(offset, list(shape))
+
+    def run(self, inputs, check=True):
+        if check:
+            self._check_rank_dtype(inputs, self.input_shapes, self.input_dtypes)
+        output_shapes = self.output_shape_fn(inputs)
+        if check:
+            assert all(len(shape) == len(static) and
+                       all(size < 0 or size == actual for size, actual in zip(static, shape))
+                       for shape, static in zip(output_shapes, self.output_shapes))
+
+        outputs = []
+        for shape, dtype in zip(output_shapes, self.output_dtypes):
+            outputs.append(torch.empty(shape, dtype=dtype, device=self.device))
+
+        self._set_shapes(self.input_arg_offsets, [input.shape for input in inputs])
+        self._set_shapes(self.output_arg_offsets, output_shapes)
+        self._bind_inputs(inputs)
+        self._bind_outputs(outputs)
+
+        self.req.finish_io_binding()
+        self.req.run()
+        self.req.sync()
+
+        return outputs
+
+
+# BRTShapeBucketBackend dispatches to static shape specializations produced by
+# byteir.compile(..., shape_buckets=[...]) according to the `.buckets.json`
+# manifest. All sessions share weights of the same value. If `allow_padding` is
+# set and the manifest marks it safe, inputs are zero-padded along bucket dims
+# up to the smallest fitting bucket and outputs are sliced back along the dims
+# recorded to follow them, which is only valid for independent dims such as
+# batch. Shapes not covered by any bucket run on the dynamic shape fallback,
+# whose output shapes are evaluated from the same recorded dims. The cpu target
+# compiles no fallback, so such shapes are rejected.
+class BRTShapeBucketBackend:
+    def __init__(self, manifest_path, device, allow_padding=False):
+        with open(manifest_path, "r") as f:
+            manifest = json.load(f)
+        base_dir = os.path.dirname(os.path.abspath(manifest_path))
+        self.device = device
+        self.allow_padding = allow_padding and manifest["paddable"]
+        # {arg dim: bucket dim} of each input and output
+        self.input_dims = [{int(k): v for k, v in dims.items()} for dims in manifest["input_dims"]]
+        self.output_dims = [{int(k): v for k, v in dims.items()} for dims in manifest["output_dims"]]
+        self.buckets = []
+        weight_owner = None
+        for bucket in manifest["buckets"]:
+            dims = {int(dim): size for dim, size in bucket["dims"].items()}
+            backend = BRTBackend(os.path.join(base_dir, bucket["file"]), device, weight_owner=weight_owner)
+            weight_owner = weight_owner or backend
+            self.buckets.append((dims, backend))
+        self.weight_owner = weight_owner
+        self.fallback_path = os.path.join(base_dir, manifest["fallback"]) if manifest.get("fallback") else None
+        self.fallback = None
+
+    def _fallback_output_shapes(self, inputs):
+        dims = set(dim for input_dims in self.input_dims for dim in input_dims.values())
+        actual = self._actual_dims(inputs, dims)
+        assert actual is not None, "inputs disagree on sizes of bucket dims"
+        shapes = []
+        for shape, output_dims in zip(self.fallback.output_shapes, self.output_dims):
+            shape = list(shape)
+            for arg_dim, bucket_dim in output_dims.items():
+                shape[arg_dim] = actual[bucket_dim]
+            shapes.append(shape)
+        return shapes
+
+    def _load_fallback(self):
+        fallback = BRTDynamicShapeBackend(self.fallback_path, self.device, self._fallback_output_shapes,
+                                          weight_owner=self.weight_owner)
+        for idx, (shape, output_dims) in enumerate(zip(fallback.output_shapes, self.output_dims)):
+            unknown = [arg_dim for arg_dim, size in enumerate(shape) if size < 0 and arg_dim not in output_dims]
+            assert not unknown, "dims {} of output {} follow no bucket dim, fallback is not runnable".format(unknown, idx)
+        self.fallback = fallback
+
+    def _actual_dims(self, inputs, dims):
+        actual = {}
+        for dim in dims:
+            sizes = set(input.shape[arg_dim]
+                        for input, input_dims in zip(inputs, self.input_dims)
+                        for arg_dim, bucket_dim in input_dims.items() if bucket_dim == dim)
+            if len(sizes) != 1:
+                return None
+            actual[dim] = sizes.pop()
+        return actual
+
+    def _select(self, inputs):
+        # prefer exact match, then the bucket with the least padding
+        best = None
+        for dims, backend in self.buckets:
+            actual = self._actual_dims(inputs, dims)
+            if actual is None:
+                continue
+            if all(actual[dim] == size for dim, size in dims.items()):
+                return backend, None
+            if not self.allow_padding:
+                continue
+            if all(actual[dim] <= size for dim, size in dims.items()):
+                cost = 1
+                for size in dims.values():
+                    cost *= size
+                if best is None or cost < best[0]:
+                    best = (cost, backend, dims, actual)
+        if best is None:
+            return None, None
+        return best[1], (best[2], best[3])
+
+    def _pad(self, inputs, dims):
+        padded = []
+        for input, input_dims in zip(inputs, self.input_dims):
+            for arg_dim, bucket_dim in input_dims.items():
+                size = dims[bucket_dim]
+                if input.shape[arg_dim] < size:
+                    pad_shape = list(input.shape)
+                    pad_shape[arg_dim] = size - input.shape[arg_dim]
+                    input = torch.cat([input, torch.zeros(pad_shape, dtype=input.dtype, device=input.device)], dim=arg_dim)
+            padded.append(input.contiguous())
+        return padded
+
+    def _slice(self, outputs, actual):
+        sliced = []
+        for output, output_dims in zip(outputs, self.output_dims):
+            for arg_dim, bucket_dim in output_dims.items():
+                output = output.narrow(arg_dim, 0, actual[bucket_dim])
+            sliced.append(output)
+        return sliced
+
+    def run(self, inputs, check=True):
+        backend, padding = self._select(inputs)
+        if backend is None:
+            assert self.fallback_path is not None, "no shape bucket matches inputs and there is no fallback"
+            if self.fallback is None:
+                self._load_fallback()
+            return self.fallback.run(inputs, check=check)
+        if padding is None:
+            return backend.run(inputs, check=check)
+        dims, actual = padding
+        outputs = backend.run(self._pad(inputs, dims), check=check)
+        return self._slice(outputs, actual)
+
 
-# TODO: add BRTDynamicShapeBackend and BRTNCCLBackend
+# TODO: add BRTNCCLBackend
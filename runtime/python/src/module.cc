@@ -285,6 +285,15 @@ PYBIND11_MODULE(MODULE_NAME, m) {
              void *ptr = req.Context().GetArg(offset);
              return reinterpret_cast<size_t>(ptr);
            })
+      .def("set_shape",
+           [](ReqeustContextWithSession &req, size_t offset,
+              const std::vector<int64_t> &shape) {
+             THROW_ON_FAIL(req.Context().SetShape(offset, shape));
+           })
+      .def("get_shape",
+           [](ReqeustContextWithSession &req, size_t offset) {
+             return req.Context().GetShape(offset);
+           })
       .def(
           "finish_io_binding",
           [](ReqeustContextWithSession &req) {
@@ -381,12 +390,24 @@ PYBIND11_MODULE(MODULE_NAME, m) {
             THROW_ON_FAIL(session.Load(path, fmt));
           },
           py::arg("path"), py::arg("format") = "byre")
+      .def(
+          "share_weights",
+          [](Session &session, Session &owner) {
+            THROW_ON_FAIL(session.ShareWeights(owner));
+          },
+          py::arg("owner"))
       .def(
           "new_request_context",
-          [](std::shared_ptr<Session> session, std::optional<size_t> stream) {
+          [](std::shared_ptr<Session> session, std::optional<size_t> stream,
+             size_t num_threads) {
             std::unique_ptr<WorkQueue> work_queue;
             if (session->GetDeviceType() == DeviceType::CPU) {
-              work_queue.reset(new cpu::CPUNaiveWorkQueue());
+              // run independent ops concurrently, 0 for all hardware threads
+              if (num_threads != 1) {
+                work_queue.reset(new cpu::CPUParallelWorkQueue(num_threads));
+              } else {
+                work_queue.reset(new cpu::CPUNaiveWorkQueue());
+              }
             }
 #ifdef BRT_USE_CUDA
             else if (session->GetDeviceType() == DeviceType::CUDA) {
@@ -403,7 +424,7 @@ PYBIND11_MODULE(MODULE_NAME, m) {
             return std::make_unique<ReqeustContextWithSession>(
                 session, work_queue.release());
           },
-          py::arg("stream") = py::none())
+          py::arg("stream") = py::none(), py::arg("num_threads") = 1)
   // clang-format off
 #define DEF_SESSION_METH_GENERIC(name, impl)                                   \
   .def(#name, &Session::impl)
@@ -0,0 +1,124 @@
+//===- cpu_work_queue_test.cc ---------------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "brt/backends/cpu/device/cpu_work_queue.h"
+#include "brt/core/common/status.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace brt;
+using namespace brt::common;
+using namespace brt::cpu;
+
+TEST(CPUWorkQueueTest, ParallelDependency) {
+  CPUParallelWorkQueue wq(4);
+  constexpr int num_ops = 256;
+  std::vector<std::atomic<bool>> done(num_ops);
+  std::atomic<int> num_violations{0};
+  for (int run = 0; run < 3; ++run) {
+    for (auto &d : done)
+      d = false;
+    for (int op_id = 0; op_id < num_ops; ++op_id) {
+      // a diamond on every 4 ops: op 4k + 1 and 4k + 2 depend on 4k, and
+      // 4k + 3 on both of them
+      std::vector<int> dependency;
+      if (op_id % 4 == 1 || op_id % 4 == 2)
+        dependency = {op_id - op_id % 4};
+      else if (op_id % 4 == 3)
+        dependency = {op_id - 2, op_id - 1};
+      else if (op_id > 0)
+        dependency = {op_id - 1};
+
+      std::function<void(void)> func = [&, op_id, dependency]() {
+        for (int dep : dependency)
+          if (!done[dep])
+            ++num_violations;
+        std::this_thread::sleep_for(std::chrono::microseconds(op_id % 7));
+        done[op_id] = true;
+      };
+      ASSERT_EQ(Status::OK(),
+                wq.AddHostTask(&func, nullptr, op_id, dependency));
+    }
+    ASSERT_EQ(Status::OK(), wq.Sync());
+    for (auto &d : done)
+      EXPECT_TRUE(d);
+    EXPECT_EQ(num_violations, 0);
+  }
+}
+
+TEST(CPUWorkQueueTest, ParallelIndependent) {
+  CPUParallelWorkQueue wq(2);
+  // both tasks only finish if they run concurrently
+  std::atomic<int> arrived{0};
+  std::atomic<int> num_concurrent{0};
+  for (int op_id = 0; op_id < 2; ++op_id) {
+    std::function<void(void)> func = [&]() {
+      ++arrived;
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (arrived < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+      if (arrived == 2)
+        ++num_concurrent;
+    };
+    ASSERT_EQ(Status::OK(), wq.AddHostTask(&func, nullptr, op_id, {}));
+  }
+  ASSERT_EQ(Status::OK(), wq.Sync());
+  EXPECT_EQ(num_concurrent, 2);
+}
+
+TEST(CPUWorkQueueTest, ParallelSameOp) {
+  CPUParallelWorkQueue wq(4);
+  // tasks of one op run in order
+  std::vector<int> order;
+  for (int i = 0; i < 64; ++i) {
+    std::function<void(void)> func = [&order, i]() { order.push_back(i); };
+    ASSERT_EQ(Status::OK(), wq.AddHostTask(&func, nullptr, 0, {}));
+  }
+  ASSERT_EQ(Status::OK(), wq.Sync());
+  ASSERT_EQ(order.size(), 64u);
+  for (int i = 0; i < 64; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST(CPUWorkQueueTest, ParallelNumaHint) {
+  CPUParallelWorkQueue wq(4);
+  // hints to nodes beyond the machine wrap around and never block tasks,
+  // including stages of several ops and ops without a node
+  constexpr int num_ops = 64;
+  std::vector<int> order;
+  for (int op_id = 0; op_id < num_ops; ++op_id) {
+    if (op_id % 4 == 0)
+      wq.SetNumaNode(op_id % 24 == 20 ? -1 : op_id / 4 % 5);
+    std::vector<int> dependency;
+    if (op_id > 0)
+      dependency = {op_id - 1};
+    std::function<void(void)> func = [&order, op_id]() {
+      order.push_back(op_id);
+    };
+    ASSERT_EQ(Status::OK(), wq.AddHostTask(&func, nullptr, op_id, dependency));
+  }
+  ASSERT_EQ(Status::OK(), wq.Sync());
+  ASSERT_EQ(order.size(), static_cast<size_t>(num_ops));
+  for (int i = 0; i < num_ops; ++i)
+    EXPECT_EQ(order[i], i);
+}
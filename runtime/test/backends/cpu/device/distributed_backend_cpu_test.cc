@@ -0,0 +1,234 @@
+//===- distributed_backend_cpu_test.cc ------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "brt/backends/cpu/device/d_context_cpu.h"
+#include "brt/backends/cpu/device/distributed_backend_cpu.h"
+#include "brt/core/common/status.h"
+#include "brt/core/distributed/rendezvous_socket.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <functional>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace brt;
+using namespace brt::common;
+
+namespace {
+
+// run `body` in `nranks` forked processes, each with an initialized backend,
+// since ranks on one host are separate processes in practice
+void RunRanks(int nranks, bool disable_shm,
+              std::function<void(DistributedBackend &, int)> body) {
+  int port = brt::GetFreePort();
+  ASSERT_EQ(Status::OK(), brt::CreateServer(nranks, port));
+
+  std::vector<pid_t> pids;
+  for (int rank = 0; rank < nranks; ++rank) {
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+      if (disable_shm)
+        setenv("BRT_CCL_DISABLE_SHM", "1", 1);
+      DistributedBackendCPU backend(nranks, rank);
+      if (backend.init("127.0.0.1", port).IsOK())
+        body(backend, rank);
+      else
+        ADD_FAILURE() << "rank " << rank << " failed to init";
+      _exit(::testing::Test::HasFailure() ? 1 : 0);
+    }
+    pids.push_back(pid);
+  }
+
+  for (int rank = 0; rank < nranks; ++rank) {
+    int wstatus;
+    ASSERT_EQ(waitpid(pids[rank], &wstatus, 0), pids[rank]);
+    EXPECT_TRUE(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0)
+        << "rank " << rank << " failed";
+  }
+}
+
+void CheckAllReduce(DistributedBackend &backend, int rank, size_t len) {
+  int nranks = backend.nranks();
+  auto ctx = CPUContext::make();
+  std::vector<float> src(len), dst(len);
+  for (size_t i = 0; i < len; ++i)
+    src[i] = rank + (i % 64);
+  backend.all_reduce(src.data(), dst.data(), len, DTypeEnum::Float32, BRT_SUM,
+                     {}, ctx);
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(dst[i], nranks * (nranks - 1) / 2 + nranks * (i % 64));
+
+  backend.all_reduce(src.data(), src.data(), len, DTypeEnum::Float32, BRT_MAX,
+                     {}, ctx);
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(src[i], nranks - 1 + (i % 64));
+
+  // rank 0 stays out of the replica group
+  std::vector<int64_t> value(len, rank + 1);
+  std::set<int64_t> group;
+  for (int r = 1; r < nranks; ++r)
+    group.insert(r);
+  backend.all_reduce(value.data(), value.data(), len, DTypeEnum::Int64,
+                     BRT_MIN, group, ctx);
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(value[i], rank == 0 ? 1 : 2);
+
+  std::vector<BFloat16> bf16(len, BFloat16(1.5f));
+  backend.all_reduce(bf16.data(), bf16.data(), len, DTypeEnum::BFloat16,
+                     BRT_SUM, {}, ctx);
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(static_cast<float>(bf16[i]), 1.5f * nranks);
+}
+
+void CheckCollectives(DistributedBackend &backend, int rank, size_t len) {
+  int nranks = backend.nranks();
+  auto ctx = CPUContext::make();
+
+  std::vector<int32_t> src(len, rank * 7), gathered(len * nranks);
+  backend.all_gather(src.data(), gathered.data(), len, DTypeEnum::Int32, {},
+                     ctx);
+  for (int r = 0; r < nranks; ++r)
+    for (size_t i = 0; i < len; ++i)
+      ASSERT_EQ(gathered[r * len + i], r * 7);
+
+  std::vector<double> scattered(len * nranks), reduced(len);
+  for (size_t i = 0; i < len * nranks; ++i)
+    scattered[i] = static_cast<double>(i);
+  backend.reduce_scatter(scattered.data(), reduced.data(), len,
+                         DTypeEnum::Float64, BRT_SUM, ctx);
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(reduced[i], static_cast<double>(nranks * (rank * len + i)));
+
+  // larger than a broadcast chunk to exercise the pipeline
+  std::vector<uint8_t> bcast((3 << 20) + len, rank == nranks - 1 ? 42 : 0);
+  backend.broadcast(bcast.data(), bcast.data(), bcast.size(),
+                    DTypeEnum::UInt8, nranks - 1, {}, ctx);
+  for (auto v : bcast)
+    ASSERT_EQ(v, 42);
+
+  std::vector<int32_t> a2a_src(len * nranks), a2a_dst(len * nranks);
+  for (int r = 0; r < nranks; ++r)
+    for (size_t i = 0; i < len; ++i)
+      a2a_src[r * len + i] = rank * 100 + r;
+  backend.all_to_all(a2a_src.data(), a2a_dst.data(), len, DTypeEnum::Int32,
+                     ctx);
+  for (int r = 0; r < nranks; ++r)
+    for (size_t i = 0; i < len; ++i)
+      ASSERT_EQ(a2a_dst[r * len + i], r * 100 + rank);
+
+  std::vector<float> msg(len);
+  if (rank == 0) {
+    for (size_t i = 0; i < len; ++i)
+      msg[i] = static_cast<float>(i);
+    backend.send(msg.data(), len, DTypeEnum::Float32, nranks - 1, ctx);
+  } else if (rank == nranks - 1) {
+    backend.recv(msg.data(), len, DTypeEnum::Float32, 0, ctx);
+    for (size_t i = 0; i < len; ++i)
+      ASSERT_EQ(msg[i], static_cast<float>(i));
+  }
+}
+
+void CheckAsync(DistributedBackend &backend, int rank, size_t len) {
+  int nranks = backend.nranks();
+  auto ctx = CPUContext::make();
+  std::vector<float> first(len, rank + 1), second(len, 2 * rank);
+  backend.issue_async(0, [&]() {
+    return backend.all_reduce(first.data(), first.data(), len,
+                              DTypeEnum::Float32, BRT_SUM, {}, ctx);
+  });
+  backend.issue_async(1, [&]() {
+    return backend.all_reduce(second.data(), second.data(), len,
+                              DTypeEnum::Float32, BRT_MAX, {}, ctx);
+  });
+
+  // computation overlapped with the collectives
+  std::vector<float> local(len);
+  for (size_t i = 0; i < len; ++i)
+    local[i] = static_cast<float>(i);
+
+  ASSERT_EQ(Status::OK(), backend.wait_async(0));
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(first[i], nranks * (nranks + 1) / 2);
+
+  // reissuing a pending id waits for it first
+  backend.issue_async(1, [&]() {
+    return backend.all_reduce(second.data(), second.data(), len,
+                              DTypeEnum::Float32, BRT_SUM, {}, ctx);
+  });
+  ASSERT_EQ(Status::OK(), backend.drain_async());
+  for (size_t i = 0; i < len; ++i)
+    ASSERT_EQ(second[i], 2 * (nranks - 1) * nranks);
+  ASSERT_EQ(Status::OK(), backend.wait_async(1));
+}
+
+} // namespace
+
+TEST(DistributedBackendCPUTest, AllReduce) {
+  // power of two sizes take recursive halving, others the ring
+  for (int nranks : {2, 3, 4, 5}) {
+    for (size_t len : {1, 7, 100000}) {
+      RunRanks(nranks, /*disable_shm=*/false,
+               [len](DistributedBackend &backend, int rank) {
+                 CheckAllReduce(backend, rank, len);
+               });
+    }
+  }
+}
+
+TEST(DistributedBackendCPUTest, Collectives) {
+  for (int nranks : {2, 3, 4}) {
+    RunRanks(nranks, /*disable_shm=*/false,
+             [](DistributedBackend &backend, int rank) {
+               CheckCollectives(backend, rank, 1000);
+             });
+  }
+}
+
+TEST(DistributedBackendCPUTest, TCP) {
+  for (int nranks : {2, 3}) {
+    RunRanks(nranks, /*disable_shm=*/true,
+             [](DistributedBackend &backend, int rank) {
+               CheckAllReduce(backend, rank, 100000);
+               CheckCollectives(backend, rank, 1000);
+             });
+  }
+}
+
+TEST(DistributedBackendCPUTest, Async) {
+  for (int nranks : {2, 3}) {
+    RunRanks(nranks, /*disable_shm=*/false,
+             [](DistributedBackend &backend, int rank) {
+               CheckAsync(backend, rank, 10000);
+             });
+  }
+}
+
+TEST(DistributedBackendCPUTest, Timeout) {
+  // both ranks wait on each other, which must fail instead of hanging
+  setenv("BRT_CCL_TIMEOUT_SECONDS", "1", 1);
+  RunRanks(2, /*disable_shm=*/false,
+           [](DistributedBackend &backend, int rank) {
+             auto ctx = CPUContext::make();
+             float value;
+             auto status = backend.recv(&value, 1, DTypeEnum::Float32,
+                                        1 - rank, ctx);
+             EXPECT_FALSE(status.IsOK());
+           });
+  unsetenv("BRT_CCL_TIMEOUT_SECONDS");
+}
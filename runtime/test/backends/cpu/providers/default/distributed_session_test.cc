@@ -0,0 +1,89 @@
+//===- distributed_session_test.cc ----------------------------*--- C++ -*-===//
+//
+// Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+
+#include "brt/backends/cpu/device/cpu_work_queue.h"
+#include "brt/backends/cpu/providers/default/cpu_provider.h"
+#include "brt/core/common/status.h"
+#include "brt/core/distributed/distributed_session.h"
+#include "brt/core/distributed/rendezvous_socket.h"
+#include "brt/core/session/request_context.h"
+#include "brt/test/common/util.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace brt;
+using namespace brt::common;
+using namespace brt::test;
+
+static std::string test_file_ccl_cpu =
+    "test/test_files/Distributed/ccl_cpu.mlir";
+
+TEST(CPUDistributedSessionTest, Collectives) {
+  const int nranks = 3;
+  const std::string host = "localhost";
+  int port = brt::GetFreePort();
+  auto ret = brt::CreateServer(nranks, port);
+  ASSERT_EQ(Status::OK(), ret);
+
+  auto run = [nranks, host, port](int rank) {
+    DistributedSession d_session(rank, nranks, host, port);
+    auto status_allocator = CPUAllocatorFactory(&d_session);
+    BRT_TEST_CHECK_STATUS(status_allocator);
+    auto status_cpu = DistributedCPUExecutionProviderFactory(&d_session);
+    BRT_TEST_CHECK_STATUS(status_cpu);
+
+    std::vector<std::string> config(nranks, test_file_ccl_cpu);
+    std::string ir_url;
+    d_session.LoadConfig(config, ir_url);
+    auto status_load = d_session.Load(ir_url, "byre");
+    BRT_TEST_CHECK_STATUS(status_load);
+
+    std::unique_ptr<RequestContext> request;
+    auto status_request =
+        d_session.NewRequestContext(&request, new cpu::CPUNaiveWorkQueue());
+    BRT_TEST_CHECK_STATUS(status_request);
+
+    float *in0 = static_cast<float *>(request->GetArg(0));
+    float *out0 = static_cast<float *>(request->GetArg(1));
+    float *out1 = static_cast<float *>(request->GetArg(2));
+    for (size_t i = 0; i < 4; ++i)
+      in0[i] = static_cast<float>(rank + 1);
+    request->FinishIOBinding();
+
+    auto status_run = d_session.Run(*request);
+    BRT_TEST_CHECK_STATUS(status_run);
+    auto status_sync = request->Sync();
+    BRT_TEST_CHECK_STATUS(status_sync);
+
+    // 1 + 2 + 3 reduced, then the input of rank 2 broadcast and gathered
+    for (size_t i = 0; i < 4; ++i)
+      EXPECT_EQ(out0[i], 6.0f);
+    for (size_t i = 0; i < 12; ++i)
+      EXPECT_EQ(out1[i], 3.0f);
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nranks; i++) {
+    threads.push_back(std::thread(run, i));
+  }
+
+  for (int i = 0; i < nranks; i++) {
+    threads[i].join();
+  }
+}
@@ -58,6 +58,14 @@ void GenerateInput(half_float::half *src, size_t len) {
   }
 }
 
+void GenerateInput(BFloat16 *src, size_t len) {
+  std::vector<float> buf(len);
+  RandCPUBuffer(buf.data(), len, -10.f, 10.f);
+  for (size_t i = 0; i < len; ++i) {
+    src[i] = static_cast<BFloat16>(buf[i]);
+  }
+}
+
 template <typename src_type, typename dst_type,
           std::enable_if_t<std::is_integral<dst_type>::value, int> = 0>
 void CheckResult(const src_type *src, const dst_type *dst, size_t len) {
@@ -81,6 +89,14 @@ void CheckResult(const src_type *src, half_float::half *dst, size_t len) {
   }
 }
 
+template <typename src_type>
+void CheckResult(const src_type *src, BFloat16 *dst, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    ASSERT_EQ(static_cast<BFloat16>(static_cast<float>(src[i])).bits,
+              dst[i].bits);
+  }
+}
+
 template <typename src_type, typename dst_type>
 void CheckTypecvtSingle(const std::vector<int64_t> &shape) {
   ByREBuilder byre_builder;
@@ -139,5 +155,7 @@ TEST(CPUOpKernelTest, TypecvtBasic) {
     CheckTypecvtSingle<int64_t, int32_t>(shape);
     CheckTypecvtSingle<float, half_float::half>(shape);
     CheckTypecvtSingle<half_float::half, float>(shape);
+    CheckTypecvtSingle<float, BFloat16>(shape);
+    CheckTypecvtSingle<BFloat16, float>(shape);
   }
 }
@@ -15,6 +15,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "brt/backends/cpu/device/cpu_device_api.h"
 #include "brt/backends/cpu/providers/default/cpu_provider.h"
 #include "brt/core/common/status.h"
 #include "brt/core/framework/dtype.h"
@@ -23,6 +24,7 @@
 #include "brt/test/common/models.h"
 #include "brt/test/common/util.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -34,6 +36,12 @@ using namespace brt::test;
 static std::string test_file_add_2 = "test/test_files/add2_cpu.mlir";
 static std::string test_file_add_2_dynamic =
     "test/test_files/DynamicShapes/Add2/entry.mlir";
+static std::string test_file_session_init =
+    "test/test_files/session_init_cpu.mlir";
+static std::string test_file_weight_value =
+    "test/test_files/add_weight_value_cpu.mlir";
+static std::string test_file_weight_value_swapped =
+    "test/test_files/add_weight_value_swapped_cpu.mlir";
 
 static void CheckCPUResult(void *h_ptr, size_t size, char val) {
   char *h_char_ptr = (char *)h_ptr;
@@ -267,3 +275,96 @@ TEST(SessionTest, DynamicShapeBasic) {
     }
   }
 }
+
+TEST(SessionTest, SessionInit) {
+  Session session;
+  auto status_allocator = CPUAllocatorFactory(&session);
+  BRT_TEST_CHECK_STATUS(status_allocator);
+  auto status_cpu = NaiveCPUExecutionProviderFactory(&session);
+  BRT_TEST_CHECK_STATUS(status_cpu);
+
+  auto status_load = session.Load(test_file_session_init, "byre");
+  BRT_TEST_CHECK_STATUS(status_load);
+  EXPECT_EQ(session.GetWeightNum(), 1);
+  EXPECT_EQ(session.GetArgNum(), 3);
+
+  size_t len = 100 * 32;
+  float *w = static_cast<float *>(session.GetWeightAsyncValue(0));
+  std::fill(w, w + len, 1.f);
+
+  auto run = [&](float expected) {
+    std::unique_ptr<RequestContext> request;
+    auto status_request = session.NewRequestContext(&request);
+    BRT_TEST_CHECK_STATUS(status_request);
+    float *i0 = static_cast<float *>(request->GetArg(0));
+    float *o0 = static_cast<float *>(request->GetArg(1));
+    std::fill(i0, i0 + len, 3.f);
+    request->FinishIOBinding();
+
+    auto status_run = session.Run(*request);
+    BRT_TEST_CHECK_STATUS(status_run);
+    auto status_sync = request->Sync();
+    BRT_TEST_CHECK_STATUS(status_sync);
+    for (size_t i = 0; i < len; ++i) {
+      ASSERT_EQ(o0[i], expected);
+    }
+  };
+
+  // session init kernel runs in the first Run only, so changing the weight
+  // behind the returned buffer doesn't affect the following Runs
+  run(5.f);
+  std::fill(w, w + len, 2.f);
+  run(5.f);
+  run(5.f);
+
+  // requesting the weight buffer again marks it as updated, which triggers
+  // session init kernels once more
+  w = static_cast<float *>(session.GetWeightAsyncValue(0));
+  run(7.f);
+  run(7.f);
+}
+
+TEST(SessionTest, ShareWeights) {
+  auto create_session = [](const std::string &file,
+                           std::unique_ptr<Session> &session) {
+    session = std::make_unique<Session>();
+    auto status_allocator = CPUAllocatorFactory(session.get());
+    BRT_TEST_CHECK_STATUS(status_allocator);
+    auto status_cpu = NaiveCPUExecutionProviderFactory(session.get());
+    BRT_TEST_CHECK_STATUS(status_cpu);
+    session->SetExecDevice(DeviceType::CPU, /*device_id*/ 0);
+    session->AddDeviceAPI(DeviceType::CPU, GetCPUDeviceAPI());
+    auto status_load = session->Load(file, "byre");
+    BRT_TEST_CHECK_STATUS(status_load);
+  };
+
+  std::unique_ptr<Session> owner, session;
+  create_session(test_file_weight_value, owner);
+  create_session(test_file_weight_value_swapped, session);
+  auto status_share = session->ShareWeights(*owner);
+  BRT_TEST_CHECK_STATUS(status_share);
+
+  // weights are matched by value rather than by position
+  EXPECT_EQ(session->GetWeightAsyncValue(0), owner->GetWeightAsyncValue(1));
+  EXPECT_NE(session->GetWeightAsyncValue(1), owner->GetWeightAsyncValue(0));
+  EXPECT_NE(session->GetWeightAsyncValue(1), owner->GetWeightAsyncValue(1));
+
+  std::unique_ptr<RequestContext> request;
+  auto status_request = session->NewRequestContext(&request);
+  BRT_TEST_CHECK_STATUS(status_request);
+  float *i0 = static_cast<float *>(request->GetArg(0));
+  float *o0 = static_cast<float *>(request->GetArg(1));
+  std::fill(i0, i0 + 4, 1.f);
+  request->FinishIOBinding();
+  auto status_run = session->Run(*request);
+  BRT_TEST_CHECK_STATUS(status_run);
+  auto status_sync = request->Sync();
+  BRT_TEST_CHECK_STATUS(status_sync);
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(o0[i], 6.f + i);
+  }
+
+  // shared weights must be released before their owner
+  request.reset();
+  session.reset();
+}
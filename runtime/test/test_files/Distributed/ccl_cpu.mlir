@@ -0,0 +1,10 @@
+module attributes {byre.container_module} {
+  func.func @test_ccl_cpu(%arg0 : memref<4xf32, "cpu"> {byre.argname = "in0", byre.argtype = 1: i32},
+                          %arg1 : memref<4xf32, "cpu"> {byre.argname = "out0", byre.argtype = 2: i32},
+                          %arg2 : memref<12xf32, "cpu"> {byre.argname = "out1", byre.argtype = 2: i32}) attributes {byre.entry_point} {
+    byre.compute @nccl.AllReduce(%arg0, %arg1) {device = "cpu", memory_effects = [1 : i32, 2 : i32], reduction = "sum", replica_group = [0, 1, 2], synchronous = true} : memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    byre.compute @nccl.Broadcast(%arg0) {device = "cpu", memory_effects = [3 : i32], replica_group = [2, 0, 1], synchronous = true} : memref<4xf32, "cpu">
+    byre.compute @nccl.AllGather(%arg0, %arg2) {device = "cpu", memory_effects = [1 : i32, 2 : i32], replica_group = [0, 1, 2], synchronous = true} : memref<4xf32, "cpu">, memref<12xf32, "cpu">
+    return
+  }
+}
@@ -0,0 +1,11 @@
+module attributes {byre.container_module} {
+  func.func @main(%arg0 : memref<4xf32, "cpu"> {byre.argname = "W0", byre.argtype = 4: i32, byre.weight_value = dense<[5.0, 6.0, 7.0, 8.0]> : tensor<4xf32>},
+                  %arg1 : memref<4xf32, "cpu"> {byre.argname = "W1", byre.argtype = 4: i32, byre.weight_value = dense<[0.0, 0.0, 0.0, 0.0]> : tensor<4xf32>},
+                  %arg2 : memref<4xf32, "cpu"> {byre.argname = "A", byre.argtype = 1: i32},
+                  %arg3 : memref<4xf32, "cpu"> {byre.argname = "B", byre.argtype = 2: i32}) attributes {byre.entry_point} {
+    %0 = memref.alloc() : memref<4xf32, "cpu">
+    byre.compute @AddOp_f32f32_f32(%arg0, %arg1, %0) {memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    byre.compute @AddOp_f32f32_f32(%arg2, %0, %arg3) {memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<4xf32, "cpu">, memref<4xf32, "cpu">, memref<4xf32, "cpu">
+    return
+  }
+}
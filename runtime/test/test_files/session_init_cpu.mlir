@@ -0,0 +1,10 @@
+module attributes {byre.container_module} {
+  func.func @main(%arg0 : memref<100x32xf32, "cpu"> {byre.argname = "W", byre.argtype = 4: i32},
+                  %arg1 : memref<100x32xf32, "cpu"> {byre.argname = "A", byre.argtype = 1: i32},
+                  %arg2 : memref<100x32xf32, "cpu"> {byre.argname = "B", byre.argtype = 2: i32}) attributes {byre.entry_point} {
+    %0 = memref.alloc() {byre.session_init} : memref<100x32xf32, "cpu">
+    byre.compute @AddOp_f32f32_f32(%arg0, %arg0, %0) {byre.session_init, memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<100x32xf32, "cpu">, memref<100x32xf32, "cpu">, memref<100x32xf32, "cpu">
+    byre.compute @AddOp_f32f32_f32(%arg1, %0, %arg2) {memory_effects = [1 : i32, 1 : i32, 2 : i32]} : memref<100x32xf32, "cpu">, memref<100x32xf32, "cpu">, memref<100x32xf32, "cpu">
+    return
+  }
+}
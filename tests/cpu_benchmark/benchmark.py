@@ -0,0 +1,173 @@
+# Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+#!/usr/bin/python3
+"""End-to-end cpu benchmark of representative models.
+
+Each model is compiled by byteir for cpu at every batch size, then run by brt
+with every number of threads on synthetic inputs, reporting latency
+percentiles and throughput in samples per second.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+import time
+import traceback
+from typing import List, NamedTuple
+
+import torch
+
+import byteir
+from brt.backend import BRTBackend
+
+from models import MODELS, model_file_name
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "numerical_test"))
+from perf_db import latency_stats
+
+
+class BenchmarkResult(NamedTuple):
+    model: str
+    batch_size: int
+    num_threads: int
+    compile_time_s: float
+    latency_p50_ms: float
+    latency_p90_ms: float
+    latency_p99_ms: float
+    latency_mean_ms: float
+    # samples per second at the median latency
+    throughput: float
+
+
+def get_model_file(name: str, batch_size: int, workdir: str) -> str:
+    """Generate the mhlo of the model at `batch_size` into the workdir."""
+    generated = os.path.join(workdir, "models", model_file_name(name, batch_size))
+    os.makedirs(os.path.dirname(generated), exist_ok=True)
+    with open(generated, "w") as f:
+        f.write(MODELS[name].build(batch_size))
+    return generated
+
+
+def generate_inputs(backend: BRTBackend, int_input_high: int, seed: int) -> List[torch.Tensor]:
+    generator = torch.Generator().manual_seed(seed)
+    inputs = []
+    for shape, dtype in zip(backend.input_shapes, backend.input_dtypes):
+        if dtype.is_floating_point:
+            # weights are scaled by their fan-in to keep activations bounded
+            fan_in = math.prod(shape[1:]) if len(shape) >= 2 else 1
+            scale = math.sqrt(3.0 / fan_in) if len(shape) >= 2 else 0.1
+            data = (torch.rand(shape, generator=generator) * 2 - 1) * scale
+            inputs.append(data.to(dtype))
+        else:
+            inputs.append(torch.randint(0, int_input_high, shape, generator=generator, dtype=dtype))
+    return inputs
+
+
+def benchmark_model(name: str, batch_size: int, thread_counts: List[int], args) -> List[BenchmarkResult]:
+    model_file = get_model_file(name, batch_size, args.workdir)
+    unique_name = f"{name}_bs{batch_size}"
+    os.makedirs(os.path.join(args.workdir, unique_name), exist_ok=True)
+    byre_file = os.path.join(args.workdir, unique_name, f"{unique_name}.rt.mlir")
+    entry_func = re.search(r"func\.func @(\w+)", open(model_file).read()).group(1)
+
+    compile_start = time.perf_counter()
+    byteir.compile(model_file, byre_file, entry_func=entry_func, target="cpu", verbose=args.verbose)
+    compile_time = time.perf_counter() - compile_start
+
+    results = []
+    inputs = None
+    for num_threads in thread_counts:
+        backend = BRTBackend(byre_file, "cpu", num_threads=num_threads)
+        if inputs is None:
+            inputs = generate_inputs(backend, MODELS[name].int_input_high, args.seed)
+        outputs = [torch.empty(shape, dtype=dtype)
+                   for shape, dtype in zip(backend.output_shapes, backend.output_dtypes)]
+        latencies = backend.profile_latencies_with_outputs(
+            inputs, outputs, warmup_trials=args.warmup_trials, run_trials=args.run_trials)
+        p50, p90, p99, mean = latency_stats(latencies)
+        results.append(BenchmarkResult(
+            model=name,
+            batch_size=batch_size,
+            num_threads=num_threads,
+            compile_time_s=compile_time,
+            latency_p50_ms=p50,
+            latency_p90_ms=p90,
+            latency_p99_ms=p99,
+            latency_mean_ms=mean,
+            throughput=batch_size * 1000.0 / p50,
+        ))
+    return results
+
+
+def report(results: List[BenchmarkResult]):
+    header = (f"{'model':<20}{'batch':>6}{'threads':>8}{'p50(ms)':>11}{'p90(ms)':>11}"
+              f"{'p99(ms)':>11}{'samples/s':>12}{'compile(s)':>12}")
+    print(header)
+    print("-" * len(header))
+    for r in results:
+        print(f"{r.model:<20}{r.batch_size:>6}{r.num_threads:>8}{r.latency_p50_ms:>11.3f}"
+              f"{r.latency_p90_ms:>11.3f}{r.latency_p99_ms:>11.3f}{r.throughput:>12.1f}"
+              f"{r.compile_time_s:>12.1f}")
+
+
+def parse_int_list(value: str) -> List[int]:
+    return [int(v) for v in value.split(",")]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "-f", "--filter", type=str, default=".*",
+        help="regular expression of model names to run, among " + ", ".join(MODELS),
+    )
+    parser.add_argument("--batch-sizes", type=parse_int_list, default=[1, 8, 32])
+    parser.add_argument("--num-threads", type=parse_int_list, default=[1, os.cpu_count()],
+                        help="comma separated numbers of brt worker threads")
+    parser.add_argument("--warmup-trials", type=int, default=5)
+    parser.add_argument("--run-trials", type=int, default=20)
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--workdir", type=str, default="./local_benchmark")
+    parser.add_argument("--output", type=str, default=None, help="write results as json to this file")
+    parser.add_argument("--verbose", default=False, action="store_true")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    thread_counts = sorted(set(args.num_threads))
+    results = []
+    failed = False
+    for name in MODELS:
+        if not re.match(args.filter, name):
+            continue
+        for batch_size in args.batch_sizes:
+            try:
+                results += benchmark_model(name, batch_size, thread_counts, args)
+            except Exception:
+                failed = True
+                print(f"{name} at batch size {batch_size} failed:", file=sys.stderr)
+                traceback.print_exc()
+    report(results)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump([r._asdict() for r in results], f, indent=2)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
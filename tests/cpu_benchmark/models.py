@@ -0,0 +1,460 @@
+# Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""Generators of mhlo for the cpu benchmark models.
+
+Weights are entry function arguments, so the generated models stay small
+and inputs of any batch size can be generated locally. Dense weights are
+laid out as [out, in] and convolution filters as OIHW, so that the fan-in of
+any weight is the product of all but its leading dim.
+"""
+
+import argparse
+import math
+import os
+from typing import Callable, List, NamedTuple, Sequence, Tuple
+
+
+class Value(NamedTuple):
+    name: str
+    shape: Tuple[int, ...]
+    dtype: str
+
+
+def tensor_type(shape: Sequence[int], dtype: str) -> str:
+    return "tensor<" + "".join(f"{d}x" for d in shape) + dtype + ">"
+
+
+def type_of(value: Value) -> str:
+    return tensor_type(value.shape, value.dtype)
+
+
+def float_literal(value: float) -> str:
+    # mlir float literals need a decimal point
+    return f"{value:.9e}"
+
+
+def dense_i64(values: Sequence[int]) -> str:
+    return f"dense<[{', '.join(str(v) for v in values)}]> : tensor<{len(values)}xi64>"
+
+
+class GraphBuilder:
+    def __init__(self, func_name: str):
+        self.func_name = func_name
+        self.args: List[Value] = []
+        self.body: List[str] = []
+        self.num_values = 0
+
+    def arg(self, shape: Sequence[int], dtype: str = "f32") -> Value:
+        value = Value(f"%arg{len(self.args)}", tuple(shape), dtype)
+        self.args.append(value)
+        return value
+
+    def _result(self, shape: Sequence[int], dtype: str) -> Value:
+        value = Value(f"%{self.num_values}", tuple(shape), dtype)
+        self.num_values += 1
+        return value
+
+    def emit(self, op: str, operands: Sequence[Value], shape: Sequence[int], dtype: str,
+             attrs: str = "", region: str = "") -> Value:
+        result = self._result(shape, dtype)
+        names = ", ".join(o.name for o in operands)
+        types = ", ".join(type_of(o) for o in operands)
+        region_str = f" ({region})" if region else ""
+        attrs_str = f" {{{attrs}}}" if attrs else ""
+        self.body.append(
+            f'  {result.name} = "{op}"({names}){region_str}{attrs_str} : ({types}) -> {type_of(result)}'
+        )
+        return result
+
+    def build(self, results: Sequence[Value]) -> str:
+        args = ", ".join(f"{a.name}: {type_of(a)}" for a in self.args)
+        result_types = ", ".join(type_of(r) for r in results)
+        lines = [f"func.func @{self.func_name}({args}) -> ({result_types}) {{"]
+        lines += self.body
+        lines.append(f"  return {', '.join(r.name for r in results)} : {result_types}")
+        lines.append("}")
+        return "\n".join(lines) + "\n"
+
+    # ---- ops ----
+
+    def constant(self, value: str, shape: Sequence[int] = (), dtype: str = "f32") -> Value:
+        result = self._result(shape, dtype)
+        self.body.append(f"  {result.name} = mhlo.constant dense<{value}> : {type_of(result)}")
+        return result
+
+    def broadcast_in_dim(self, x: Value, shape: Sequence[int], dims: Sequence[int]) -> Value:
+        return self.emit("mhlo.broadcast_in_dim", [x], shape, x.dtype,
+                         f"broadcast_dimensions = {dense_i64(dims)}")
+
+    def broadcast_to(self, x: Value, shape: Sequence[int]) -> Value:
+        """Numpy-style broadcast aligning trailing dims."""
+        if tuple(x.shape) == tuple(shape):
+            return x
+        offset = len(shape) - len(x.shape)
+        return self.broadcast_in_dim(x, shape, list(range(offset, len(shape))))
+
+    def _binary_shape(self, lhs: Value, rhs: Value) -> Tuple[int, ...]:
+        rank = max(len(lhs.shape), len(rhs.shape))
+        l = (1,) * (rank - len(lhs.shape)) + tuple(lhs.shape)
+        r = (1,) * (rank - len(rhs.shape)) + tuple(rhs.shape)
+        return tuple(max(a, b) for a, b in zip(l, r))
+
+    def _binary(self, op: str, lhs: Value, rhs: Value) -> Value:
+        shape = self._binary_shape(lhs, rhs)
+        lhs = self.broadcast_to(lhs, shape)
+        rhs = self.broadcast_to(rhs, shape)
+        return self.emit(op, [lhs, rhs], shape, lhs.dtype)
+
+    def add(self, lhs, rhs): return self._binary("mhlo.add", lhs, rhs)
+    def sub(self, lhs, rhs): return self._binary("mhlo.subtract", lhs, rhs)
+    def mul(self, lhs, rhs): return self._binary("mhlo.multiply", lhs, rhs)
+    def div(self, lhs, rhs): return self._binary("mhlo.divide", lhs, rhs)
+    def max(self, lhs, rhs): return self._binary("mhlo.maximum", lhs, rhs)
+    def rem(self, lhs, rhs): return self._binary("mhlo.remainder", lhs, rhs)
+
+    def compare(self, lhs: Value, rhs: Value, direction: str) -> Value:
+        shape = self._binary_shape(lhs, rhs)
+        lhs = self.broadcast_to(lhs, shape)
+        rhs = self.broadcast_to(rhs, shape)
+        return self.emit("mhlo.compare", [lhs, rhs], shape, "i1",
+                         f"comparison_direction = #mhlo<comparison_direction {direction}>")
+
+    def select(self, pred: Value, on_true: Value, on_false: Value) -> Value:
+        return self.emit("mhlo.select", [pred, on_true, on_false], pred.shape, on_true.dtype)
+
+    def unary(self, op: str, x: Value) -> Value:
+        return self.emit(op, [x], x.shape, x.dtype)
+
+    def convert(self, x: Value, dtype: str) -> Value:
+        return self.emit("mhlo.convert", [x], x.shape, dtype)
+
+    def scalar(self, value: float, like: Value) -> Value:
+        literal = float_literal(value) if like.dtype.startswith("f") else str(int(value))
+        return self.constant(literal, (), like.dtype)
+
+    def reshape(self, x: Value, shape: Sequence[int]) -> Value:
+        assert math.prod(shape) == math.prod(x.shape)
+        return self.emit("mhlo.reshape", [x], shape, x.dtype)
+
+    def transpose(self, x: Value, perm: Sequence[int]) -> Value:
+        shape = [x.shape[p] for p in perm]
+        return self.emit("mhlo.transpose", [x], shape, x.dtype, f"permutation = {dense_i64(perm)}")
+
+    def concatenate(self, values: Sequence[Value], dim: int) -> Value:
+        shape = list(values[0].shape)
+        shape[dim] = sum(v.shape[dim] for v in values)
+        return self.emit("mhlo.concatenate", values, shape, values[0].dtype, f"dimension = {dim} : i64")
+
+    def dot_general(self, lhs: Value, rhs: Value, lhs_batch: Sequence[int], rhs_batch: Sequence[int],
+                    lhs_contract: Sequence[int], rhs_contract: Sequence[int]) -> Value:
+        shape = [lhs.shape[d] for d in lhs_batch]
+        shape += [s for d, s in enumerate(lhs.shape) if d not in lhs_batch and d not in lhs_contract]
+        shape += [s for d, s in enumerate(rhs.shape) if d not in rhs_batch and d not in rhs_contract]
+        attrs = ("dot_dimension_numbers = #mhlo.dot<"
+                 f"lhs_batching_dimensions = {list(lhs_batch)}, rhs_batching_dimensions = {list(rhs_batch)}, "
+                 f"lhs_contracting_dimensions = {list(lhs_contract)}, "
+                 f"rhs_contracting_dimensions = {list(rhs_contract)}>")
+        return self.emit("mhlo.dot_general", [lhs, rhs], shape, lhs.dtype, attrs)
+
+    def _reducer(self, kind: str, dtype: str) -> str:
+        scalar = tensor_type((), dtype)
+        lhs, rhs, out = (f"%r{self.num_values}_{n}" for n in ("lhs", "rhs", "out"))
+        return ("{\n"
+                f"  ^bb0({lhs}: {scalar}, {rhs}: {scalar}):\n"
+                f"    {out} = mhlo.{kind} {lhs}, {rhs} : {scalar}\n"
+                f"    mhlo.return {out} : {scalar}\n"
+                "  }")
+
+    def reduce(self, x: Value, dims: Sequence[int], kind: str = "add") -> Value:
+        init = self.constant("0xFF800000" if kind == "maximum" else "0.0", (), x.dtype) \
+            if x.dtype.startswith("f") else self.constant("0", (), x.dtype)
+        shape = [s for d, s in enumerate(x.shape) if d not in dims]
+        result = self._result(shape, x.dtype)
+        self.body.append(
+            f'  {result.name} = "mhlo.reduce"({x.name}, {init.name}) ({self._reducer(kind, x.dtype)}) '
+            f"{{dimensions = {dense_i64(dims)}}} : ({type_of(x)}, {type_of(init)}) -> {type_of(result)}"
+        )
+        return result
+
+    def convolution(self, x: Value, w: Value, stride: int, padding: int) -> Value:
+        n, _, h, wd = x.shape
+        out_c, _, kh, kw = w.shape
+        oh = (h + 2 * padding - kh) // stride + 1
+        ow = (wd + 2 * padding - kw) // stride + 1
+        attrs = ("batch_group_count = 1 : i64, "
+                 "dimension_numbers = #mhlo.conv<[b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1]>, "
+                 "feature_group_count = 1 : i64, "
+                 f"padding = dense<[[{padding}, {padding}], [{padding}, {padding}]]> : tensor<2x2xi64>, "
+                 "rhs_dilation = dense<1> : tensor<2xi64>, "
+                 f"window_strides = dense<{stride}> : tensor<2xi64>")
+        return self.emit("mhlo.convolution", [x, w], (n, out_c, oh, ow), x.dtype, attrs)
+
+    def max_pool(self, x: Value, window: int, stride: int, padding: int) -> Value:
+        n, c, h, w = x.shape
+        oh = (h + 2 * padding - window) // stride + 1
+        ow = (w + 2 * padding - window) // stride + 1
+        init = self.constant("0xFF800000", (), x.dtype)
+        result = self._result((n, c, oh, ow), x.dtype)
+        attrs = (f"padding = dense<[[0, 0], [0, 0], [{padding}, {padding}], [{padding}, {padding}]]> "
+                 ": tensor<4x2xi64>, "
+                 f"window_dimensions = {dense_i64([1, 1, window, window])}, "
+                 f"window_strides = {dense_i64([1, 1, stride, stride])}")
+        self.body.append(
+            f'  {result.name} = "mhlo.reduce_window"({x.name}, {init.name}) '
+            f'({self._reducer("maximum", x.dtype)}) {{{attrs}}} : '
+            f"({type_of(x)}, {type_of(init)}) -> {type_of(result)}"
+        )
+        return result
+
+    def gather_rows(self, table: Value, ids: Value) -> Value:
+        """Embedding lookup of `ids` of any shape into rows of `table`."""
+        dim = table.shape[1]
+        rank = len(ids.shape)
+        attrs = ("dimension_numbers = #mhlo.gather<"
+                 f"offset_dims = [{rank}], collapsed_slice_dims = [0], start_index_map = [0], "
+                 f"index_vector_dim = {rank}>, indices_are_sorted = false, "
+                 f"slice_sizes = {dense_i64([1, dim])}")
+        return self.emit("mhlo.gather", [table, ids], tuple(ids.shape) + (dim,), table.dtype, attrs)
+
+    # ---- layers ----
+
+    def linear(self, x: Value, out_features: int, bias: bool = True) -> Value:
+        in_features = x.shape[-1]
+        weight = self.arg((out_features, in_features))
+        rows = math.prod(x.shape[:-1])
+        flat = self.reshape(x, (rows, in_features)) if len(x.shape) != 2 else x
+        y = self.dot_general(flat, weight, [], [], [1], [1])
+        if bias:
+            y = self.add(y, self.arg((out_features,)))
+        return self.reshape(y, tuple(x.shape[:-1]) + (out_features,)) if len(x.shape) != 2 else y
+
+    def relu(self, x: Value) -> Value:
+        return self.max(x, self.scalar(0.0, x))
+
+    def gelu(self, x: Value) -> Value:
+        # tanh approximation
+        x3 = self.mul(self.mul(x, x), x)
+        inner = self.mul(self.add(x, self.mul(x3, self.scalar(0.044715, x))),
+                         self.scalar(math.sqrt(2.0 / math.pi), x))
+        t = self.add(self.unary("mhlo.tanh", inner), self.scalar(1.0, x))
+        return self.mul(self.mul(x, t), self.scalar(0.5, x))
+
+    def layer_norm(self, x: Value, eps: float = 1e-5) -> Value:
+        last = len(x.shape) - 1
+        reduced_shape = x.shape[:-1] + (1,)
+        n = self.scalar(x.shape[-1], x)
+        mean = self.reshape(self.div(self.reduce(x, [last]), n), reduced_shape)
+        centered = self.sub(x, mean)
+        var = self.reshape(self.div(self.reduce(self.mul(centered, centered), [last]), n), reduced_shape)
+        inv_std = self.unary("mhlo.rsqrt", self.add(var, self.scalar(eps, x)))
+        y = self.mul(centered, inv_std)
+        return self.add(self.mul(y, self.arg((x.shape[-1],))), self.arg((x.shape[-1],)))
+
+    def softmax(self, x: Value) -> Value:
+        last = len(x.shape) - 1
+        reduced_shape = x.shape[:-1] + (1,)
+        x_max = self.reshape(self.reduce(x, [last], "maximum"), reduced_shape)
+        e = self.unary("mhlo.exponential", self.sub(x, x_max))
+        s = self.reshape(self.reduce(e, [last]), reduced_shape)
+        return self.div(e, s)
+
+    def attention(self, q: Value, k: Value, v: Value) -> Value:
+        """Attention of q [B, H, Sq, D] over k, v [B, H, Sk, D]."""
+        scores = self.dot_general(q, k, [0, 1], [0, 1], [3], [3])
+        scores = self.mul(scores, self.scalar(1.0 / math.sqrt(q.shape[-1]), scores))
+        return self.dot_general(self.softmax(scores), v, [0, 1], [0, 1], [3], [2])
+
+    def split_heads(self, x: Value, num_heads: int) -> Value:
+        b, s, hidden = x.shape
+        x = self.reshape(x, (b, s, num_heads, hidden // num_heads))
+        return self.transpose(x, [0, 2, 1, 3])
+
+    def merge_heads(self, x: Value) -> Value:
+        b, h, s, d = x.shape
+        return self.reshape(self.transpose(x, [0, 2, 1, 3]), (b, s, h * d))
+
+
+# ---- models ----
+
+BERT_VOCAB = 30522
+
+
+def bert_base(batch: int, seq_len: int = 128, hidden: int = 768, num_heads: int = 12,
+              num_layers: int = 12, intermediate: int = 3072) -> str:
+    g = GraphBuilder("bert_base")
+    ids = g.arg((batch, seq_len), "i64")
+    # additive attention mask, 0 for tokens and a large negative for padding
+    mask = g.arg((batch, 1, 1, seq_len))
+    x = g.gather_rows(g.arg((BERT_VOCAB, hidden)), ids)
+    x = g.add(x, g.arg((seq_len, hidden)))
+    x = g.layer_norm(x, 1e-12)
+    for _ in range(num_layers):
+        q = g.split_heads(g.linear(x, hidden), num_heads)
+        k = g.split_heads(g.linear(x, hidden), num_heads)
+        v = g.split_heads(g.linear(x, hidden), num_heads)
+        scores = g.dot_general(q, k, [0, 1], [0, 1], [3], [3])
+        scores = g.add(g.mul(scores, g.scalar(1.0 / math.sqrt(hidden // num_heads), scores)), mask)
+        context = g.dot_general(g.softmax(scores), v, [0, 1], [0, 1], [3], [2])
+        x = g.layer_norm(g.add(x, g.linear(g.merge_heads(context), hidden)), 1e-12)
+        ffn = g.linear(g.gelu(g.linear(x, intermediate)), hidden)
+        x = g.layer_norm(g.add(x, ffn), 1e-12)
+    return g.build([x])
+
+
+def _conv_bias(g: GraphBuilder, x: Value, out_c: int, kernel: int, stride: int, relu: bool) -> Value:
+    # batch norm is folded into the filter and bias, as after inference export
+    y = g.convolution(x, g.arg((out_c, x.shape[1], kernel, kernel)), stride, kernel // 2)
+    y = g.add(y, g.broadcast_in_dim(g.arg((out_c,)), y.shape, [1]))
+    return g.relu(y) if relu else y
+
+
+def resnet50(batch: int, image_size: int = 224, num_classes: int = 1000) -> str:
+    g = GraphBuilder("resnet50")
+    x = g.arg((batch, 3, image_size, image_size))
+    x = _conv_bias(g, x, 64, 7, 2, True)
+    x = g.max_pool(x, 3, 2, 1)
+    for width, blocks, stride in [(64, 3, 1), (128, 4, 2), (256, 6, 2), (512, 3, 2)]:
+        for i in range(blocks):
+            s = stride if i == 0 else 1
+            y = _conv_bias(g, x, width, 1, 1, True)
+            y = _conv_bias(g, y, width, 3, s, True)
+            y = _conv_bias(g, y, width * 4, 1, 1, False)
+            shortcut = x
+            if i == 0:
+                shortcut = _conv_bias(g, x, width * 4, 1, s, False)
+            x = g.relu(g.add(y, shortcut))
+    pooled = g.div(g.reduce(x, [2, 3]), g.scalar(x.shape[2] * x.shape[3], x))
+    return g.build([g.linear(pooled, num_classes)])
+
+
+DLRM_TABLE_ROWS = 100000
+
+
+def dlrm(batch: int, num_dense: int = 13, num_tables: int = 8, dim: int = 64) -> str:
+    g = GraphBuilder("dlrm")
+    dense = g.arg((batch, num_dense))
+    indices = [g.arg((batch,), "i64") for _ in range(num_tables)]
+    x = dense
+    for width in [512, 256, dim]:
+        x = g.relu(g.linear(x, width))
+    features = [g.reshape(x, (batch, 1, dim))]
+    for ids in indices:
+        emb = g.gather_rows(g.arg((DLRM_TABLE_ROWS, dim)), ids)
+        features.append(g.reshape(emb, (batch, 1, dim)))
+    # pairwise dot interaction of all features
+    t = g.concatenate(features, 1)
+    inter = g.dot_general(t, t, [0], [0], [2], [2])
+    n = num_tables + 1
+    y = g.concatenate([x, g.reshape(inter, (batch, n * n))], 1)
+    for width in [512, 256]:
+        y = g.relu(g.linear(y, width))
+    return g.build([g.unary("mhlo.logistic", g.linear(y, 1))])
+
+
+GPT_VOCAB = 50257
+
+
+def gpt_decode_step(batch: int, past_len: int = 127, hidden: int = 768, num_heads: int = 12,
+                    num_layers: int = 12) -> str:
+    """One decoding step of a gpt2-small sized decoder with a kv cache."""
+    g = GraphBuilder("gpt_decode_step")
+    head_dim = hidden // num_heads
+    ids = g.arg((batch, 1), "i64")
+    caches = [(g.arg((batch, num_heads, past_len, head_dim)),
+               g.arg((batch, num_heads, past_len, head_dim))) for _ in range(num_layers)]
+    wte = g.arg((GPT_VOCAB, hidden))
+    # embedding of the current position
+    x = g.add(g.gather_rows(wte, ids), g.arg((1, hidden)))
+    new_caches = []
+    for past_k, past_v in caches:
+        h = g.layer_norm(x)
+        q = g.split_heads(g.linear(h, hidden), num_heads)
+        k = g.concatenate([past_k, g.split_heads(g.linear(h, hidden), num_heads)], 2)
+        v = g.concatenate([past_v, g.split_heads(g.linear(h, hidden), num_heads)], 2)
+        new_caches += [k, v]
+        x = g.add(x, g.linear(g.merge_heads(g.attention(q, k, v)), hidden))
+        x = g.add(x, g.linear(g.gelu(g.linear(g.layer_norm(x), 4 * hidden)), hidden))
+    x = g.reshape(g.layer_norm(x), (batch, hidden))
+    # language model head tied to the token embedding
+    logits = g.dot_general(x, wte, [], [], [1], [1])
+    return g.build([logits] + new_caches)
+
+
+PREPROCESS_HASH_HIGH = 2**31
+
+
+def feature_preprocess(batch: int, num_categorical: int = 16, num_numeric: int = 16,
+                       num_hash_buckets: int = 1000, num_boundaries: int = 32) -> str:
+    """Feature-column style preprocessing: string features arrive as 64-bit
+    fingerprints, which are hashed into per-feature buckets with 0 kept for
+    missing values, and numeric features are bucketized by boundaries and
+    normalized."""
+    g = GraphBuilder("feature_preprocess")
+    fingerprints = g.arg((batch, num_categorical), "i64")
+    numeric = g.arg((batch, num_numeric))
+
+    zero = g.constant("0", (), "i64")
+    buckets = g.add(g.rem(fingerprints, g.constant(str(num_hash_buckets - 1), (), "i64")),
+                    g.constant("1", (), "i64"))
+    buckets = g.select(g.compare(fingerprints, zero, "EQ"), g.broadcast_to(zero, buckets.shape), buckets)
+    offsets = g.constant(f"[{', '.join(str(i * num_hash_buckets) for i in range(num_categorical))}]",
+                         (num_categorical,), "i64")
+    categorical_ids = g.add(buckets, offsets)
+
+    boundaries = ", ".join(float_literal(i / num_boundaries) for i in range(1, num_boundaries + 1))
+    bounds = g.constant(f"[{boundaries}]", (num_boundaries,), "f32")
+    x3 = g.reshape(numeric, (batch, num_numeric, 1))
+    above = g.convert(g.compare(x3, g.reshape(bounds, (1, 1, num_boundaries)), "GE"), "i64")
+    numeric_ids = g.add(g.reduce(above, [2]),
+                        g.constant(str(num_categorical * num_hash_buckets), (), "i64"))
+    numeric_offsets = ", ".join(str(i * (num_boundaries + 1)) for i in range(num_numeric))
+    numeric_ids = g.add(numeric_ids, g.constant(f"[{numeric_offsets}]", (num_numeric,), "i64"))
+
+    normalized = g.unary("mhlo.log_plus_one", g.max(numeric, g.scalar(0.0, numeric)))
+    normalized = g.div(g.sub(normalized, g.scalar(0.5, normalized)), g.scalar(0.25, normalized))
+    return g.build([g.concatenate([categorical_ids, numeric_ids], 1), normalized])
+
+
+class Model(NamedTuple):
+    build: Callable[[int], str]
+    # integer inputs are drawn from [0, int_input_high)
+    int_input_high: int
+
+
+MODELS = {
+    "bert_base": Model(bert_base, BERT_VOCAB),
+    "resnet50": Model(resnet50, 1),
+    "dlrm": Model(dlrm, DLRM_TABLE_ROWS),
+    "gpt_decode_step": Model(gpt_decode_step, GPT_VOCAB),
+    "feature_preprocess": Model(feature_preprocess, PREPROCESS_HASH_HIGH),
+}
+
+def model_file_name(name: str, batch: int) -> str:
+    return f"{name}_bs{batch}.mlir"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="generate the benchmark models for inspection")
+    parser.add_argument("--batch-sizes", type=str, default="1")
+    parser.add_argument("--outdir", type=str, default="./models")
+    args = parser.parse_args()
+    os.makedirs(args.outdir, exist_ok=True)
+    for name, model in MODELS.items():
+        for batch in [int(b) for b in args.batch_sizes.split(",")]:
+            with open(os.path.join(args.outdir, model_file_name(name, batch)), "w") as f:
+                f.write(model.build(batch))
+
+
+if __name__ == "__main__":
+    main()
@@ -12,6 +12,7 @@
 # limitations under the License.
 # ==============================================================================
 
+from perf_db import PerfRecord, get_peak_arena_bytes
 from reporting import TestResult
 
 import brt
@@ -101,6 +102,27 @@ class MLIRDataGenerator:
         return outputs
 
 
+def run_standalone_cpp(cpp_file, np_inputs, torch_outputs) -> List[torch.Tensor]:
+    """Build the standalone c++ emitted by byteir as a shared library and run it."""
+    import ctypes
+    import subprocess
+
+    lib_file = os.path.splitext(cpp_file)[0] + ".so"
+    cxx = os.environ.get("CXX", "c++")
+    subprocess.run(
+        [cxx, "-O2", "-std=c++17", "-shared", "-fPIC", cpp_file, "-o", lib_file],
+        check=True,
+    )
+    lib = ctypes.CDLL(lib_file)
+
+    inputs = [np.ascontiguousarray(np_input) for np_input in np_inputs]
+    outputs = [torch.empty_like(output) for output in torch_outputs]
+    input_ptrs = (ctypes.c_void_p * len(inputs))(*[i.ctypes.data for i in inputs])
+    output_ptrs = (ctypes.c_void_p * len(outputs))(*[o.data_ptr() for o in outputs])
+    lib.run(input_ptrs, output_ptrs)
+    return outputs
+
+
 def compile_and_run_mlir(mhlo_file, target, workdir, verbose, mode="numerical", unique_name=None, **kwargs):
     if unique_name is None:
         unique_name = os.path.basename(mhlo_file).split(".")[0] + "." + target
@@ -120,13 +142,16 @@ def compile_and_run_mlir(mhlo_file, target, workdir, verbose, mode="numerical",
         os.makedirs(workdir, exist_ok=True)
         os.makedirs(workdir + f"/{unique_name}", exist_ok=True)
         output_mlir_file_name = f"{workdir}/{unique_name}/{unique_name}.rt.mlir"
+        compile_start = time.perf_counter()
         byteir.compile(
             mhlo_file,
             output_mlir_file_name,
             entry_func=entry_func_name,
             target=target,
             verbose=verbose,
+            emit_standalone_cpp=(mode == "aot"),
         )
+        compile_time = time.perf_counter() - compile_start
     except Exception as e:
         return TestResult(
             unique_name=unique_name,
@@ -150,6 +175,33 @@ def compile_and_run_mlir(mhlo_file, target, workdir, verbose, mode="numerical",
 
         if mode == "numerical":
             brt_backend.run_with_outputs(torch_inputs, torch_outputs)
+        elif mode == "aot":
+            # brt outputs are the golden of the standalone c++
+            brt_backend.run_with_outputs(torch_inputs, torch_outputs)
+            golden_outputs = [output.cpu().numpy() for output in torch_outputs]
+            torch_outputs = run_standalone_cpp(
+                f"{workdir}/{unique_name}/{unique_name}.rt.aot.cpp",
+                np_inputs,
+                torch_outputs,
+            )
+        elif mode == "perf":
+            latencies = brt_backend.profile_latencies_with_outputs(
+                torch_inputs,
+                torch_outputs,
+                warmup_trials=kwargs.get("warmup_trials", 10),
+                run_trials=kwargs.get("run_trials", 100),
+            )
+            perf_record = PerfRecord.from_measurements(
+                latencies, get_peak_arena_bytes(output_mlir_file_name), compile_time
+            )
+            return TestResult(
+                unique_name=unique_name,
+                compilation_error=None,
+                runtime_error=None,
+                numerical_error=None,
+                performance_result=perf_record.latency_p50_ms,
+                perf_record=perf_record,
+            )
         else:
             avg_time = brt_backend.profile_with_outputs(torch_inputs, torch_outputs)
             return TestResult(
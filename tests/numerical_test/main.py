@@ -19,6 +19,7 @@ import re
 import sys
 
 from execute import compile_and_run_torch, compile_and_run_mlir
+from perf_db import PerfDB, compare_with_baseline, get_git_revision
 from reporting import report_results
 from torch_e2e_testing.registry import (
     GLOBAL_TORCH_TEST_REGISTRY,
@@ -42,7 +43,7 @@ def get_local_gpu_arch():
     gpu_arch = int(gpu_arch[3:])
     return gpu_arch
 
-def run(target, filter, workdir, mode="numerical", verbose=False):
+def run(target, filter, workdir, mode="numerical", verbose=False, **kwargs):
     if target == "dynamo":
         from torch_dynamo_e2e_testing.execute import run_torch_dynamo_tests
         gpu_arch = get_local_gpu_arch()
@@ -70,7 +71,7 @@ def run(target, filter, workdir, mode="numerical", verbose=False):
             if target == "cpu":
                 results.append(
                     compile_and_run_mlir(
-                        os.path.join(CPU_MLIR_TEST_DIR, test), target, workdir, verbose, mode
+                        os.path.join(CPU_MLIR_TEST_DIR, test), target, workdir, verbose, mode, **kwargs
                     )
                 )
             else:
@@ -102,8 +103,43 @@ def parse_args():
         "--mode",
         type=str,
         default="numerical",
-        choices=["numerical", "profile"],
-        help="testing mode, `numerical` means numerical test, `profile` means performance test",
+        choices=["numerical", "profile", "aot", "perf"],
+        help="testing mode, `numerical` means numerical test, `profile` means performance test, "
+        "`aot` means comparing standalone c++ against brt (cpu only), "
+        "`perf` means recording latency percentiles, arena and compile time into --perf-db "
+        "and comparing them against a baseline (cpu only)",
+    )
+    parser.add_argument(
+        "--perf-db",
+        type=str,
+        default="./perf_db.json",
+        help="json database of perf results, keyed by machine signature and git revision",
+    )
+    parser.add_argument(
+        "--baseline",
+        type=str,
+        default=None,
+        help="git revision in --perf-db to compare against, the latest other revision if not set",
+    )
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.1,
+        help="relative latency increase over the baseline reported as a regression",
+    )
+    parser.add_argument(
+        "--compile-time-tolerance",
+        type=float,
+        default=0.5,
+        help="relative compile time increase over the baseline reported as a regression",
+    )
+    parser.add_argument("--warmup-trials", type=int, default=10)
+    parser.add_argument("--run-trials", type=int, default=100)
+    parser.add_argument(
+        "--no-record",
+        default=False,
+        action="store_true",
+        help="only compare against the baseline without recording results into --perf-db",
     )
     parser.add_argument(
         "-f",
@@ -133,9 +169,40 @@ def parse_args():
         help="Work directory to save compiled outputs",
     )
     args = parser.parse_args()
+    if args.mode in ["aot", "perf"] and args.target != "cpu":
+        parser.error(f"{args.mode} mode only supports cpu target")
     return args
 
 
+def check_perf_regressions(results, args):
+    db = PerfDB(args.perf_db)
+    revision = get_git_revision()
+    records = {
+        result.unique_name: result.perf_record
+        for result in results
+        if result.perf_record is not None
+    }
+    baseline_revision = args.baseline or db.latest_revision(exclude=revision)
+    baseline = db.get(baseline_revision) if baseline_revision else None
+
+    regressions = []
+    if baseline is None:
+        print(f"\n****** no perf baseline on machine {db.machine_signature}")
+    else:
+        regressions = compare_with_baseline(
+            records, baseline, args.tolerance, args.compile_time_tolerance
+        )
+        print(f"\n****** PERF REGRESSIONS against {baseline_revision} - {len(regressions)}")
+        for regression in regressions:
+            print(regression)
+
+    if not args.no_record:
+        db.record(revision, records)
+        db.save()
+        print(f"\nrecorded perf of {revision} on machine {db.machine_signature} into {args.perf_db}")
+    return len(regressions) > 0
+
+
 def main():
     args = parse_args()
 
@@ -144,9 +211,19 @@ def main():
         for target in ["cpu", "cuda", "cuda_with_ait", "dynamo"]:
             results += run(target, args.filter, args.workdir)
     else:
-        results += run(args.target, args.filter, args.workdir, mode=args.mode, verbose=args.verbose)
+        results += run(
+            args.target,
+            args.filter,
+            args.workdir,
+            mode=args.mode,
+            verbose=args.verbose,
+            warmup_trials=args.warmup_trials,
+            run_trials=args.run_trials,
+        )
 
     failed = report_results(results)
+    if args.mode == "perf":
+        failed = check_perf_regressions(results, args) or failed
     sys.exit(1 if failed else 0)
 
 
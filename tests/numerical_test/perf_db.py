@@ -0,0 +1,187 @@
+# Copyright 2024 ByteDance Ltd. and/or its affiliates. All rights reserved.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+
+import hashlib
+import json
+import os
+import platform
+import subprocess
+import time
+from typing import Dict, List, NamedTuple, Optional, Tuple
+
+import numpy as np
+
+
+def latency_stats(latencies_ms: List[float]) -> Tuple[float, float, float, float]:
+    """Return p50, p90, p99 and mean of latencies in ms."""
+    p50, p90, p99 = np.percentile(latencies_ms, [50, 90, 99])
+    return float(p50), float(p90), float(p99), float(np.mean(latencies_ms))
+
+
+class PerfRecord(NamedTuple):
+    latency_p50_ms: float
+    latency_p90_ms: float
+    latency_p99_ms: float
+    latency_mean_ms: float
+    peak_arena_bytes: int
+    compile_time_s: float
+
+    @staticmethod
+    def from_measurements(latencies_ms: List[float], peak_arena_bytes: int, compile_time_s: float):
+        p50, p90, p99, mean = latency_stats(latencies_ms)
+        return PerfRecord(
+            latency_p50_ms=p50,
+            latency_p90_ms=p90,
+            latency_p99_ms=p99,
+            latency_mean_ms=mean,
+            peak_arena_bytes=int(peak_arena_bytes),
+            compile_time_s=float(compile_time_s),
+        )
+
+
+def get_peak_arena_bytes(byre_file) -> int:
+    """Sum static allocs of the entry function of a compiled byre module,
+    which is the arena brt allocates for intermediates once memory planning
+    folded them into a few buffers."""
+    from byteir import ir
+    from byteir.utils import mlir_type_to_np_dtype
+
+    context = ir.Context()
+    with open(byre_file, "rb") as f:
+        module = ir.Module.parse(f.read(), context)
+    total = 0
+    for func in module.body.operations:
+        if "byre.entry_point" not in func.attributes:
+            continue
+        for op in func.regions[0].blocks[0].operations:
+            if op.operation.name != "memref.alloc":
+                continue
+            memref_type = ir.MemRefType(op.result.type)
+            if not memref_type.has_static_shape:
+                continue
+            itemsize = np.dtype(mlir_type_to_np_dtype(memref_type.element_type)).itemsize
+            total += int(np.prod(memref_type.shape)) * itemsize
+    return total
+
+
+def get_git_revision() -> str:
+    try:
+        return subprocess.check_output(
+            ["git", "rev-parse", "--short", "HEAD"],
+            cwd=os.path.dirname(os.path.abspath(__file__)),
+            stderr=subprocess.DEVNULL,
+        ).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def get_machine_info() -> Dict[str, str]:
+    cpu_model = platform.processor()
+    if os.path.exists("/proc/cpuinfo"):
+        with open("/proc/cpuinfo", "r") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpu_model = line.split(":", 1)[1].strip()
+                    break
+    return {
+        "cpu": cpu_model,
+        "num_cpus": str(os.cpu_count()),
+        "machine": platform.machine(),
+        "system": platform.system(),
+    }
+
+
+def get_machine_signature(info: Dict[str, str]) -> str:
+    """Results are only comparable on machines of the same signature."""
+    content = json.dumps(info, sort_keys=True).encode()
+    return hashlib.sha1(content).hexdigest()[:12]
+
+
+class PerfDB:
+    """Perf results stored as json, keyed by machine signature and then by
+    git revision:
+      {"machines": {signature: {"info": {...},
+                                "revisions": {revision: {"timestamp": ...,
+                                                         "results": {test: PerfRecord}}}}}}
+    """
+
+    def __init__(self, path):
+        self.path = path
+        self.db = {"machines": {}}
+        if os.path.exists(path):
+            with open(path, "r") as f:
+                self.db = json.load(f)
+        self.machine_info = get_machine_info()
+        self.machine_signature = get_machine_signature(self.machine_info)
+
+    def _revisions(self) -> Dict:
+        machine = self.db["machines"].setdefault(
+            self.machine_signature, {"info": self.machine_info, "revisions": {}}
+        )
+        return machine["revisions"]
+
+    def get(self, revision) -> Optional[Dict[str, PerfRecord]]:
+        entry = self._revisions().get(revision)
+        if entry is None:
+            return None
+        return {name: PerfRecord(**record) for name, record in entry["results"].items()}
+
+    def latest_revision(self, exclude=None) -> Optional[str]:
+        candidates = [
+            (entry["timestamp"], revision)
+            for revision, entry in self._revisions().items()
+            if revision != exclude
+        ]
+        return max(candidates)[1] if candidates else None
+
+    def record(self, revision, results: Dict[str, PerfRecord]):
+        entry = self._revisions().setdefault(revision, {"timestamp": 0, "results": {}})
+        entry["timestamp"] = time.time()
+        for name, record in results.items():
+            entry["results"][name] = record._asdict()
+
+    def save(self):
+        os.makedirs(os.path.dirname(os.path.abspath(self.path)), exist_ok=True)
+        with open(self.path, "w") as f:
+            json.dump(self.db, f, indent=2, sort_keys=True)
+
+
+def compare_with_baseline(
+    results: Dict[str, PerfRecord],
+    baseline: Dict[str, PerfRecord],
+    tolerance: float,
+    compile_time_tolerance: float,
+) -> List[str]:
+    """Return a message for each metric regressed beyond its tolerance, tests
+    missing in the baseline are skipped."""
+    regressions = []
+    for name, record in sorted(results.items()):
+        base = baseline.get(name)
+        if base is None:
+            continue
+        checks = [
+            ("latency_p50_ms", tolerance),
+            ("latency_p99_ms", tolerance),
+            ("peak_arena_bytes", 0.0),
+            ("compile_time_s", compile_time_tolerance),
+        ]
+        for metric, tol in checks:
+            current = getattr(record, metric)
+            previous = getattr(base, metric)
+            if current > previous * (1.0 + tol):
+                regressions.append(
+                    f"{name}: {metric} regressed from {previous:.6g} to {current:.6g}"
+                    f" (tolerance {tol:.0%})"
+                )
+    return regressions
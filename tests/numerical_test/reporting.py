@@ -21,6 +21,8 @@ class TestResult(NamedTuple):
     runtime_error: Optional[str]
     numerical_error: Optional[str]
     performance_result: Optional[int]
+    # latency percentiles, arena and compile time of cpu perf mode
+    perf_record: Optional["PerfRecord"] = None
 
 
 def report_results(results: List[TestResult]):
@@ -43,7 +45,12 @@ def report_results(results: List[TestResult]):
 
     print(f"\n****** PASS tests - {len(pass_set)} tests")
     for test in pass_set:
-        if test.performance_result is not None:
+        if test.perf_record is not None:
+            record = test.perf_record
+            print(test.unique_name,
+                  f" p50 {record.latency_p50_ms:.4f} ms, p99 {record.latency_p99_ms:.4f} ms,"
+                  f" arena {record.peak_arena_bytes} bytes, compile {record.compile_time_s:.2f} s")
+        elif test.performance_result is not None:
             print(test.unique_name, f" {test.performance_result} ms")
         else:
             print(test.unique_name, " --- PASS")